@@ -0,0 +1,120 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace NumCPP::bench {
+
+// Per-run parameters handed to a benchmark body
+class State {
+public:
+    State(size_t size, size_t threads, double min_time)
+        : size_(size)
+        , threads_(threads)
+        , min_time_(min_time)
+    {
+    }
+
+    // Problem size: element count for array kernels, n for n x n matrices
+    size_t size() const { return size_; }
+    size_t threads() const { return threads_; }
+
+    // Work done by one call of the measured body, for GB/s and GFLOP/s
+    void set_bytes(double bytes) { bytes_ = bytes; }
+    void set_flops(double flops) { flops_ = flops; }
+    double bytes() const { return bytes_; }
+    double flops() const { return flops_; }
+
+    // Time body() repeatedly. Calls are batched so that every sample takes
+    // at least ~50us, and sampling stops once min_time seconds have passed.
+    template <typename F>
+    void measure(F&& body);
+
+    // Seconds per call, one entry per sample
+    const std::vector<double>& samples() const { return samples_; }
+    size_t iterations() const { return iterations_; }
+
+private:
+    size_t size_;
+    size_t threads_;
+    double min_time_;
+    double bytes_ = 0.0;
+    double flops_ = 0.0;
+    size_t iterations_ = 0;
+    std::vector<double> samples_;
+};
+
+// Element counts whose double buffers sit in L1, L2, L3 and DRAM on common
+// x86 parts (16 KiB, 128 KiB, 2 MiB and 32 MiB)
+inline std::vector<size_t> cache_sweep()
+{
+    return { 2048, 16384, 262144, 4194304 };
+}
+
+struct Benchmark {
+    std::string name;
+    std::vector<size_t> sizes;
+    std::function<void(State&)> body;
+};
+
+inline std::vector<Benchmark>& registry()
+{
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+struct Registrar {
+    Registrar(std::string name, std::vector<size_t> sizes, std::function<void(State&)> body)
+    {
+        registry().push_back({ std::move(name), std::move(sizes), std::move(body) });
+    }
+};
+
+// Prevent the compiler from discarding a computed value
+template <typename T>
+inline void keep(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template <typename F>
+void State::measure(F&& body)
+{
+    using clock = std::chrono::steady_clock;
+    auto seconds = [](clock::duration d) { return std::chrono::duration<double>(d).count(); };
+
+    auto start = clock::now();
+    body(); // warm-up: page faults, lazy thread start
+    double once = std::max(seconds(clock::now() - start), 1e-9);
+    size_t batch = std::max<size_t>(1, static_cast<size_t>(50e-6 / once));
+
+    samples_.clear();
+    iterations_ = 0;
+    auto begin = clock::now();
+    while (samples_.size() < 5 || (seconds(clock::now() - begin) < min_time_ && samples_.size() < 10000)) {
+        auto t0 = clock::now();
+        for (size_t i = 0; i < batch; ++i)
+            body();
+        samples_.push_back(seconds(clock::now() - t0) / double(batch));
+        iterations_ += batch;
+    }
+}
+
+} // namespace NumCPP::bench
+
+#define NUMCPP_BENCH_CONCAT_(a, b) a##b
+#define NUMCPP_BENCH_CONCAT(a, b) NUMCPP_BENCH_CONCAT_(a, b)
+
+// NUMCPP_BENCHMARK("name", sizes) { ... body using `state` ... }
+#define NUMCPP_BENCHMARK(name, ...)                                                             \
+    static void NUMCPP_BENCH_CONCAT(bench_body_, __LINE__)(NumCPP::bench::State & state);      \
+    static NumCPP::bench::Registrar NUMCPP_BENCH_CONCAT(bench_registrar_, __LINE__)(            \
+        name, __VA_ARGS__, NUMCPP_BENCH_CONCAT(bench_body_, __LINE__));                         \
+    static void NUMCPP_BENCH_CONCAT(bench_body_, __LINE__)(NumCPP::bench::State & state)
+
+#endif // BENCHMARK_HPP
@@ -0,0 +1,240 @@
+#include "Benchmark.hpp"
+#include "NumCPP.hpp"
+
+using namespace NumCPP;
+using NumCPP::bench::keep;
+
+namespace {
+Array<double> ramp(size_t n)
+{
+    Array<double> a({ n });
+    for (size_t i = 0; i < n; ++i)
+        a(i) = 1.0 + double(i % 97) * 0.01;
+    return a;
+}
+
+// Closest to square 2-D shape with n elements (n is a power of two)
+std::vector<size_t> square_shape(size_t n)
+{
+    size_t rows = 1;
+    while (rows * rows < n)
+        rows *= 2;
+    return { rows, n / rows };
+}
+}
+
+NUMCPP_BENCHMARK("array/construct", bench::cache_sweep())
+{
+    size_t n = state.size();
+    state.set_bytes(double(n) * sizeof(double));
+    state.measure([&] {
+        Array<double> a({ n }, 1.0);
+        keep(a(n - 1));
+    });
+}
+
+NUMCPP_BENCHMARK("array/fill", bench::cache_sweep())
+{
+    Array<double> a({ state.size() });
+    state.set_bytes(double(state.size()) * sizeof(double));
+    state.measure([&] {
+        a.fill(2.5);
+        keep(a.data()[0]);
+    });
+}
+
+NUMCPP_BENCHMARK("array/sum", bench::cache_sweep())
+{
+    Array<double> a = ramp(state.size());
+    state.set_bytes(double(state.size()) * sizeof(double));
+    state.set_flops(double(state.size()));
+    state.measure([&] { keep(a.sum()); });
+}
+
+NUMCPP_BENCHMARK("array/sum_reproducible", bench::cache_sweep())
+{
+    Array<double> a = ramp(state.size());
+    state.set_bytes(double(state.size()) * sizeof(double));
+    state.set_flops(double(state.size()));
+    SumMode saved = sum_mode();
+    set_sum_mode(SumMode::Reproducible);
+    state.measure([&] { keep(a.sum()); });
+    set_sum_mode(saved);
+}
+
+NUMCPP_BENCHMARK("array/moments", bench::cache_sweep())
+{
+    Array<double> a = ramp(state.size());
+    state.set_bytes(double(state.size()) * sizeof(double));
+    state.measure([&] { keep(a.moments().m2); });
+}
+
+NUMCPP_BENCHMARK("array/min", bench::cache_sweep())
+{
+    Array<double> a = ramp(state.size());
+    state.set_bytes(double(state.size()) * sizeof(double));
+    state.set_flops(double(state.size()));
+    state.measure([&] { keep(a.min()); });
+}
+
+NUMCPP_BENCHMARK("array/max", bench::cache_sweep())
+{
+    Array<double> a = ramp(state.size());
+    state.set_bytes(double(state.size()) * sizeof(double));
+    state.set_flops(double(state.size()));
+    state.measure([&] { keep(a.max()); });
+}
+
+NUMCPP_BENCHMARK("array/add", bench::cache_sweep())
+{
+    Array<double> a = ramp(state.size());
+    Array<double> b = ramp(state.size());
+    Array<double> c({ state.size() });
+    state.set_bytes(3.0 * double(state.size()) * sizeof(double));
+    state.set_flops(double(state.size()));
+    state.measure([&] {
+        c = a + b;
+        keep(c.data()[0]);
+    });
+}
+
+NUMCPP_BENCHMARK("array/multiply", bench::cache_sweep())
+{
+    Array<double> a = ramp(state.size());
+    Array<double> b = ramp(state.size());
+    Array<double> c({ state.size() });
+    state.set_bytes(3.0 * double(state.size()) * sizeof(double));
+    state.set_flops(double(state.size()));
+    state.measure([&] {
+        c = a * b;
+        keep(c.data()[0]);
+    });
+}
+
+// a * b + c * 2.0 - 1.0, fused into one pass by the expression templates
+NUMCPP_BENCHMARK("array/fused", bench::cache_sweep())
+{
+    Array<double> a = ramp(state.size());
+    Array<double> b = ramp(state.size());
+    Array<double> c = ramp(state.size());
+    Array<double> d({ state.size() });
+    state.set_bytes(4.0 * double(state.size()) * sizeof(double));
+    state.set_flops(4.0 * double(state.size()));
+    state.measure([&] {
+        d = a * b + c * 2.0 - 1.0;
+        keep(d.data()[0]);
+    });
+}
+
+NUMCPP_BENCHMARK("array/scalar_inplace", bench::cache_sweep())
+{
+    Array<double> a = ramp(state.size());
+    state.set_bytes(2.0 * double(state.size()) * sizeof(double));
+    state.set_flops(double(state.size()));
+    state.measure([&] {
+        a *= 1.0000001;
+        keep(a.data()[0]);
+    });
+}
+
+NUMCPP_BENCHMARK("array/transpose", bench::cache_sweep())
+{
+    Array<double> a = ramp(state.size()).reshape(square_shape(state.size()));
+    state.set_bytes(2.0 * double(state.size()) * sizeof(double));
+    state.measure([&] {
+        Array<double> t = a.transposed();
+        keep(t.data()[0]);
+    });
+}
+
+NUMCPP_BENCHMARK("array/transpose_inplace", bench::cache_sweep())
+{
+    Array<double> a = ramp(state.size()).reshape(square_shape(state.size()));
+    a.data();
+    state.set_bytes(2.0 * double(state.size()) * sizeof(double));
+    state.measure([&] {
+        a.transpose();
+        keep(a.data()[0]);
+    });
+}
+
+NUMCPP_BENCHMARK("array/permute", bench::cache_sweep())
+{
+    // Moves the last axis of an {n/64, 8, 8} array to the front
+    Array<double> a = ramp(state.size()).reshape({ state.size() / 64, 8, 8 });
+    state.set_bytes(2.0 * double(state.size()) * sizeof(double));
+    state.measure([&] {
+        Array<double> p = a.permuted({ 2, 0, 1 });
+        keep(p.data()[0]);
+    });
+}
+
+NUMCPP_BENCHMARK("array/sum_axis0", bench::cache_sweep())
+{
+    const Array<double> a = ramp(state.size()).reshape(square_shape(state.size()));
+    state.set_bytes(double(state.size()) * sizeof(double));
+    state.measure([&] {
+        Array<double> s = a.sum(0);
+        keep(s.data()[0]);
+    });
+}
+
+NUMCPP_BENCHMARK("array/sum_axis1", bench::cache_sweep())
+{
+    const Array<double> a = ramp(state.size()).reshape(square_shape(state.size()));
+    state.set_bytes(double(state.size()) * sizeof(double));
+    state.measure([&] {
+        Array<double> s = a.sum(1);
+        keep(s.data()[0]);
+    });
+}
+
+NUMCPP_BENCHMARK("array/argmax_axis0", bench::cache_sweep())
+{
+    const Array<double> a = ramp(state.size()).reshape(square_shape(state.size()));
+    state.set_bytes(double(state.size()) * sizeof(double));
+    state.measure([&] {
+        Array<size_t> s = a.argmax(0);
+        keep(s.data()[0]);
+    });
+}
+
+NUMCPP_BENCHMARK("array/flatten", bench::cache_sweep())
+{
+    Array<double> a = ramp(state.size()).reshape(square_shape(state.size()));
+    state.set_bytes(2.0 * double(state.size()) * sizeof(double));
+    state.measure([&] {
+        std::vector<double> flat = a.flatten();
+        keep(flat[0]);
+    });
+}
+
+NUMCPP_BENCHMARK("array/index_checked", bench::cache_sweep())
+{
+    const Array<double> a = ramp(state.size()).reshape(square_shape(state.size()));
+    size_t rows = a.shape()[0], cols = a.shape()[1];
+    state.set_bytes(double(state.size()) * sizeof(double));
+    state.measure([&] {
+        double total = 0.0;
+        for (size_t i = 0; i < rows; i++) {
+            for (size_t j = 0; j < cols; j++)
+                total += a(i, j);
+        }
+        keep(total);
+    });
+}
+
+NUMCPP_BENCHMARK("array/index_span", bench::cache_sweep())
+{
+    const Array<double> a = ramp(state.size()).reshape(square_shape(state.size()));
+    state.set_bytes(double(state.size()) * sizeof(double));
+    state.measure([&] {
+        ArraySpan<const double, 2> s = a.span<2>();
+        double total = 0.0;
+        for (size_t i = 0; i < s.extent(0); i++) {
+            for (size_t j = 0; j < s.extent(1); j++)
+                total += s(i, j);
+        }
+        keep(total);
+    });
+}
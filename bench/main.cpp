@@ -0,0 +1,248 @@
+// NumCPP benchmark runner.
+//
+//   bench [--filter SUBSTR] [--threads 1,4,8] [--min-time SECONDS] [--quick]
+//         [--out FILE] [--baseline FILE] [--tolerance FRACTION]
+//   bench --calibrate FILE
+//
+// Results are written as JSON (stdout unless --out is given), one benchmark
+// per line so files diff cleanly. With --baseline, every result that also
+// appears in the baseline gains "baseline_ns_p50" and "change" fields, and
+// the run exits with status 1 if any median is slower by more than the
+// tolerance (default 0.10).
+//
+// --calibrate measures the CostModel parameters of this machine and writes
+// them to FILE for NUMCPP_COST_MODEL, then exits.
+
+#include "Benchmark.hpp"
+#include "NumCPP.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+using namespace NumCPP;
+
+namespace {
+
+struct Options {
+    std::string filter;
+    std::vector<size_t> threads;
+    double min_time = 0.2;
+    bool quick = false;
+    std::string out;
+    std::string baseline;
+    double tolerance = 0.10;
+    std::string calibrate;
+};
+
+struct Result {
+    std::string name;
+    size_t size;
+    size_t threads;
+    size_t iterations;
+    double p50 = 0, p90 = 0, p99 = 0, min = 0, mean = 0; // ns per call
+    double gb_per_s = 0, gflop_per_s = 0;
+};
+
+std::vector<size_t> parse_list(const std::string& text)
+{
+    std::vector<size_t> values;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ','))
+        values.push_back(std::stoul(item));
+    return values;
+}
+
+Options parse_options(int argc, char** argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc)
+                throw std::invalid_argument("Missing value for " + arg);
+            return argv[++i];
+        };
+        if (arg == "--filter")
+            options.filter = value();
+        else if (arg == "--threads")
+            options.threads = parse_list(value());
+        else if (arg == "--min-time")
+            options.min_time = std::stod(value());
+        else if (arg == "--quick")
+            options.quick = true;
+        else if (arg == "--out")
+            options.out = value();
+        else if (arg == "--baseline")
+            options.baseline = value();
+        else if (arg == "--tolerance")
+            options.tolerance = std::stod(value());
+        else if (arg == "--calibrate")
+            options.calibrate = value();
+        else
+            throw std::invalid_argument("Unknown option " + arg);
+    }
+    if (options.threads.empty()) {
+        size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+        options.threads = { 1 };
+        if (hardware > 1)
+            options.threads.push_back(hardware);
+    }
+    if (options.quick)
+        options.min_time = 0.0;
+    return options;
+}
+
+double percentile(std::vector<double> sorted, double q)
+{
+    size_t index = static_cast<size_t>(q * double(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+Result run(const bench::Benchmark& benchmark, size_t size, size_t threads, double min_time)
+{
+    ThreadPool::instance().set_num_threads(threads);
+    bench::State state(size, threads, min_time);
+    benchmark.body(state);
+
+    std::vector<double> samples = state.samples();
+    std::sort(samples.begin(), samples.end());
+    double total = 0.0;
+    for (double s : samples)
+        total += s;
+
+    Result result { benchmark.name, size, threads, state.iterations() };
+    result.p50 = percentile(samples, 0.50) * 1e9;
+    result.p90 = percentile(samples, 0.90) * 1e9;
+    result.p99 = percentile(samples, 0.99) * 1e9;
+    result.min = samples.front() * 1e9;
+    result.mean = total / double(samples.size()) * 1e9;
+    result.gb_per_s = state.bytes() / result.p50;
+    result.gflop_per_s = state.flops() / result.p50;
+    return result;
+}
+
+std::string key(const std::string& name, size_t size, size_t threads)
+{
+    return name + "/" + std::to_string(size) + "/" + std::to_string(threads);
+}
+
+// Reads the p50 of every result in a file written by this runner
+std::map<std::string, double> load_baseline(const std::string& path)
+{
+    std::ifstream in(path);
+    if (!in)
+        throw std::runtime_error("Cannot open baseline " + path);
+    auto field = [](const std::string& line, const std::string& name) {
+        size_t at = line.find("\"" + name + "\":");
+        if (at == std::string::npos)
+            return std::string();
+        at += name.size() + 3;
+        while (at < line.size() && line[at] == ' ')
+            ++at;
+        if (line[at] == '"')
+            return line.substr(at + 1, line.find('"', at + 1) - at - 1);
+        return line.substr(at, line.find_first_of(",}", at) - at);
+    };
+    std::map<std::string, double> baseline;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::string name = field(line, "name");
+        if (name.empty())
+            continue;
+        baseline[key(name, std::stoul(field(line, "size")), std::stoul(field(line, "threads")))]
+            = std::stod(field(line, "ns_p50"));
+    }
+    return baseline;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    std::map<std::string, double> baseline;
+    try {
+        options = parse_options(argc, argv);
+        if (!options.baseline.empty())
+            baseline = load_baseline(options.baseline);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+
+    if (!options.calibrate.empty()) {
+        CostModel::Parameters params = CostModel::instance().calibrate();
+        try {
+            CostModel::instance().save(options.calibrate);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << "\n";
+            return 2;
+        }
+        std::cerr << "dispatch_ns " << params.dispatch_ns << ", ns_per_byte " << params.ns_per_byte
+                  << ", ns_per_op " << params.ns_per_op << ", ns_per_call " << params.ns_per_call << "\n";
+        return 0;
+    }
+
+    std::ofstream file;
+    if (!options.out.empty())
+        file.open(options.out);
+    std::ostream& out = options.out.empty() ? std::cout : file;
+
+    char buffer[512];
+    out << "{\n  \"context\": {\"simd\": \"" << simd_level_name(simd_level())
+        << "\", \"hardware_threads\": " << std::thread::hardware_concurrency() << "},\n"
+        << "  \"benchmarks\": [\n";
+
+    bool first = true;
+    int regressions = 0;
+    for (const auto& benchmark : bench::registry()) {
+        if (benchmark.name.find(options.filter) == std::string::npos)
+            continue;
+        std::vector<size_t> sizes = benchmark.sizes;
+        if (options.quick)
+            sizes.resize(1);
+        for (size_t size : sizes) {
+            for (size_t threads : options.threads) {
+                Result r = run(benchmark, size, threads, options.min_time);
+                std::snprintf(buffer, sizeof(buffer),
+                    "    {\"name\": \"%s\", \"size\": %zu, \"threads\": %zu, \"iterations\": %zu, "
+                    "\"ns_p50\": %.1f, \"ns_p90\": %.1f, \"ns_p99\": %.1f, \"ns_min\": %.1f, "
+                    "\"ns_mean\": %.1f, \"gb_per_s\": %.3f, \"gflop_per_s\": %.3f",
+                    r.name.c_str(), r.size, r.threads, r.iterations, r.p50, r.p90, r.p99, r.min,
+                    r.mean, r.gb_per_s, r.gflop_per_s);
+                out << (first ? "" : ",\n") << buffer;
+                first = false;
+
+                std::cerr << key(r.name, r.size, r.threads) << ": " << r.p50 << " ns";
+                auto it = baseline.find(key(r.name, r.size, r.threads));
+                if (it != baseline.end()) {
+                    double change = r.p50 / it->second - 1.0;
+                    std::snprintf(buffer, sizeof(buffer),
+                        ", \"baseline_ns_p50\": %.1f, \"change\": %.4f", it->second, change);
+                    out << buffer;
+                    std::cerr << " (" << (change >= 0 ? "+" : "") << change * 100.0 << "%)";
+                    if (change > options.tolerance) {
+                        std::cerr << " REGRESSION";
+                        regressions++;
+                    }
+                }
+                out << "}";
+                std::cerr << "\n";
+            }
+        }
+    }
+    out << "\n  ]\n}\n";
+
+    if (regressions > 0) {
+        std::cerr << regressions << " benchmark(s) slower than the baseline by more than "
+                  << options.tolerance * 100.0 << "%\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include "Benchmark.hpp"
+#include "NumCPP.hpp"
+#include <cmath>
+#include <utility>
+
+using namespace NumCPP;
+using NumCPP::bench::keep;
+
+namespace {
+template <typename T>
+Array<T> ramp(size_t n)
+{
+    Array<T> a({ n });
+    for (size_t i = 0; i < n; ++i)
+        a(i) = T(0.05) + T(i % 97) * T(0.03);
+    return a;
+}
+
+// out = f(a) through the library
+template <typename T, typename F>
+void ufunc(bench::State& state, F f)
+{
+    Array<T> a = ramp<T>(state.size());
+    Array<T> out({ state.size() });
+    state.set_bytes(2.0 * double(state.size()) * sizeof(T));
+    state.measure([&] {
+        f(a, out);
+        keep(out.data()[0]);
+    });
+}
+
+// The same with one C library call per element, as a baseline
+template <typename T, typename F>
+void libm(bench::State& state, F f)
+{
+    Array<T> a = ramp<T>(state.size());
+    Array<T> out({ state.size() });
+    const T* in = std::as_const(a).data();
+    state.set_bytes(2.0 * double(state.size()) * sizeof(T));
+    state.measure([&] {
+        T* dst = out.data();
+        for (size_t i = 0; i < state.size(); ++i)
+            dst[i] = f(in[i]);
+        keep(dst[0]);
+    });
+}
+}
+
+NUMCPP_BENCHMARK("math/exp", bench::cache_sweep())
+{
+    ufunc<double>(state, [](auto& a, auto& out) { exp(a, out); });
+}
+
+NUMCPP_BENCHMARK("math/exp_libm", bench::cache_sweep())
+{
+    libm<double>(state, [](double x) { return std::exp(x); });
+}
+
+NUMCPP_BENCHMARK("math/log", bench::cache_sweep())
+{
+    ufunc<double>(state, [](auto& a, auto& out) { log(a, out); });
+}
+
+NUMCPP_BENCHMARK("math/log_libm", bench::cache_sweep())
+{
+    libm<double>(state, [](double x) { return std::log(x); });
+}
+
+NUMCPP_BENCHMARK("math/sin", bench::cache_sweep())
+{
+    ufunc<double>(state, [](auto& a, auto& out) { sin(a, out); });
+}
+
+NUMCPP_BENCHMARK("math/sin_libm", bench::cache_sweep())
+{
+    libm<double>(state, [](double x) { return std::sin(x); });
+}
+
+NUMCPP_BENCHMARK("math/tanh", bench::cache_sweep())
+{
+    ufunc<double>(state, [](auto& a, auto& out) { tanh(a, out); });
+}
+
+NUMCPP_BENCHMARK("math/tanh_libm", bench::cache_sweep())
+{
+    libm<double>(state, [](double x) { return std::tanh(x); });
+}
+
+NUMCPP_BENCHMARK("math/erf", bench::cache_sweep())
+{
+    ufunc<double>(state, [](auto& a, auto& out) { erf(a, out); });
+}
+
+NUMCPP_BENCHMARK("math/erf_libm", bench::cache_sweep())
+{
+    libm<double>(state, [](double x) { return std::erf(x); });
+}
+
+NUMCPP_BENCHMARK("math/expf", bench::cache_sweep())
+{
+    ufunc<float>(state, [](auto& a, auto& out) { exp(a, out); });
+}
+
+NUMCPP_BENCHMARK("math/expf_libm", bench::cache_sweep())
+{
+    libm<float>(state, [](float x) { return std::exp(x); });
+}
+
+// sigmoid(a * w - 1), one fused pass
+NUMCPP_BENCHMARK("math/sigmoid_fused", bench::cache_sweep())
+{
+    Array<double> a = ramp<double>(state.size());
+    Array<double> w = ramp<double>(state.size());
+    Array<double> out({ state.size() });
+    state.set_bytes(3.0 * double(state.size()) * sizeof(double));
+    state.measure([&] {
+        sigmoid(a * w - 1.0, out);
+        keep(out.data()[0]);
+    });
+}
@@ -0,0 +1,205 @@
+#include "Benchmark.hpp"
+#include "NumCPP.hpp"
+
+using namespace NumCPP;
+using NumCPP::bench::keep;
+
+namespace {
+Array<double> random_matrix(size_t n, unsigned seed)
+{
+    Array<double> a({ n, n });
+    for (size_t i = 0; i < n * n; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        a(i) = double(seed >> 16 & 0x7fff) / 32768.0 - 0.5;
+    }
+    // Diagonally dominant, so elimination never meets a tiny pivot
+    for (size_t i = 0; i < n; ++i)
+        a({ i, i }) += double(n);
+    return a;
+}
+}
+
+NUMCPP_BENCHMARK("matrix/dot", { 64, 256, 1024 })
+{
+    size_t n = state.size();
+    Array<double> a = random_matrix(n, 1);
+    Array<double> b = random_matrix(n, 2);
+    Matrix<double> ma(a);
+    Matrix<double> mb(b);
+    state.set_bytes(3.0 * double(n * n) * sizeof(double));
+    state.set_flops(2.0 * double(n) * double(n) * double(n));
+    state.measure([&] {
+        Array<double> c = ma.dot(mb);
+        keep(c.data()[0]);
+    });
+}
+
+NUMCPP_BENCHMARK("matrix/dot_transposed", { 64, 256, 1024 })
+{
+    size_t n = state.size();
+    Array<double> a = random_matrix(n, 1);
+    Array<double> b = random_matrix(n, 2);
+    Matrix<double> ma(a);
+    Matrix<double> mb(b);
+    state.set_bytes(3.0 * double(n * n) * sizeof(double));
+    state.set_flops(2.0 * double(n) * double(n) * double(n));
+    state.measure([&] {
+        Array<double> c = ma.dot(mb, Trans::No, Trans::Yes);
+        keep(c.data()[0]);
+    });
+}
+
+NUMCPP_BENCHMARK("matrix/flatten", { 64, 256, 1024 })
+{
+    size_t n = state.size();
+    Array<double> a = random_matrix(n, 1);
+    Matrix<double> m(a);
+    state.set_bytes(2.0 * double(n * n) * sizeof(double));
+    state.measure([&] {
+        Array<double> flat = m.flatten();
+        keep(flat.data()[0]);
+    });
+}
+
+NUMCPP_BENCHMARK("square/determinant", { 16, 64, 256 })
+{
+    size_t n = state.size();
+    SquareMatrix<double> m(random_matrix(n, 3));
+    state.set_bytes(double(n * n) * sizeof(double));
+    state.set_flops(2.0 / 3.0 * double(n) * double(n) * double(n));
+    state.measure([&] { keep(m.determinant()); });
+}
+
+NUMCPP_BENCHMARK("square/inverse", { 16, 64, 256 })
+{
+    size_t n = state.size();
+    SquareMatrix<double> m(random_matrix(n, 4));
+    state.set_bytes(2.0 * double(n * n) * sizeof(double));
+    state.set_flops(2.0 * double(n) * double(n) * double(n));
+    state.measure([&] {
+        SquareMatrix<double> inv = m.inverse();
+        keep(inv(0, 0));
+    });
+}
+
+NUMCPP_BENCHMARK("lu/factor", { 64, 256, 1024 })
+{
+    size_t n = state.size();
+    Array<double> a = random_matrix(n, 5);
+    state.set_bytes(double(n * n) * sizeof(double));
+    state.set_flops(2.0 / 3.0 * double(n) * double(n) * double(n));
+    state.measure([&] {
+        LU<double> lu(a);
+        keep(lu.factors().data()[0]);
+    });
+}
+
+NUMCPP_BENCHMARK("lu/solve", { 64, 256, 1024 })
+{
+    size_t n = state.size();
+    LU<double> lu(random_matrix(n, 6));
+    Array<double> b({ n }, 1.0);
+    state.set_bytes(double(n * n) * sizeof(double));
+    state.set_flops(2.0 * double(n) * double(n));
+    state.measure([&] {
+        Array<double> x = lu.solve(b);
+        keep(x.data()[0]);
+    });
+}
+
+NUMCPP_BENCHMARK("cholesky/factor", { 64, 256, 1024 })
+{
+    size_t n = state.size();
+    Array<double> a = random_matrix(n, 7);
+    // Symmetric, diagonally dominant, so positive definite
+    double* data = a.data();
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < i; ++j)
+            data[j * n + i] = data[i * n + j];
+    state.set_bytes(double(n * n) * sizeof(double));
+    state.set_flops(1.0 / 3.0 * double(n) * double(n) * double(n));
+    state.measure([&] {
+        Cholesky<double> chol(a);
+        keep(chol.factor().data()[0]);
+    });
+}
+
+// Batches of 4 x 4 transforms: size() matrices inverted and multiplied per call
+NUMCPP_BENCHMARK("fixed4/inverse_dot", { 1024 })
+{
+    size_t n = state.size();
+    std::vector<FixedSquareMatrix<double, 4>> batch(n);
+    for (size_t b = 0; b < n; ++b)
+        batch[b] = FixedSquareMatrix<double, 4>(random_matrix(4, unsigned(b + 1)));
+    state.set_bytes(double(n * 16) * sizeof(double));
+    state.set_flops(double(n) * (128.0 + 200.0));
+    state.measure([&] {
+        double acc = 0;
+        for (const auto& m : batch)
+            acc += m.inverse().dot(m)[0];
+        keep(acc);
+    });
+}
+
+NUMCPP_BENCHMARK("square4/inverse_dot", { 1024 })
+{
+    size_t n = state.size();
+    std::vector<Array<double>> batch;
+    for (size_t b = 0; b < n; ++b)
+        batch.push_back(random_matrix(4, unsigned(b + 1)));
+    state.set_bytes(double(n * 16) * sizeof(double));
+    state.set_flops(double(n) * (128.0 + 200.0));
+    state.measure([&] {
+        double acc = 0;
+        for (auto& a : batch) {
+            SquareMatrix<double> m(a);
+            acc += m.inverse().dot(m).data()[0];
+        }
+        keep(acc);
+    });
+}
+
+// The same 4 x 4 work as a stack: one batched inverse and one batched product,
+// written into preallocated results
+NUMCPP_BENCHMARK("batch4/inverse_matmul", { 1024 })
+{
+    size_t n = state.size();
+    Array<double> stack({ n, 4, 4 });
+    for (size_t b = 0; b < n; ++b) {
+        Array<double> m = random_matrix(4, unsigned(b + 1));
+        std::copy(m.data(), m.data() + 16, stack.data() + b * 16);
+    }
+    Array<double> inv({ n, 4, 4 });
+    Array<double> product({ n, 4, 4 });
+    state.set_bytes(double(n * 48) * sizeof(double));
+    state.set_flops(double(n) * (128.0 + 200.0));
+    state.measure([&] {
+        batch_inverse(stack, inv);
+        batch_matmul(inv, stack, product);
+        keep(product.data()[0]);
+    });
+}
+
+// size() x size() with 16 entries per row, times a dense vector
+NUMCPP_BENCHMARK("sparse/spmv", { 10000, 100000 })
+{
+    size_t n = state.size();
+    CooMatrix<double> coo(n, n);
+    coo.reserve(n * 16);
+    unsigned seed = 1;
+    for (size_t r = 0; r < n; ++r)
+        for (size_t i = 0; i < 16; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            coo.add(r, (size_t(seed) * 2654435761u) % n, 1.0);
+        }
+    CsrMatrix<double> csr = coo.to_csr();
+    Array<double> x({ n }, 1.0);
+    Array<double> y({ n });
+    double nnz = double(csr.nnz());
+    state.set_bytes(nnz * double(sizeof(double) + sizeof(size_t)) + 2.0 * double(n) * sizeof(double));
+    state.set_flops(2.0 * nnz);
+    state.measure([&] {
+        csr.dot(x, y);
+        keep(y.data()[0]);
+    });
+}
@@ -0,0 +1,103 @@
+#ifndef ALLOCATOR_HPP
+#define ALLOCATOR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace NumCPP {
+
+// Counters reported by allocators that track them
+struct AllocatorStats {
+    size_t allocations = 0; // allocate() calls
+    size_t hits = 0; // allocations served from retained memory
+    size_t bytes_in_use = 0; // handed out and not yet deallocated
+    size_t bytes_retained = 0; // held for reuse, not in use
+
+    double hit_rate() const { return allocations ? double(hits) / double(allocations) : 0.0; }
+};
+
+// Source of raw memory for Storage buffers. Implementations must return
+// blocks aligned to at least `alignment` (a power of two) and must be safe to
+// call from several threads.
+class Allocator {
+public:
+    virtual ~Allocator() = default;
+
+    virtual void* allocate(size_t bytes, size_t alignment) = 0;
+    virtual void deallocate(void* ptr, size_t bytes, size_t alignment) noexcept = 0;
+    virtual AllocatorStats stats() const { return {}; }
+};
+
+// Aligned operator new / delete
+class AlignedAllocator : public Allocator {
+public:
+    void* allocate(size_t bytes, size_t alignment) override
+    {
+        return ::operator new(bytes, std::align_val_t(alignment));
+    }
+
+    void deallocate(void* ptr, size_t, size_t alignment) noexcept override
+    {
+        ::operator delete(ptr, std::align_val_t(alignment));
+    }
+};
+
+namespace detail {
+    inline AlignedAllocator& aligned_allocator()
+    {
+        static AlignedAllocator aligned;
+        return aligned;
+    }
+
+    inline std::atomic<Allocator*>& default_allocator_slot()
+    {
+        static std::atomic<Allocator*> slot(&aligned_allocator());
+        return slot;
+    }
+
+    // Set by ScopedAllocator for the current thread
+    inline Allocator*& scoped_allocator_slot()
+    {
+        thread_local Allocator* slot = nullptr;
+        return slot;
+    }
+}
+
+// Allocator used by Storage (and so by Array) when none is given: the
+// innermost ScopedAllocator on this thread, else the process default
+inline Allocator& default_allocator()
+{
+    if (Allocator* scoped = detail::scoped_allocator_slot())
+        return *scoped;
+    return *detail::default_allocator_slot().load(std::memory_order_acquire);
+}
+
+// Replace the default allocator. Buffers remember the allocator that made
+// them, so existing arrays stay valid; `allocator` must outlive them.
+inline void set_default_allocator(Allocator& allocator)
+{
+    detail::default_allocator_slot().store(&allocator, std::memory_order_release);
+}
+
+// Makes `allocator` the default for arrays created on this thread until the
+// guard is destroyed. Guards nest.
+class ScopedAllocator {
+public:
+    explicit ScopedAllocator(Allocator& allocator)
+        : previous_(std::exchange(detail::scoped_allocator_slot(), &allocator))
+    {
+    }
+    ~ScopedAllocator() { detail::scoped_allocator_slot() = previous_; }
+
+    ScopedAllocator(const ScopedAllocator&) = delete;
+    ScopedAllocator& operator=(const ScopedAllocator&) = delete;
+
+private:
+    Allocator* previous_;
+};
+
+} // namespace NumCPP
+
+#endif // ALLOCATOR_HPP
@@ -1,6 +1,11 @@
 #ifndef ARRAY_HPP
 #define ARRAY_HPP
 
+#include "ArraySpan.hpp"
+#include "ArrayView.hpp"
+#include "Expression.hpp"
+#include "Reduce.hpp"
+#include "Storage.hpp"
 #include <cmath>
 #include <initializer_list>
 #include <iostream>
@@ -10,8 +15,10 @@
 namespace NumCPP {
 
 template <typename T = double>
-class Array {
+class Array : public ArrayExpr<Array<T>, T> {
 public:
+    using value_type = T;
+
     // Constructors and Destructor
     Array();
     ~Array();
@@ -29,17 +36,44 @@ public:
     Array(const std::vector<size_t>& shape, const std::vector<T>& data);
     Array(std::initializer_list<size_t> shape, const std::vector<T>& data);
 
+    // Use existing storage without copying, e.g. Storage<T>::adopt() of an
+    // external buffer. The storage must hold at least the shape's elements.
+    Array(const std::vector<size_t>& shape, const Storage<T>& storage);
+
     // Basic Array Properties
-    std::vector<size_t> shape() const;
+    const std::vector<size_t>& shape() const;
     size_t ndim() const;
-    size_t size() const;
-    std::vector<size_t> strides() const;
+    size_t size() const; // cached, O(1)
+    const std::vector<size_t>& strides() const;
 
     // Basic Array Operations
     T sum() const;
     T mean() const;
     T min() const;
     T max() const;
+    // Flat index of the first minimum / maximum
+    size_t argmin() const;
+    size_t argmax() const;
+    // Single-pass statistics over every element (see Reduce.hpp); integer
+    // arrays report them in double. Throw std::runtime_error when empty.
+    moment_type<T> var(size_t ddof = 0) const;
+    moment_type<T> stddev(size_t ddof = 0) const;
+    Moments<moment_type<T>> moments() const;
+
+    // Reductions over one axis or several (see Reduce.hpp). The reduced axes
+    // are dropped, or kept with extent 1 when keepdims is set; reducing every
+    // axis without keepdims gives shape {1}. Throws std::out_of_range for an
+    // axis past ndim() and std::invalid_argument for a repeated axis.
+    Array<T> sum(size_t axis, bool keepdims = false) const;
+    Array<T> sum(const std::vector<size_t>& axes, bool keepdims = false) const;
+    Array<T> mean(size_t axis, bool keepdims = false) const;
+    Array<T> mean(const std::vector<size_t>& axes, bool keepdims = false) const;
+    Array<T> min(size_t axis, bool keepdims = false) const;
+    Array<T> min(const std::vector<size_t>& axes, bool keepdims = false) const;
+    Array<T> max(size_t axis, bool keepdims = false) const;
+    Array<T> max(const std::vector<size_t>& axes, bool keepdims = false) const;
+    Array<size_t> argmin(size_t axis, bool keepdims = false) const;
+    Array<size_t> argmax(size_t axis, bool keepdims = false) const;
     bool is_square() const;
     Array<T> reshape(const std::vector<size_t>& new_shape) const;
     std::vector<T> flatten() const;
@@ -48,7 +82,10 @@ public:
     void fill(const T& value);
     void zeros();
     void ones();
+    // Reverses the axes (in place for a square 2D array that owns its buffer)
     void transpose();
+    // Reorders the axes: new axis i is old axis axes[i]
+    void permute(const std::vector<size_t>& axes);
     void reverse();
     void pow(const T& exponent);
 
@@ -57,6 +94,7 @@ public:
     Array<T> zeros_like() const;
     Array<T> ones_like() const;
     Array<T> transposed() const;
+    Array<T> permuted(const std::vector<size_t>& axes) const;
     Array<T> powed(const T& exponent) const;
     Array<T> reversed() const;
 
@@ -78,61 +116,84 @@ public:
     T& operator[](const std::vector<size_t>& indices);
     const T& operator[](const std::vector<size_t>& indices) const;
 
-    // Arithmetic Operators (element-wise)
-    Array<T> operator+(const Array<T>& other) const;
-    Array<T> operator-(const Array<T>& other) const;
-    Array<T> operator*(const Array<T>& other) const;
-    Array<T> operator/(const Array<T>& other) const;
-    Array<T> operator+(const T& scalar) const;
-    Array<T> operator-(const T& scalar) const;
-    Array<T> operator*(const T& scalar) const;
-    Array<T> operator/(const T& scalar) const;
-    Array<T>& operator+=(const Array<T>& other);
-    Array<T>& operator-=(const Array<T>& other);
-    Array<T>& operator*=(const Array<T>& other);
-    Array<T>& operator/=(const Array<T>& other);
+    // Unchecked access: one index is a flat index, otherwise one index per
+    // axis. No rank or bounds checks; the non-const overload still unshares
+    // a shared buffer, so prefer span() inside loops.
+    template <typename... Indices>
+    T& at_unchecked(Indices... indices);
+    template <typename... Indices>
+    const T& at_unchecked(Indices... indices) const;
+
+    // Fixed-rank, unchecked view for hot loops (see ArraySpan.hpp). Throws
+    // std::invalid_argument if Rank != ndim(). Like view(), the non-const
+    // overload unshares the buffer once up front.
+    template <size_t Rank>
+    ArraySpan<T, Rank> span();
+    template <size_t Rank>
+    ArraySpan<const T, Rank> span() const;
+
+    // Element-wise arithmetic, comparison and unary operators are free
+    // functions returning lazy expressions (see Expression.hpp). Assigning
+    // an expression evaluates it in a single fused pass.
+    template <typename E>
+    Array(const ArrayExpr<E, T>& expr);
+    template <typename E>
+    Array<T>& operator=(const ArrayExpr<E, T>& expr);
+    // An expiring expression that owns an Array operand of the result's
+    // shape (a temporary or a std::move'd array) whose buffer nothing else
+    // shares is evaluated into that buffer, so `f(x) * 2.0` allocates once
+    template <typename E>
+    Array(ArrayExpr<E, T>&& expr);
+    template <typename E>
+    Array<T>& operator=(ArrayExpr<E, T>&& expr);
+
+    // Compound assignment (element-wise)
+    template <typename E>
+    Array<T>& operator+=(const ArrayExpr<E, T>& other);
+    template <typename E>
+    Array<T>& operator-=(const ArrayExpr<E, T>& other);
+    template <typename E>
+    Array<T>& operator*=(const ArrayExpr<E, T>& other);
+    template <typename E>
+    Array<T>& operator/=(const ArrayExpr<E, T>& other);
     Array<T>& operator+=(const T& scalar);
     Array<T>& operator-=(const T& scalar);
     Array<T>& operator*=(const T& scalar);
     Array<T>& operator/=(const T& scalar);
-    Array<T> operator-() const;
-    Array<T> operator+() const;
-    Array<T> operator++();
-    Array<T> operator--();
+    template <typename E>
+    Array<T>& operator&=(const ArrayExpr<E, T>& other);
+    template <typename E>
+    Array<T>& operator|=(const ArrayExpr<E, T>& other);
+    template <typename E>
+    Array<T>& operator^=(const ArrayExpr<E, T>& other);
+    Array<T>& operator&=(const T& scalar);
+    Array<T>& operator|=(const T& scalar);
+    Array<T>& operator^=(const T& scalar);
+
+    // Prefix forms work in place; postfix ones return the old values, in the
+    // one new buffer the operation needs
+    Array<T>& operator++();
+    Array<T>& operator--();
     Array<T> operator++(int);
     Array<T> operator--(int);
-    Array<T> operator!() const;
-    Array<T> operator~() const;
     Array<T> operator&() const;
     Array<T>& operator&();
-    Array<T> operator&(const Array<T>& other) const;
-    Array<T> operator|(const Array<T>& other) const;
-    Array<T> operator^(const Array<T>& other) const;
-    Array<T>& operator&=(const Array<T>& other);
-    Array<T>& operator|=(const Array<T>& other);
-    Array<T>& operator^=(const Array<T>& other);
-    Array<T> operator&(const T& scalar) const;
-    Array<T> operator|(const T& scalar) const;
-    Array<T> operator^(const T& scalar) const;
-    Array<T>& operator&=(const T& scalar);
-    Array<T>& operator|=(const T& scalar);
-    Array<T>& operator^=(const T& scalar);
-    Array<T> operator==(const Array<T>& other) const;
-    Array<T> operator!=(const Array<T>& other) const;
-    Array<T> operator<(const Array<T>& other) const;
-    Array<T> operator<=(const Array<T>& other) const;
-    Array<T> operator>(const Array<T>& other) const;
-    Array<T> operator>=(const Array<T>& other) const;
-    Array<T> operator==(const T& scalar) const;
-    Array<T> operator!=(const T& scalar) const;
-    Array<T> operator<(const T& scalar) const;
-    Array<T> operator<=(const T& scalar) const;
-    Array<T> operator>(const T& scalar) const;
-    Array<T> operator>=(const T& scalar) const;
-    Array<T> operator&&(const Array<T>& other) const;
-    Array<T> operator||(const Array<T>& other) const;
-    Array<T> operator&&(const T& scalar) const;
-    Array<T> operator||(const T& scalar) const;
+
+    // Zero-copy views of the buffer (see ArrayView.hpp). The array must
+    // outlive its views; copies made later get their own buffer, so writes
+    // through an earlier view are seen by this array only.
+    ArrayView<T> view();
+    ArrayView<const T> view() const;
+    ArrayView<T> slice(size_t axis, size_t start, size_t stop, size_t step = 1);
+    ArrayView<const T> slice(size_t axis, size_t start, size_t stop, size_t step = 1) const;
+
+    // Raw access to the contiguous element buffer. The non-const overload
+    // (like every non-const accessor) first gives this array its own copy of
+    // a shared buffer, and copies made later get their own buffer too, since
+    // the pointer may still be written through.
+    T* data();
+    const T* data() const;
+    const Storage<T>& storage() const;
 
     // Utility
     void print() const;
@@ -142,11 +203,37 @@ public:
 protected:
     std::vector<size_t> shape_;
     std::vector<size_t> strides_;
-    T* data_;
+    size_t size_ = 0; // product of shape_, 0 for an empty shape
+    Storage<T> storage_;
+    T* data_; // storage_.data()
 
     // Helper Functions
+    // Copy a shared buffer before writing to it
+    void detach();
+    // Like detach(), for writes that replace every element
+    void prepare_overwrite();
+    // Like detach(), for accessors handing out a reference or pointer into
+    // the buffer: later copies no longer share it (Storage::leak())
+    void leak();
+    // this[i] = Op(this[i], expr[i]) with expr broadcast to this shape
+    template <typename Op, typename E>
+    void compound_assign(const E& expr);
     std::vector<size_t> compute_strides(const std::vector<size_t>& shape) const;
     size_t compute_index(const std::vector<size_t>& indices) const;
+    // compute_index() without building an index vector
+    template <typename... Indices>
+    size_t checked_index(Indices... indices) const;
+    template <typename... Indices>
+    size_t unchecked_index(Indices... indices) const;
+    // Shape of a reduction over the flagged axes
+    std::vector<size_t> reduced_shape(const std::vector<bool>& reduced, bool keepdims) const;
+    std::vector<bool> reduced_axes(const std::vector<size_t>& axes) const;
+    template <typename R>
+    Array<T> reduce(const std::vector<size_t>& axes, bool keepdims, const char* name) const;
+    template <typename R>
+    Array<size_t> arg_reduce(size_t axis, bool keepdims, const char* name) const;
+
+    friend T* detail::writable_data<T>(Array<T>& arr);
 };
 
 } // namespace NumCPP
@@ -2,17 +2,34 @@
 #define ARRAY_TPP
 
 #include "Array.hpp"
+#include "CostModel.hpp"
+#include "Permute.hpp"
+#include "ThreadPool.hpp"
 #include <algorithm>
 #include <cmath>
+#include <memory>
 #include <stdexcept>
-#include <thread>
+#include <string>
+#include <type_traits>
+#include <utility>
 
 namespace NumCPP {
 
+namespace detail {
+    template <typename T>
+    T* writable_data(Array<T>& arr)
+    {
+        arr.detach();
+        return arr.data_;
+    }
+}
+
 template <typename T>
 Array<T>::Array()
     : shape_()
     , strides_()
+    , size_(0)
+    , storage_()
     , data_(nullptr)
 {
 }
@@ -20,25 +37,29 @@ Array<T>::Array()
 template <typename T>
 Array<T>::~Array()
 {
-    delete[] data_;
 }
 
+// Copies share the buffer until one of them writes (copy-on-write), unless
+// a reference into it has been handed out (see leak())
 template <typename T>
 Array<T>::Array(const Array<T>& other)
     : shape_(other.shape_)
     , strides_(other.strides_)
+    , size_(other.size_)
+    , storage_(other.storage_.share())
+    , data_(storage_.data())
 {
-    size_t total = other.size();
-    data_ = new T[total];
-    std::copy(other.data_, other.data_ + total, data_);
 }
 
 template <typename T>
 Array<T>::Array(Array<T>&& other) noexcept
     : shape_(std::move(other.shape_))
     , strides_(std::move(other.strides_))
+    , size_(other.size_)
+    , storage_(std::move(other.storage_))
     , data_(other.data_)
 {
+    other.size_ = 0;
     other.data_ = nullptr;
 }
 
@@ -49,6 +70,8 @@ Array<T>& Array<T>::operator=(const Array<T>& other)
     Array<T> temp(other);
     swap(shape_, temp.shape_);
     swap(strides_, temp.strides_);
+    swap(size_, temp.size_);
+    swap(storage_, temp.storage_);
     swap(data_, temp.data_);
     return *this;
 }
@@ -56,10 +79,11 @@ Array<T>& Array<T>::operator=(const Array<T>& other)
 template <typename T>
 Array<T>& Array<T>::operator=(Array<T>&& other) noexcept
 {
-    if (this != &other) {
-        delete[] data_;
+    if (this != std::addressof(other)) {
         shape_ = std::move(other.shape_);
         strides_ = std::move(other.strides_);
+        size_ = std::exchange(other.size_, 0);
+        storage_ = std::move(other.storage_);
         data_ = other.data_;
         other.data_ = nullptr;
     }
@@ -69,15 +93,18 @@ Array<T>& Array<T>::operator=(Array<T>&& other) noexcept
 template <typename T>
 Array<T>::Array(const std::vector<size_t>& shape, const T& init_val)
     : shape_(shape)
+    , strides_(compute_strides(shape_))
+    , size_(detail::shape_size(shape_))
 {
-    strides_ = compute_strides(shape_);
+    NUMCPP_PROFILE("Array::Array", size());
     size_t total = 1;
     for (auto s : shape_) {
         if (s <= 0)
             throw std::invalid_argument("Shape dimensions must be positive");
         total *= s;
     }
-    data_ = new T[total];
+    storage_ = Storage<T>(total);
+    data_ = storage_.data();
     fill(init_val);
 }
 
@@ -85,14 +112,17 @@ template <typename T>
 Array<T>::Array(std::initializer_list<size_t> shape, const T& init_val)
     : shape_(shape)
     , strides_(compute_strides(shape_))
+    , size_(detail::shape_size(shape_))
 {
+    NUMCPP_PROFILE("Array::Array", size());
     size_t total = 1;
     for (auto s : shape_) {
         if (s <= 0)
             throw std::invalid_argument("Shape dimensions must be positive");
         total *= s;
     }
-    data_ = new T[total];
+    storage_ = Storage<T>(total);
+    data_ = storage_.data();
     fill(init_val);
 }
 
@@ -100,7 +130,9 @@ template <typename T>
 Array<T>::Array(const std::vector<size_t>& shape, const std::vector<T>& data)
     : shape_(shape)
     , strides_(compute_strides(shape_))
+    , size_(detail::shape_size(shape_))
 {
+    NUMCPP_PROFILE("Array::Array", size());
     size_t total = 1;
     for (auto s : shape_) {
         if (s <= 0)
@@ -109,7 +141,8 @@ Array<T>::Array(const std::vector<size_t>& shape, const std::vector<T>& data)
     }
     if (data.size() != total)
         throw std::invalid_argument("Data size does not match shape");
-    data_ = new T[total];
+    storage_ = Storage<T>(total);
+    data_ = storage_.data();
     std::copy(data.begin(), data.end(), data_);
 }
 
@@ -117,7 +150,9 @@ template <typename T>
 Array<T>::Array(std::initializer_list<size_t> shape, const std::vector<T>& data)
     : shape_(shape)
     , strides_(compute_strides(shape_))
+    , size_(detail::shape_size(shape_))
 {
+    NUMCPP_PROFILE("Array::Array", size());
     size_t total = 1;
     for (auto s : shape_) {
         if (s <= 0)
@@ -126,12 +161,31 @@ Array<T>::Array(std::initializer_list<size_t> shape, const std::vector<T>& data)
     }
     if (data.size() != total)
         throw std::invalid_argument("Data size does not match shape");
-    data_ = new T[total];
+    storage_ = Storage<T>(total);
+    data_ = storage_.data();
     std::copy(data.begin(), data.end(), data_);
 }
 
 template <typename T>
-std::vector<size_t> Array<T>::shape() const
+Array<T>::Array(const std::vector<size_t>& shape, const Storage<T>& storage)
+    : shape_(shape)
+    , strides_(compute_strides(shape_))
+    , size_(detail::shape_size(shape_))
+    , storage_(storage.share())
+    , data_(storage_.data())
+{
+    size_t total = 1;
+    for (auto s : shape_) {
+        if (s <= 0)
+            throw std::invalid_argument("Shape dimensions must be positive");
+        total *= s;
+    }
+    if (storage_.size() < total)
+        throw std::invalid_argument("Storage is smaller than shape");
+}
+
+template <typename T>
+const std::vector<size_t>& Array<T>::shape() const
 {
     return shape_;
 }
@@ -145,16 +199,11 @@ size_t Array<T>::ndim() const
 template <typename T>
 size_t Array<T>::size() const
 {
-    if (shape_.empty())
-        return 0;
-    size_t total = 1;
-    for (auto s : shape_)
-        total *= s;
-    return total;
+    return size_;
 }
 
 template <typename T>
-std::vector<size_t> Array<T>::strides() const
+const std::vector<size_t>& Array<T>::strides() const
 {
     return strides_;
 }
@@ -162,79 +211,40 @@ std::vector<size_t> Array<T>::strides() const
 template <typename T>
 Array<T> Array<T>::reshape(const std::vector<size_t>& new_shape) const
 {
+    NUMCPP_PROFILE("Array::reshape", size());
+    if (detail::shape_size(new_shape) != size())
+        throw std::invalid_argument("New shape must have the same number of elements");
+    // Shares the buffer, so this is O(1) until either array is written
     Array<T> new_array(*this);
     new_array.shape_ = new_shape;
     new_array.strides_ = new_array.compute_strides(new_shape);
+    new_array.size_ = detail::shape_size(new_shape);
     return new_array;
 }
 
 template <typename T>
 std::vector<T> Array<T>::flatten() const
 {
+    NUMCPP_PROFILE("Array::flatten", size());
     size_t total = size();
     std::vector<T> flat(total);
-    if (total < 1000) {
-        std::copy(data_, data_ + total, flat.begin());
-        return flat;
-    }
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([this, &flat, start, end]() {
-            for (size_t j = start; j < end; j++) {
-                flat[j] = data_[j];
-            }
-        }));
-    }
-    for (auto& t : threads)
-        t.join();
+    parallel_for(0, total, [&](size_t start, size_t end) {
+        std::copy(data_ + start, data_ + end, flat.begin() + start);
+    }, parallel_grain(KernelCost::stream<T>(1, 1)));
     return flat;
 }
 
 template <typename T>
 T Array<T>::sum() const
 {
-    T total = 0;
-    size_t total_size = size();
-    if (total_size < 1000) {
-        for (size_t i = 0; i < total_size; i++) {
-            total += data_[i];
-        }
-        return total;
-    }
-
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total_size / nthreads;
-    std::vector<std::thread> threads;
-    std::vector<T> partial_sums(nthreads, T(0));
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total_size : start + block;
-        threads.push_back(std::thread([this, start, end, &partial_sums, i]() {
-            T local_sum = T(0);
-            for (size_t j = start; j < end; j++) {
-                local_sum += data_[j];
-            }
-            partial_sums[i] = local_sum;
-        }));
-    }
-    for (auto& t : threads)
-        t.join();
-    for (const auto& ps : partial_sums)
-        total += ps;
-    return total;
+    NUMCPP_PROFILE("Array::sum", size());
+    return detail::reduce_sum(*this);
 }
 
 template <typename T>
 T Array<T>::mean() const
 {
+    NUMCPP_PROFILE("Array::mean", size());
     if (size() == 0)
         throw std::runtime_error("Cannot compute mean of empty array");
     return sum() / size();
@@ -243,88 +253,133 @@ T Array<T>::mean() const
 template <typename T>
 T Array<T>::min() const
 {
-    T min_val = std::numeric_limits<T>::max();
-    size_t total_size = size();
-    if (total_size < 1000) {
-        for (size_t i = 0; i < total_size; i++) {
-            if (data_[i] < min_val) {
-                min_val = data_[i];
-            }
-        }
-        return min_val;
-    }
-
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total_size / nthreads;
-    std::vector<std::thread> threads;
-    std::vector<T> thread_mins(nthreads, std::numeric_limits<T>::max());
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total_size : start + block;
-        threads.push_back(std::thread([this, start, end, &thread_mins, i]() {
-            T local_min = std::numeric_limits<T>::max();
-            for (size_t j = start; j < end; j++) {
-                if (data_[j] < local_min)
-                    local_min = data_[j];
-            }
-            thread_mins[i] = local_min;
-        }));
-    }
-    for (auto& t : threads)
-        t.join();
-    if (total_size == 0)
-        throw std::runtime_error("Cannot compute min of empty array");
-    min_val = thread_mins[0];
-    for (const auto& tm : thread_mins)
-        if (tm < min_val)
-            min_val = tm;
-    return min_val;
+    NUMCPP_PROFILE("Array::min", size());
+    return detail::reduce_min(*this);
 }
 
 template <typename T>
 T Array<T>::max() const
 {
-    T max_val = std::numeric_limits<T>::lowest();
-    size_t total_size = size();
-    if (total_size == 0)
-        throw std::runtime_error("Cannot compute max of empty array");
-    if (total_size < 1000) {
-        for (size_t i = 0; i < total_size; i++) {
-            if (data_[i] > max_val) {
-                max_val = data_[i];
-            }
-        }
-        return max_val;
-    }
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total_size / nthreads;
-    std::vector<std::thread> threads;
-    std::vector<T> thread_maxs(nthreads, std::numeric_limits<T>::lowest());
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total_size : start + block;
-        threads.push_back(std::thread([this, start, end, &thread_maxs, i]() {
-            T local_max = std::numeric_limits<T>::lowest();
-            for (size_t j = start; j < end; j++) {
-                if (data_[j] > local_max)
-                    local_max = data_[j];
-            }
-            thread_maxs[i] = local_max;
-        }));
+    NUMCPP_PROFILE("Array::max", size());
+    return detail::reduce_max(*this);
+}
+
+template <typename T>
+size_t Array<T>::argmin() const
+{
+    NUMCPP_PROFILE("Array::argmin", size());
+    if (size() == 0)
+        throw std::runtime_error("Cannot compute argmin of empty array");
+    return detail::arg_row<simd::Min>(data_, size(), true);
+}
+
+template <typename T>
+size_t Array<T>::argmax() const
+{
+    NUMCPP_PROFILE("Array::argmax", size());
+    if (size() == 0)
+        throw std::runtime_error("Cannot compute argmax of empty array");
+    return detail::arg_row<simd::Max>(data_, size(), true);
+}
+
+template <typename T>
+moment_type<T> Array<T>::var(size_t ddof) const
+{
+    NUMCPP_PROFILE("Array::var", size());
+    return moments().variance(ddof);
+}
+
+template <typename T>
+moment_type<T> Array<T>::stddev(size_t ddof) const
+{
+    NUMCPP_PROFILE("Array::stddev", size());
+    return moments().stddev(ddof);
+}
+
+template <typename T>
+Moments<moment_type<T>> Array<T>::moments() const
+{
+    NUMCPP_PROFILE("Array::moments", size());
+    if (size() == 0)
+        throw std::runtime_error("Cannot compute moments of empty array");
+    return compute_moments(data_, size());
+}
+
+template <typename T>
+Array<T> Array<T>::sum(size_t axis, bool keepdims) const
+{
+    return sum(std::vector<size_t> { axis }, keepdims);
+}
+
+template <typename T>
+Array<T> Array<T>::sum(const std::vector<size_t>& axes, bool keepdims) const
+{
+    NUMCPP_PROFILE("Array::sum", size());
+    return reduce<simd::Sum>(axes, keepdims, "sum");
+}
+
+template <typename T>
+Array<T> Array<T>::mean(size_t axis, bool keepdims) const
+{
+    return mean(std::vector<size_t> { axis }, keepdims);
+}
+
+template <typename T>
+Array<T> Array<T>::mean(const std::vector<size_t>& axes, bool keepdims) const
+{
+    NUMCPP_PROFILE("Array::mean", size());
+    std::vector<bool> reduced = reduced_axes(axes);
+    size_t count = 1;
+    for (size_t d = 0; d < ndim(); d++) {
+        if (reduced[d])
+            count *= shape_[d];
     }
-    for (auto& t : threads)
-        t.join();
-    if (total_size == 0)
-        throw std::runtime_error("Cannot compute max of empty array");
-    max_val = thread_maxs[0];
-    for (const auto& tm : thread_maxs)
-        if (tm > max_val)
-            max_val = tm;
-    return max_val;
+    Array<T> result = reduce<simd::Sum>(axes, keepdims, "mean");
+    if (count == 0 && result.size() > 0)
+        throw std::runtime_error("Cannot compute mean of empty array");
+    if (result.size() > 0)
+        result /= T(count);
+    return result;
+}
+
+template <typename T>
+Array<T> Array<T>::min(size_t axis, bool keepdims) const
+{
+    return min(std::vector<size_t> { axis }, keepdims);
+}
+
+template <typename T>
+Array<T> Array<T>::min(const std::vector<size_t>& axes, bool keepdims) const
+{
+    NUMCPP_PROFILE("Array::min", size());
+    return reduce<simd::Min>(axes, keepdims, "min");
+}
+
+template <typename T>
+Array<T> Array<T>::max(size_t axis, bool keepdims) const
+{
+    return max(std::vector<size_t> { axis }, keepdims);
+}
+
+template <typename T>
+Array<T> Array<T>::max(const std::vector<size_t>& axes, bool keepdims) const
+{
+    NUMCPP_PROFILE("Array::max", size());
+    return reduce<simd::Max>(axes, keepdims, "max");
+}
+
+template <typename T>
+Array<size_t> Array<T>::argmin(size_t axis, bool keepdims) const
+{
+    NUMCPP_PROFILE("Array::argmin", size());
+    return arg_reduce<simd::Min>(axis, keepdims, "argmin");
+}
+
+template <typename T>
+Array<size_t> Array<T>::argmax(size_t axis, bool keepdims) const
+{
+    NUMCPP_PROFILE("Array::argmax", size());
+    return arg_reduce<simd::Max>(axis, keepdims, "argmax");
 }
 
 template <typename T>
@@ -336,144 +391,73 @@ bool Array<T>::is_square() const
 template <typename T>
 void Array<T>::fill(const T& value)
 {
-    size_t total = size();
-    if (total < 1000) {
-        for (size_t i = 0; i < total; i++) {
-            data_[i] = value;
-        }
-        return;
-    }
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([this, start, end, value]() {
-            for (size_t j = start; j < end; j++) {
-                data_[j] = value;
-            }
-        }));
-    }
-    for (auto& t : threads)
-        t.join();
+    NUMCPP_PROFILE("Array::fill", size());
+    prepare_overwrite();
+    detail::fill(data_, size(), value);
 }
 
 template <typename T>
 void Array<T>::zeros()
 {
+    NUMCPP_PROFILE("Array::zeros", size());
     fill(T(0));
 }
 
 template <typename T>
 void Array<T>::ones()
 {
+    NUMCPP_PROFILE("Array::ones", size());
     fill(T(1));
 }
 
 template <typename T>
 void Array<T>::transpose()
 {
-    std::vector<size_t> new_shape(shape_.rbegin(), shape_.rend());
-    std::vector<size_t> new_strides = compute_strides(new_shape);
-    size_t total = size();
-    T* new_data = new T[total];
-    if (total < 1000) {
-        for (size_t i = 0; i < total; i++) {
-            std::vector<size_t> new_idx(new_shape.size());
-            size_t tmp = i;
-            for (int k = static_cast<int>(new_shape.size()) - 1; k >= 0; k--) {
-                new_idx[k] = tmp % new_shape[k];
-                tmp /= new_shape[k];
-            }
-            std::vector<size_t> orig_idx(new_idx.rbegin(), new_idx.rend());
-            size_t orig_flat = 0;
-            for (size_t k = 0; k < orig_idx.size(); k++) {
-                orig_flat += orig_idx[k] * strides_[k];
-            }
-            new_data[i] = data_[orig_flat];
-        }
-        delete[] data_;
-        data_ = new_data;
-        shape_ = new_shape;
-        strides_ = new_strides;
+    NUMCPP_PROFILE("Array::transpose", size());
+    if (shape_.size() == 2 && shape_[0] == shape_[1] && storage_.writable()) {
+        detach();
+        NumCPP::transpose_inplace(data_, shape_[0]);
         return;
     }
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([=]() {
-            for (size_t j = start; j < end; j++) {
-                std::vector<size_t> new_idx(new_shape.size());
-                size_t tmp = j;
-                for (int k = static_cast<int>(new_shape.size()) - 1; k >= 0; k--) {
-                    new_idx[k] = tmp % new_shape[k];
-                    tmp /= new_shape[k];
-                }
-                std::vector<size_t> orig_idx(new_idx.rbegin(), new_idx.rend());
-                size_t orig_flat = 0;
-                for (size_t k = 0; k < orig_idx.size(); k++) {
-                    orig_flat += orig_idx[k] * strides_[k];
-                }
-                new_data[j] = data_[orig_flat];
-            }
-        }));
-    }
-    for (auto& t : threads)
-        t.join();
-    delete[] data_;
-    data_ = new_data;
-    shape_ = new_shape;
-    strides_ = new_strides;
+    *this = transposed();
+}
+
+template <typename T>
+void Array<T>::permute(const std::vector<size_t>& axes)
+{
+    NUMCPP_PROFILE("Array::permute", size());
+    *this = permuted(axes);
 }
 
 template <typename T>
 void Array<T>::reverse()
 {
+    NUMCPP_PROFILE("Array::reverse", size());
     if (shape_.size() == 0)
         return;
     size_t total = size();
+    detach();
     std::reverse(data_, data_ + total);
 }
 
 template <typename T>
 void Array<T>::pow(const T& exponent)
 {
-    size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([this, start, end, exponent]() {
-            for (size_t j = start; j < end; j++) {
-                data_[j] = std::pow(data_[j], exponent);
-            }
-        }));
-    }
-    for (auto& t : threads)
-        t.join();
+    NUMCPP_PROFILE("Array::pow", size());
+    detach();
+    detail::pow_inplace(data_, size(), exponent);
 }
 
 template <typename T>
 Array<T> Array<T>::copy() const
 {
+    NUMCPP_PROFILE("Array::copy", size());
     Array<T> new_array;
     new_array.shape_ = shape_;
     new_array.strides_ = strides_;
-    size_t total = size();
-    new_array.data_ = new T[total];
-    std::copy(data_, data_ + total, new_array.data_);
+    new_array.size_ = size_;
+    new_array.storage_ = storage_.clone();
+    new_array.data_ = new_array.storage_.data();
     return new_array;
 }
 
@@ -482,6 +466,7 @@ T& Array<T>::operator()(size_t index)
 {
     if (index >= size() || index < 0)
         throw std::out_of_range("Index out of range");
+    leak();
     return data_[index];
 }
 
@@ -503,6 +488,7 @@ T& Array<T>::operator()(const std::vector<size_t>& indices)
     size_t index = compute_index(indices);
     if (index >= size())
         throw std::out_of_range("Index out of range");
+    leak();
     return data_[index];
 }
 
@@ -523,16 +509,8 @@ template <typename T>
 template <typename... Indices>
 T& Array<T>::operator()(Indices... indices)
 {
-    if (sizeof...(indices) != shape_.size())
-        throw std::invalid_argument("Number of indices must match number of dimensions");
-    if (sizeof...(indices) == 0)
-        throw std::invalid_argument("No indices provided");
-    if (sizeof...(indices) > shape_.size())
-        throw std::invalid_argument("Too many indices provided");
-    std::vector<size_t> idx = { static_cast<size_t>(indices)... };
-    size_t index = compute_index(idx);
-    if (index >= size())
-        throw std::out_of_range("Index out of range");
+    size_t index = checked_index(indices...);
+    leak();
     return data_[index];
 }
 
@@ -540,17 +518,43 @@ template <typename T>
 template <typename... Indices>
 const T& Array<T>::operator()(Indices... indices) const
 {
-    std::vector<size_t> idx = { static_cast<size_t>(indices)... };
-    if (sizeof...(indices) != shape_.size())
-        throw std::invalid_argument("Number of indices must match number of dimensions");
-    if (sizeof...(indices) == 0)
-        throw std::invalid_argument("No indices provided");
-    if (sizeof...(indices) > shape_.size())
-        throw std::invalid_argument("Too many indices provided");
-    size_t index = compute_index(idx);
-    if (index >= size())
-        throw std::out_of_range("Index out of range");
-    return data_[compute_index(index)];
+    return data_[checked_index(indices...)];
+}
+
+template <typename T>
+template <typename... Indices>
+T& Array<T>::at_unchecked(Indices... indices)
+{
+    leak();
+    return data_[unchecked_index(indices...)];
+}
+
+template <typename T>
+template <typename... Indices>
+const T& Array<T>::at_unchecked(Indices... indices) const
+{
+    return data_[unchecked_index(indices...)];
+}
+
+template <typename T>
+template <size_t Rank>
+ArraySpan<T, Rank> Array<T>::span()
+{
+    leak();
+    ArraySpan<const T, Rank> span = std::as_const(*this).template span<Rank>();
+    return ArraySpan<T, Rank>(data_, span.extents(), span.strides());
+}
+
+template <typename T>
+template <size_t Rank>
+ArraySpan<const T, Rank> Array<T>::span() const
+{
+    if (shape_.size() != Rank)
+        throw std::invalid_argument("Span rank must match number of dimensions");
+    std::array<size_t, Rank> extents {}, strides {};
+    std::copy(shape_.begin(), shape_.end(), extents.begin());
+    std::copy(strides_.begin(), strides_.end(), strides.begin());
+    return ArraySpan<const T, Rank>(data_, extents, strides);
 }
 
 template <typename T>
@@ -588,6 +592,7 @@ const T& Array<T>::operator[](const std::vector<size_t>& indices) const
 template <typename T>
 Array<T> Array<T>::filled(const T& value) const
 {
+    NUMCPP_PROFILE("Array::filled", size());
     Array<T> result = copy();
     result.fill(value);
     return result;
@@ -596,26 +601,47 @@ Array<T> Array<T>::filled(const T& value) const
 template <typename T>
 Array<T> Array<T>::zeros_like() const
 {
+    NUMCPP_PROFILE("Array::zeros_like", size());
     return filled(T(0));
 }
 
 template <typename T>
 Array<T> Array<T>::ones_like() const
 {
+    NUMCPP_PROFILE("Array::ones_like", size());
     return filled(T(1));
 }
 
 template <typename T>
 Array<T> Array<T>::transposed() const
 {
-    Array<T> result = copy();
-    result.transpose();
+    NUMCPP_PROFILE("Array::transposed", size());
+    std::vector<size_t> axes(shape_.size());
+    for (size_t d = 0; d < axes.size(); d++)
+        axes[d] = axes.size() - 1 - d;
+    return permuted(axes);
+}
+
+template <typename T>
+Array<T> Array<T>::permuted(const std::vector<size_t>& axes) const
+{
+    NUMCPP_PROFILE("Array::permuted", size());
+    if (axes.size() != shape_.size())
+        throw std::invalid_argument("Invalid axes permutation");
+    if (shape_.empty())
+        return copy();
+    std::vector<size_t> new_shape(shape_.size());
+    for (size_t d = 0; d < axes.size(); d++)
+        new_shape[d] = shape_[axes[d] < shape_.size() ? axes[d] : 0];
+    Array<T> result(new_shape, Storage<T>(size()));
+    NumCPP::permute(static_cast<const T*>(data_), shape_, axes, result.data_);
     return result;
 }
 
 template <typename T>
 Array<T> Array<T>::powed(const T& exponent) const
 {
+    NUMCPP_PROFILE("Array::powed", size());
     Array<T> result = copy();
     result.pow(exponent);
     return result;
@@ -624,855 +650,471 @@ Array<T> Array<T>::powed(const T& exponent) const
 template <typename T>
 Array<T> Array<T>::reversed() const
 {
+    NUMCPP_PROFILE("Array::reversed", size());
     Array<T> result = copy();
     result.reverse();
     return result;
 }
 
 template <typename T>
-Array<T> Array<T>::operator+(const Array<T>& other) const
-{
-    if (shape_ != other.shape_)
-        throw std::runtime_error("Shapes do not match for addition");
-    Array<T> result(shape_);
-    size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([=, this, &other, &result]() {
-            for (size_t j = start; j < end; j++) {
-                result.data_[j] = this->data_[j] + other.data_[j];
-            }
-        }));
-    }
-    for (auto& t : threads)
-        t.join();
-    return result;
-}
-
-template <typename T>
-Array<T> Array<T>::operator-(const Array<T>& other) const
-{
-    if (shape_ != other.shape_)
-        throw std::runtime_error("Shapes do not match for subtraction");
-    Array<T> result(shape_);
-    size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([=, this, &other, &result]() {
-            for (size_t j = start; j < end; j++) {
-                result.data_[j] = this->data_[j] - other.data_[j];
-            }
-        }));
-    }
-    for (auto& t : threads)
-        t.join();
-    return result;
-}
-
-template <typename T>
-Array<T> Array<T>::operator*(const Array<T>& other) const
-{
-    if (shape_ != other.shape_)
-        throw std::runtime_error("Shapes do not match for multiplication");
-    Array<T> result(shape_);
-    size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([=, this, &other, &result]() {
-            for (size_t j = start; j < end; j++) {
-                result.data_[j] = this->data_[j] * other.data_[j];
-            }
-        }));
-    }
-    for (auto& t : threads)
-        t.join();
-    return result;
-}
-
-template <typename T>
-Array<T> Array<T>::operator/(const Array<T>& other) const
+template <typename E>
+Array<T>::Array(const ArrayExpr<E, T>& expr)
+    : shape_(detail::shape_of(expr.derived()))
+    , strides_(compute_strides(shape_))
+    , size_(detail::shape_size(shape_))
+    , data_(nullptr)
 {
-    if (shape_ != other.shape_)
-        throw std::runtime_error("Shapes do not match for division");
-    Array<T> result(shape_);
-    size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([=, this, &other, &result]() {
-            for (size_t j = start; j < end; j++) {
-                result.data_[j] = this->data_[j] / other.data_[j];
-            }
-        }));
+    NUMCPP_PROFILE("Array::Array(expr)", expr.derived().size());
+    size_t total = expr.derived().size();
+    if (total > 0) {
+        storage_ = Storage<T>(total);
+        data_ = storage_.data();
+        detail::assign(data_, expr.derived());
     }
-    for (auto& t : threads)
-        t.join();
-    return result;
 }
 
 template <typename T>
-Array<T> Array<T>::operator+(const T& scalar) const
+template <typename E>
+Array<T>::Array(ArrayExpr<E, T>&& expr)
+    : shape_(detail::shape_of(expr.derived()))
+    , strides_(compute_strides(shape_))
+    , size_(detail::shape_size(shape_))
+    , data_(nullptr)
 {
-    Array<T> result(shape_);
-    size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([&, this, scalar]() {
-            for (size_t j = start; j < end; j++) {
-                result.data_[j] = this->data_[j] + scalar;
-            }
-        }));
+    NUMCPP_PROFILE("Array::Array(expr)", expr.derived().size());
+    E& node = static_cast<E&>(expr);
+    Array<T>* donor = nullptr;
+    if constexpr (requires { node.expiring_operand(shape_); })
+        donor = node.expiring_operand(shape_);
+    // A view of the donor's buffer in another layout would read elements
+    // this pass has already written
+    if (donor && detail::reads_elsewhere(donor->data_, shape_, node))
+        donor = nullptr;
+    if (!donor) {
+        if (size_ > 0) {
+            storage_ = Storage<T>(size_);
+            data_ = storage_.data();
+            detail::assign(data_, node);
+        }
+        return;
     }
-    for (auto& t : threads)
-        t.join();
-    return result;
+    // The kernel holds the donor's data pointer, which stays valid once its
+    // buffer moves here; every element reads the donor at its own index
+    auto kernel = detail::kernel_of(node);
+    storage_ = std::move(donor->storage_);
+    data_ = storage_.data();
+    detail::assign_kernel(data_, size_, kernel);
 }
 
 template <typename T>
-Array<T> Array<T>::operator-(const T& scalar) const
+template <typename E>
+Array<T>& Array<T>::operator=(ArrayExpr<E, T>&& expr)
 {
-    Array<T> result(shape_);
-    size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([&, this, scalar]() {
-            for (size_t j = start; j < end; j++) {
-                result.data_[j] = this->data_[j] - scalar;
-            }
-        }));
+    NUMCPP_PROFILE("Array::operator=(expr)", expr.derived().size());
+    if (shape_ == detail::shape_of(expr.derived()) && storage_.writable()
+        && !detail::reads_elsewhere(data_, shape_, expr.derived())) {
+        detail::assign(data_, expr.derived());
+        return *this;
     }
-    for (auto& t : threads)
-        t.join();
-    return result;
+    Array<T> result(std::move(expr));
+    return *this = std::move(result);
 }
 
 template <typename T>
-Array<T> Array<T>::operator*(const T& scalar) const
+template <typename E>
+Array<T>& Array<T>::operator=(const ArrayExpr<E, T>& expr)
 {
-    Array<T> result(shape_);
-    size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([&, this, scalar]() {
-            for (size_t j = start; j < end; j++) {
-                result.data_[j] = this->data_[j] * scalar;
-            }
-        }));
+    NUMCPP_PROFILE("Array::operator=(expr)", expr.derived().size());
+    if (shape_ == detail::shape_of(expr.derived()) && storage_.writable()
+        && !detail::reads_elsewhere(data_, shape_, expr.derived())) {
+        // expr reads this buffer, if at all, only at the index being
+        // written, so it can be reused; views of it in another layout or
+        // broadcast operands are evaluated into fresh storage below
+        detail::assign(data_, expr.derived());
+        return *this;
     }
-    for (auto& t : threads)
-        t.join();
-    return result;
+    Array<T> result(expr);
+    return *this = std::move(result);
 }
 
 template <typename T>
-Array<T> Array<T>::operator/(const T& scalar) const
+template <typename E>
+Array<T>& Array<T>::operator+=(const ArrayExpr<E, T>& other)
 {
-    Array<T> result(shape_);
-    size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([&, this, scalar]() {
-            for (size_t j = start; j < end; j++) {
-                result.data_[j] = this->data_[j] / scalar;
-            }
-        }));
-    }
-    for (auto& t : threads)
-        t.join();
-    return result;
+    NUMCPP_PROFILE("Array::operator+=", size());
+    compound_assign<detail::Add>(other.derived());
+    return *this;
 }
 
 template <typename T>
-Array<T>& Array<T>::operator+=(const Array<T>& other)
+template <typename E>
+Array<T>& Array<T>::operator-=(const ArrayExpr<E, T>& other)
 {
-    if (shape_ != other.shape_)
-        throw std::runtime_error("Shapes do not match for addition");
-    size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([=, this, &other]() {
-            for (size_t j = start; j < end; j++) {
-                this->data_[j] += other.data_[j];
-            }
-        }));
-    }
-    for (auto& t : threads)
-        t.join();
+    NUMCPP_PROFILE("Array::operator-=", size());
+    compound_assign<detail::Subtract>(other.derived());
     return *this;
 }
 
 template <typename T>
-Array<T>& Array<T>::operator-=(const Array<T>& other)
+template <typename E>
+Array<T>& Array<T>::operator*=(const ArrayExpr<E, T>& other)
 {
-    if (shape_ != other.shape_)
-        throw std::runtime_error("Shapes do not match for subtraction");
-    size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([=, this, &other]() {
-            for (size_t j = start; j < end; j++) {
-                this->data_[j] -= other.data_[j];
-            }
-        }));
-    }
-    for (auto& t : threads)
-        t.join();
+    NUMCPP_PROFILE("Array::operator*=", size());
+    compound_assign<detail::Multiply>(other.derived());
     return *this;
 }
 
 template <typename T>
-Array<T>& Array<T>::operator*=(const Array<T>& other)
+template <typename E>
+Array<T>& Array<T>::operator/=(const ArrayExpr<E, T>& other)
 {
-    if (shape_ != other.shape_)
-        throw std::runtime_error("Shapes do not match for multiplication");
-    size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([=, this, &other]() {
-            for (size_t j = start; j < end; j++) {
-                this->data_[j] *= other.data_[j];
-            }
-        }));
-    }
-    for (auto& t : threads)
-        t.join();
+    NUMCPP_PROFILE("Array::operator/=", size());
+    compound_assign<detail::Divide>(other.derived());
     return *this;
 }
 
 template <typename T>
-Array<T>& Array<T>::operator/=(const Array<T>& other)
+template <typename Op, typename E>
+void Array<T>::compound_assign(const E& expr)
 {
-    if (shape_ != other.shape_)
-        throw std::runtime_error("Shapes do not match for division");
-    size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([=, this, &other]() {
-            for (size_t j = start; j < end; j++) {
-                this->data_[j] /= other.data_[j];
-            }
-        }));
+    detach();
+    if (!detail::reads_elsewhere(data_, shape_, expr)) {
+        detail::assign_op<Op>(data_, shape_, expr);
+        return;
     }
-    for (auto& t : threads)
-        t.join();
-    return *this;
+    // expr reads rows this pass overwrites (a broadcast or transposed view
+    // of this array), so it is evaluated into a buffer of its own first
+    Array<T> operand(detail::shape_of(expr), Storage<T>(detail::shape_size(detail::shape_of(expr))));
+    detail::assign(operand.data_, expr);
+    detail::assign_op<Op>(data_, shape_, operand);
 }
 
 template <typename T>
 Array<T>& Array<T>::operator+=(const T& scalar)
 {
-    size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([=, this, &scalar]() {
-            for (size_t j = start; j < end; j++) {
-                this->data_[j] += scalar;
-            }
-        }));
-    }
-    for (auto& t : threads)
-        t.join();
+    NUMCPP_PROFILE("Array::operator+=", size());
+    detach();
+    detail::assign_op_scalar<detail::Add>(data_, size(), scalar);
     return *this;
 }
 
 template <typename T>
 Array<T>& Array<T>::operator-=(const T& scalar)
 {
-    size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([&, this, scalar]() {
-            for (size_t j = start; j < end; j++) {
-                this->data_[j] -= scalar;
-            }
-        }));
-    }
-    for (auto& t : threads)
-        t.join();
+    NUMCPP_PROFILE("Array::operator-=", size());
+    detach();
+    detail::assign_op_scalar<detail::Subtract>(data_, size(), scalar);
     return *this;
 }
 
 template <typename T>
 Array<T>& Array<T>::operator*=(const T& scalar)
 {
-    size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([=, this]() {
-            for (size_t j = start; j < end; j++) {
-                this->data_[j] *= scalar;
-            }
-        }));
-    }
-    for (auto& t : threads)
-        t.join();
+    NUMCPP_PROFILE("Array::operator*=", size());
+    detach();
+    detail::assign_op_scalar<detail::Multiply>(data_, size(), scalar);
     return *this;
 }
 
 template <typename T>
 Array<T>& Array<T>::operator/=(const T& scalar)
 {
-    size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([=, this](size_t start, size_t end, T scalar) {
-            for (size_t j = start; j < end; j++) {
-                this->data_[j] /= scalar;
-            }
-        },
-            start, end, scalar));
-    }
-    for (auto& t : threads)
-        t.join();
+    NUMCPP_PROFILE("Array::operator/=", size());
+    detach();
+    detail::assign_op_scalar<detail::Divide>(data_, size(), scalar);
     return *this;
 }
 
 template <typename T>
-Array<T> Array<T>::operator-() const
+Array<T>& Array<T>::operator++()
 {
-    Array<T> result(shape_);
-    size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([=, this, &result]() {
-            for (size_t j = start; j < end; j++) {
-                result.data_[j] = -this->data_[j];
-            }
-        }));
-    }
-    for (auto& t : threads)
-        t.join();
-    return result;
+    NUMCPP_PROFILE("Array::operator++", size());
+    return *this += T(1);
 }
 
 template <typename T>
-Array<T> Array<T>::operator+() const
+Array<T>& Array<T>::operator--()
 {
-    return copy();
+    NUMCPP_PROFILE("Array::operator--", size());
+    return *this -= T(1);
 }
 
 template <typename T>
-Array<T> Array<T>::operator++()
+Array<T> Array<T>::operator++(int)
 {
-    Array<T> result(shape_);
-    size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([=, this, &result]() {
-            for (size_t j = start; j < end; j++) {
-                result.data_[j] = ++this->data_[j];
-            }
-        }));
-    }
-    for (auto& t : threads)
-        t.join();
-    return result;
+    NUMCPP_PROFILE("Array::operator++(int)", size());
+    // The old values keep the current buffer; the new ones get a fresh one
+    Array<T> old(*this);
+    *this = old + T(1);
+    return old;
 }
 
 template <typename T>
-Array<T> Array<T>::operator--()
-{
-    Array<T> result(shape_);
-    size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([=, this, &result]() {
-            for (size_t j = start; j < end; j++) {
-                result.data_[j] = --this->data_[j];
-            }
-        }));
-    }
-    for (auto& t : threads)
-        t.join();
-    return result;
-}
-
-template <typename T>
-Array<T> Array<T>::operator++(int)
+Array<T> Array<T>::operator--(int)
 {
-    Array<T> result(shape_);
-    size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([=, this, &result]() {
-            for (size_t j = start; j < end; j++) {
-                result.data_[j] = this->data_[j]++;
-            }
-        }));
-    }
-    for (auto& t : threads)
-        t.join();
-    return result;
+    NUMCPP_PROFILE("Array::operator--(int)", size());
+    Array<T> old(*this);
+    *this = old - T(1);
+    return old;
 }
 
 template <typename T>
-Array<T> Array<T>::operator--(int)
+Array<T> Array<T>::operator&() const
 {
+    NUMCPP_PROFILE("Array::operator&", size());
     Array<T> result(shape_);
     size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([=, this, &result]() {
-            for (size_t j = start; j < end; j++) {
-                result.data_[j] = this->data_[j]--;
-            }
-        }));
-    }
-    for (auto& t : threads)
-        t.join();
+    parallel_for(0, total, [&](size_t start, size_t end) {
+        for (size_t j = start; j < end; j++) {
+            result.data_[j] = this->data_[j];
+        }
+    }, parallel_grain(KernelCost::stream<T>(1, 1)));
     return result;
 }
 
 template <typename T>
-Array<T> Array<T>::operator!() const
+template <typename E>
+Array<T>& Array<T>::operator&=(const ArrayExpr<E, T>& other)
 {
-    Array<T> result(shape_);
-    size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([=, this, &result]() {
-            for (size_t j = start; j < end; j++) {
-                result.data_[j] = !this->data_[j];
-            }
-        }));
-    }
-    for (auto& t : threads)
-        t.join();
-    return result;
+    NUMCPP_PROFILE("Array::operator&=", size());
+    compound_assign<detail::BitAnd>(other.derived());
+    return *this;
 }
 
 template <typename T>
-Array<T> Array<T>::operator~() const
+template <typename E>
+Array<T>& Array<T>::operator|=(const ArrayExpr<E, T>& other)
 {
-    Array<T> result(shape_);
-    size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([=, this, &result]() {
-            for (size_t j = start; j < end; j++) {
-                result.data_[j] = ~this->data_[j];
-            }
-        }));
-    }
-    for (auto& t : threads)
-        t.join();
-    return result;
+    NUMCPP_PROFILE("Array::operator|=", size());
+    compound_assign<detail::BitOr>(other.derived());
+    return *this;
 }
 
 template <typename T>
-Array<T> Array<T>::operator&() const
+template <typename E>
+Array<T>& Array<T>::operator^=(const ArrayExpr<E, T>& other)
 {
-    Array<T> result(shape_);
-    size_t total = size();
-    unsigned nthreads = std::thread::hardware_concurrency();
-    if (nthreads == 0)
-        nthreads = 2;
-    size_t block = total / nthreads;
-    std::vector<std::thread> threads;
-    for (unsigned i = 0; i < nthreads; i++) {
-        size_t start = i * block;
-        size_t end = (i == nthreads - 1) ? total : start + block;
-        threads.push_back(std::thread([=, this, &result]() {
-            for (size_t j = start; j < end; j++) {
-                result.data_[j] = this->data_[j];
-            }
-        }));
-    }
-    for (auto& t : threads)
-        t.join();
-    return result;
+    NUMCPP_PROFILE("Array::operator^=", size());
+    compound_assign<detail::BitXor>(other.derived());
+    return *this;
 }
 
 template <typename T>
-Array<T> Array<T>::operator|(const Array<T>& other) const
+Array<T>& Array<T>::operator&=(const T& scalar)
 {
-    if (shape_ != other.shape_)
-        throw std::runtime_error("Shapes do not match for bitwise OR");
-    Array<T> result(shape_);
-    size_t total = size();
-    for (size_t i = 0; i < total; i++) {
-        result.data_[i] = data_[i] | other.data_[i];
-    }
-    return result;
+    NUMCPP_PROFILE("Array::operator&=", size());
+    detach();
+    detail::assign_op_scalar<detail::BitAnd>(data_, size(), scalar);
+    return *this;
 }
 
 template <typename T>
-Array<T> Array<T>::operator^(const Array<T>& other) const
+Array<T>& Array<T>::operator|=(const T& scalar)
 {
-    if (shape_ != other.shape_)
-        throw std::runtime_error("Shapes do not match for bitwise XOR");
-    Array<T> result(shape_);
-    size_t total = size();
-    for (size_t i = 0; i < total; i++) {
-        result.data_[i] = data_[i] ^ other.data_[i];
-    }
-    return result;
+    NUMCPP_PROFILE("Array::operator|=", size());
+    detach();
+    detail::assign_op_scalar<detail::BitOr>(data_, size(), scalar);
+    return *this;
 }
 
 template <typename T>
-Array<T>& Array<T>::operator&=(const Array<T>& other)
+Array<T>& Array<T>::operator^=(const T& scalar)
 {
-    if (shape_ != other.shape_)
-        throw std::runtime_error("Shapes do not match for bitwise AND assignment");
-    size_t total = size();
-    for (size_t i = 0; i < total; i++) {
-        data_[i] &= other.data_[i];
-    }
+    NUMCPP_PROFILE("Array::operator^=", size());
+    detach();
+    detail::assign_op_scalar<detail::BitXor>(data_, size(), scalar);
     return *this;
 }
 
 template <typename T>
-Array<T>& Array<T>::operator|=(const Array<T>& other)
+T* Array<T>::data()
 {
-    if (shape_ != other.shape_)
-        throw std::runtime_error("Shapes do not match for bitwise OR assignment");
-    size_t total = size();
-    for (size_t i = 0; i < total; i++) {
-        data_[i] |= other.data_[i];
-    }
-    return *this;
+    leak();
+    return data_;
 }
 
 template <typename T>
-Array<T>& Array<T>::operator^=(const Array<T>& other)
+const T* Array<T>::data() const
 {
-    if (shape_ != other.shape_)
-        throw std::runtime_error("Shapes do not match for bitwise XOR assignment");
-    size_t total = size();
-    for (size_t i = 0; i < total; i++) {
-        data_[i] ^= other.data_[i];
-    }
-    return *this;
+    return data_;
 }
 
 template <typename T>
-Array<T> Array<T>::operator&(const T& scalar) const
+ArrayView<T> Array<T>::view()
 {
-    Array<T> result(shape_);
-    size_t total = size();
-    for (size_t i = 0; i < total; i++) {
-        result.data_[i] = data_[i] & scalar;
-    }
-    return result;
+    leak();
+    return ArrayView<T>(data_, shape_, strides_);
 }
 
 template <typename T>
-Array<T> Array<T>::operator|(const T& scalar) const
+ArrayView<const T> Array<T>::view() const
 {
-    Array<T> result(shape_);
-    size_t total = size();
-    for (size_t i = 0; i < total; i++) {
-        result.data_[i] = data_[i] | scalar;
-    }
-    return result;
+    return ArrayView<const T>(data_, shape_, strides_);
 }
 
 template <typename T>
-Array<T> Array<T>::operator^(const T& scalar) const
+ArrayView<T> Array<T>::slice(size_t axis, size_t start, size_t stop, size_t step)
 {
-    Array<T> result(shape_);
-    size_t total = size();
-    for (size_t i = 0; i < total; i++) {
-        result.data_[i] = data_[i] ^ scalar;
-    }
-    return result;
+    return view().slice(axis, start, stop, step);
 }
 
 template <typename T>
-Array<T>& Array<T>::operator&=(const T& scalar)
+ArrayView<const T> Array<T>::slice(size_t axis, size_t start, size_t stop, size_t step) const
 {
-    size_t total = size();
-    for (size_t i = 0; i < total; i++) {
-        data_[i] &= scalar;
-    }
-    return *this;
+    return view().slice(axis, start, stop, step);
 }
 
 template <typename T>
-Array<T>& Array<T>::operator|=(const T& scalar)
+void Array<T>::print() const
 {
+    std::cout << "[";
     size_t total = size();
     for (size_t i = 0; i < total; i++) {
-        data_[i] |= scalar;
+        std::cout << data_[i];
+        if (i != total - 1)
+            std::cout << ", ";
     }
-    return *this;
+    std::cout << "]\n";
 }
 
 template <typename T>
-Array<T>& Array<T>::operator^=(const T& scalar)
+std::vector<size_t> Array<T>::compute_strides(const std::vector<size_t>& shape) const
 {
-    size_t total = size();
-    for (size_t i = 0; i < total; i++) {
-        data_[i] ^= scalar;
+    std::vector<size_t> strides(shape.size());
+    if (shape.empty())
+        return strides;
+    strides.back() = 1;
+    for (int i = static_cast<int>(shape.size()) - 2; i >= 0; i--) {
+        strides[i] = strides[i + 1] * shape[i + 1];
     }
-    return *this;
+    return strides;
 }
 
 template <typename T>
-Array<T> Array<T>::operator==(const Array<T>& other) const
+const Storage<T>& Array<T>::storage() const
 {
-    if (shape_ != other.shape_)
-        throw std::runtime_error("Shapes do not match for equality comparison");
-    Array<T> result(shape_);
-    size_t total = size();
-    for (size_t i = 0; i < total; i++) {
-        result.data_[i] = data_[i] == other.data_[i];
-    }
-    return result;
+    return storage_;
 }
 
 template <typename T>
-Array<T> Array<T>::operator!=(const Array<T>& other) const
+void Array<T>::detach()
 {
-    if (shape_ != other.shape_)
-        throw std::runtime_error("Shapes do not match for inequality comparison");
-    Array<T> result(shape_);
-    size_t total = size();
-    for (size_t i = 0; i < total; i++) {
-        result.data_[i] = data_[i] != other.data_[i];
+    if (!storage_.writable()) {
+        storage_.make_unique();
+        data_ = storage_.data();
     }
-    return result;
 }
 
 template <typename T>
-Array<T> Array<T>::operator<(const Array<T>& other) const
+void Array<T>::leak()
 {
-    if (shape_ != other.shape_)
-        throw std::runtime_error("Shapes do not match for less-than comparison");
-    Array<T> result(shape_);
-    size_t total = size();
-    for (size_t i = 0; i < total; i++) {
-        result.data_[i] = data_[i] < other.data_[i];
-    }
-    return result;
+    storage_.leak();
+    data_ = storage_.data();
 }
 
 template <typename T>
-Array<T> Array<T>::operator<=(const Array<T>& other) const
+void Array<T>::prepare_overwrite()
 {
-    if (shape_ != other.shape_)
-        throw std::runtime_error("Shapes do not match for less-than-or-equal comparison");
-    Array<T> result(shape_);
-    size_t total = size();
-    for (size_t i = 0; i < total; i++) {
-        result.data_[i] = data_[i] <= other.data_[i];
+    if (!storage_.writable()) {
+        storage_ = Storage<T>(size());
+        data_ = storage_.data();
     }
-    return result;
 }
 
 template <typename T>
-Array<T> Array<T>::operator>(const Array<T>& other) const
+template <typename... Indices>
+size_t Array<T>::checked_index(Indices... indices) const
 {
-    if (shape_ != other.shape_)
-        throw std::runtime_error("Shapes do not match for greater-than comparison");
-    Array<T> result(shape_);
-    size_t total = size();
-    for (size_t i = 0; i < total; i++) {
-        result.data_[i] = data_[i] > other.data_[i];
+    if (sizeof...(indices) != shape_.size())
+        throw std::invalid_argument("Number of indices must match number of dimensions");
+    if constexpr (sizeof...(indices) == 0) {
+        throw std::invalid_argument("No indices provided");
+    } else {
+        size_t index = 0, d = 0;
+        bool in_bounds = true;
+        ((in_bounds &= static_cast<size_t>(indices) < shape_[d], index += static_cast<size_t>(indices) * strides_[d++]), ...);
+        if (!in_bounds)
+            throw std::runtime_error("Index out of bounds");
+        return index;
     }
-    return result;
 }
 
 template <typename T>
-Array<T> Array<T>::operator>=(const Array<T>& other) const
+template <typename... Indices>
+size_t Array<T>::unchecked_index(Indices... indices) const
 {
-    if (shape_ != other.shape_)
-        throw std::runtime_error("Shapes do not match for greater-than-or-equal comparison");
-    Array<T> result(shape_);
-    size_t total = size();
-    for (size_t i = 0; i < total; i++) {
-        result.data_[i] = data_[i] >= other.data_[i];
+    if constexpr (sizeof...(indices) == 1) {
+        return (static_cast<size_t>(indices), ...);
+    } else {
+        size_t index = 0, d = 0;
+        ((index += static_cast<size_t>(indices) * strides_[d++]), ...);
+        return index;
     }
-    return result;
 }
 
 template <typename T>
-Array<T> Array<T>::operator&&(const Array<T>& other) const
+std::vector<bool> Array<T>::reduced_axes(const std::vector<size_t>& axes) const
 {
-    if (shape_ != other.shape_)
-        throw std::runtime_error("Shapes do not match for logical AND");
-    Array<T> result(shape_);
-    size_t total = size();
-    for (size_t i = 0; i < total; i++) {
-        result.data_[i] = data_[i] && other.data_[i];
+    std::vector<bool> reduced(ndim(), false);
+    for (auto axis : axes) {
+        if (axis >= ndim())
+            throw std::out_of_range("Axis out of range");
+        if (reduced[axis])
+            throw std::invalid_argument("Duplicate axis in reduction");
+        reduced[axis] = true;
     }
-    return result;
+    return reduced;
 }
 
 template <typename T>
-Array<T> Array<T>::operator||(const Array<T>& other) const
+std::vector<size_t> Array<T>::reduced_shape(const std::vector<bool>& reduced, bool keepdims) const
 {
-    if (shape_ != other.shape_)
-        throw std::runtime_error("Shapes do not match for logical OR");
-    Array<T> result(shape_);
-    size_t total = size();
-    for (size_t i = 0; i < total; i++) {
-        result.data_[i] = data_[i] || other.data_[i];
+    std::vector<size_t> shape;
+    for (size_t d = 0; d < ndim(); d++) {
+        if (!reduced[d])
+            shape.push_back(shape_[d]);
+        else if (keepdims)
+            shape.push_back(1);
     }
-    return result;
+    if (shape.empty())
+        shape.push_back(1);
+    return shape;
 }
 
 template <typename T>
-void Array<T>::print() const
+template <typename R>
+Array<T> Array<T>::reduce(const std::vector<size_t>& axes, bool keepdims, const char* name) const
 {
-    std::cout << "[";
-    size_t total = size();
-    for (size_t i = 0; i < total; i++) {
-        std::cout << data_[i];
-        if (i != total - 1)
-            std::cout << ", ";
+    std::vector<bool> reduced = reduced_axes(axes);
+    std::vector<size_t> shape = reduced_shape(reduced, keepdims);
+    size_t count = 1, reduce_count = 1;
+    for (auto s : shape)
+        count *= s;
+    for (size_t d = 0; d < ndim(); d++) {
+        if (reduced[d])
+            reduce_count *= shape_[d];
     }
-    std::cout << "]\n";
+    if (!std::is_same_v<R, simd::Sum> && reduce_count == 0 && count > 0)
+        throw std::runtime_error(std::string("Cannot compute ") + name + " of empty array");
+    Storage<T> storage(count);
+    reduce_axes<R>(data_, shape_, reduced, storage.data());
+    return Array<T>(shape, storage);
 }
 
 template <typename T>
-std::vector<size_t> Array<T>::compute_strides(const std::vector<size_t>& shape) const
+template <typename R>
+Array<size_t> Array<T>::arg_reduce(size_t axis, bool keepdims, const char* name) const
 {
-    std::vector<size_t> strides(shape.size());
-    if (shape.empty())
-        return strides;
-    strides.back() = 1;
-    for (int i = static_cast<int>(shape.size()) - 2; i >= 0; i--) {
-        strides[i] = strides[i + 1] * shape[i + 1];
-    }
-    return strides;
+    std::vector<bool> reduced = reduced_axes({ axis });
+    std::vector<size_t> shape = reduced_shape(reduced, keepdims);
+    size_t count = 1;
+    for (auto s : shape)
+        count *= s;
+    if (shape_[axis] == 0 && count > 0)
+        throw std::runtime_error(std::string("Cannot compute ") + name + " of empty array");
+    Storage<size_t> storage(count);
+    arg_reduce_axis<R>(data_, shape_, axis, storage.data());
+    return Array<size_t>(shape, storage);
 }
 
 template <typename T>
@@ -0,0 +1,67 @@
+#ifndef ARRAYSPAN_HPP
+#define ARRAYSPAN_HPP
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+
+namespace NumCPP {
+
+namespace detail {
+    template <size_t Rank>
+    constexpr std::array<size_t, Rank> row_major_strides(const std::array<size_t, Rank>& shape);
+
+    template <size_t Rank>
+    constexpr size_t extent_product(const std::array<size_t, Rank>& shape);
+
+    // Buffer offset of a multi-index; no bounds checks
+    template <size_t Rank, typename... Indices>
+    constexpr size_t linear_index(const std::array<size_t, Rank>& strides, Indices... indices);
+}
+
+// Non-owning, rank-Rank window onto a strided buffer in the spirit of
+// std::mdspan. Indexing is unchecked and allocation-free, so it compiles to
+// plain pointer arithmetic in hot loops. Obtain one from Array::span<Rank>()
+// or FixedRankArray::span(); it must not outlive the buffer.
+template <typename T, size_t Rank>
+class ArraySpan {
+    static_assert(Rank > 0, "ArraySpan requires a rank of at least 1");
+
+public:
+    using value_type = std::remove_const_t<T>;
+    using extents_type = std::array<size_t, Rank>;
+    static constexpr size_t rank = Rank;
+
+    constexpr ArraySpan() = default;
+    // Row-major layout
+    constexpr ArraySpan(T* data, const extents_type& extents);
+    constexpr ArraySpan(T* data, const extents_type& extents, const extents_type& strides);
+
+    constexpr operator ArraySpan<const T, Rank>() const
+        requires(!std::is_const_v<T>);
+
+    constexpr T* data() const { return data_; }
+    constexpr size_t size() const { return size_; }
+    constexpr size_t extent(size_t axis) const { return extents_[axis]; }
+    constexpr size_t stride(size_t axis) const { return strides_[axis]; }
+    constexpr const extents_type& extents() const { return extents_; }
+    constexpr const extents_type& strides() const { return strides_; }
+
+    template <typename... Indices>
+        requires(sizeof...(Indices) == Rank && (std::convertible_to<Indices, size_t> && ...))
+    constexpr T& operator()(Indices... indices) const;
+    constexpr T& operator[](const extents_type& indices) const;
+
+private:
+    T* data_ = nullptr;
+    extents_type extents_ {};
+    extents_type strides_ {};
+    size_t size_ = 0;
+};
+
+} // namespace NumCPP
+
+#include "ArraySpan.tpp"
+
+#endif // ARRAYSPAN_HPP
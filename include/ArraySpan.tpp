@@ -0,0 +1,81 @@
+#ifndef ARRAYSPAN_TPP
+#define ARRAYSPAN_TPP
+
+#include "ArraySpan.hpp"
+
+namespace NumCPP {
+
+namespace detail {
+    template <size_t Rank>
+    constexpr std::array<size_t, Rank> row_major_strides(const std::array<size_t, Rank>& shape)
+    {
+        std::array<size_t, Rank> strides {};
+        size_t stride = 1;
+        for (size_t d = Rank; d-- > 0;) {
+            strides[d] = stride;
+            stride *= shape[d];
+        }
+        return strides;
+    }
+
+    template <size_t Rank>
+    constexpr size_t extent_product(const std::array<size_t, Rank>& shape)
+    {
+        size_t total = 1;
+        for (auto s : shape)
+            total *= s;
+        return total;
+    }
+
+    template <size_t Rank, typename... Indices>
+    constexpr size_t linear_index(const std::array<size_t, Rank>& strides, Indices... indices)
+    {
+        static_assert(sizeof...(Indices) == Rank, "Number of indices must match the rank");
+        size_t index = 0, d = 0;
+        ((index += static_cast<size_t>(indices) * strides[d++]), ...);
+        return index;
+    }
+}
+
+template <typename T, size_t Rank>
+constexpr ArraySpan<T, Rank>::ArraySpan(T* data, const extents_type& extents)
+    : ArraySpan(data, extents, detail::row_major_strides(extents))
+{
+}
+
+template <typename T, size_t Rank>
+constexpr ArraySpan<T, Rank>::ArraySpan(T* data, const extents_type& extents, const extents_type& strides)
+    : data_(data)
+    , extents_(extents)
+    , strides_(strides)
+    , size_(detail::extent_product(extents))
+{
+}
+
+template <typename T, size_t Rank>
+constexpr ArraySpan<T, Rank>::operator ArraySpan<const T, Rank>() const
+    requires(!std::is_const_v<T>)
+{
+    return ArraySpan<const T, Rank>(data_, extents_, strides_);
+}
+
+template <typename T, size_t Rank>
+template <typename... Indices>
+    requires(sizeof...(Indices) == Rank && (std::convertible_to<Indices, size_t> && ...))
+constexpr T& ArraySpan<T, Rank>::operator()(Indices... indices) const
+{
+    return data_[detail::linear_index(strides_, indices...)];
+}
+
+template <typename T, size_t Rank>
+constexpr T& ArraySpan<T, Rank>::operator[](const extents_type& indices) const
+{
+    size_t index = 0;
+    for (size_t d = 0; d < Rank; d++)
+        index += indices[d] * strides_[d];
+    return data_[index];
+}
+
+} // namespace NumCPP
+
+#endif // ARRAYSPAN_TPP
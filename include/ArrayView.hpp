@@ -0,0 +1,88 @@
+#ifndef ARRAYVIEW_HPP
+#define ARRAYVIEW_HPP
+
+#include "Expression.hpp"
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace NumCPP {
+
+// A non-owning window onto an Array buffer: an offset plus a shape and
+// element strides. Reshaping, transposing, permuting axes and slicing a view
+// only rewrite this metadata, so they are O(1) and never copy elements.
+//
+// A view does not keep its Array alive; it must not outlive the buffer it
+// was taken from. ArrayView<const T> is the read-only form.
+template <typename T>
+class ArrayView : public ArrayExpr<ArrayView<T>, std::remove_const_t<T>> {
+public:
+    using value_type = std::remove_const_t<T>;
+    using element_type = T;
+
+    ArrayView(T* base, const std::vector<size_t>& shape, const std::vector<size_t>& strides,
+        size_t offset = 0);
+
+    // Read-only views convert from writable ones
+    operator ArrayView<const T>() const
+        requires(!std::is_const_v<T>);
+
+    // Basic View Properties
+    const std::vector<size_t>& shape() const { return shape_; }
+    const std::vector<size_t>& strides() const { return strides_; }
+    size_t ndim() const { return shape_.size(); }
+    size_t size() const { return size_; }
+    size_t offset() const { return offset_; }
+    // True when the elements are laid out row-major without gaps
+    bool is_contiguous() const { return contiguous_; }
+
+    // Pointer to the first element of the view
+    T* data() const { return base_ + offset_; }
+
+    // Element Access. One index is a flat (row-major) index, otherwise the
+    // number of indices must match ndim().
+    template <typename... Indices>
+    T& operator()(Indices... indices) const;
+    T& operator()(const std::vector<size_t>& indices) const;
+
+    // Zero-copy transformations
+    ArrayView<T> reshape(const std::vector<size_t>& new_shape) const;
+    ArrayView<T> transpose() const;
+    ArrayView<T> permute(const std::vector<size_t>& axes) const;
+    // Elements start, start + step, ... below stop along axis
+    ArrayView<T> slice(size_t axis, size_t start, size_t stop, size_t step = 1) const;
+
+    // Materialize into a new contiguous Array
+    Array<value_type> copy() const;
+
+    // Write through the view; expr is broadcast to the view's shape. expr is
+    // read at the index being written, so it may refer to this view but not
+    // to its elements in another layout.
+    template <typename E>
+    void assign(const ArrayExpr<E, value_type>& expr) const;
+    void fill(const value_type& value) const;
+
+    detail::StridedKernel<value_type> kernel() const;
+
+private:
+    T* base_;
+    size_t offset_;
+    std::vector<size_t> shape_;
+    std::vector<size_t> strides_;
+    size_t size_;
+    bool contiguous_;
+
+    size_t offset_of(size_t flat) const;
+};
+
+namespace detail {
+    // Copies a view into a contiguous buffer one row (last axis) at a time
+    template <typename T, typename U>
+    void assign(T* dst, const ArrayView<U>& view);
+}
+
+} // namespace NumCPP
+
+#include "ArrayView.tpp"
+
+#endif // ARRAYVIEW_HPP
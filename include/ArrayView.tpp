@@ -0,0 +1,261 @@
+#ifndef ARRAYVIEW_TPP
+#define ARRAYVIEW_TPP
+
+#include "ArrayView.hpp"
+#include "CostModel.hpp"
+#include "Permute.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace NumCPP {
+
+namespace detail {
+    inline bool is_row_major(const std::vector<size_t>& shape, const std::vector<size_t>& strides)
+    {
+        size_t expected = 1;
+        for (size_t d = shape.size(); d-- > 0;) {
+            if (shape[d] == 1)
+                continue;
+            if (strides[d] != expected)
+                return false;
+            expected *= shape[d];
+        }
+        return true;
+    }
+
+    // Calls body(row, offset) for every row of the last axis, where offset is
+    // the buffer offset of the row's first element. Rows run in parallel,
+    // each element costing `cost`.
+    template <typename F>
+    void for_each_row(const std::vector<size_t>& shape, const std::vector<size_t>& strides,
+        const KernelCost& cost, F&& body)
+    {
+        size_t inner = shape.empty() ? 1 : shape.back();
+        size_t total = 1;
+        for (auto s : shape)
+            total *= s;
+        if (total == 0)
+            return;
+        size_t rows = total / inner;
+        size_t outer_dims = shape.empty() ? 0 : shape.size() - 1;
+        size_t grain = parallel_grain(cost * double(inner));
+        parallel_for(0, rows, [&](size_t start, size_t end) {
+            for (size_t r = start; r < end; r++) {
+                size_t off = 0;
+                size_t rem = r;
+                for (size_t d = outer_dims; d-- > 0;) {
+                    off += (rem % shape[d]) * strides[d];
+                    rem /= shape[d];
+                }
+                body(r, off);
+            }
+        }, grain);
+    }
+
+    template <typename T, typename U>
+    void assign(T* dst, const ArrayView<U>& view)
+    {
+        if constexpr (std::is_same_v<std::remove_const_t<U>, T>) {
+            // Tiled transposes when the view's unit stride is not its last axis
+            copy_strided<T>(view.data(), view.shape(), view.strides(), dst);
+            return;
+        }
+        if (view.is_contiguous()) {
+            const U* src = view.data();
+            parallel_for(0, view.size(), [&](size_t start, size_t end) {
+                std::copy(src + start, src + end, dst + start);
+            }, parallel_grain(KernelCost::stream<U>(1) + KernelCost::stream<T>(0, 1)));
+            return;
+        }
+        const U* base = view.data();
+        size_t inner = view.shape().back();
+        size_t step = view.strides().back();
+        KernelCost cost = KernelCost::stream<U>(1) + KernelCost::stream<T>(0, 1);
+        for_each_row(view.shape(), view.strides(), cost, [&](size_t row, size_t off) {
+            const U* src = base + off;
+            T* out = dst + row * inner;
+            for (size_t j = 0; j < inner; j++)
+                out[j] = src[j * step];
+        });
+    }
+}
+
+template <typename T>
+ArrayView<T>::ArrayView(T* base, const std::vector<size_t>& shape, const std::vector<size_t>& strides,
+    size_t offset)
+    : base_(base)
+    , offset_(offset)
+    , shape_(shape)
+    , strides_(strides)
+{
+    if (shape_.size() != strides_.size())
+        throw std::invalid_argument("Shape and strides must have the same length");
+    size_ = shape_.empty() ? 0 : 1;
+    for (auto s : shape_)
+        size_ *= s;
+    contiguous_ = detail::is_row_major(shape_, strides_);
+}
+
+template <typename T>
+ArrayView<T>::operator ArrayView<const T>() const
+    requires(!std::is_const_v<T>)
+{
+    return ArrayView<const T>(base_, shape_, strides_, offset_);
+}
+
+template <typename T>
+size_t ArrayView<T>::offset_of(size_t flat) const
+{
+    size_t off = offset_;
+    for (size_t d = shape_.size(); d-- > 0;) {
+        off += (flat % shape_[d]) * strides_[d];
+        flat /= shape_[d];
+    }
+    return off;
+}
+
+template <typename T>
+template <typename... Indices>
+T& ArrayView<T>::operator()(Indices... indices) const
+{
+    static_assert(sizeof...(indices) > 0, "No indices provided");
+    if constexpr (sizeof...(indices) == 1) {
+        size_t flat = (static_cast<size_t>(indices), ...);
+        if (flat >= size_)
+            throw std::out_of_range("Index out of range");
+        return base_[offset_of(flat)];
+    } else {
+        return (*this)(std::vector<size_t> { static_cast<size_t>(indices)... });
+    }
+}
+
+template <typename T>
+T& ArrayView<T>::operator()(const std::vector<size_t>& indices) const
+{
+    if (indices.size() != shape_.size())
+        throw std::invalid_argument("Number of indices must match number of dimensions");
+    size_t off = offset_;
+    for (size_t d = 0; d < indices.size(); d++) {
+        if (indices[d] >= shape_[d])
+            throw std::out_of_range("Index out of range");
+        off += indices[d] * strides_[d];
+    }
+    return base_[off];
+}
+
+template <typename T>
+ArrayView<T> ArrayView<T>::reshape(const std::vector<size_t>& new_shape) const
+{
+    size_t total = new_shape.empty() ? 0 : 1;
+    for (auto s : new_shape)
+        total *= s;
+    if (total != size_)
+        throw std::invalid_argument("New shape must have the same number of elements");
+    if (!contiguous_)
+        throw std::runtime_error("Cannot reshape a non-contiguous view; copy() it first");
+    std::vector<size_t> new_strides(new_shape.size());
+    size_t stride = 1;
+    for (size_t d = new_shape.size(); d-- > 0;) {
+        new_strides[d] = stride;
+        stride *= new_shape[d];
+    }
+    return ArrayView<T>(base_, new_shape, new_strides, offset_);
+}
+
+template <typename T>
+ArrayView<T> ArrayView<T>::transpose() const
+{
+    std::vector<size_t> new_shape(shape_.rbegin(), shape_.rend());
+    std::vector<size_t> new_strides(strides_.rbegin(), strides_.rend());
+    return ArrayView<T>(base_, new_shape, new_strides, offset_);
+}
+
+template <typename T>
+ArrayView<T> ArrayView<T>::permute(const std::vector<size_t>& axes) const
+{
+    if (axes.size() != shape_.size())
+        throw std::invalid_argument("Permutation must list every axis once");
+    std::vector<bool> seen(axes.size(), false);
+    std::vector<size_t> new_shape(axes.size());
+    std::vector<size_t> new_strides(axes.size());
+    for (size_t d = 0; d < axes.size(); d++) {
+        if (axes[d] >= axes.size() || seen[axes[d]])
+            throw std::invalid_argument("Permutation must list every axis once");
+        seen[axes[d]] = true;
+        new_shape[d] = shape_[axes[d]];
+        new_strides[d] = strides_[axes[d]];
+    }
+    return ArrayView<T>(base_, new_shape, new_strides, offset_);
+}
+
+template <typename T>
+ArrayView<T> ArrayView<T>::slice(size_t axis, size_t start, size_t stop, size_t step) const
+{
+    if (axis >= shape_.size())
+        throw std::out_of_range("Axis out of range");
+    if (step == 0)
+        throw std::invalid_argument("Slice step must be positive");
+    stop = std::min(stop, shape_[axis]);
+    if (start > stop)
+        throw std::out_of_range("Slice start out of range");
+    std::vector<size_t> new_shape = shape_;
+    std::vector<size_t> new_strides = strides_;
+    new_shape[axis] = (stop - start + step - 1) / step;
+    new_strides[axis] = strides_[axis] * step;
+    return ArrayView<T>(base_, new_shape, new_strides, offset_ + start * strides_[axis]);
+}
+
+template <typename T>
+Array<typename ArrayView<T>::value_type> ArrayView<T>::copy() const
+{
+    return Array<value_type>(*this);
+}
+
+template <typename T>
+template <typename E>
+void ArrayView<T>::assign(const ArrayExpr<E, value_type>& expr) const
+{
+    static_assert(!std::is_const_v<T>, "Cannot assign through a read-only view");
+    detail::BroadcastInfo info = detail::broadcast_info(detail::shape_of(expr.derived()), shape_, "assignment");
+    auto kernel = detail::broadcast_kernel(detail::kernel_of(expr.derived()), info);
+    if (contiguous_) {
+        detail::assign_kernel(data(), size_, kernel);
+        return;
+    }
+    T* base = data();
+    size_t inner = shape_.back();
+    size_t step = strides_.back();
+    KernelCost cost = detail::kernel_cost(kernel) + KernelCost::stream<T>(0, 1);
+    detail::for_each_row(shape_, strides_, cost, [&](size_t row, size_t off) {
+        for (size_t j = 0; j < inner; j++)
+            base[off + j * step] = kernel(row * inner + j);
+    });
+}
+
+template <typename T>
+void ArrayView<T>::fill(const value_type& value) const
+{
+    static_assert(!std::is_const_v<T>, "Cannot fill a read-only view");
+    if (contiguous_) {
+        detail::fill(data(), size_, value);
+        return;
+    }
+    T* base = data();
+    size_t inner = shape_.back();
+    size_t step = strides_.back();
+    detail::for_each_row(shape_, strides_, KernelCost::stream<T>(0, 1), [&](size_t, size_t off) {
+        for (size_t j = 0; j < inner; j++)
+            base[off + j * step] = value;
+    });
+}
+
+template <typename T>
+detail::StridedKernel<typename ArrayView<T>::value_type> ArrayView<T>::kernel() const
+{
+    return { data(), shape_.data(), strides_.data(), shape_.size(), contiguous_ };
+}
+
+} // namespace NumCPP
+
+#endif // ARRAYVIEW_TPP
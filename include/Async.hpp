@@ -0,0 +1,132 @@
+#ifndef ASYNC_HPP
+#define ASYNC_HPP
+
+#include "Array.hpp"
+#include "Matrix.hpp"
+#include "SquareMatrix.hpp"
+#include "ThreadPool.hpp"
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <stop_token>
+#include <tuple>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace NumCPP {
+
+// Thrown by Task::get() for a task cancelled before it started
+class TaskCancelled : public std::runtime_error {
+public:
+    TaskCancelled()
+        : std::runtime_error("Task was cancelled")
+    {
+    }
+};
+
+namespace detail {
+    template <typename T>
+    struct TaskState;
+}
+
+// Handle to a result computed on the ThreadPool by async(), then() or
+// when_all(). Copies refer to the same result.
+//
+// A Task can be waited on with get(), chained with then() or awaited with
+// co_await from a coroutine; the last two occupy no thread while waiting, the
+// continuation or coroutine being resumed on the pool once the result is
+// ready. Exceptions thrown by the work surface from get() and pass through
+// then() continuations without running them.
+//
+// cancel() stops work that has not started yet: the task and every step
+// chained onto it with then() complete with TaskCancelled instead. Kernels
+// already running are not interrupted, but work taking a std::stop_token
+// can poll it.
+template <typename T>
+class Task {
+public:
+    using value_type = T;
+
+    // No result; valid() is false and the other members throw
+    // std::runtime_error
+    Task() = default;
+
+    bool valid() const { return state_ != nullptr; }
+    bool ready() const;
+    void wait() const;
+    // Waits, then returns the result or rethrows the task's exception.
+    // Callable any number of times.
+    T get() const;
+
+    void cancel() const;
+    std::stop_token stop_token() const;
+
+    // Task running f(result) (f() for Task<void>) on the pool once this task
+    // has completed. Shares this task's cancellation.
+    template <typename F>
+    auto then(F&& f) const;
+
+    // Awaitable: `co_await task` suspends until the result is ready and
+    // resumes on the pool
+    bool await_ready() const { return ready(); }
+    void await_suspend(std::coroutine_handle<> handle) const;
+    T await_resume() const { return get(); }
+
+private:
+    explicit Task(std::shared_ptr<detail::TaskState<T>> state)
+        : state_(std::move(state))
+    {
+    }
+
+    std::shared_ptr<detail::TaskState<T>> state_;
+
+    // *state_; throws std::runtime_error for a Task without one
+    detail::TaskState<T>& state() const;
+
+    template <typename U>
+    friend class Task;
+    template <typename F>
+    friend auto async(F&& f);
+    template <typename... Ts>
+    friend Task<std::tuple<Ts...>> when_all(const Task<Ts>&... tasks);
+    template <typename U>
+    friend Task<std::vector<U>> when_all(const std::vector<Task<U>>& tasks);
+};
+
+// Runs f() on the ThreadPool and returns a Task for its result. f may take a
+// std::stop_token instead, to notice cancel() while running. With an inline
+// or single-threaded pool f runs before async() returns.
+template <typename F>
+auto async(F&& f);
+
+// Completes once every task has; the result holds their results in order.
+// Fails with the first failing task's exception (in argument order), and
+// cancelling it cancels the inputs.
+template <typename... Ts>
+Task<std::tuple<Ts...>> when_all(const Task<Ts>&... tasks);
+template <typename T>
+Task<std::vector<T>> when_all(const std::vector<Task<T>>& tasks);
+
+// Asynchronous forms of long-running kernels. Operands are taken by value;
+// as Arrays and Matrices share storage copy-on-write this copies no
+// elements, and later writes by the caller do not affect the result.
+template <typename T>
+Task<T> async_sum(Array<T> arr);
+template <typename T>
+Task<Array<T>> async_dot(Matrix<T> a, Matrix<T> b, Trans trans_a = Trans::No, Trans trans_b = Trans::No);
+template <typename T>
+Task<SquareMatrix<T>> async_inverse(SquareMatrix<T> matrix);
+template <typename T>
+Task<Array<T>> async_solve(SquareMatrix<T> matrix, Array<T> b);
+
+} // namespace NumCPP
+
+#include "Async.tpp"
+
+#endif // ASYNC_HPP
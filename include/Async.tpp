@@ -0,0 +1,279 @@
+#ifndef ASYNC_TPP
+#define ASYNC_TPP
+
+#include "Async.hpp"
+#include <atomic>
+#include <chrono>
+#include <utility>
+
+namespace NumCPP {
+
+namespace detail {
+    template <typename T>
+    using TaskValue = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+    template <typename T>
+    struct TaskState {
+        std::mutex mutex;
+        std::condition_variable done;
+        bool ready = false;
+        std::optional<TaskValue<T>> value;
+        std::exception_ptr error;
+        std::vector<std::function<void()>> continuations;
+        // Copies share one stop state, so a then() chain cancels as a whole
+        std::stop_source stop;
+        // Anything that must live as long as the task (when_all's callback)
+        std::shared_ptr<void> keep_alive;
+
+        // Runs callback now when the task is ready, else once it completes
+        void on_ready(std::function<void()> callback)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!ready) {
+                    continuations.push_back(std::move(callback));
+                    return;
+                }
+            }
+            callback();
+        }
+    };
+
+    template <typename T>
+    void complete(TaskState<T>& state, std::optional<TaskValue<T>> value, std::exception_ptr error)
+    {
+        std::vector<std::function<void()>> continuations;
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            state.value = std::move(value);
+            state.error = std::move(error);
+            state.ready = true;
+            continuations.swap(state.continuations);
+        }
+        state.done.notify_all();
+        for (auto& continuation : continuations)
+            continuation();
+    }
+
+    // Completes state with work()'s result or exception, or with
+    // TaskCancelled without calling work once a stop was requested
+    template <typename T, typename F>
+    void run_task(TaskState<T>& state, F&& work)
+    {
+        std::optional<TaskValue<T>> value;
+        std::exception_ptr error;
+        if (state.stop.stop_requested()) {
+            error = std::make_exception_ptr(TaskCancelled());
+        } else {
+            try {
+                if constexpr (std::is_void_v<T>) {
+                    work();
+                    value.emplace();
+                } else {
+                    value.emplace(work());
+                }
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+        complete(state, std::move(value), std::move(error));
+    }
+}
+
+template <typename T>
+detail::TaskState<T>& Task<T>::state() const
+{
+    if (!state_)
+        throw std::runtime_error("Task has no result");
+    return *state_;
+}
+
+template <typename T>
+bool Task<T>::ready() const
+{
+    std::lock_guard<std::mutex> lock(state().mutex);
+    return state_->ready;
+}
+
+template <typename T>
+void Task<T>::wait() const
+{
+    ThreadPool& pool = ThreadPool::instance();
+    std::unique_lock<std::mutex> lock(state().mutex);
+    while (!state_->ready) {
+        if (!pool.in_worker()) {
+            state_->done.wait(lock);
+            continue;
+        }
+        // A blocked worker could be the one this task is queued on, so run
+        // queued work while waiting
+        lock.unlock();
+        bool ran = pool.run_pending();
+        lock.lock();
+        if (!ran && !state_->ready)
+            state_->done.wait_for(lock, std::chrono::microseconds(100));
+    }
+}
+
+template <typename T>
+T Task<T>::get() const
+{
+    wait();
+    if (state_->error)
+        std::rethrow_exception(state_->error);
+    if constexpr (!std::is_void_v<T>)
+        return *state_->value;
+}
+
+template <typename T>
+void Task<T>::cancel() const
+{
+    state().stop.request_stop();
+}
+
+template <typename T>
+std::stop_token Task<T>::stop_token() const
+{
+    return state().stop.get_token();
+}
+
+template <typename T>
+template <typename F>
+auto Task<T>::then(F&& f) const
+{
+    using R = typename std::conditional_t<std::is_void_v<T>, std::invoke_result<F&>,
+        std::invoke_result<F&, const detail::TaskValue<T>&>>::type;
+    auto next = std::make_shared<detail::TaskState<R>>();
+    next->stop = state().stop;
+    auto parent = state_;
+    parent->on_ready([parent, next, f = std::forward<F>(f)]() mutable {
+        ThreadPool::instance().submit([parent, next, f = std::move(f)]() mutable {
+            if (parent->error) {
+                detail::complete(*next, std::nullopt, parent->error);
+                return;
+            }
+            detail::run_task(*next, [&]() -> R {
+                if constexpr (std::is_void_v<T>)
+                    return f();
+                else
+                    return f(std::as_const(*parent->value));
+            });
+        });
+    });
+    return Task<R>(next);
+}
+
+template <typename T>
+void Task<T>::await_suspend(std::coroutine_handle<> handle) const
+{
+    state().on_ready([handle]() { ThreadPool::instance().submit([handle]() { handle.resume(); }); });
+}
+
+template <typename F>
+auto async(F&& f)
+{
+    using Fn = std::decay_t<F>;
+    constexpr bool takes_token = std::is_invocable_v<Fn&, std::stop_token>;
+    using R = typename std::conditional_t<takes_token, std::invoke_result<Fn&, std::stop_token>,
+        std::invoke_result<Fn&>>::type;
+    auto state = std::make_shared<detail::TaskState<R>>();
+    ThreadPool::instance().submit([state, f = std::forward<F>(f)]() mutable {
+        detail::run_task(*state, [&]() -> R {
+            if constexpr (takes_token)
+                return f(state->stop.get_token());
+            else
+                return f();
+        });
+    });
+    return Task<R>(state);
+}
+
+template <typename... Ts>
+Task<std::tuple<Ts...>> when_all(const Task<Ts>&... tasks)
+{
+    static_assert((!std::is_void_v<Ts> && ...), "when_all needs tasks with results");
+    using R = std::tuple<Ts...>;
+    (tasks.state(), ...);
+    auto state = std::make_shared<detail::TaskState<R>>();
+    auto inputs = std::make_shared<std::tuple<Task<Ts>...>>(tasks...);
+    std::function<void()> cancel_inputs = [inputs]() {
+        std::apply([](const auto&... task) { (task.cancel(), ...); }, *inputs);
+    };
+    state->keep_alive = std::make_shared<std::stop_callback<std::function<void()>>>(
+        state->stop.get_token(), std::move(cancel_inputs));
+
+    auto remaining = std::make_shared<std::atomic<size_t>>(sizeof...(Ts) + 1);
+    auto arrive = [state, inputs, remaining]() {
+        if (remaining->fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+        // Braced initialization gets the results, and so the first
+        // exception, in argument order
+        detail::run_task(*state, [&]() {
+            return std::apply([](const auto&... task) { return R { task.get()... }; }, *inputs);
+        });
+    };
+    std::apply([&](const auto&... task) { (task.state_->on_ready(arrive), ...); }, *inputs);
+    arrive();
+    return Task<R>(state);
+}
+
+template <typename T>
+Task<std::vector<T>> when_all(const std::vector<Task<T>>& tasks)
+{
+    static_assert(!std::is_void_v<T>, "when_all needs tasks with results");
+    for (const auto& task : tasks)
+        task.state();
+    auto state = std::make_shared<detail::TaskState<std::vector<T>>>();
+    auto inputs = std::make_shared<std::vector<Task<T>>>(tasks);
+    std::function<void()> cancel_inputs = [inputs]() {
+        for (const auto& task : *inputs)
+            task.cancel();
+    };
+    state->keep_alive = std::make_shared<std::stop_callback<std::function<void()>>>(
+        state->stop.get_token(), std::move(cancel_inputs));
+
+    auto remaining = std::make_shared<std::atomic<size_t>>(tasks.size() + 1);
+    auto arrive = [state, inputs, remaining]() {
+        if (remaining->fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+        detail::run_task(*state, [&]() {
+            std::vector<T> results;
+            results.reserve(inputs->size());
+            for (const auto& task : *inputs)
+                results.push_back(task.get());
+            return results;
+        });
+    };
+    for (const auto& task : *inputs)
+        task.state_->on_ready(arrive);
+    arrive();
+    return Task<std::vector<T>>(state);
+}
+
+template <typename T>
+Task<T> async_sum(Array<T> arr)
+{
+    return async([arr = std::move(arr)]() { return arr.sum(); });
+}
+
+template <typename T>
+Task<Array<T>> async_dot(Matrix<T> a, Matrix<T> b, Trans trans_a, Trans trans_b)
+{
+    return async([a = std::move(a), b = std::move(b), trans_a, trans_b]() { return a.dot(b, trans_a, trans_b); });
+}
+
+template <typename T>
+Task<SquareMatrix<T>> async_inverse(SquareMatrix<T> matrix)
+{
+    return async([matrix = std::move(matrix)]() { return matrix.inverse(); });
+}
+
+template <typename T>
+Task<Array<T>> async_solve(SquareMatrix<T> matrix, Array<T> b)
+{
+    return async([matrix = std::move(matrix), b = std::move(b)]() { return matrix.solve(b); });
+}
+
+} // namespace NumCPP
+
+#endif // ASYNC_TPP
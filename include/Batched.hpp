@@ -0,0 +1,68 @@
+#ifndef BATCHED_HPP
+#define BATCHED_HPP
+
+#include "Array.hpp"
+#include "FixedMatrix.hpp"
+#include "Gemm.hpp"
+#include <cstddef>
+
+namespace NumCPP {
+
+// Linear algebra over stacks of independent matrices. A stack is a 3D Array
+// of shape {batch, rows, cols} holding `batch` row-major matrices back to
+// back, so every matrix is one contiguous block.
+//
+// The matrices are spread over the ThreadPool, with as many per task as the
+// CostModel asks for. Results are written into a single array; the overloads
+// taking `out` write into an array that already has the result's shape
+// (std::invalid_argument otherwise) and allocate nothing. Shapes that do not
+// match throw std::invalid_argument.
+
+// out[i] = op(a[i]) * op(b[i]). b may also be one 2D matrix used for every
+// item of the batch.
+template <typename T>
+Array<T> batch_matmul(const Array<T>& a, const Array<T>& b, Trans trans_a = Trans::No,
+    Trans trans_b = Trans::No);
+template <typename T>
+void batch_matmul(const Array<T>& a, const Array<T>& b, Array<T>& out, Trans trans_a = Trans::No,
+    Trans trans_b = Trans::No);
+
+// {batch, rows, cols} -> {batch, cols, rows}
+template <typename T>
+Array<T> batch_transpose(const Array<T>& a);
+template <typename T>
+void batch_transpose(const Array<T>& a, Array<T>& out);
+
+// Square stacks only. Matrices up to 4 x 4 use the closed forms of
+// FixedSquareMatrix, larger ones partial-pivoting elimination. inverse() and
+// solve() throw std::runtime_error naming the first singular matrix found.
+
+// One determinant per matrix, shape {batch}
+template <typename T>
+Array<T> batch_determinant(const Array<T>& a);
+template <typename T>
+void batch_determinant(const Array<T>& a, Array<T>& out);
+
+template <typename T>
+Array<T> batch_inverse(const Array<T>& a);
+template <typename T>
+void batch_inverse(const Array<T>& a, Array<T>& out);
+
+// Solves a[i] * x[i] = b[i] for b of shape {batch, n} or {batch, n, k}; the
+// solution has b's shape
+template <typename T>
+Array<T> batch_solve(const Array<T>& a, const Array<T>& b);
+template <typename T>
+void batch_solve(const Array<T>& a, const Array<T>& b, Array<T>& out);
+
+namespace detail {
+    // Products up to this many multiply-adds skip gemm's packing and run a
+    // direct loop
+    inline constexpr size_t batch_direct_flops = 32 * 32 * 32;
+}
+
+} // namespace NumCPP
+
+#include "Batched.tpp"
+
+#endif // BATCHED_HPP
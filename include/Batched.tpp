@@ -0,0 +1,336 @@
+#ifndef BATCHED_TPP
+#define BATCHED_TPP
+
+#include "Batched.hpp"
+#include "CostModel.hpp"
+#include "Permute.hpp"
+#include "Profiler.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace NumCPP {
+
+namespace detail {
+    template <typename T>
+    void check_stack(const Array<T>& a, bool square, const char* what)
+    {
+        if (a.ndim() != 3)
+            throw std::invalid_argument(std::string(what) + " requires a 3D array of shape {batch, rows, cols}");
+        if (square && a.shape()[1] != a.shape()[2])
+            throw std::invalid_argument(std::string(what) + " requires square matrices");
+    }
+
+    template <typename T>
+    void check_output(const Array<T>& out, const std::vector<size_t>& shape)
+    {
+        if (out.shape() != shape)
+            throw std::invalid_argument("Output array has the wrong shape");
+    }
+
+    [[noreturn]] inline void throw_singular(size_t index)
+    {
+        throw std::runtime_error("Matrix " + std::to_string(index) + " of the batch is singular");
+    }
+
+    // Calls f(std::integral_constant<size_t, N>) when 1 <= n <= 4 and
+    // returns whether it did
+    template <typename F>
+    bool with_fixed_size(size_t n, F&& f)
+    {
+        switch (n) {
+        case 1:
+            f(std::integral_constant<size_t, 1> {});
+            return true;
+        case 2:
+            f(std::integral_constant<size_t, 2> {});
+            return true;
+        case 3:
+            f(std::integral_constant<size_t, 3> {});
+            return true;
+        case 4:
+            f(std::integral_constant<size_t, 4> {});
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // c = op(a) * op(b) for one small product, without packing. Rows of c
+    // are accumulated from rows of op(b) when b is stored as is, and as dot
+    // products with its rows when it is transposed, so the innermost loop
+    // always runs over contiguous memory.
+    template <typename T>
+    void direct_matmul(Trans trans_a, Trans trans_b, size_t m, size_t n, size_t k, const T* a, const T* b, T* c)
+    {
+        auto a_at = [&](size_t i, size_t p) { return trans_a == Trans::No ? a[i * k + p] : a[p * m + i]; };
+        for (size_t i = 0; i < m; i++) {
+            T* row = c + i * n;
+            if (trans_b == Trans::No) {
+                std::fill(row, row + n, T(0));
+                for (size_t p = 0; p < k; p++) {
+                    T scale = a_at(i, p);
+                    const T* b_row = b + p * n;
+                    for (size_t j = 0; j < n; j++)
+                        row[j] += scale * b_row[j];
+                }
+            } else {
+                for (size_t j = 0; j < n; j++) {
+                    const T* b_row = b + j * k;
+                    T acc = T(0);
+                    for (size_t p = 0; p < k; p++)
+                        acc += a_at(i, p) * b_row[p];
+                    row[j] = acc;
+                }
+            }
+        }
+    }
+
+    // Gauss-Jordan on a scratch copy of the n x n matrix src, applied to the
+    // n x k right-hand sides that init() writes into x (solved in place).
+    // src is copied before init() runs, so x may overlap it, as it does for
+    // an in-place inverse. False if singular.
+    template <typename T, typename Init>
+    bool gauss_jordan(const T* src, size_t n, T* x, size_t k, Init&& init)
+    {
+        thread_local std::vector<T> scratch;
+        scratch.assign(src, src + n * n);
+        init();
+        if (eliminate(scratch.data(), n, x, k, true) == T(0))
+            return false;
+        for (size_t i = 0; i < n; i++) {
+            T pivot = scratch[i * n + i];
+            for (size_t c = 0; c < k; c++)
+                x[i * k + c] /= pivot;
+        }
+        return true;
+    }
+}
+
+template <typename T>
+Array<T> batch_matmul(const Array<T>& a, const Array<T>& b, Trans trans_a, Trans trans_b)
+{
+    detail::check_stack(a, false, "batch_matmul");
+    if (b.ndim() != 2 && b.ndim() != 3)
+        throw std::invalid_argument("batch_matmul requires b of shape {batch, rows, cols} or {rows, cols}");
+    size_t m = trans_a == Trans::No ? a.shape()[1] : a.shape()[2];
+    size_t n = b.shape().back();
+    if (b.ndim() >= 2 && trans_b == Trans::Yes)
+        n = b.shape()[b.ndim() - 2];
+    Array<T> out({ a.shape()[0], m, n }, Storage<T>(a.shape()[0] * m * n));
+    batch_matmul(a, b, out, trans_a, trans_b);
+    return out;
+}
+
+template <typename T>
+void batch_matmul(const Array<T>& a, const Array<T>& b, Array<T>& out, Trans trans_a, Trans trans_b)
+{
+    NUMCPP_PROFILE("batch_matmul", a.size());
+    detail::check_stack(a, false, "batch_matmul");
+    if (b.ndim() != 2 && b.ndim() != 3)
+        throw std::invalid_argument("batch_matmul requires b of shape {batch, rows, cols} or {rows, cols}");
+    const size_t batch = a.shape()[0];
+    const bool shared = b.ndim() == 2;
+    if (!shared && b.shape()[0] != batch)
+        throw std::invalid_argument("Batch sizes do not match");
+    const size_t a_rows = a.shape()[1], a_cols = a.shape()[2];
+    const size_t b_rows = b.shape()[b.ndim() - 2], b_cols = b.shape().back();
+    const size_t m = trans_a == Trans::No ? a_rows : a_cols;
+    const size_t k = trans_a == Trans::No ? a_cols : a_rows;
+    const size_t n = trans_b == Trans::No ? b_cols : b_rows;
+    if ((trans_b == Trans::No ? b_rows : b_cols) != k)
+        throw std::invalid_argument("Shapes do not align for dot product");
+    detail::check_output(out, { batch, m, n });
+
+    T* dst = detail::writable_data(out);
+    const T* src_a = a.data();
+    const T* src_b = b.data();
+    const size_t b_step = shared ? 0 : b_rows * b_cols;
+    const bool direct = m * n * k <= detail::batch_direct_flops;
+    KernelCost cost { double((m * k + k * n + m * n) * sizeof(T)), 2.0 * double(m * n * k), 0 };
+    parallel_for(0, batch, [&](size_t start, size_t end) {
+        // Square products up to 4 x 4 are fully unrolled by FixedMatrix
+        bool fixed = m == n && n == k && detail::with_fixed_size(n, [&](auto size) {
+            constexpr size_t N = decltype(size)::value;
+            FixedSquareMatrix<T, N> x, y;
+            for (size_t i = start; i < end; i++) {
+                std::copy(src_a + i * N * N, src_a + (i + 1) * N * N, x.data());
+                std::copy(src_b + i * b_step, src_b + i * b_step + N * N, y.data());
+                FixedSquareMatrix<T, N> z = (trans_a == Trans::No ? x : x.transposed())
+                                                .dot(trans_b == Trans::No ? y : y.transposed());
+                std::copy(z.data(), z.data() + N * N, dst + i * N * N);
+            }
+        });
+        if (fixed)
+            return;
+        for (size_t i = start; i < end; i++) {
+            const T* ai = src_a + i * a_rows * a_cols;
+            const T* bi = src_b + i * b_step;
+            T* ci = dst + i * m * n;
+            if (direct)
+                detail::direct_matmul(trans_a, trans_b, m, n, k, ai, bi, ci);
+            else
+                gemm(trans_a, trans_b, m, n, k, T(1), ai, a_cols, bi, b_cols, T(0), ci, n);
+        }
+    }, parallel_grain(cost));
+}
+
+template <typename T>
+Array<T> batch_transpose(const Array<T>& a)
+{
+    detail::check_stack(a, false, "batch_transpose");
+    const auto& shape = a.shape();
+    Array<T> out({ shape[0], shape[2], shape[1] }, Storage<T>(a.size()));
+    batch_transpose(a, out);
+    return out;
+}
+
+template <typename T>
+void batch_transpose(const Array<T>& a, Array<T>& out)
+{
+    NUMCPP_PROFILE("batch_transpose", a.size());
+    detail::check_stack(a, false, "batch_transpose");
+    const size_t batch = a.shape()[0], rows = a.shape()[1], cols = a.shape()[2];
+    detail::check_output(out, { batch, cols, rows });
+    T* dst = detail::writable_data(out);
+    const T* src = a.data();
+    parallel_for(0, batch, [&](size_t start, size_t end) {
+        for (size_t i = start; i < end; i++)
+            transpose(src + i * rows * cols, rows, cols, cols, dst + i * rows * cols, rows);
+    }, parallel_grain(KernelCost::stream<T>(1, 1) * double(rows * cols)));
+}
+
+template <typename T>
+Array<T> batch_determinant(const Array<T>& a)
+{
+    detail::check_stack(a, true, "batch_determinant");
+    Array<T> out({ a.shape()[0] }, Storage<T>(a.shape()[0]));
+    batch_determinant(a, out);
+    return out;
+}
+
+template <typename T>
+void batch_determinant(const Array<T>& a, Array<T>& out)
+{
+    static_assert(std::is_floating_point_v<T>, "batch_determinant requires a floating-point element type");
+    NUMCPP_PROFILE("batch_determinant", a.size());
+    detail::check_stack(a, true, "batch_determinant");
+    const size_t batch = a.shape()[0], n = a.shape()[1];
+    detail::check_output(out, { batch });
+    T* dst = detail::writable_data(out);
+    const T* src = a.data();
+    double nd = double(n);
+    KernelCost cost { nd * nd * sizeof(T), 2.0 * nd * nd * nd / 3.0, 0 };
+    parallel_for(0, batch, [&](size_t start, size_t end) {
+        bool fixed = detail::with_fixed_size(n, [&](auto size) {
+            constexpr size_t N = decltype(size)::value;
+            FixedSquareMatrix<T, N> m;
+            for (size_t i = start; i < end; i++) {
+                std::copy(src + i * N * N, src + (i + 1) * N * N, m.data());
+                dst[i] = m.determinant();
+            }
+        });
+        if (fixed)
+            return;
+        std::vector<T> scratch(n * n);
+        for (size_t i = start; i < end; i++) {
+            std::copy(src + i * n * n, src + (i + 1) * n * n, scratch.begin());
+            dst[i] = detail::eliminate<T>(scratch.data(), n, nullptr, 0, false);
+        }
+    }, parallel_grain(cost));
+}
+
+template <typename T>
+Array<T> batch_inverse(const Array<T>& a)
+{
+    detail::check_stack(a, true, "batch_inverse");
+    Array<T> out(a.shape(), Storage<T>(a.size()));
+    batch_inverse(a, out);
+    return out;
+}
+
+template <typename T>
+void batch_inverse(const Array<T>& a, Array<T>& out)
+{
+    static_assert(std::is_floating_point_v<T>, "batch_inverse requires a floating-point element type");
+    NUMCPP_PROFILE("batch_inverse", a.size());
+    detail::check_stack(a, true, "batch_inverse");
+    const size_t batch = a.shape()[0], n = a.shape()[1];
+    detail::check_output(out, a.shape());
+    T* dst = detail::writable_data(out);
+    const T* src = a.data();
+    double nd = double(n);
+    KernelCost cost { 2.0 * nd * nd * sizeof(T), 2.0 * nd * nd * nd, 0 };
+    parallel_for(0, batch, [&](size_t start, size_t end) {
+        bool fixed = detail::with_fixed_size(n, [&](auto size) {
+            constexpr size_t N = decltype(size)::value;
+            FixedSquareMatrix<T, N> m;
+            for (size_t i = start; i < end; i++) {
+                std::copy(src + i * N * N, src + (i + 1) * N * N, m.data());
+                try {
+                    m = m.inverse();
+                } catch (const std::runtime_error&) {
+                    detail::throw_singular(i);
+                }
+                std::copy(m.data(), m.data() + N * N, dst + i * N * N);
+            }
+        });
+        if (fixed)
+            return;
+        for (size_t i = start; i < end; i++) {
+            T* x = dst + i * n * n;
+            auto identity = [x, n]() {
+                std::fill(x, x + n * n, T(0));
+                for (size_t d = 0; d < n; d++)
+                    x[d * n + d] = T(1);
+            };
+            if (!detail::gauss_jordan(src + i * n * n, n, x, n, identity))
+                detail::throw_singular(i);
+        }
+    }, parallel_grain(cost));
+}
+
+template <typename T>
+Array<T> batch_solve(const Array<T>& a, const Array<T>& b)
+{
+    Array<T> out(b.shape(), Storage<T>(b.size()));
+    batch_solve(a, b, out);
+    return out;
+}
+
+template <typename T>
+void batch_solve(const Array<T>& a, const Array<T>& b, Array<T>& out)
+{
+    static_assert(std::is_floating_point_v<T>, "batch_solve requires a floating-point element type");
+    NUMCPP_PROFILE("batch_solve", a.size());
+    detail::check_stack(a, true, "batch_solve");
+    const size_t batch = a.shape()[0], n = a.shape()[1];
+    if ((b.ndim() != 2 && b.ndim() != 3) || b.shape()[0] != batch || b.shape()[1] != n)
+        throw std::invalid_argument("Right-hand side must have shape {batch, n} or {batch, n, k}");
+    const size_t k = b.ndim() == 3 ? b.shape()[2] : 1;
+    detail::check_output(out, b.shape());
+    T* dst = detail::writable_data(out);
+    const T* src = a.data();
+    const T* rhs = b.data();
+    double nd = double(n);
+    KernelCost cost { (nd * nd + 2.0 * nd * double(k)) * sizeof(T), nd * nd * nd + 2.0 * nd * nd * double(k), 0 };
+    parallel_for(0, batch, [&](size_t start, size_t end) {
+        for (size_t i = start; i < end; i++) {
+            T* x = dst + i * n * k;
+            const T* bi = rhs + i * n * k;
+            auto load = [x, bi, n, k]() {
+                if (bi != x)
+                    std::copy(bi, bi + n * k, x);
+            };
+            if (!detail::gauss_jordan(src + i * n * n, n, x, k, load))
+                detail::throw_singular(i);
+        }
+    }, parallel_grain(cost));
+}
+
+} // namespace NumCPP
+
+#endif // BATCHED_TPP
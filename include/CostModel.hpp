@@ -0,0 +1,101 @@
+#ifndef COSTMODEL_HPP
+#define COSTMODEL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+namespace NumCPP {
+
+// Work of one item of a parallel loop: bytes streamed to or from memory,
+// vectorizable arithmetic (in single SIMD-lane operations) and scalar
+// library calls such as std::pow.
+struct KernelCost {
+    double bytes = 0;
+    double ops = 0;
+    double calls = 0;
+
+    // `reads` loads and `writes` stores of one T, without arithmetic
+    template <typename T>
+    static constexpr KernelCost stream(size_t reads, size_t writes = 0)
+    {
+        return { double(sizeof(T) * (reads + writes)), 0, 0 };
+    }
+
+    constexpr KernelCost operator+(const KernelCost& other) const
+    {
+        return { bytes + other.bytes, ops + other.ops, calls + other.calls };
+    }
+    constexpr KernelCost operator*(double items) const
+    {
+        return { bytes * items, ops * items, calls * items };
+    }
+};
+
+// Chooses how every library kernel splits its range over the ThreadPool.
+//
+// An item is estimated at max(bytes, ops) time, whichever of memory or
+// arithmetic bounds it, plus its library calls. A chunk pays off once its work
+// covers the cost of a parallel dispatch, so grain() is the number of items
+// reaching dispatch_ns: ranges below it run serially (still SIMD-vectorized
+// on the caller) and larger ones on one thread per grain, up to the pool size.
+//
+// Parameters start at conservative defaults. NUMCPP_COST_MODEL=<file> loads
+// them from a file written by save(), or calibrates on first use and writes
+// that file when it does not exist yet; NUMCPP_CALIBRATE=1 calibrates on
+// first use without saving. Each parameter can then be overridden with
+// NUMCPP_COST_<NAME>, e.g. NUMCPP_COST_DISPATCH_NS=20000.
+class CostModel {
+public:
+    struct Parameters {
+        // Fork and join of a parallel call waking every thread
+        double dispatch_ns = 10000;
+        // Per byte streamed by one thread
+        double ns_per_byte = 0.1;
+        // Per SIMD-lane arithmetic operation
+        double ns_per_op = 0.1;
+        // Per scalar library call
+        double ns_per_call = 15;
+    };
+
+    static CostModel& instance();
+
+    CostModel();
+    CostModel(const CostModel&) = delete;
+    CostModel& operator=(const CostModel&) = delete;
+
+    Parameters parameters() const;
+    // Throws std::invalid_argument unless every parameter is positive
+    void set_parameters(const Parameters& params);
+
+    // Estimated time of one item
+    double item_ns(const KernelCost& cost) const;
+    // Items per ThreadPool chunk, at least 1
+    size_t grain(const KernelCost& cost) const;
+    // Threads a range of `count` items runs on
+    size_t threads(size_t count, const KernelCost& cost) const;
+
+    // Measures the parameters on this machine with the current ThreadPool
+    // and adopts them. Takes a few tens of milliseconds.
+    Parameters calibrate();
+
+    // One "name value" line per parameter. load() throws std::runtime_error
+    // when the file cannot be read or holds an unknown or invalid entry.
+    void save(const std::string& path) const;
+    void load(const std::string& path);
+
+private:
+    std::atomic<double> dispatch_ns_;
+    std::atomic<double> ns_per_byte_;
+    std::atomic<double> ns_per_op_;
+    std::atomic<double> ns_per_call_;
+};
+
+// Grain for items costing `cost` under CostModel::instance()
+size_t parallel_grain(const KernelCost& cost);
+
+} // namespace NumCPP
+
+#include "CostModel.tpp"
+
+#endif // COSTMODEL_HPP
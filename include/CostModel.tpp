@@ -0,0 +1,294 @@
+#ifndef COSTMODEL_TPP
+#define COSTMODEL_TPP
+
+#include "CostModel.hpp"
+#include "Simd.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace NumCPP {
+
+namespace detail {
+#if NUMCPP_SIMD_VECTOR_EXT
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+    // data[i] put through `Degree` multiply-adds, so Degree = 0 measures
+    // loads alone and the difference to a higher degree the arithmetic
+    template <typename T, size_t Degree>
+    struct CalibrationKernel {
+        const T* data;
+        T operator()(size_t i) const
+        {
+            T r = data[i];
+            for (size_t d = 0; d < Degree; d++)
+                r = r * data[i] + T(0.5);
+            return r;
+        }
+        template <typename P>
+        NUMCPP_ALWAYS_INLINE typename P::reg packet(size_t i) const { return horner<P>(P::load(data + i)); }
+        template <typename P>
+        NUMCPP_ALWAYS_INLINE typename P::reg packet(size_t i, size_t count) const
+        {
+            return horner<P>(P::load_partial(data + i, count, T(0)));
+        }
+        template <typename P>
+        static NUMCPP_ALWAYS_INLINE typename P::reg horner(typename P::reg x)
+        {
+            typename P::reg r = x;
+            for (size_t d = 0; d < Degree; d++)
+                r = r * x + P::broadcast(T(0.5));
+            return r;
+        }
+    };
+#if NUMCPP_SIMD_VECTOR_EXT
+#pragma GCC diagnostic pop
+#endif
+
+    inline constexpr const char* cost_parameter_names[] = { "dispatch_ns", "ns_per_byte", "ns_per_op", "ns_per_call" };
+
+    inline double& cost_parameter(CostModel::Parameters& params, size_t index)
+    {
+        double* fields[] = { &params.dispatch_ns, &params.ns_per_byte, &params.ns_per_op, &params.ns_per_call };
+        return *fields[index];
+    }
+
+    inline bool valid_cost_parameter(double value)
+    {
+        return value > 0 && std::isfinite(value);
+    }
+
+    // Nanoseconds per call of f: best (or median) of `reps` timings of
+    // `inner` back-to-back calls
+    template <typename F>
+    double time_ns(size_t reps, size_t inner, bool median, F&& f)
+    {
+        std::vector<double> samples(reps);
+        for (auto& sample : samples) {
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < inner; i++)
+                f();
+            sample = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count()
+                / double(inner);
+        }
+        std::sort(samples.begin(), samples.end());
+        return median ? samples[reps / 2] : samples.front();
+    }
+
+    // Busy-waits for `ns` nanoseconds
+    inline void spin_ns(double ns)
+    {
+        auto until = std::chrono::steady_clock::now() + std::chrono::duration<double, std::nano>(ns);
+        while (std::chrono::steady_clock::now() < until) {
+        }
+    }
+
+    // Applies NUMCPP_COST_<NAME> overrides, ignoring malformed values
+    inline void apply_cost_overrides(CostModel::Parameters& params)
+    {
+        for (size_t k = 0; k < std::size(cost_parameter_names); k++) {
+            std::string name = cost_parameter_names[k];
+            std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return char(std::toupper(c)); });
+            const char* env = std::getenv(("NUMCPP_COST_" + name).c_str());
+            if (!env)
+                continue;
+            try {
+                double value = std::stod(env);
+                if (valid_cost_parameter(value))
+                    cost_parameter(params, k) = value;
+            } catch (const std::exception&) {
+            }
+        }
+    }
+}
+
+inline CostModel& CostModel::instance()
+{
+    static CostModel model;
+    return model;
+}
+
+inline CostModel::CostModel()
+{
+    Parameters defaults;
+    set_parameters(defaults);
+    if (const char* path = std::getenv("NUMCPP_COST_MODEL")) {
+        if (std::ifstream(path)) {
+            try {
+                load(path);
+            } catch (const std::exception&) {
+                // Keep the defaults rather than failing every kernel
+            }
+        } else {
+            calibrate();
+            try {
+                save(path);
+            } catch (const std::exception&) {
+            }
+        }
+    } else if (const char* env = std::getenv("NUMCPP_CALIBRATE"); env && std::string(env) != "0") {
+        calibrate();
+    }
+    Parameters params = parameters();
+    detail::apply_cost_overrides(params);
+    set_parameters(params);
+}
+
+inline CostModel::Parameters CostModel::parameters() const
+{
+    Parameters params;
+    params.dispatch_ns = dispatch_ns_.load(std::memory_order_relaxed);
+    params.ns_per_byte = ns_per_byte_.load(std::memory_order_relaxed);
+    params.ns_per_op = ns_per_op_.load(std::memory_order_relaxed);
+    params.ns_per_call = ns_per_call_.load(std::memory_order_relaxed);
+    return params;
+}
+
+inline void CostModel::set_parameters(const Parameters& params)
+{
+    if (!detail::valid_cost_parameter(params.dispatch_ns) || !detail::valid_cost_parameter(params.ns_per_byte)
+        || !detail::valid_cost_parameter(params.ns_per_op) || !detail::valid_cost_parameter(params.ns_per_call))
+        throw std::invalid_argument("Cost model parameters must be positive");
+    dispatch_ns_.store(params.dispatch_ns, std::memory_order_relaxed);
+    ns_per_byte_.store(params.ns_per_byte, std::memory_order_relaxed);
+    ns_per_op_.store(params.ns_per_op, std::memory_order_relaxed);
+    ns_per_call_.store(params.ns_per_call, std::memory_order_relaxed);
+}
+
+inline double CostModel::item_ns(const KernelCost& cost) const
+{
+    double memory = cost.bytes * ns_per_byte_.load(std::memory_order_relaxed);
+    double compute = cost.ops * ns_per_op_.load(std::memory_order_relaxed);
+    return std::max(memory, compute) + cost.calls * ns_per_call_.load(std::memory_order_relaxed);
+}
+
+inline size_t CostModel::grain(const KernelCost& cost) const
+{
+    constexpr size_t max_grain = std::numeric_limits<size_t>::max() / 2;
+    double item = item_ns(cost);
+    double items = dispatch_ns_.load(std::memory_order_relaxed) / item;
+    if (!(item > 0) || !(items < double(max_grain)))
+        return max_grain;
+    return std::max<size_t>(1, size_t(std::ceil(items)));
+}
+
+inline size_t CostModel::threads(size_t count, const KernelCost& cost) const
+{
+    const ThreadPool& pool = ThreadPool::instance();
+    return std::min(pool.num_threads(), std::max<size_t>(1, pool.chunk_count(count, grain(cost))));
+}
+
+inline CostModel::Parameters CostModel::calibrate()
+{
+    Parameters params = parameters();
+    volatile double sink = 0;
+
+    // Streaming: one thread summing a buffer larger than the private caches
+    {
+        const size_t n = size_t(1) << 21;
+        std::vector<double> data(n, 1.0);
+        detail::CalibrationKernel<double, 0> loads { data.data() };
+        double ns = detail::time_ns(5, 1, false, [&] { sink = sink + simd::reduce<simd::Sum, double>(loads, 0, n); });
+        params.ns_per_byte = std::max(ns / double(n * sizeof(double)), 1e-4);
+    }
+
+    // Arithmetic: a 16-operation polynomial over an L1-resident buffer, less
+    // the same loads alone
+    {
+        const size_t n = 2048;
+        std::vector<double> data(n, 0.25);
+        detail::CalibrationKernel<double, 0> loads { data.data() };
+        detail::CalibrationKernel<double, 8> poly { data.data() };
+        double base = detail::time_ns(9, 16, false, [&] { sink = sink + simd::reduce<simd::Sum, double>(loads, 0, n); });
+        double busy = detail::time_ns(9, 16, false, [&] { sink = sink + simd::reduce<simd::Sum, double>(poly, 0, n); });
+        params.ns_per_op = std::max((busy - base) / double(16 * n), 1e-4);
+    }
+
+    // Scalar library calls
+    {
+        const size_t n = 1024;
+        std::vector<double> data(n);
+        for (size_t i = 0; i < n; i++)
+            data[i] = 1.0 + double(i) / double(n);
+        double ns = detail::time_ns(9, 1, false, [&] {
+            double acc = 0;
+            for (size_t i = 0; i < n; i++)
+                acc += std::pow(data[i], 1.37);
+            sink = sink + acc;
+        });
+        params.ns_per_call = std::max(ns / double(n), 1e-3);
+    }
+
+    // Dispatch: a parallel call whose chunks each take a fixed time, less
+    // that time
+    ThreadPool& pool = ThreadPool::instance();
+    size_t threads = pool.num_threads();
+    if (threads > 1 && !pool.is_inline()) {
+        const double work_ns = 2000;
+        auto call = [&] { pool.parallel_chunks(threads, [&](size_t) { detail::spin_ns(work_ns); }); };
+        detail::time_ns(5, 1, false, call);
+        params.dispatch_ns = std::max(detail::time_ns(51, 1, true, call) - work_ns, 100.0);
+    }
+
+    set_parameters(params);
+    return params;
+}
+
+inline void CostModel::save(const std::string& path) const
+{
+    std::ofstream file(path);
+    if (!file)
+        throw std::runtime_error("Cannot write cost model to " + path);
+    Parameters params = parameters();
+    file.precision(17);
+    for (size_t k = 0; k < std::size(detail::cost_parameter_names); k++)
+        file << detail::cost_parameter_names[k] << ' ' << detail::cost_parameter(params, k) << '\n';
+    if (!file)
+        throw std::runtime_error("Cannot write cost model to " + path);
+}
+
+inline void CostModel::load(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file)
+        throw std::runtime_error("Cannot read cost model from " + path);
+    Parameters params = parameters();
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string name;
+        double value = 0;
+        if (!(fields >> name) || name[0] == '#')
+            continue;
+        auto names = std::begin(detail::cost_parameter_names);
+        auto found = std::find_if(names, std::end(detail::cost_parameter_names),
+            [&](const char* known) { return name == known; });
+        if (found == std::end(detail::cost_parameter_names))
+            throw std::runtime_error("Unknown cost model parameter: " + name);
+        if (!(fields >> value) || !detail::valid_cost_parameter(value))
+            throw std::runtime_error("Invalid value for cost model parameter " + name);
+        detail::cost_parameter(params, size_t(found - names)) = value;
+    }
+    set_parameters(params);
+}
+
+inline size_t parallel_grain(const KernelCost& cost)
+{
+    return CostModel::instance().grain(cost);
+}
+
+} // namespace NumCPP
+
+#endif // COSTMODEL_TPP
@@ -0,0 +1,90 @@
+#ifndef DECOMPOSITION_HPP
+#define DECOMPOSITION_HPP
+
+#include "Array.hpp"
+#include "Gemm.hpp"
+#include "Matrix.hpp"
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace NumCPP {
+
+namespace detail {
+    // Panel width of the blocked factorizations; trailing updates are gemm
+    // calls of this depth
+    inline constexpr size_t factor_block = 64;
+}
+
+// LU factorization with partial pivoting, P * A = L * U, of an n x n matrix.
+//
+// Computed once with a blocked right-looking algorithm: each 64-column panel
+// is factored in place, the block row of U is solved, and the trailing matrix
+// is updated with a (threaded, SIMD) gemm call. The factorization can then
+// serve any number of solves.
+template <typename T>
+class LU {
+    static_assert(std::is_floating_point_v<T>, "LU requires a floating-point element type");
+
+public:
+    explicit LU(Array<T> a);
+    explicit LU(const Matrix<T>& m);
+
+    size_t size() const { return n_; }
+    // True if some pivot was exactly zero; solve() and inverse() then throw
+    bool is_singular() const { return singular_; }
+
+    // Solve A * X = B for B of shape {n} or {n, k}; X has B's shape
+    Array<T> solve(const Array<T>& b) const;
+    T determinant() const;
+    Array<T> inverse() const;
+
+    // Packed factors: unit-diagonal L below the diagonal, U on and above it
+    const Array<T>& factors() const { return lu_; }
+    // Row i of P * A is row permutation()[i] of A
+    const std::vector<size_t>& permutation() const { return perm_; }
+
+private:
+    size_t n_ = 0;
+    Array<T> lu_;
+    std::vector<size_t> perm_;
+    bool odd_swaps_ = false;
+    bool singular_ = false;
+
+    void factor();
+};
+
+// Cholesky factorization A = L * L^T of a symmetric positive definite n x n
+// matrix; only the lower triangle of A is read. Blocked like LU, with the
+// trailing update restricted to the lower triangle. Throws
+// std::runtime_error if A is not positive definite.
+template <typename T>
+class Cholesky {
+    static_assert(std::is_floating_point_v<T>, "Cholesky requires a floating-point element type");
+
+public:
+    explicit Cholesky(Array<T> a);
+    explicit Cholesky(const Matrix<T>& m);
+
+    size_t size() const { return n_; }
+
+    // Solve A * X = B for B of shape {n} or {n, k}; X has B's shape
+    Array<T> solve(const Array<T>& b) const;
+    T determinant() const;
+    Array<T> inverse() const;
+
+    // The lower-triangular factor L (zeros above the diagonal)
+    const Array<T>& factor() const { return l_; }
+
+private:
+    size_t n_ = 0;
+    Array<T> l_;
+
+    void factorize();
+};
+
+} // namespace NumCPP
+
+#include "Decomposition.tpp"
+
+#endif // DECOMPOSITION_HPP
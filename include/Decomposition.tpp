@@ -0,0 +1,359 @@
+#ifndef DECOMPOSITION_TPP
+#define DECOMPOSITION_TPP
+
+#include "CostModel.hpp"
+#include "Decomposition.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace NumCPP {
+
+namespace detail {
+    template <typename T>
+    size_t square_order(const Array<T>& a)
+    {
+        std::vector<size_t> shape = a.shape();
+        if (shape.size() != 2 || shape[0] != shape[1])
+            throw std::invalid_argument("Factorization requires a square 2D array");
+        return shape[0];
+    }
+
+    // Number of right-hand sides in b: 1 for shape {n}, k for {n, k}
+    template <typename T>
+    size_t rhs_columns(const Array<T>& b, size_t n)
+    {
+        std::vector<size_t> shape = b.shape();
+        if (shape.empty() || shape.size() > 2 || shape[0] != n)
+            throw std::invalid_argument("Right-hand side must have shape {n} or {n, k}");
+        return shape.size() == 2 ? shape[1] : 1;
+    }
+
+    // Right-hand sides per task: each costs about n^2 flops
+    inline size_t solve_grain(size_t n)
+    {
+        return parallel_grain(KernelCost { 0, double(n) * double(n), 0 });
+    }
+
+    // Items per ThreadPool task in the factorizations, each costing about
+    // work_per_item flops
+    inline size_t factor_grain(size_t work_per_item)
+    {
+        return parallel_grain(KernelCost { 0, double(work_per_item), 0 });
+    }
+
+    // Columns [c0, c1) of the n x k matrix x become L^{-1} x, where L is the
+    // lower triangle of the n x n matrix l (unit diagonal if `unit`).
+    template <typename T>
+    void lower_solve(size_t n, const T* l, bool unit, T* x, size_t k, size_t c0, size_t c1)
+    {
+        for (size_t i = 0; i < n; ++i) {
+            T* xi = x + i * k;
+            const T* li = l + i * n;
+            if (k == 1) {
+                T sum = xi[0];
+                for (size_t j = 0; j < i; ++j)
+                    sum -= li[j] * x[j];
+                xi[0] = unit ? sum : sum / li[i];
+                continue;
+            }
+            for (size_t j = 0; j < i; ++j) {
+                T lij = li[j];
+                const T* xj = x + j * k;
+                for (size_t c = c0; c < c1; ++c)
+                    xi[c] -= lij * xj[c];
+            }
+            if (!unit) {
+                for (size_t c = c0; c < c1; ++c)
+                    xi[c] /= li[i];
+            }
+        }
+    }
+
+    // Columns [c0, c1) of x become U^{-1} x for the upper triangle U of u
+    template <typename T>
+    void upper_solve(size_t n, const T* u, T* x, size_t k, size_t c0, size_t c1)
+    {
+        for (size_t i = n; i-- > 0;) {
+            T* xi = x + i * k;
+            const T* ui = u + i * n;
+            if (k == 1) {
+                T sum = xi[0];
+                for (size_t j = i + 1; j < n; ++j)
+                    sum -= ui[j] * x[j];
+                xi[0] = sum / ui[i];
+                continue;
+            }
+            for (size_t j = i + 1; j < n; ++j) {
+                T uij = ui[j];
+                const T* xj = x + j * k;
+                for (size_t c = c0; c < c1; ++c)
+                    xi[c] -= uij * xj[c];
+            }
+            for (size_t c = c0; c < c1; ++c)
+                xi[c] /= ui[i];
+        }
+    }
+
+    // Columns [c0, c1) of x become L^{-T} x for the lower triangle L of l.
+    // Row i of L is column i of L^T, so each finished row is pushed into
+    // the rows above it.
+    template <typename T>
+    void lower_transposed_solve(size_t n, const T* l, T* x, size_t k, size_t c0, size_t c1)
+    {
+        for (size_t i = n; i-- > 0;) {
+            T* xi = x + i * k;
+            const T* li = l + i * n;
+            for (size_t c = c0; c < c1; ++c)
+                xi[c] /= li[i];
+            for (size_t j = 0; j < i; ++j) {
+                T lij = li[j];
+                T* xj = x + j * k;
+                for (size_t c = c0; c < c1; ++c)
+                    xj[c] -= lij * xi[c];
+            }
+        }
+    }
+
+    // Copy b (rows reordered by perm, if given) and run body(x, k, c0, c1)
+    // over column ranges of the copy in parallel
+    template <typename T, typename Body>
+    Array<T> solve_columns(const Array<T>& b, size_t n, const std::vector<size_t>* perm, Body&& body)
+    {
+        size_t k = rhs_columns(b, n);
+        Array<T> x(b.shape());
+        const T* src = b.data();
+        T* dst = detail::writable_data(x);
+        for (size_t i = 0; i < n; ++i) {
+            const T* row = src + (perm ? (*perm)[i] : i) * k;
+            std::copy(row, row + k, dst + i * k);
+        }
+        parallel_for(0, k, [&](size_t c0, size_t c1) { body(dst, k, c0, c1); }, solve_grain(n));
+        return x;
+    }
+
+    template <typename T>
+    Array<T> identity(size_t n)
+    {
+        Array<T> eye({ n, n }, T(0));
+        T* data = detail::writable_data(eye);
+        for (size_t i = 0; i < n; ++i)
+            data[i * n + i] = T(1);
+        return eye;
+    }
+}
+
+template <typename T>
+LU<T>::LU(Array<T> a)
+    : n_(detail::square_order(a))
+    , lu_(std::move(a))
+{
+    factor();
+}
+
+template <typename T>
+LU<T>::LU(const Matrix<T>& m)
+    : LU(m.flatten().reshape(m.shape()))
+{
+}
+
+template <typename T>
+void LU<T>::factor()
+{
+    NUMCPP_PROFILE("LU::factor", n_ * n_);
+    const size_t n = n_;
+    perm_.resize(n);
+    std::iota(perm_.begin(), perm_.end(), size_t(0));
+    if (n == 0)
+        return;
+    T* a = detail::writable_data(lu_);
+
+    for (size_t k0 = 0; k0 < n; k0 += detail::factor_block) {
+        size_t k1 = std::min(k0 + detail::factor_block, n);
+
+        // Unblocked factorization of the panel a[k0:n, k0:k1]
+        for (size_t j = k0; j < k1; ++j) {
+            size_t p = j;
+            for (size_t i = j + 1; i < n; ++i) {
+                if (std::abs(a[i * n + j]) > std::abs(a[p * n + j]))
+                    p = i;
+            }
+            if (a[p * n + j] == T(0)) {
+                singular_ = true;
+                continue;
+            }
+            if (p != j) {
+                std::swap_ranges(a + j * n, a + j * n + n, a + p * n);
+                std::swap(perm_[j], perm_[p]);
+                odd_swaps_ = !odd_swaps_;
+            }
+            const T* pivot_row = a + j * n;
+            T pivot = pivot_row[j];
+            parallel_for(j + 1, n, [&](size_t start, size_t stop) {
+                for (size_t i = start; i < stop; ++i) {
+                    T* row = a + i * n;
+                    T l = row[j] /= pivot;
+                    for (size_t c = j + 1; c < k1; ++c)
+                        row[c] -= l * pivot_row[c];
+                }
+            }, detail::factor_grain(k1 - j));
+        }
+        if (k1 == n)
+            break;
+
+        // U12 = L11^{-1} A12
+        parallel_for(k1, n, [&](size_t c0, size_t c1) {
+            for (size_t r = k0; r < k1; ++r) {
+                const T* ur = a + r * n;
+                for (size_t i = r + 1; i < k1; ++i) {
+                    T* row = a + i * n;
+                    T l = row[r];
+                    for (size_t c = c0; c < c1; ++c)
+                        row[c] -= l * ur[c];
+                }
+            }
+        }, detail::factor_grain((k1 - k0) * (k1 - k0)));
+
+        // A22 -= L21 * U12
+        gemm(Trans::No, Trans::No, n - k1, n - k1, k1 - k0, T(-1), a + k1 * n + k0, n,
+            a + k0 * n + k1, n, T(1), a + k1 * n + k1, n);
+    }
+}
+
+template <typename T>
+Array<T> LU<T>::solve(const Array<T>& b) const
+{
+    NUMCPP_PROFILE("LU::solve", b.size());
+    if (singular_)
+        throw std::runtime_error("Matrix is singular");
+    const T* a = lu_.data();
+    return detail::solve_columns(b, n_, &perm_, [&](T* x, size_t k, size_t c0, size_t c1) {
+        detail::lower_solve(n_, a, true, x, k, c0, c1);
+        detail::upper_solve(n_, a, x, k, c0, c1);
+    });
+}
+
+template <typename T>
+T LU<T>::determinant() const
+{
+    if (singular_)
+        return T(0);
+    const T* a = lu_.data();
+    T det = odd_swaps_ ? T(-1) : T(1);
+    for (size_t i = 0; i < n_; ++i)
+        det *= a[i * n_ + i];
+    return det;
+}
+
+template <typename T>
+Array<T> LU<T>::inverse() const
+{
+    return solve(detail::identity<T>(n_));
+}
+
+template <typename T>
+Cholesky<T>::Cholesky(Array<T> a)
+    : n_(detail::square_order(a))
+    , l_(std::move(a))
+{
+    factorize();
+}
+
+template <typename T>
+Cholesky<T>::Cholesky(const Matrix<T>& m)
+    : Cholesky(m.flatten().reshape(m.shape()))
+{
+}
+
+template <typename T>
+void Cholesky<T>::factorize()
+{
+    NUMCPP_PROFILE("Cholesky::factor", n_ * n_);
+    const size_t n = n_;
+    if (n == 0)
+        return;
+    T* a = detail::writable_data(l_);
+
+    for (size_t k0 = 0; k0 < n; k0 += detail::factor_block) {
+        size_t k1 = std::min(k0 + detail::factor_block, n);
+
+        // Diagonal block, left-looking within the block
+        for (size_t j = k0; j < k1; ++j) {
+            T* rj = a + j * n;
+            T d = rj[j];
+            for (size_t c = k0; c < j; ++c)
+                d -= rj[c] * rj[c];
+            if (!(d > T(0)))
+                throw std::runtime_error("Matrix is not positive definite");
+            rj[j] = std::sqrt(d);
+            for (size_t i = j + 1; i < k1; ++i) {
+                T* ri = a + i * n;
+                T s = ri[j];
+                for (size_t c = k0; c < j; ++c)
+                    s -= ri[c] * rj[c];
+                ri[j] = s / rj[j];
+            }
+        }
+        if (k1 == n)
+            break;
+
+        // L21 = A21 * L11^{-T}, one row at a time
+        parallel_for(k1, n, [&](size_t start, size_t stop) {
+            for (size_t i = start; i < stop; ++i) {
+                T* ri = a + i * n;
+                for (size_t j = k0; j < k1; ++j) {
+                    const T* rj = a + j * n;
+                    T s = ri[j];
+                    for (size_t c = k0; c < j; ++c)
+                        s -= ri[c] * rj[c];
+                    ri[j] = s / rj[j];
+                }
+            }
+        }, detail::factor_grain((k1 - k0) * (k1 - k0)));
+
+        // A22 -= L21 * L21^T, block column by block column of the lower
+        // triangle (the diagonal blocks' upper parts are cleared below)
+        for (size_t j0 = k1; j0 < n; j0 += detail::factor_block) {
+            size_t w = std::min(detail::factor_block, n - j0);
+            gemm(Trans::No, Trans::Yes, n - j0, w, k1 - k0, T(-1), a + j0 * n + k0, n,
+                a + j0 * n + k0, n, T(1), a + j0 * n + j0, n);
+        }
+    }
+
+    for (size_t i = 0; i < n; ++i)
+        std::fill(a + i * n + i + 1, a + i * n + n, T(0));
+}
+
+template <typename T>
+Array<T> Cholesky<T>::solve(const Array<T>& b) const
+{
+    NUMCPP_PROFILE("Cholesky::solve", b.size());
+    const T* l = l_.data();
+    return detail::solve_columns(b, n_, nullptr, [&](T* x, size_t k, size_t c0, size_t c1) {
+        detail::lower_solve(n_, l, false, x, k, c0, c1);
+        detail::lower_transposed_solve(n_, l, x, k, c0, c1);
+    });
+}
+
+template <typename T>
+T Cholesky<T>::determinant() const
+{
+    const T* l = l_.data();
+    T det = T(1);
+    for (size_t i = 0; i < n_; ++i)
+        det *= l[i * n_ + i] * l[i * n_ + i];
+    return det;
+}
+
+template <typename T>
+Array<T> Cholesky<T>::inverse() const
+{
+    return solve(detail::identity<T>(n_));
+}
+
+} // namespace NumCPP
+
+#endif // DECOMPOSITION_TPP
@@ -0,0 +1,671 @@
+#ifndef EXPRESSION_HPP
+#define EXPRESSION_HPP
+
+#include "CostModel.hpp"
+#include "Simd.hpp"
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace NumCPP {
+
+template <typename T>
+class Array;
+
+namespace detail {
+    // Common tag for every array expression (Array itself and lazy nodes)
+    struct ExprTag { };
+
+    // Array::data() for library kernels that write an array and keep no
+    // pointer past the call: unshares the buffer without leaking it
+    template <typename T>
+    T* writable_data(Array<T>& arr);
+}
+
+// An operand of the lazy element-wise operators.
+template <typename E>
+concept Expression = std::is_base_of_v<detail::ExprTag, std::remove_cvref_t<E>>;
+
+// An Array (or a class derived from one), as opposed to a lazy node.
+template <typename E>
+concept ArrayLike = Expression<E>
+    && std::is_base_of_v<Array<typename std::remove_cvref_t<E>::value_type>, std::remove_cvref_t<E>>;
+
+template <typename E>
+using expr_value_t = typename std::remove_cvref_t<E>::value_type;
+
+// How a node stores an operand: lvalue arrays by reference, everything else
+// (nodes and expiring arrays) by value so the node never dangles.
+template <typename E>
+using operand_t = std::conditional_t<ArrayLike<E> && std::is_lvalue_reference_v<E>,
+    const std::remove_cvref_t<E>&, std::remove_cvref_t<E>>;
+
+// CRTP base of all array expressions. Nodes are evaluated in a single fused
+// pass when assigned to an Array or reduced.
+template <typename Derived, typename T>
+class ArrayExpr : public detail::ExprTag {
+public:
+    using value_type = T;
+
+    const Derived& derived() const { return static_cast<const Derived&>(*this); }
+
+    size_t ndim() const;
+    size_t size() const;
+
+    // Materialize the expression into a new Array
+    Array<T> eval() const;
+
+    // Fused reductions (no temporary array is created)
+    T sum() const;
+    T mean() const;
+    T min() const;
+    T max() const;
+
+    // Evaluate a single element. One index is a flat index, otherwise the
+    // number of indices must match ndim().
+    template <typename... Indices>
+    T operator()(Indices... indices) const;
+};
+
+namespace detail {
+#if NUMCPP_SIMD_VECTOR_EXT
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+    // Evaluation kernels: trivially copyable functors mapping a flat index to
+    // a value. They are built from the expression tree right before the loop
+    // so the compiler sees plain pointer arithmetic it can vectorize.
+    // packet<P>(i) evaluates a whole SIMD register starting at i, and
+    // packet<P>(i, count) only its first `count` lanes (see Simd.hpp).
+    template <typename T>
+    struct PointerKernel {
+        const T* data;
+        T operator()(size_t i) const { return data[i]; }
+        template <typename P>
+        NUMCPP_ALWAYS_INLINE typename P::reg packet(size_t i) const { return P::load(data + i); }
+        template <typename P>
+        NUMCPP_ALWAYS_INLINE typename P::reg packet(size_t i, size_t count) const { return P::load_partial(data + i, count, T(1)); }
+    };
+
+    // Element i of a strided view in row-major order. shape/strides point
+    // into the view, which outlives the evaluation. Contiguous views read
+    // the buffer directly; others gather lane by lane.
+    template <typename T>
+    struct StridedKernel {
+        const T* data;
+        const size_t* shape;
+        const size_t* strides;
+        size_t ndim;
+        bool contiguous;
+
+        size_t offset(size_t i) const
+        {
+            size_t off = 0;
+            for (size_t d = ndim; d-- > 0;) {
+                off += (i % shape[d]) * strides[d];
+                i /= shape[d];
+            }
+            return off;
+        }
+        T operator()(size_t i) const { return contiguous ? data[i] : data[offset(i)]; }
+        template <typename P>
+        NUMCPP_ALWAYS_INLINE typename P::reg packet(size_t i) const
+        {
+            if (contiguous)
+                return P::load(data + i);
+            T lanes[P::width];
+            for (size_t k = 0; k < P::width; k++)
+                lanes[k] = data[offset(i + k)];
+            return P::load(lanes);
+        }
+        template <typename P>
+        NUMCPP_ALWAYS_INLINE typename P::reg packet(size_t i, size_t count) const
+        {
+            if (contiguous)
+                return P::load_partial(data + i, count, T(1));
+            T lanes[P::width];
+            for (size_t k = 0; k < count; k++)
+                lanes[k] = data[offset(i + k)];
+            return P::load_partial(lanes, count, T(1));
+        }
+    };
+
+    template <typename T>
+    struct ScalarKernel {
+        T value;
+        T operator()(size_t) const { return value; }
+        template <typename P>
+        NUMCPP_ALWAYS_INLINE typename P::reg packet(size_t) const { return P::broadcast(value); }
+        template <typename P>
+        NUMCPP_ALWAYS_INLINE typename P::reg packet(size_t, size_t) const { return P::broadcast(value); }
+    };
+
+    // How an operand is read at each flat index of a broadcast result:
+    // Same   - shapes match (up to leading 1s), index i
+    // Row    - operand matches the trailing axes, index i % extent
+    // Column - operand has a last axis of 1, index i / extent
+    // General- anything else, through per-axis strides (0 on broadcast axes)
+    enum class BroadcastMode {
+        Same,
+        Row,
+        Column,
+        General
+    };
+
+    struct BroadcastInfo {
+        BroadcastMode mode = BroadcastMode::Same;
+        size_t extent = 1;
+        std::vector<size_t> shape;
+        std::vector<size_t> strides;
+    };
+
+    // NumPy broadcasting: shapes are right-aligned and each pair of axes must
+    // match or contain a 1. Throws std::runtime_error naming `what`.
+    std::vector<size_t> broadcast_shapes(const std::vector<size_t>& a, const std::vector<size_t>& b,
+        const char* what);
+    // Which operand's shape the broadcast of `a` and `b` equals, so nodes
+    // need not store a copy; Own when it is neither. Throws like
+    // broadcast_shapes.
+    enum class ShapeSource {
+        Lhs,
+        Rhs,
+        Own
+    };
+    ShapeSource broadcast_source(const std::vector<size_t>& a, const std::vector<size_t>& b, const char* what);
+    // How an operand of shape `from` is read inside a result of shape `to`
+    BroadcastInfo broadcast_info(const std::vector<size_t>& from, const std::vector<size_t>& to,
+        const char* what);
+    size_t shape_size(const std::vector<size_t>& shape);
+
+    // Reads `inner` at the operand index of each result index. Row and column
+    // broadcasts load whole registers whenever a packet stays within one row.
+    template <typename K>
+    struct BroadcastKernel {
+        K inner;
+        BroadcastMode mode;
+        size_t extent;
+        const size_t* shape;
+        const size_t* strides;
+        size_t ndim;
+
+        size_t index(size_t i) const
+        {
+            switch (mode) {
+            case BroadcastMode::Same:
+                return i;
+            case BroadcastMode::Row:
+                return i % extent;
+            case BroadcastMode::Column:
+                return i / extent;
+            default: {
+                size_t off = 0;
+                for (size_t d = ndim; d-- > 0;) {
+                    off += (i % shape[d]) * strides[d];
+                    i /= shape[d];
+                }
+                return off;
+            }
+            }
+        }
+        auto operator()(size_t i) const { return inner(index(i)); }
+
+        template <typename P>
+        NUMCPP_ALWAYS_INLINE typename P::reg gather(size_t i, size_t count) const
+        {
+            typename P::value_type lanes[P::width];
+            for (size_t k = 0; k < count; k++)
+                lanes[k] = inner(index(i + k));
+            return P::load_partial(lanes, count, typename P::value_type(1));
+        }
+        template <typename P, typename I = K>
+        NUMCPP_ALWAYS_INLINE auto packet(size_t i) const -> decltype(std::declval<const I&>().template packet<P>(i))
+        {
+            if (mode == BroadcastMode::Same)
+                return inner.template packet<P>(i);
+            if (mode == BroadcastMode::Row && i % extent + P::width <= extent)
+                return inner.template packet<P>(i % extent);
+            if (mode == BroadcastMode::Column && i % extent + P::width <= extent)
+                return P::broadcast(inner(i / extent));
+            return gather<P>(i, P::width);
+        }
+        template <typename P, typename I = K>
+        NUMCPP_ALWAYS_INLINE auto packet(size_t i, size_t count) const
+            -> decltype(std::declval<const I&>().template packet<P>(i, count))
+        {
+            if (mode == BroadcastMode::Same)
+                return inner.template packet<P>(i, count);
+            if (mode == BroadcastMode::Row && i % extent + count <= extent)
+                return inner.template packet<P>(i % extent, count);
+            if (mode == BroadcastMode::Column && i % extent + count <= extent)
+                return P::broadcast(inner(i / extent));
+            return gather<P>(i, count);
+        }
+    };
+
+    template <typename K>
+    BroadcastKernel<K> broadcast_kernel(const K& kernel, const BroadcastInfo& info)
+    {
+        return { kernel, info.mode, info.extent, info.shape.data(), info.strides.data(), info.shape.size() };
+    }
+
+    // Op is re-bound as a default argument O so that a missing packet()
+    // removes the overload instead of failing the class instantiation.
+    template <typename Op, typename L, typename R>
+    struct BinaryKernel {
+        L lhs;
+        R rhs;
+        auto operator()(size_t i) const { return Op::apply(lhs(i), rhs(i)); }
+        template <typename P, typename O = Op>
+        NUMCPP_ALWAYS_INLINE auto packet(size_t i) const
+            -> decltype(O::template packet<P>(lhs.template packet<P>(i), rhs.template packet<P>(i)))
+        {
+            return O::template packet<P>(lhs.template packet<P>(i), rhs.template packet<P>(i));
+        }
+        template <typename P, typename O = Op>
+        NUMCPP_ALWAYS_INLINE auto packet(size_t i, size_t count) const
+            -> decltype(O::template packet<P>(lhs.template packet<P>(i, count), rhs.template packet<P>(i, count)))
+        {
+            return O::template packet<P>(lhs.template packet<P>(i, count), rhs.template packet<P>(i, count));
+        }
+    };
+
+    template <typename Op, typename K>
+    struct UnaryKernel {
+        K operand;
+        auto operator()(size_t i) const { return Op::apply(operand(i)); }
+        template <typename P, typename O = Op>
+        NUMCPP_ALWAYS_INLINE auto packet(size_t i) const
+            -> decltype(O::template packet<P>(operand.template packet<P>(i)))
+        {
+            return O::template packet<P>(operand.template packet<P>(i));
+        }
+        template <typename P, typename O = Op>
+        NUMCPP_ALWAYS_INLINE auto packet(size_t i, size_t count) const
+            -> decltype(O::template packet<P>(operand.template packet<P>(i, count)))
+        {
+            return O::template packet<P>(operand.template packet<P>(i, count));
+        }
+    };
+
+    // Element-wise operations. packet() is the SIMD form; operations without
+    // one are evaluated with the scalar loop.
+#define NUMCPP_PACKET_OP(EXPR)                                                              \
+    template <typename P>                                                                   \
+    static NUMCPP_ALWAYS_INLINE typename P::reg packet(typename P::reg a, typename P::reg b) \
+    {                                                                                       \
+        return EXPR;                                                                        \
+    }
+#define NUMCPP_PACKET_UNARY_OP(EXPR)                                      \
+    template <typename P>                                                 \
+    static NUMCPP_ALWAYS_INLINE typename P::reg packet(typename P::reg a) \
+    {                                                                     \
+        return EXPR;                                                      \
+    }
+
+    struct Add {
+        static constexpr const char* name = "addition";
+        template <typename T>
+        static T apply(const T& a, const T& b) { return a + b; }
+        NUMCPP_PACKET_OP(a + b)
+    };
+    struct Subtract {
+        static constexpr const char* name = "subtraction";
+        template <typename T>
+        static T apply(const T& a, const T& b) { return a - b; }
+        NUMCPP_PACKET_OP(a - b)
+    };
+    struct Multiply {
+        static constexpr const char* name = "multiplication";
+        template <typename T>
+        static T apply(const T& a, const T& b) { return a * b; }
+        NUMCPP_PACKET_OP(a * b)
+    };
+    struct Divide {
+        static constexpr const char* name = "division";
+        static constexpr KernelCost cost { 0, 4, 0 };
+        template <typename T>
+        static T apply(const T& a, const T& b) { return a / b; }
+        NUMCPP_PACKET_OP(a / b)
+    };
+    struct BitAnd {
+        static constexpr const char* name = "bitwise AND";
+        template <typename T>
+        static T apply(const T& a, const T& b) { return a & b; }
+        NUMCPP_PACKET_OP(a & b)
+    };
+    struct BitOr {
+        static constexpr const char* name = "bitwise OR";
+        template <typename T>
+        static T apply(const T& a, const T& b) { return a | b; }
+        NUMCPP_PACKET_OP(a | b)
+    };
+    struct BitXor {
+        static constexpr const char* name = "bitwise XOR";
+        template <typename T>
+        static T apply(const T& a, const T& b) { return a ^ b; }
+        NUMCPP_PACKET_OP(a ^ b)
+    };
+    struct Equal {
+        static constexpr const char* name = "equality comparison";
+        template <typename T>
+        static T apply(const T& a, const T& b) { return T(a == b); }
+        NUMCPP_PACKET_OP(P::from_mask(a == b))
+    };
+    struct NotEqual {
+        static constexpr const char* name = "inequality comparison";
+        template <typename T>
+        static T apply(const T& a, const T& b) { return T(a != b); }
+        NUMCPP_PACKET_OP(P::from_mask(a != b))
+    };
+    struct Less {
+        static constexpr const char* name = "less-than comparison";
+        template <typename T>
+        static T apply(const T& a, const T& b) { return T(a < b); }
+        NUMCPP_PACKET_OP(P::from_mask(a < b))
+    };
+    struct LessEqual {
+        static constexpr const char* name = "less-than-or-equal comparison";
+        template <typename T>
+        static T apply(const T& a, const T& b) { return T(a <= b); }
+        NUMCPP_PACKET_OP(P::from_mask(a <= b))
+    };
+    struct Greater {
+        static constexpr const char* name = "greater-than comparison";
+        template <typename T>
+        static T apply(const T& a, const T& b) { return T(a > b); }
+        NUMCPP_PACKET_OP(P::from_mask(a > b))
+    };
+    struct GreaterEqual {
+        static constexpr const char* name = "greater-than-or-equal comparison";
+        template <typename T>
+        static T apply(const T& a, const T& b) { return T(a >= b); }
+        NUMCPP_PACKET_OP(P::from_mask(a >= b))
+    };
+    struct LogicalAnd {
+        static constexpr const char* name = "logical AND";
+        template <typename T>
+        static T apply(const T& a, const T& b) { return T(a && b); }
+        NUMCPP_PACKET_OP(P::from_mask((a != P::broadcast(0)) & (b != P::broadcast(0))))
+    };
+    struct LogicalOr {
+        static constexpr const char* name = "logical OR";
+        template <typename T>
+        static T apply(const T& a, const T& b) { return T(a || b); }
+        NUMCPP_PACKET_OP(P::from_mask((a != P::broadcast(0)) | (b != P::broadcast(0))))
+    };
+    // NaN in `a` propagates, as in NumPy's maximum/minimum
+    struct Maximum {
+        static constexpr const char* name = "maximum";
+        template <typename T>
+        static T apply(const T& a, const T& b) { return b > a ? b : a; }
+        NUMCPP_PACKET_OP(P::max(a, b))
+    };
+    struct Minimum {
+        static constexpr const char* name = "minimum";
+        template <typename T>
+        static T apply(const T& a, const T& b) { return b < a ? b : a; }
+        NUMCPP_PACKET_OP(P::min(a, b))
+    };
+    struct Power {
+        static constexpr const char* name = "power";
+        static constexpr KernelCost cost { 0, 0, 1 };
+        template <typename T>
+        static T apply(const T& a, const T& b) { return static_cast<T>(std::pow(a, b)); }
+    };
+    struct Negate {
+        template <typename T>
+        static T apply(const T& a) { return -a; }
+        NUMCPP_PACKET_UNARY_OP(-a)
+    };
+    struct Identity {
+        static constexpr KernelCost cost {};
+        template <typename T>
+        static T apply(const T& a) { return a; }
+        NUMCPP_PACKET_UNARY_OP(a)
+    };
+    struct LogicalNot {
+        template <typename T>
+        static T apply(const T& a) { return T(!a); }
+        NUMCPP_PACKET_UNARY_OP(P::from_mask(a == P::broadcast(0)))
+    };
+    struct BitNot {
+        template <typename T>
+        static T apply(const T& a) { return ~a; }
+        NUMCPP_PACKET_UNARY_OP(~a)
+    };
+
+#undef NUMCPP_PACKET_OP
+#undef NUMCPP_PACKET_UNARY_OP
+#if NUMCPP_SIMD_VECTOR_EXT
+#pragma GCC diagnostic pop
+#endif
+
+    template <typename T>
+    PointerKernel<T> kernel_of(const Array<T>& arr);
+
+    template <typename E>
+        requires(!ArrayLike<E>)
+    auto kernel_of(const E& expr);
+
+    // Per-element work of a kernel tree for the CostModel: one stream per
+    // array operand plus the arithmetic of every operator
+    template <typename T>
+    KernelCost kernel_cost(const PointerKernel<T>& kernel);
+    template <typename T>
+    KernelCost kernel_cost(const StridedKernel<T>& kernel);
+    template <typename T>
+    KernelCost kernel_cost(const ScalarKernel<T>& kernel);
+    template <typename K>
+    KernelCost kernel_cost(const BroadcastKernel<K>& kernel);
+    template <typename Op, typename L, typename R>
+    KernelCost kernel_cost(const BinaryKernel<Op, L, R>& kernel);
+    template <typename Op, typename K>
+    KernelCost kernel_cost(const UnaryKernel<Op, K>& kernel);
+
+    // Whether a kernel evaluated at flat index i reads an element of
+    // dst[0, count) other than dst[i]: the buffer seen through a view in
+    // another layout, or read under a broadcast (`remapped`)
+    template <typename T>
+    bool kernel_aliases(const PointerKernel<T>& kernel, const T* dst, size_t count, bool remapped);
+    template <typename T>
+    bool kernel_aliases(const StridedKernel<T>& kernel, const T* dst, size_t count, bool remapped);
+    template <typename T>
+    bool kernel_aliases(const ScalarKernel<T>& kernel, const T* dst, size_t count, bool remapped);
+    template <typename K, typename T>
+    bool kernel_aliases(const BroadcastKernel<K>& kernel, const T* dst, size_t count, bool remapped);
+    template <typename Op, typename L, typename R, typename T>
+    bool kernel_aliases(const BinaryKernel<Op, L, R>& kernel, const T* dst, size_t count, bool remapped);
+    template <typename Op, typename K, typename T>
+    bool kernel_aliases(const UnaryKernel<Op, K>& kernel, const T* dst, size_t count, bool remapped);
+
+    template <typename T>
+    const std::vector<size_t>& shape_of(const Array<T>& arr);
+
+    template <typename E>
+        requires(!ArrayLike<E>)
+    const std::vector<size_t>& shape_of(const E& expr);
+
+    // Evaluate expr element-wise into dst (size() elements)
+    template <typename T, typename E>
+    void assign(T* dst, const E& expr);
+
+    // Whether evaluating expr into dst, a buffer of the given shape, would
+    // read an element of dst after it has been overwritten. Such
+    // expressions must be evaluated out of place.
+    template <typename T, typename E>
+    bool reads_elsewhere(const T* dst, const std::vector<size_t>& shape, const E& expr);
+
+    // dst[i] = Op(dst[i], expr[i]) over a destination of the given shape;
+    // expr is broadcast to it
+    template <typename Op, typename T, typename E>
+    void assign_op(T* dst, const std::vector<size_t>& shape, const E& expr);
+
+    // dst[i] = Op(dst[i], scalar)
+    template <typename Op, typename T>
+    void assign_op_scalar(T* dst, size_t count, const T& scalar);
+
+    // dst[i] = kernel(i) for i in [0, count), parallel and vectorized
+    template <typename T, typename K>
+    void assign_kernel(T* dst, size_t count, const K& kernel);
+
+    template <typename T>
+    void fill(T* dst, size_t count, const T& value);
+
+    // dst[i] = pow(dst[i], exponent)
+    template <typename T>
+    void pow_inplace(T* dst, size_t count, const T& exponent);
+
+    template <typename E>
+    expr_value_t<E> reduce_sum(const E& expr);
+
+    template <typename E>
+    expr_value_t<E> reduce_min(const E& expr);
+
+    template <typename E>
+    expr_value_t<E> reduce_max(const E& expr);
+
+    // `operand`, stored in a node as type Stored, if it is an Array the node
+    // owns with the given shape and a buffer it may hand on; else a search
+    // of the node's own operands
+    template <typename Stored, typename Operand>
+    Array<expr_value_t<Operand>>* expiring_in(Operand& operand, const std::vector<size_t>& shape);
+}
+
+// Element-wise combination of two expressions, broadcast to a common shape
+template <typename Op, typename L, typename R>
+class BinaryExpr : public ArrayExpr<BinaryExpr<Op, L, R>, expr_value_t<L>> {
+public:
+    using value_type = expr_value_t<L>;
+
+    template <typename LA, typename RA>
+    BinaryExpr(LA&& lhs, RA&& rhs);
+
+    const std::vector<size_t>& shape() const;
+    size_t size() const { return size_; }
+    auto kernel() const;
+
+    // An Array operand this node owns (a temporary or moved array) whose
+    // buffer the result may take over, or nullptr; see Array(ArrayExpr&&)
+    Array<value_type>* expiring_operand(const std::vector<size_t>& shape);
+
+private:
+    L lhs_;
+    R rhs_;
+    // The result shape is an operand's unless both operands broadcast
+    detail::ShapeSource shape_source_;
+    std::vector<size_t> shape_;
+    size_t size_;
+    detail::BroadcastInfo lhs_broadcast_;
+    detail::BroadcastInfo rhs_broadcast_;
+};
+
+// Element-wise combination of an expression with a scalar. ScalarLeft
+// selects `scalar op expr` instead of `expr op scalar`.
+template <typename Op, typename E, bool ScalarLeft>
+class ScalarExpr : public ArrayExpr<ScalarExpr<Op, E, ScalarLeft>, expr_value_t<E>> {
+public:
+    using value_type = expr_value_t<E>;
+
+    template <typename EA>
+    ScalarExpr(EA&& expr, const value_type& scalar);
+
+    const std::vector<size_t>& shape() const { return detail::shape_of(expr_); }
+    size_t size() const { return size_; }
+    auto kernel() const;
+    Array<value_type>* expiring_operand(const std::vector<size_t>& shape);
+
+private:
+    E expr_;
+    value_type scalar_;
+    size_t size_;
+};
+
+// Element-wise unary operation
+template <typename Op, typename E>
+class UnaryExpr : public ArrayExpr<UnaryExpr<Op, E>, expr_value_t<E>> {
+public:
+    using value_type = expr_value_t<E>;
+
+    template <typename EA>
+    explicit UnaryExpr(EA&& expr);
+
+    const std::vector<size_t>& shape() const { return detail::shape_of(expr_); }
+    size_t size() const { return size_; }
+    auto kernel() const;
+    Array<value_type>* expiring_operand(const std::vector<size_t>& shape);
+
+private:
+    E expr_;
+    size_t size_;
+};
+
+// Element-wise operators. Both operands must have the same value type; the
+// result is a lazy node evaluated on assignment or reduction.
+#define NUMCPP_DECLARE_BINARY_OPERATOR(OP, FUNCTOR)                                          \
+    template <Expression L, Expression R>                                                    \
+        requires std::same_as<expr_value_t<L>, expr_value_t<R>>                              \
+    auto operator OP(L&& lhs, R&& rhs);                                                      \
+    template <Expression E>                                                                  \
+    auto operator OP(E&& expr, const std::type_identity_t<expr_value_t<E>>& scalar);         \
+    template <Expression E>                                                                  \
+    auto operator OP(const std::type_identity_t<expr_value_t<E>>& scalar, E&& expr);
+
+NUMCPP_DECLARE_BINARY_OPERATOR(+, Add)
+NUMCPP_DECLARE_BINARY_OPERATOR(-, Subtract)
+NUMCPP_DECLARE_BINARY_OPERATOR(*, Multiply)
+NUMCPP_DECLARE_BINARY_OPERATOR(/, Divide)
+NUMCPP_DECLARE_BINARY_OPERATOR(&, BitAnd)
+NUMCPP_DECLARE_BINARY_OPERATOR(|, BitOr)
+NUMCPP_DECLARE_BINARY_OPERATOR(^, BitXor)
+NUMCPP_DECLARE_BINARY_OPERATOR(==, Equal)
+NUMCPP_DECLARE_BINARY_OPERATOR(!=, NotEqual)
+NUMCPP_DECLARE_BINARY_OPERATOR(<, Less)
+NUMCPP_DECLARE_BINARY_OPERATOR(<=, LessEqual)
+NUMCPP_DECLARE_BINARY_OPERATOR(>, Greater)
+NUMCPP_DECLARE_BINARY_OPERATOR(>=, GreaterEqual)
+NUMCPP_DECLARE_BINARY_OPERATOR(&&, LogicalAnd)
+NUMCPP_DECLARE_BINARY_OPERATOR(||, LogicalOr)
+
+#undef NUMCPP_DECLARE_BINARY_OPERATOR
+
+template <Expression E>
+auto operator-(E&& expr);
+template <Expression E>
+auto operator+(E&& expr);
+template <Expression E>
+auto operator!(E&& expr);
+template <Expression E>
+auto operator~(E&& expr);
+
+// Evaluates expr into `out`, which must already have expr's shape, in one
+// pass and without allocating (unless out shares its buffer, which it then
+// copies first). out may appear in expr. When expr reads out at another
+// index, through a transposed view or a broadcast slice of it, the result is
+// evaluated into a new buffer that replaces out's. Throws
+// std::invalid_argument for a shape mismatch.
+template <typename E, typename T>
+void evaluate(const ArrayExpr<E, T>& expr, Array<T>& out);
+
+// Out-parameter forms of the arithmetic operators, for loops that reuse
+// their buffers: add(a, b, out) is evaluate(a + b, out). Either operand may
+// be a scalar.
+#define NUMCPP_DECLARE_OUT_FUNCTION(NAME)                 \
+    template <typename L, typename R, typename T>         \
+        requires(Expression<L> || Expression<R>)          \
+    void NAME(L&& lhs, R&& rhs, Array<T>& out);
+
+NUMCPP_DECLARE_OUT_FUNCTION(add)
+NUMCPP_DECLARE_OUT_FUNCTION(subtract)
+NUMCPP_DECLARE_OUT_FUNCTION(multiply)
+NUMCPP_DECLARE_OUT_FUNCTION(divide)
+
+#undef NUMCPP_DECLARE_OUT_FUNCTION
+
+} // namespace NumCPP
+
+#include "Expression.tpp"
+
+#endif // EXPRESSION_HPP
@@ -0,0 +1,642 @@
+#ifndef EXPRESSION_TPP
+#define EXPRESSION_TPP
+
+#include "CostModel.hpp"
+#include "Expression.hpp"
+#include "Reduce.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace NumCPP {
+
+namespace detail {
+    template <typename T>
+    PointerKernel<T> kernel_of(const Array<T>& arr)
+    {
+        return { arr.data() };
+    }
+
+    template <typename E>
+        requires(!ArrayLike<E>)
+    auto kernel_of(const E& expr)
+    {
+        return expr.kernel();
+    }
+
+    template <typename T>
+    KernelCost kernel_cost(const PointerKernel<T>&)
+    {
+        return KernelCost::stream<T>(1);
+    }
+
+    template <typename T>
+    KernelCost kernel_cost(const StridedKernel<T>& kernel)
+    {
+        KernelCost cost = KernelCost::stream<T>(1);
+        if (!kernel.contiguous)
+            cost.ops += 8.0 * double(kernel.ndim);
+        return cost;
+    }
+
+    template <typename T>
+    KernelCost kernel_cost(const ScalarKernel<T>&)
+    {
+        return {};
+    }
+
+    template <typename K>
+    KernelCost kernel_cost(const BroadcastKernel<K>& kernel)
+    {
+        KernelCost cost = kernel_cost(kernel.inner);
+        // General broadcasts gather each lane through per-axis divisions
+        if (kernel.mode == BroadcastMode::General)
+            cost.ops += 8.0 * double(kernel.ndim);
+        else if (kernel.mode != BroadcastMode::Same)
+            cost.ops += 1;
+        return cost;
+    }
+
+    // Operators cost one lane operation unless they declare otherwise
+    template <typename Op>
+    constexpr KernelCost op_cost()
+    {
+        if constexpr (requires { Op::cost; })
+            return Op::cost;
+        else
+            return { 0, 1, 0 };
+    }
+
+    template <typename Op, typename L, typename R>
+    KernelCost kernel_cost(const BinaryKernel<Op, L, R>& kernel)
+    {
+        return kernel_cost(kernel.lhs) + kernel_cost(kernel.rhs) + op_cost<Op>();
+    }
+
+    template <typename Op, typename K>
+    KernelCost kernel_cost(const UnaryKernel<Op, K>& kernel)
+    {
+        return kernel_cost(kernel.operand) + op_cost<Op>();
+    }
+
+    // Whether [a, a + a_count) and [b, b + b_count) share an element
+    template <typename T>
+    bool ranges_overlap(const T* a, size_t a_count, const T* b, size_t b_count)
+    {
+        std::less<const T*> less;
+        return a_count > 0 && b_count > 0 && less(a, b + b_count) && less(b, a + a_count);
+    }
+
+    // An array operand spans at most count elements, even when broadcast
+    template <typename T>
+    bool kernel_aliases(const PointerKernel<T>& kernel, const T* dst, size_t count, bool remapped)
+    {
+        return ranges_overlap(kernel.data, count, dst, count) && (remapped || kernel.data != dst);
+    }
+
+    template <typename T>
+    bool kernel_aliases(const StridedKernel<T>& kernel, const T* dst, size_t count, bool remapped)
+    {
+        size_t span = 1;
+        for (size_t d = 0; d < kernel.ndim; d++) {
+            if (kernel.shape[d] == 0)
+                return false;
+            span += (kernel.shape[d] - 1) * kernel.strides[d];
+        }
+        bool same_index = !remapped && kernel.contiguous && kernel.data == dst;
+        return ranges_overlap(kernel.data, span, dst, count) && !same_index;
+    }
+
+    template <typename T>
+    bool kernel_aliases(const ScalarKernel<T>&, const T*, size_t, bool)
+    {
+        return false;
+    }
+
+    template <typename K, typename T>
+    bool kernel_aliases(const BroadcastKernel<K>& kernel, const T* dst, size_t count, bool remapped)
+    {
+        return kernel_aliases(kernel.inner, dst, count, remapped || kernel.mode != BroadcastMode::Same);
+    }
+
+    template <typename Op, typename L, typename R, typename T>
+    bool kernel_aliases(const BinaryKernel<Op, L, R>& kernel, const T* dst, size_t count, bool remapped)
+    {
+        return kernel_aliases(kernel.lhs, dst, count, remapped) || kernel_aliases(kernel.rhs, dst, count, remapped);
+    }
+
+    template <typename Op, typename K, typename T>
+    bool kernel_aliases(const UnaryKernel<Op, K>& kernel, const T* dst, size_t count, bool remapped)
+    {
+        return kernel_aliases(kernel.operand, dst, count, remapped);
+    }
+
+    template <typename T>
+    const std::vector<size_t>& shape_of(const Array<T>& arr)
+    {
+        return arr.shape();
+    }
+
+    template <typename E>
+        requires(!ArrayLike<E>)
+    const std::vector<size_t>& shape_of(const E& expr)
+    {
+        return expr.shape();
+    }
+
+    inline size_t shape_size(const std::vector<size_t>& shape)
+    {
+        if (shape.empty())
+            return 0;
+        size_t total = 1;
+        for (auto s : shape)
+            total *= s;
+        return total;
+    }
+
+    inline std::vector<size_t> broadcast_shapes(const std::vector<size_t>& a, const std::vector<size_t>& b,
+        const char* what)
+    {
+        if (a == b)
+            return a;
+        size_t ndim = std::max(a.size(), b.size());
+        std::vector<size_t> result(ndim);
+        for (size_t k = 0; k < ndim; k++) {
+            size_t da = k < ndim - a.size() ? 1 : a[k - (ndim - a.size())];
+            size_t db = k < ndim - b.size() ? 1 : b[k - (ndim - b.size())];
+            if (da != db && da != 1 && db != 1)
+                throw std::runtime_error(std::string("Shapes do not match for ") + what);
+            result[k] = da == 1 ? db : da;
+        }
+        return result;
+    }
+
+    inline ShapeSource broadcast_source(const std::vector<size_t>& a, const std::vector<size_t>& b, const char* what)
+    {
+        if (a == b)
+            return ShapeSource::Lhs;
+        size_t ndim = std::max(a.size(), b.size());
+        bool is_a = a.size() == ndim;
+        bool is_b = b.size() == ndim;
+        for (size_t k = 0; k < ndim; k++) {
+            size_t da = k < ndim - a.size() ? 1 : a[k - (ndim - a.size())];
+            size_t db = k < ndim - b.size() ? 1 : b[k - (ndim - b.size())];
+            if (da != db && da != 1 && db != 1)
+                throw std::runtime_error(std::string("Shapes do not match for ") + what);
+            size_t result = da == 1 ? db : da;
+            is_a = is_a && da == result;
+            is_b = is_b && db == result;
+        }
+        return is_a ? ShapeSource::Lhs : is_b ? ShapeSource::Rhs : ShapeSource::Own;
+    }
+
+    inline BroadcastInfo broadcast_info(const std::vector<size_t>& from, const std::vector<size_t>& to,
+        const char* what)
+    {
+        if (from == to)
+            return {};
+        if (from.size() > to.size())
+            throw std::runtime_error(std::string("Shapes do not match for ") + what);
+        // `from` padded with leading 1s to to.size() axes, without building it
+        size_t ndim = to.size();
+        size_t pad = ndim - from.size();
+        auto padded = [&](size_t k) { return k < pad ? size_t(1) : from[k - pad]; };
+        bool same = true;
+        for (size_t k = 0; k < ndim; k++) {
+            if (padded(k) != to[k] && padded(k) != 1)
+                throw std::runtime_error(std::string("Shapes do not match for ") + what);
+            same = same && padded(k) == to[k];
+        }
+
+        BroadcastInfo info;
+        if (same)
+            return info;
+
+        // Row: leading broadcast axes followed by matching trailing axes
+        size_t first = 0;
+        while (first < ndim && padded(first) == 1)
+            first++;
+        bool row = true;
+        for (size_t k = first; k < ndim; k++)
+            row = row && padded(k) == to[k];
+        if (row) {
+            info.mode = BroadcastMode::Row;
+            for (size_t k = first; k < ndim; k++)
+                info.extent *= to[k];
+            return info;
+        }
+
+        // Column: every axis matches except a last axis of 1
+        bool column = padded(ndim - 1) == 1;
+        for (size_t k = 0; k + 1 < ndim; k++)
+            column = column && padded(k) == to[k];
+        if (column) {
+            info.mode = BroadcastMode::Column;
+            info.extent = to.back();
+            return info;
+        }
+
+        info.mode = BroadcastMode::General;
+        info.shape = to;
+        info.strides.assign(ndim, 0);
+        size_t stride = 1;
+        for (size_t k = ndim; k-- > 0;) {
+            if (padded(k) != 1)
+                info.strides[k] = stride;
+            stride *= padded(k);
+        }
+        return info;
+    }
+
+    template <typename T, typename K>
+    void assign_kernel(T* dst, size_t count, const K& kernel)
+    {
+        size_t grain = parallel_grain(kernel_cost(kernel) + KernelCost::stream<T>(0, 1));
+        parallel_for(0, count, [dst, &kernel](size_t start, size_t end) {
+            simd::assign(dst, kernel, start, end);
+        }, grain);
+    }
+
+    template <typename T, typename E>
+    void assign(T* dst, const E& expr)
+    {
+        assign_kernel(dst, expr.size(), kernel_of(expr));
+    }
+
+    template <typename T, typename E>
+    bool reads_elsewhere(const T* dst, const std::vector<size_t>& shape, const E& expr)
+    {
+        // A valid broadcast keeps the element count only when it is the
+        // identity, so a size change is exactly a remapped read
+        size_t count = shape_size(shape);
+        return kernel_aliases(kernel_of(expr), dst, count, shape_size(shape_of(expr)) != count);
+    }
+
+    template <typename Op, typename T, typename E>
+    void assign_op(T* dst, const std::vector<size_t>& shape, const E& expr)
+    {
+        using K = BroadcastKernel<decltype(kernel_of(expr))>;
+        BroadcastInfo info = broadcast_info(shape_of(expr), shape, Op::name);
+        assign_kernel(dst, shape_size(shape),
+            BinaryKernel<Op, PointerKernel<T>, K> { { dst }, broadcast_kernel(kernel_of(expr), info) });
+    }
+
+    template <typename Op, typename T>
+    void assign_op_scalar(T* dst, size_t count, const T& scalar)
+    {
+        assign_kernel(dst, count, BinaryKernel<Op, PointerKernel<T>, ScalarKernel<T>> { { dst }, { scalar } });
+    }
+
+    template <typename T>
+    void fill(T* dst, size_t count, const T& value)
+    {
+        assign_kernel(dst, count, ScalarKernel<T> { value });
+    }
+
+    template <typename T>
+    void pow_inplace(T* dst, size_t count, const T& exponent)
+    {
+        using Self = PointerKernel<T>;
+        if constexpr (std::is_floating_point_v<T>) {
+            // Exponents with an exact register form, as NumPy special-cases
+            if (exponent == T(1))
+                return;
+            if (exponent == T(0))
+                return fill(dst, count, T(1));
+            if (exponent == T(2))
+                return assign_kernel(dst, count, BinaryKernel<Multiply, Self, Self> { { dst }, { dst } });
+            if (exponent == T(-1))
+                return assign_kernel(dst, count, BinaryKernel<Divide, ScalarKernel<T>, Self> { { T(1) }, { dst } });
+        }
+        assign_kernel(dst, count, BinaryKernel<Power, Self, ScalarKernel<T>> { { dst }, { exponent } });
+    }
+
+    template <typename E>
+    expr_value_t<E> reduce_sum(const E& expr)
+    {
+        using T = expr_value_t<E>;
+        auto kernel = kernel_of(expr);
+        if constexpr (std::is_floating_point_v<T>) {
+            if (sum_mode() == SumMode::Reproducible) {
+                if constexpr (std::is_same_v<decltype(kernel), PointerKernel<T>>)
+                    return NumCPP::reproducible_sum(kernel.data, expr.size());
+                else
+                    return detail::reproducible_sum<T>(kernel, expr.size());
+            }
+        }
+        return parallel_reduce(
+            0, expr.size(), T(0),
+            [&kernel](size_t start, size_t end) { return simd::reduce<simd::Sum, T>(kernel, start, end); },
+            [](const T& a, const T& b) { return a + b; }, parallel_grain(kernel_cost(kernel)));
+    }
+
+    template <typename E>
+    expr_value_t<E> reduce_min(const E& expr)
+    {
+        using T = expr_value_t<E>;
+        if (expr.size() == 0)
+            throw std::runtime_error("Cannot compute min of empty array");
+        auto kernel = kernel_of(expr);
+        return parallel_reduce(
+            0, expr.size(), std::numeric_limits<T>::max(),
+            [&kernel](size_t start, size_t end) { return simd::reduce<simd::Min, T>(kernel, start, end); },
+            [](const T& a, const T& b) { return b < a ? b : a; }, parallel_grain(kernel_cost(kernel)));
+    }
+
+    template <typename E>
+    expr_value_t<E> reduce_max(const E& expr)
+    {
+        using T = expr_value_t<E>;
+        if (expr.size() == 0)
+            throw std::runtime_error("Cannot compute max of empty array");
+        auto kernel = kernel_of(expr);
+        return parallel_reduce(
+            0, expr.size(), std::numeric_limits<T>::lowest(),
+            [&kernel](size_t start, size_t end) { return simd::reduce<simd::Max, T>(kernel, start, end); },
+            [](const T& a, const T& b) { return b > a ? b : a; }, parallel_grain(kernel_cost(kernel)));
+    }
+}
+
+// ArrayExpr
+template <typename Derived, typename T>
+size_t ArrayExpr<Derived, T>::ndim() const
+{
+    return detail::shape_of(derived()).size();
+}
+
+template <typename Derived, typename T>
+size_t ArrayExpr<Derived, T>::size() const
+{
+    return derived().size();
+}
+
+template <typename Derived, typename T>
+Array<T> ArrayExpr<Derived, T>::eval() const
+{
+    return Array<T>(derived());
+}
+
+template <typename Derived, typename T>
+T ArrayExpr<Derived, T>::sum() const
+{
+    return detail::reduce_sum(derived());
+}
+
+template <typename Derived, typename T>
+T ArrayExpr<Derived, T>::mean() const
+{
+    if (derived().size() == 0)
+        throw std::runtime_error("Cannot compute mean of empty array");
+    return sum() / derived().size();
+}
+
+template <typename Derived, typename T>
+T ArrayExpr<Derived, T>::min() const
+{
+    return detail::reduce_min(derived());
+}
+
+template <typename Derived, typename T>
+T ArrayExpr<Derived, T>::max() const
+{
+    return detail::reduce_max(derived());
+}
+
+template <typename Derived, typename T>
+template <typename... Indices>
+T ArrayExpr<Derived, T>::operator()(Indices... indices) const
+{
+    static_assert(sizeof...(indices) > 0, "No indices provided");
+    const auto& shape = detail::shape_of(derived());
+    std::vector<size_t> idx = { static_cast<size_t>(indices)... };
+    size_t flat = 0;
+    if (idx.size() == 1) {
+        flat = idx[0];
+    } else {
+        if (idx.size() != shape.size())
+            throw std::invalid_argument("Number of indices must match number of dimensions");
+        for (size_t k = 0; k < idx.size(); k++) {
+            if (idx[k] >= shape[k])
+                throw std::out_of_range("Index out of range");
+            flat = flat * shape[k] + idx[k];
+        }
+    }
+    if (flat >= derived().size())
+        throw std::out_of_range("Index out of range");
+    return detail::kernel_of(derived())(flat);
+}
+
+namespace detail {
+    template <typename Stored, typename Operand>
+    Array<expr_value_t<Operand>>* expiring_in(Operand& operand, const std::vector<size_t>& shape)
+    {
+        if constexpr (std::is_reference_v<Stored>) {
+            return nullptr;
+        } else if constexpr (ArrayLike<Stored>) {
+            // Wrapped external memory stays with its owner
+            Array<expr_value_t<Operand>>& arr = operand;
+            bool free = arr.storage().writable() && arr.storage().owns_memory();
+            return free && arr.shape() == shape ? std::addressof(arr) : nullptr;
+        } else if constexpr (requires { operand.expiring_operand(shape); }) {
+            return operand.expiring_operand(shape);
+        } else {
+            return nullptr;
+        }
+    }
+}
+
+// BinaryExpr
+template <typename Op, typename L, typename R>
+template <typename LA, typename RA>
+BinaryExpr<Op, L, R>::BinaryExpr(LA&& lhs, RA&& rhs)
+    : lhs_(std::forward<LA>(lhs))
+    , rhs_(std::forward<RA>(rhs))
+    , shape_source_(detail::broadcast_source(detail::shape_of(lhs_), detail::shape_of(rhs_), Op::name))
+    , shape_(shape_source_ == detail::ShapeSource::Own
+              ? detail::broadcast_shapes(detail::shape_of(lhs_), detail::shape_of(rhs_), Op::name)
+              : std::vector<size_t>())
+    , size_(detail::shape_size(shape()))
+    , lhs_broadcast_(detail::broadcast_info(detail::shape_of(lhs_), shape(), Op::name))
+    , rhs_broadcast_(detail::broadcast_info(detail::shape_of(rhs_), shape(), Op::name))
+{
+}
+
+template <typename Op, typename L, typename R>
+const std::vector<size_t>& BinaryExpr<Op, L, R>::shape() const
+{
+    switch (shape_source_) {
+    case detail::ShapeSource::Lhs:
+        return detail::shape_of(lhs_);
+    case detail::ShapeSource::Rhs:
+        return detail::shape_of(rhs_);
+    default:
+        return shape_;
+    }
+}
+
+template <typename Op, typename L, typename R>
+Array<typename BinaryExpr<Op, L, R>::value_type>* BinaryExpr<Op, L, R>::expiring_operand(
+    const std::vector<size_t>& shape)
+{
+    if (auto* found = detail::expiring_in<L>(lhs_, shape))
+        return found;
+    return detail::expiring_in<R>(rhs_, shape);
+}
+
+template <typename Op, typename L, typename R>
+auto BinaryExpr<Op, L, R>::kernel() const
+{
+    using LK = detail::BroadcastKernel<decltype(detail::kernel_of(lhs_))>;
+    using RK = detail::BroadcastKernel<decltype(detail::kernel_of(rhs_))>;
+    return detail::BinaryKernel<Op, LK, RK> { detail::broadcast_kernel(detail::kernel_of(lhs_), lhs_broadcast_),
+        detail::broadcast_kernel(detail::kernel_of(rhs_), rhs_broadcast_) };
+}
+
+// ScalarExpr
+template <typename Op, typename E, bool ScalarLeft>
+template <typename EA>
+ScalarExpr<Op, E, ScalarLeft>::ScalarExpr(EA&& expr, const value_type& scalar)
+    : expr_(std::forward<EA>(expr))
+    , scalar_(scalar)
+    , size_(expr_.size())
+{
+}
+
+template <typename Op, typename E, bool ScalarLeft>
+Array<typename ScalarExpr<Op, E, ScalarLeft>::value_type>* ScalarExpr<Op, E, ScalarLeft>::expiring_operand(
+    const std::vector<size_t>& shape)
+{
+    return detail::expiring_in<E>(expr_, shape);
+}
+
+template <typename Op, typename E, bool ScalarLeft>
+auto ScalarExpr<Op, E, ScalarLeft>::kernel() const
+{
+    using K = decltype(detail::kernel_of(expr_));
+    using S = detail::ScalarKernel<value_type>;
+    if constexpr (ScalarLeft)
+        return detail::BinaryKernel<Op, S, K> { S { scalar_ }, detail::kernel_of(expr_) };
+    else
+        return detail::BinaryKernel<Op, K, S> { detail::kernel_of(expr_), S { scalar_ } };
+}
+
+// UnaryExpr
+template <typename Op, typename E>
+template <typename EA>
+UnaryExpr<Op, E>::UnaryExpr(EA&& expr)
+    : expr_(std::forward<EA>(expr))
+    , size_(expr_.size())
+{
+}
+
+template <typename Op, typename E>
+Array<typename UnaryExpr<Op, E>::value_type>* UnaryExpr<Op, E>::expiring_operand(const std::vector<size_t>& shape)
+{
+    return detail::expiring_in<E>(expr_, shape);
+}
+
+template <typename Op, typename E>
+auto UnaryExpr<Op, E>::kernel() const
+{
+    using K = decltype(detail::kernel_of(expr_));
+    return detail::UnaryKernel<Op, K> { detail::kernel_of(expr_) };
+}
+
+// Operators
+#define NUMCPP_DEFINE_BINARY_OPERATOR(OP, FUNCTOR)                                                \
+    template <Expression L, Expression R>                                                         \
+        requires std::same_as<expr_value_t<L>, expr_value_t<R>>                                   \
+    auto operator OP(L&& lhs, R&& rhs)                                                            \
+    {                                                                                             \
+        return BinaryExpr<detail::FUNCTOR, operand_t<L>, operand_t<R>>(                           \
+            std::forward<L>(lhs), std::forward<R>(rhs));                                          \
+    }                                                                                             \
+    template <Expression E>                                                                       \
+    auto operator OP(E&& expr, const std::type_identity_t<expr_value_t<E>>& scalar)               \
+    {                                                                                             \
+        return ScalarExpr<detail::FUNCTOR, operand_t<E>, false>(std::forward<E>(expr), scalar);   \
+    }                                                                                             \
+    template <Expression E>                                                                       \
+    auto operator OP(const std::type_identity_t<expr_value_t<E>>& scalar, E&& expr)               \
+    {                                                                                             \
+        return ScalarExpr<detail::FUNCTOR, operand_t<E>, true>(std::forward<E>(expr), scalar);    \
+    }
+
+NUMCPP_DEFINE_BINARY_OPERATOR(+, Add)
+NUMCPP_DEFINE_BINARY_OPERATOR(-, Subtract)
+NUMCPP_DEFINE_BINARY_OPERATOR(*, Multiply)
+NUMCPP_DEFINE_BINARY_OPERATOR(/, Divide)
+NUMCPP_DEFINE_BINARY_OPERATOR(&, BitAnd)
+NUMCPP_DEFINE_BINARY_OPERATOR(|, BitOr)
+NUMCPP_DEFINE_BINARY_OPERATOR(^, BitXor)
+NUMCPP_DEFINE_BINARY_OPERATOR(==, Equal)
+NUMCPP_DEFINE_BINARY_OPERATOR(!=, NotEqual)
+NUMCPP_DEFINE_BINARY_OPERATOR(<, Less)
+NUMCPP_DEFINE_BINARY_OPERATOR(<=, LessEqual)
+NUMCPP_DEFINE_BINARY_OPERATOR(>, Greater)
+NUMCPP_DEFINE_BINARY_OPERATOR(>=, GreaterEqual)
+NUMCPP_DEFINE_BINARY_OPERATOR(&&, LogicalAnd)
+NUMCPP_DEFINE_BINARY_OPERATOR(||, LogicalOr)
+
+#undef NUMCPP_DEFINE_BINARY_OPERATOR
+
+template <Expression E>
+auto operator-(E&& expr)
+{
+    return UnaryExpr<detail::Negate, operand_t<E>>(std::forward<E>(expr));
+}
+
+template <Expression E>
+auto operator+(E&& expr)
+{
+    return UnaryExpr<detail::Identity, operand_t<E>>(std::forward<E>(expr));
+}
+
+template <Expression E>
+auto operator!(E&& expr)
+{
+    return UnaryExpr<detail::LogicalNot, operand_t<E>>(std::forward<E>(expr));
+}
+
+template <Expression E>
+auto operator~(E&& expr)
+{
+    return UnaryExpr<detail::BitNot, operand_t<E>>(std::forward<E>(expr));
+}
+
+template <typename E, typename T>
+void evaluate(const ArrayExpr<E, T>& expr, Array<T>& out)
+{
+    if (detail::shape_of(expr.derived()) != out.shape())
+        throw std::invalid_argument("Output array has the wrong shape");
+    T* dst = detail::writable_data(out);
+    if (detail::reads_elsewhere(dst, out.shape(), expr.derived())) {
+        // out is read through a view in another layout or a broadcast
+        out = Array<T>(expr.derived());
+        return;
+    }
+    detail::assign(dst, expr.derived());
+}
+
+#define NUMCPP_DEFINE_OUT_FUNCTION(NAME, OP)                        \
+    template <typename L, typename R, typename T>                   \
+        requires(Expression<L> || Expression<R>)                    \
+    void NAME(L&& lhs, R&& rhs, Array<T>& out)                      \
+    {                                                               \
+        evaluate(std::forward<L>(lhs) OP std::forward<R>(rhs), out); \
+    }
+
+NUMCPP_DEFINE_OUT_FUNCTION(add, +)
+NUMCPP_DEFINE_OUT_FUNCTION(subtract, -)
+NUMCPP_DEFINE_OUT_FUNCTION(multiply, *)
+NUMCPP_DEFINE_OUT_FUNCTION(divide, /)
+
+#undef NUMCPP_DEFINE_OUT_FUNCTION
+
+} // namespace NumCPP
+
+#endif // EXPRESSION_TPP
@@ -0,0 +1,119 @@
+#ifndef FIXEDMATRIX_HPP
+#define FIXEDMATRIX_HPP
+
+#include "Array.hpp"
+#include "Matrix.hpp"
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+
+namespace NumCPP {
+
+// An R x C matrix whose extents are template parameters, stored row-major in
+// an inline std::array: no heap, no shape vectors, and every operation is
+// constexpr. Products are unrolled over the inner dimension; determinant()
+// and inverse() use closed forms up to 4 x 4 and partial-pivoting
+// elimination above that.
+//
+// Converts explicitly from and to Array and Matrix (copying R * C elements).
+template <typename T, size_t R, size_t C>
+class FixedMatrix {
+    static_assert(R > 0 && C > 0, "FixedMatrix extents must be positive");
+
+public:
+    using value_type = T;
+    static constexpr size_t rows = R;
+    static constexpr size_t cols = C;
+
+    // Zero-initialized
+    constexpr FixedMatrix() = default;
+    constexpr explicit FixedMatrix(const T& value);
+    // R * C values in row-major order; throws std::invalid_argument otherwise
+    constexpr FixedMatrix(std::initializer_list<T> values);
+    // Throws std::invalid_argument unless the shape is {R, C}. Templates so
+    // a braced list never converts to an Array or Matrix.
+    template <typename A>
+        requires std::is_base_of_v<Array<T>, A>
+    explicit FixedMatrix(const A& arr);
+    template <typename M>
+        requires std::is_base_of_v<Matrix<T>, M>
+    explicit FixedMatrix(const M& matrix);
+
+    static constexpr FixedMatrix identity()
+        requires(R == C);
+
+    Array<T> to_array() const;
+    Matrix<T> to_matrix() const;
+
+    static constexpr size_t ndim() { return 2; }
+    static constexpr std::array<size_t, 2> shape() { return { R, C }; }
+    static constexpr size_t size() { return R * C; }
+
+    // Bounds-checked; throws std::out_of_range
+    constexpr T& operator()(size_t row, size_t col);
+    constexpr const T& operator()(size_t row, size_t col) const;
+    // No bounds checks
+    constexpr T& at_unchecked(size_t row, size_t col) { return data_[row * C + col]; }
+    constexpr const T& at_unchecked(size_t row, size_t col) const { return data_[row * C + col]; }
+    // Row-major flat index, unchecked
+    constexpr T& operator[](size_t index) { return data_[index]; }
+    constexpr const T& operator[](size_t index) const { return data_[index]; }
+
+    constexpr T* data() { return data_.data(); }
+    constexpr const T* data() const { return data_.data(); }
+
+    // Element-wise arithmetic, as on Matrix
+    constexpr FixedMatrix operator+(const FixedMatrix& other) const;
+    constexpr FixedMatrix operator-(const FixedMatrix& other) const;
+    constexpr FixedMatrix operator*(const T& scalar) const;
+    constexpr FixedMatrix operator/(const T& scalar) const;
+    constexpr FixedMatrix operator-() const;
+    constexpr FixedMatrix& operator+=(const FixedMatrix& other);
+    constexpr FixedMatrix& operator-=(const FixedMatrix& other);
+    constexpr FixedMatrix& operator*=(const T& scalar);
+    constexpr FixedMatrix& operator/=(const T& scalar);
+    constexpr bool operator==(const FixedMatrix& other) const = default;
+
+    // Matrix products
+    template <size_t K>
+    constexpr FixedMatrix<T, R, K> dot(const FixedMatrix<T, C, K>& other) const;
+    constexpr std::array<T, R> dot(const std::array<T, C>& vector) const;
+
+    constexpr FixedMatrix<T, C, R> transposed() const;
+
+    constexpr T trace() const
+        requires(R == C);
+    constexpr T determinant() const
+        requires(R == C);
+    // Throws std::runtime_error when the matrix is singular
+    constexpr FixedMatrix inverse() const
+        requires(R == C);
+
+private:
+    std::array<T, R * C> data_ {};
+};
+
+template <typename T, size_t N>
+using FixedSquareMatrix = FixedMatrix<T, N, N>;
+
+namespace detail {
+    // f(std::integral_constant<size_t, I>) for every I in [0, N), expanded at
+    // compile time
+    template <size_t N, typename F>
+    constexpr void unroll(F&& f);
+
+    // Reduces the row-major n x n matrix a with partial pivoting, applying
+    // every row operation to the n x k matrix b as well: to row-echelon form,
+    // or with back_substitute to a diagonal (Gauss-Jordan). Returns the
+    // determinant of a; zero, with a left partially reduced, when a pivot
+    // vanishes.
+    template <typename T>
+    constexpr T eliminate(T* a, size_t n, T* b, size_t k, bool back_substitute);
+}
+
+} // namespace NumCPP
+
+#include "FixedMatrix.tpp"
+
+#endif // FIXEDMATRIX_HPP
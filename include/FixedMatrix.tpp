@@ -0,0 +1,337 @@
+#ifndef FIXEDMATRIX_TPP
+#define FIXEDMATRIX_TPP
+
+#include "FixedMatrix.hpp"
+#include <stdexcept>
+#include <utility>
+
+namespace NumCPP {
+
+namespace detail {
+    template <size_t N, typename F>
+    constexpr void unroll(F&& f)
+    {
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            (f(std::integral_constant<size_t, I> {}), ...);
+        }(std::make_index_sequence<N> {});
+    }
+
+    template <typename T>
+    constexpr T fixed_abs(T value)
+    {
+        return value < T(0) ? -value : value;
+    }
+
+    template <typename T>
+    constexpr T eliminate(T* a, size_t n, T* b, size_t k, bool back_substitute)
+    {
+        T det = T(1);
+        for (size_t j = 0; j < n; j++) {
+            size_t p = j;
+            for (size_t i = j + 1; i < n; i++) {
+                if (fixed_abs(a[i * n + j]) > fixed_abs(a[p * n + j]))
+                    p = i;
+            }
+            if (a[p * n + j] == T(0))
+                return T(0);
+            if (p != j) {
+                for (size_t c = 0; c < n; c++)
+                    std::swap(a[p * n + c], a[j * n + c]);
+                for (size_t c = 0; c < k; c++)
+                    std::swap(b[p * k + c], b[j * k + c]);
+                det = -det;
+            }
+            T pivot = a[j * n + j];
+            det *= pivot;
+            for (size_t i = back_substitute ? 0 : j + 1; i < n; i++) {
+                if (i == j)
+                    continue;
+                T l = a[i * n + j] / pivot;
+                for (size_t c = j; c < n; c++)
+                    a[i * n + c] -= l * a[j * n + c];
+                for (size_t c = 0; c < k; c++)
+                    b[i * k + c] -= l * b[j * k + c];
+            }
+        }
+        return det;
+    }
+}
+
+template <typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, R, C>::FixedMatrix(const T& value)
+{
+    data_.fill(value);
+}
+
+template <typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, R, C>::FixedMatrix(std::initializer_list<T> values)
+{
+    if (values.size() != R * C)
+        throw std::invalid_argument("Data size does not match shape");
+    size_t i = 0;
+    for (const T& value : values)
+        data_[i++] = value;
+}
+
+template <typename T, size_t R, size_t C>
+template <typename A>
+    requires std::is_base_of_v<Array<T>, A>
+FixedMatrix<T, R, C>::FixedMatrix(const A& arr)
+{
+    if (arr.shape() != std::vector<size_t> { R, C })
+        throw std::invalid_argument("Array shape does not match FixedMatrix shape");
+    std::copy(arr.data(), arr.data() + R * C, data_.begin());
+}
+
+template <typename T, size_t R, size_t C>
+template <typename M>
+    requires std::is_base_of_v<Matrix<T>, M>
+FixedMatrix<T, R, C>::FixedMatrix(const M& matrix)
+{
+    if (matrix.shape() != std::vector<size_t> { R, C })
+        throw std::invalid_argument("Matrix shape does not match FixedMatrix shape");
+    std::copy(matrix.array().data(), matrix.array().data() + R * C, data_.begin());
+}
+
+template <typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, R, C> FixedMatrix<T, R, C>::identity()
+    requires(R == C)
+{
+    FixedMatrix result;
+    for (size_t i = 0; i < R; i++)
+        result.data_[i * C + i] = T(1);
+    return result;
+}
+
+template <typename T, size_t R, size_t C>
+Array<T> FixedMatrix<T, R, C>::to_array() const
+{
+    return Array<T>({ R, C }, std::vector<T>(data_.begin(), data_.end()));
+}
+
+template <typename T, size_t R, size_t C>
+Matrix<T> FixedMatrix<T, R, C>::to_matrix() const
+{
+    return Matrix<T>(to_array());
+}
+
+template <typename T, size_t R, size_t C>
+constexpr T& FixedMatrix<T, R, C>::operator()(size_t row, size_t col)
+{
+    if (row >= R || col >= C)
+        throw std::out_of_range("Index out of bounds");
+    return data_[row * C + col];
+}
+
+template <typename T, size_t R, size_t C>
+constexpr const T& FixedMatrix<T, R, C>::operator()(size_t row, size_t col) const
+{
+    if (row >= R || col >= C)
+        throw std::out_of_range("Index out of bounds");
+    return data_[row * C + col];
+}
+
+template <typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, R, C> FixedMatrix<T, R, C>::operator+(const FixedMatrix& other) const
+{
+    FixedMatrix result(*this);
+    return result += other;
+}
+
+template <typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, R, C> FixedMatrix<T, R, C>::operator-(const FixedMatrix& other) const
+{
+    FixedMatrix result(*this);
+    return result -= other;
+}
+
+template <typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, R, C> FixedMatrix<T, R, C>::operator*(const T& scalar) const
+{
+    FixedMatrix result(*this);
+    return result *= scalar;
+}
+
+template <typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, R, C> FixedMatrix<T, R, C>::operator/(const T& scalar) const
+{
+    FixedMatrix result(*this);
+    return result /= scalar;
+}
+
+template <typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, R, C> FixedMatrix<T, R, C>::operator-() const
+{
+    FixedMatrix result;
+    for (size_t i = 0; i < R * C; i++)
+        result.data_[i] = -data_[i];
+    return result;
+}
+
+template <typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, R, C>& FixedMatrix<T, R, C>::operator+=(const FixedMatrix& other)
+{
+    for (size_t i = 0; i < R * C; i++)
+        data_[i] += other.data_[i];
+    return *this;
+}
+
+template <typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, R, C>& FixedMatrix<T, R, C>::operator-=(const FixedMatrix& other)
+{
+    for (size_t i = 0; i < R * C; i++)
+        data_[i] -= other.data_[i];
+    return *this;
+}
+
+template <typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, R, C>& FixedMatrix<T, R, C>::operator*=(const T& scalar)
+{
+    for (size_t i = 0; i < R * C; i++)
+        data_[i] *= scalar;
+    return *this;
+}
+
+template <typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, R, C>& FixedMatrix<T, R, C>::operator/=(const T& scalar)
+{
+    for (size_t i = 0; i < R * C; i++)
+        data_[i] /= scalar;
+    return *this;
+}
+
+template <typename T, size_t R, size_t C>
+template <size_t K>
+constexpr FixedMatrix<T, R, K> FixedMatrix<T, R, C>::dot(const FixedMatrix<T, C, K>& other) const
+{
+    FixedMatrix<T, R, K> result;
+    for (size_t i = 0; i < R; i++) {
+        for (size_t j = 0; j < K; j++) {
+            T acc = T(0);
+            detail::unroll<C>([&](auto k) { acc += data_[i * C + k] * other.at_unchecked(k, j); });
+            result.at_unchecked(i, j) = acc;
+        }
+    }
+    return result;
+}
+
+template <typename T, size_t R, size_t C>
+constexpr std::array<T, R> FixedMatrix<T, R, C>::dot(const std::array<T, C>& vector) const
+{
+    std::array<T, R> result {};
+    for (size_t i = 0; i < R; i++) {
+        T acc = T(0);
+        detail::unroll<C>([&](auto k) { acc += data_[i * C + k] * vector[k]; });
+        result[i] = acc;
+    }
+    return result;
+}
+
+template <typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, C, R> FixedMatrix<T, R, C>::transposed() const
+{
+    FixedMatrix<T, C, R> result;
+    for (size_t i = 0; i < R; i++) {
+        for (size_t j = 0; j < C; j++)
+            result.at_unchecked(j, i) = data_[i * C + j];
+    }
+    return result;
+}
+
+template <typename T, size_t R, size_t C>
+constexpr T FixedMatrix<T, R, C>::trace() const
+    requires(R == C)
+{
+    T acc = T(0);
+    detail::unroll<R>([&](auto i) { acc += data_[i * C + i]; });
+    return acc;
+}
+
+template <typename T, size_t R, size_t C>
+constexpr T FixedMatrix<T, R, C>::determinant() const
+    requires(R == C)
+{
+    const auto& a = data_;
+    if constexpr (R == 1) {
+        return a[0];
+    } else if constexpr (R == 2) {
+        return a[0] * a[3] - a[1] * a[2];
+    } else if constexpr (R == 3) {
+        return a[0] * (a[4] * a[8] - a[5] * a[7]) - a[1] * (a[3] * a[8] - a[5] * a[6])
+            + a[2] * (a[3] * a[7] - a[4] * a[6]);
+    } else if constexpr (R == 4) {
+        // Laplace expansion along the first two rows: 2 x 2 minors of the
+        // top rows times their complements in the bottom rows
+        T s0 = a[0] * a[5] - a[4] * a[1], s1 = a[0] * a[6] - a[4] * a[2];
+        T s2 = a[0] * a[7] - a[4] * a[3], s3 = a[1] * a[6] - a[5] * a[2];
+        T s4 = a[1] * a[7] - a[5] * a[3], s5 = a[2] * a[7] - a[6] * a[3];
+        T c5 = a[10] * a[15] - a[14] * a[11], c4 = a[9] * a[15] - a[13] * a[11];
+        T c3 = a[9] * a[14] - a[13] * a[10], c2 = a[8] * a[15] - a[12] * a[11];
+        T c1 = a[8] * a[14] - a[12] * a[10], c0 = a[8] * a[13] - a[12] * a[9];
+        return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    } else {
+        static_assert(std::is_floating_point_v<T>, "Determinants above 4 x 4 require a floating-point type");
+        FixedMatrix work(*this);
+        return detail::eliminate<T>(work.data(), R, nullptr, 0, false);
+    }
+}
+
+template <typename T, size_t R, size_t C>
+constexpr FixedMatrix<T, R, C> FixedMatrix<T, R, C>::inverse() const
+    requires(R == C)
+{
+    static_assert(std::is_floating_point_v<T>, "Inverse requires a floating-point type");
+    const auto& a = data_;
+    FixedMatrix result;
+    auto& b = result.data_;
+    T det = T(0);
+    if constexpr (R == 1) {
+        det = a[0];
+        b[0] = T(1);
+    } else if constexpr (R == 2) {
+        det = determinant();
+        b = { a[3], -a[1], -a[2], a[0] };
+    } else if constexpr (R == 3) {
+        b = { a[4] * a[8] - a[5] * a[7], a[2] * a[7] - a[1] * a[8], a[1] * a[5] - a[2] * a[4],
+            a[5] * a[6] - a[3] * a[8], a[0] * a[8] - a[2] * a[6], a[2] * a[3] - a[0] * a[5],
+            a[3] * a[7] - a[4] * a[6], a[1] * a[6] - a[0] * a[7], a[0] * a[4] - a[1] * a[3] };
+        det = a[0] * b[0] + a[1] * b[3] + a[2] * b[6];
+    } else if constexpr (R == 4) {
+        // Adjugate from the same 2 x 2 minors as determinant()
+        T s0 = a[0] * a[5] - a[4] * a[1], s1 = a[0] * a[6] - a[4] * a[2];
+        T s2 = a[0] * a[7] - a[4] * a[3], s3 = a[1] * a[6] - a[5] * a[2];
+        T s4 = a[1] * a[7] - a[5] * a[3], s5 = a[2] * a[7] - a[6] * a[3];
+        T c5 = a[10] * a[15] - a[14] * a[11], c4 = a[9] * a[15] - a[13] * a[11];
+        T c3 = a[9] * a[14] - a[13] * a[10], c2 = a[8] * a[15] - a[12] * a[11];
+        T c1 = a[8] * a[14] - a[12] * a[10], c0 = a[8] * a[13] - a[12] * a[9];
+        det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+        b = { a[5] * c5 - a[6] * c4 + a[7] * c3, -a[1] * c5 + a[2] * c4 - a[3] * c3,
+            a[13] * s5 - a[14] * s4 + a[15] * s3, -a[9] * s5 + a[10] * s4 - a[11] * s3,
+            -a[4] * c5 + a[6] * c2 - a[7] * c1, a[0] * c5 - a[2] * c2 + a[3] * c1,
+            -a[12] * s5 + a[14] * s2 - a[15] * s1, a[8] * s5 - a[10] * s2 + a[11] * s1,
+            a[4] * c4 - a[5] * c2 + a[7] * c0, -a[0] * c4 + a[1] * c2 - a[3] * c0,
+            a[12] * s4 - a[13] * s2 + a[15] * s0, -a[8] * s4 + a[9] * s2 - a[11] * s0,
+            -a[4] * c3 + a[5] * c1 - a[6] * c0, a[0] * c3 - a[1] * c1 + a[2] * c0,
+            -a[12] * s3 + a[13] * s1 - a[14] * s0, a[8] * s3 - a[9] * s1 + a[10] * s0 };
+    } else {
+        // Gauss-Jordan: reduce a copy to a diagonal while applying the same
+        // row operations to the identity, then scale by the pivots
+        FixedMatrix work(*this);
+        result = identity();
+        if (detail::eliminate(work.data(), R, result.data(), R, true) == T(0))
+            throw std::runtime_error("Matrix is singular and cannot be inverted");
+        for (size_t i = 0; i < R; i++) {
+            T pivot = work.data_[i * C + i];
+            for (size_t j = 0; j < C; j++)
+                b[i * C + j] /= pivot;
+        }
+        return result;
+    }
+    if (det == T(0))
+        throw std::runtime_error("Matrix is singular and cannot be inverted");
+    return result / det;
+}
+
+} // namespace NumCPP
+
+#endif // FIXEDMATRIX_TPP
@@ -0,0 +1,97 @@
+#ifndef FIXEDRANKARRAY_HPP
+#define FIXEDRANKARRAY_HPP
+
+#include "Array.hpp"
+#include "ArraySpan.hpp"
+#include "Storage.hpp"
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace NumCPP {
+
+// An N-dimensional array whose rank is a template parameter. Shape and
+// strides live inline in std::arrays and the element count is cached, so
+// copying, indexing and size() never touch the heap; multi-indices are
+// checked per axis and folded into an offset without building a vector.
+//
+// The buffer is the same copy-on-write Storage that Array uses: copying and
+// converting in either direction (FixedRankArray(const Array&), to_array())
+// share it instead of copying, until a non-const accessor hands out a
+// reference into it (see Storage::leak()).
+template <typename T, size_t Rank>
+class FixedRankArray {
+    static_assert(Rank > 0, "FixedRankArray requires a rank of at least 1");
+
+public:
+    using value_type = T;
+    using shape_type = std::array<size_t, Rank>;
+    static constexpr size_t rank = Rank;
+
+    FixedRankArray() = default;
+    FixedRankArray(const FixedRankArray& other);
+    FixedRankArray(FixedRankArray&& other) noexcept = default;
+    FixedRankArray& operator=(const FixedRankArray& other);
+    FixedRankArray& operator=(FixedRankArray&& other) noexcept = default;
+    explicit FixedRankArray(const shape_type& shape, const T& init_val = T());
+    FixedRankArray(const shape_type& shape, const std::vector<T>& data);
+    // Throws std::invalid_argument if arr.ndim() != Rank. A template so a
+    // braced shape never converts to an Array.
+    template <typename A>
+        requires std::is_base_of_v<Array<T>, A>
+    explicit FixedRankArray(const A& arr);
+
+    Array<T> to_array() const;
+
+    static constexpr size_t ndim() { return Rank; }
+    const shape_type& shape() const { return shape_; }
+    const shape_type& strides() const { return strides_; }
+    size_t size() const { return size_; }
+
+    // Bounds-checked; throws std::out_of_range
+    template <typename... Indices>
+        requires(sizeof...(Indices) == Rank)
+    T& operator()(Indices... indices);
+    template <typename... Indices>
+        requires(sizeof...(Indices) == Rank)
+    const T& operator()(Indices... indices) const;
+
+    // No bounds checks (the non-const overload still unshares the buffer)
+    template <typename... Indices>
+        requires(sizeof...(Indices) == Rank)
+    T& at_unchecked(Indices... indices);
+    template <typename... Indices>
+        requires(sizeof...(Indices) == Rank)
+    const T& at_unchecked(Indices... indices) const;
+
+    // Unchecked view for hot loops; the non-const overload unshares once
+    ArraySpan<T, Rank> span();
+    ArraySpan<const T, Rank> span() const;
+
+    void fill(const T& value);
+
+    T* data();
+    const T* data() const { return data_; }
+    const Storage<T>& storage() const { return storage_; }
+
+private:
+    shape_type shape_ {};
+    shape_type strides_ {};
+    size_t size_ = 0;
+    Storage<T> storage_;
+    T* data_ = nullptr;
+
+    void allocate(const shape_type& shape);
+    void detach();
+    // detach() for accessors handing out a reference into the buffer
+    void leak();
+    template <typename... Indices>
+    size_t checked_index(Indices... indices) const;
+};
+
+} // namespace NumCPP
+
+#include "FixedRankArray.tpp"
+
+#endif // FIXEDRANKARRAY_HPP
@@ -0,0 +1,181 @@
+#ifndef FIXEDRANKARRAY_TPP
+#define FIXEDRANKARRAY_TPP
+
+#include "FixedRankArray.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace NumCPP {
+
+template <typename T, size_t Rank>
+FixedRankArray<T, Rank>::FixedRankArray(const shape_type& shape, const T& init_val)
+{
+    NUMCPP_PROFILE("FixedRankArray::FixedRankArray", detail::extent_product(shape));
+    allocate(shape);
+    detail::fill(data_, size_, init_val);
+}
+
+template <typename T, size_t Rank>
+FixedRankArray<T, Rank>::FixedRankArray(const shape_type& shape, const std::vector<T>& data)
+{
+    NUMCPP_PROFILE("FixedRankArray::FixedRankArray", detail::extent_product(shape));
+    if (data.size() != detail::extent_product(shape))
+        throw std::invalid_argument("Data size does not match shape");
+    allocate(shape);
+    std::copy(data.begin(), data.end(), data_);
+}
+
+template <typename T, size_t Rank>
+template <typename A>
+    requires std::is_base_of_v<Array<T>, A>
+FixedRankArray<T, Rank>::FixedRankArray(const A& arr)
+    : storage_(arr.storage().share())
+    , data_(storage_.data())
+{
+    if (arr.ndim() != Rank)
+        throw std::invalid_argument("Array rank does not match FixedRankArray rank");
+    std::copy(arr.shape().begin(), arr.shape().end(), shape_.begin());
+    strides_ = detail::row_major_strides(shape_);
+    size_ = arr.size();
+}
+
+template <typename T, size_t Rank>
+FixedRankArray<T, Rank>::FixedRankArray(const FixedRankArray& other)
+    : shape_(other.shape_)
+    , strides_(other.strides_)
+    , size_(other.size_)
+    , storage_(other.storage_.share())
+    , data_(storage_.data())
+{
+}
+
+template <typename T, size_t Rank>
+FixedRankArray<T, Rank>& FixedRankArray<T, Rank>::operator=(const FixedRankArray& other)
+{
+    if (this != &other) {
+        shape_ = other.shape_;
+        strides_ = other.strides_;
+        size_ = other.size_;
+        storage_ = other.storage_.share();
+        data_ = storage_.data();
+    }
+    return *this;
+}
+
+template <typename T, size_t Rank>
+Array<T> FixedRankArray<T, Rank>::to_array() const
+{
+    return Array<T>(std::vector<size_t>(shape_.begin(), shape_.end()), storage_);
+}
+
+template <typename T, size_t Rank>
+template <typename... Indices>
+    requires(sizeof...(Indices) == Rank)
+T& FixedRankArray<T, Rank>::operator()(Indices... indices)
+{
+    size_t index = checked_index(indices...);
+    leak();
+    return data_[index];
+}
+
+template <typename T, size_t Rank>
+template <typename... Indices>
+    requires(sizeof...(Indices) == Rank)
+const T& FixedRankArray<T, Rank>::operator()(Indices... indices) const
+{
+    return data_[checked_index(indices...)];
+}
+
+template <typename T, size_t Rank>
+template <typename... Indices>
+    requires(sizeof...(Indices) == Rank)
+T& FixedRankArray<T, Rank>::at_unchecked(Indices... indices)
+{
+    leak();
+    return data_[detail::linear_index(strides_, indices...)];
+}
+
+template <typename T, size_t Rank>
+template <typename... Indices>
+    requires(sizeof...(Indices) == Rank)
+const T& FixedRankArray<T, Rank>::at_unchecked(Indices... indices) const
+{
+    return data_[detail::linear_index(strides_, indices...)];
+}
+
+template <typename T, size_t Rank>
+ArraySpan<T, Rank> FixedRankArray<T, Rank>::span()
+{
+    leak();
+    return ArraySpan<T, Rank>(data_, shape_, strides_);
+}
+
+template <typename T, size_t Rank>
+ArraySpan<const T, Rank> FixedRankArray<T, Rank>::span() const
+{
+    return ArraySpan<const T, Rank>(data_, shape_, strides_);
+}
+
+template <typename T, size_t Rank>
+void FixedRankArray<T, Rank>::fill(const T& value)
+{
+    NUMCPP_PROFILE("FixedRankArray::fill", size_);
+    if (!storage_.writable()) {
+        storage_ = Storage<T>(size_);
+        data_ = storage_.data();
+    }
+    detail::fill(data_, size_, value);
+}
+
+template <typename T, size_t Rank>
+T* FixedRankArray<T, Rank>::data()
+{
+    leak();
+    return data_;
+}
+
+template <typename T, size_t Rank>
+void FixedRankArray<T, Rank>::allocate(const shape_type& shape)
+{
+    for (auto s : shape) {
+        if (s == 0)
+            throw std::invalid_argument("Shape dimensions must be positive");
+    }
+    shape_ = shape;
+    strides_ = detail::row_major_strides(shape_);
+    size_ = detail::extent_product(shape_);
+    storage_ = Storage<T>(size_);
+    data_ = storage_.data();
+}
+
+template <typename T, size_t Rank>
+void FixedRankArray<T, Rank>::detach()
+{
+    if (!storage_.writable()) {
+        storage_.make_unique();
+        data_ = storage_.data();
+    }
+}
+
+template <typename T, size_t Rank>
+void FixedRankArray<T, Rank>::leak()
+{
+    storage_.leak();
+    data_ = storage_.data();
+}
+
+template <typename T, size_t Rank>
+template <typename... Indices>
+size_t FixedRankArray<T, Rank>::checked_index(Indices... indices) const
+{
+    size_t d = 0;
+    bool in_bounds = true;
+    ((in_bounds &= static_cast<size_t>(indices) < shape_[d++]), ...);
+    if (!in_bounds)
+        throw std::out_of_range("Index out of range");
+    return detail::linear_index(strides_, indices...);
+}
+
+} // namespace NumCPP
+
+#endif // FIXEDRANKARRAY_TPP
@@ -0,0 +1,40 @@
+#ifndef GEMM_HPP
+#define GEMM_HPP
+
+#include "Simd.hpp"
+#include <cstddef>
+
+namespace NumCPP {
+
+// Whether an operand of gemm() is read as stored or as its transpose.
+enum class Trans {
+    No,
+    Yes
+};
+
+// C = alpha * op(A) * op(B) + beta * C on row-major buffers, where op(A) is
+// m x k, op(B) is k x n and C is m x n. lda, ldb and ldc are the row strides
+// (in elements) of A, B and C as stored, so a transposed operand is read in
+// place without materializing the transpose.
+//
+// Operands are packed into cache-sized panels and multiplied by a
+// register-blocked SIMD microkernel for the active SimdLevel; blocks of C are
+// distributed over the shared ThreadPool.
+template <typename T>
+void gemm(Trans trans_a, Trans trans_b, size_t m, size_t n, size_t k,
+    T alpha, const T* a, size_t lda, const T* b, size_t ldb,
+    T beta, T* c, size_t ldc);
+
+namespace detail {
+    // Cache blocking: KC x NR slivers of B stay in L1, an MC x KC block of A
+    // in L2 and a KC x NC panel of B in L3.
+    inline constexpr size_t gemm_kc = 256;
+    inline constexpr size_t gemm_mc = 96;
+    inline constexpr size_t gemm_nc = 2048;
+}
+
+} // namespace NumCPP
+
+#include "Gemm.tpp"
+
+#endif // GEMM_HPP
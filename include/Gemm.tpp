@@ -0,0 +1,283 @@
+#ifndef GEMM_TPP
+#define GEMM_TPP
+
+#include "CostModel.hpp"
+#include "Gemm.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace NumCPP {
+
+namespace detail {
+    template <typename T>
+    T gemm_at(Trans trans, const T* data, size_t ld, size_t row, size_t col)
+    {
+        return trans == Trans::No ? data[row * ld + col] : data[col * ld + row];
+    }
+
+    // Packs rows [row0, row0 + mc) and columns [col0, col0 + kc) of op(A)
+    // into slivers of MR rows, each stored column by column and padded with
+    // zeros, so the microkernel reads A sequentially.
+    template <size_t MR, typename T>
+    void gemm_pack_a(Trans trans, const T* a, size_t lda, size_t row0, size_t mc,
+        size_t col0, size_t kc, T* out)
+    {
+        for (size_t ir = 0; ir < mc; ir += MR) {
+            T* dst = out + ir * kc;
+            size_t mr = std::min(MR, mc - ir);
+            if (trans == Trans::No) {
+                for (size_t i = 0; i < mr; i++) {
+                    const T* src = a + (row0 + ir + i) * lda + col0;
+                    for (size_t p = 0; p < kc; p++)
+                        dst[p * MR + i] = src[p];
+                }
+            } else {
+                for (size_t p = 0; p < kc; p++) {
+                    const T* src = a + (col0 + p) * lda + row0 + ir;
+                    for (size_t i = 0; i < mr; i++)
+                        dst[p * MR + i] = src[i];
+                }
+            }
+            for (size_t p = 0; p < kc && mr < MR; p++)
+                for (size_t i = mr; i < MR; i++)
+                    dst[p * MR + i] = T(0);
+        }
+    }
+
+    // Packs sliver `group` (NR columns starting at col0 + group * NR) of the
+    // kc x nc panel of op(B) starting at row0, row by row and zero padded.
+    template <size_t NR, typename T>
+    void gemm_pack_b(Trans trans, const T* b, size_t ldb, size_t row0, size_t kc,
+        size_t col0, size_t nc, size_t group, T* out)
+    {
+        size_t jr = group * NR;
+        size_t nr = std::min(NR, nc - jr);
+        T* dst = out + jr * kc;
+        if (trans == Trans::No) {
+            for (size_t p = 0; p < kc; p++) {
+                const T* src = b + (row0 + p) * ldb + col0 + jr;
+                for (size_t j = 0; j < nr; j++)
+                    dst[p * NR + j] = src[j];
+            }
+        } else {
+            for (size_t j = 0; j < nr; j++) {
+                const T* src = b + (col0 + jr + j) * ldb + row0;
+                for (size_t p = 0; p < kc; p++)
+                    dst[p * NR + j] = src[p];
+            }
+        }
+        for (size_t p = 0; p < kc && nr < NR; p++)
+            for (size_t j = nr; j < NR; j++)
+                dst[p * NR + j] = T(0);
+    }
+
+    // Microkernels compute an MR x NR tile of A * B from packed slivers into
+    // a row-major scratch tile.
+    template <typename T, size_t MR, size_t NR>
+    struct ScalarMicroKernel {
+        static constexpr size_t mr = MR;
+        static constexpr size_t nr = NR;
+
+        static NUMCPP_ALWAYS_INLINE void run(size_t kc, const T* ap, const T* bp, T* tile)
+        {
+            T acc[MR][NR] = {};
+            for (size_t p = 0; p < kc; p++)
+                for (size_t i = 0; i < MR; i++)
+                    for (size_t j = 0; j < NR; j++)
+                        acc[i][j] += ap[p * MR + i] * bp[p * NR + j];
+            for (size_t i = 0; i < MR; i++)
+                for (size_t j = 0; j < NR; j++)
+                    tile[i * NR + j] = acc[i][j];
+        }
+    };
+
+#if NUMCPP_SIMD_VECTOR_EXT
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+    // MR rows times two registers of B per step, held in 2 * MR accumulators
+    template <typename P, size_t MR>
+    struct VectorMicroKernel {
+        using T = typename P::value_type;
+        static constexpr size_t mr = MR;
+        static constexpr size_t nr = 2 * P::width;
+
+        static NUMCPP_ALWAYS_INLINE void run(size_t kc, const T* ap, const T* bp, T* tile)
+        {
+            using reg = typename P::reg;
+            reg acc0[MR];
+            reg acc1[MR];
+            for (size_t i = 0; i < MR; i++)
+                acc0[i] = acc1[i] = P::broadcast(T(0));
+            for (size_t p = 0; p < kc; p++) {
+                reg b0 = P::load(bp + p * nr);
+                reg b1 = P::load(bp + p * nr + P::width);
+                for (size_t i = 0; i < MR; i++) {
+                    reg a = P::broadcast(ap[p * MR + i]);
+                    acc0[i] += a * b0;
+                    acc1[i] += a * b1;
+                }
+            }
+            for (size_t i = 0; i < MR; i++) {
+                P::store(tile + i * nr, acc0[i]);
+                P::store(tile + i * nr + P::width, acc1[i]);
+            }
+        }
+    };
+#pragma GCC diagnostic pop
+#endif
+
+    // C[mc x nc] += alpha * Ap * Bp over all MR x NR tiles of one block
+    template <typename Micro, typename T>
+    NUMCPP_ALWAYS_INLINE void gemm_macro_body(size_t mc, size_t nc, size_t kc,
+        const T* ap, const T* bp, T alpha, T* c, size_t ldc)
+    {
+        constexpr size_t MR = Micro::mr;
+        constexpr size_t NR = Micro::nr;
+        alignas(64) T tile[MR * NR];
+        for (size_t jr = 0; jr < nc; jr += NR) {
+            size_t nr = std::min(NR, nc - jr);
+            for (size_t ir = 0; ir < mc; ir += MR) {
+                size_t mr = std::min(MR, mc - ir);
+                Micro::run(kc, ap + ir * kc, bp + jr * kc, tile);
+                T* dst = c + ir * ldc + jr;
+                for (size_t i = 0; i < mr; i++)
+                    for (size_t j = 0; j < nr; j++)
+                        dst[i * ldc + j] += alpha * tile[i * NR + j];
+            }
+        }
+    }
+
+    template <typename T>
+    using GemmMacroKernel = void (*)(size_t, size_t, size_t, const T*, const T*, T, T*, size_t);
+
+    template <typename T>
+    void gemm_macro_scalar(size_t mc, size_t nc, size_t kc, const T* ap, const T* bp,
+        T alpha, T* c, size_t ldc)
+    {
+        gemm_macro_body<ScalarMicroKernel<T, 4, 4>>(mc, nc, kc, ap, bp, alpha, c, ldc);
+    }
+
+#if NUMCPP_SIMD_X86
+#define NUMCPP_GEMM_ENTRY_POINT(SUFFIX, TARGET, BYTES, MR)                                      \
+    template <typename T>                                                                       \
+    TARGET void gemm_macro_##SUFFIX(size_t mc, size_t nc, size_t kc, const T* ap, const T* bp,  \
+        T alpha, T* c, size_t ldc)                                                              \
+    {                                                                                           \
+        gemm_macro_body<VectorMicroKernel<simd::Pack<T, BYTES>, MR>>(mc, nc, kc, ap, bp, alpha, \
+            c, ldc);                                                                            \
+    }
+
+    NUMCPP_GEMM_ENTRY_POINT(sse2, NUMCPP_TARGET_SSE2, 16, 4)
+    NUMCPP_GEMM_ENTRY_POINT(avx2, NUMCPP_TARGET_AVX2, 32, 6)
+    NUMCPP_GEMM_ENTRY_POINT(avx512, NUMCPP_TARGET_AVX512, 64, 8)
+
+#undef NUMCPP_GEMM_ENTRY_POINT
+#endif
+
+    // Loops over NC column panels and KC-deep slices of op(B); each slice is
+    // packed once and shared, then (MC block of A) x (range of B slivers)
+    // tasks are spread over the pool, each packing its own block of A.
+    template <size_t MR, size_t NR, typename T>
+    void gemm_blocked(Trans trans_a, Trans trans_b, size_t m, size_t n, size_t k,
+        T alpha, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc,
+        GemmMacroKernel<T> macro)
+    {
+        constexpr size_t mc_max = std::max(gemm_mc / MR, size_t(1)) * MR;
+        constexpr size_t nc_max = std::max(gemm_nc / NR, size_t(1)) * NR;
+        // Every element of C costs k multiply-adds
+        const bool parallel = CostModel::instance().threads(m * n, KernelCost { 0, 2.0 * double(k), 0 }) > 1;
+        const size_t threads = ThreadPool::instance().num_threads();
+        const size_t m_blocks = (m + mc_max - 1) / mc_max;
+        std::vector<T> b_pack;
+
+        for (size_t jc = 0; jc < n; jc += nc_max) {
+            size_t nc = std::min(nc_max, n - jc);
+            size_t groups = (nc + NR - 1) / NR;
+            size_t n_split = parallel ? std::min(groups, std::max(size_t(1), (2 * threads + m_blocks - 1) / m_blocks)) : 1;
+            size_t tasks = m_blocks * n_split;
+
+            for (size_t pc = 0; pc < k; pc += gemm_kc) {
+                size_t kc = std::min(gemm_kc, k - pc);
+                b_pack.resize(groups * NR * kc);
+                T* bp = b_pack.data();
+                parallel_for(0, groups, [&](size_t start, size_t end) {
+                    for (size_t g = start; g < end; g++)
+                        gemm_pack_b<NR>(trans_b, b, ldb, pc, kc, jc, nc, g, bp);
+                }, parallel ? 1 : groups);
+
+                parallel_for(0, tasks, [&](size_t start, size_t end) {
+                    thread_local std::vector<T> a_pack;
+                    a_pack.resize(mc_max * kc);
+                    for (size_t t = start; t < end; t++) {
+                        size_t ic = (t / n_split) * mc_max;
+                        size_t part = t % n_split;
+                        size_t g0 = groups * part / n_split;
+                        size_t g1 = groups * (part + 1) / n_split;
+                        if (g0 == g1)
+                            continue;
+                        size_t mc = std::min(mc_max, m - ic);
+                        size_t j0 = g0 * NR;
+                        size_t j1 = std::min(g1 * NR, nc);
+                        gemm_pack_a<MR>(trans_a, a, lda, ic, mc, pc, kc, a_pack.data());
+                        macro(mc, j1 - j0, kc, a_pack.data(), bp + j0 * kc, alpha,
+                            c + ic * ldc + jc + j0, ldc);
+                    }
+                }, parallel ? 1 : tasks);
+            }
+        }
+    }
+
+    template <typename T>
+    void gemm_scale(size_t m, size_t n, T beta, T* c, size_t ldc)
+    {
+        size_t grain = parallel_grain(KernelCost::stream<T>(1, 1) * double(n));
+        parallel_for(0, m, [&](size_t start, size_t end) {
+            for (size_t i = start; i < end; i++) {
+                T* row = c + i * ldc;
+                if (beta == T(0))
+                    std::fill(row, row + n, T(0));
+                else
+                    for (size_t j = 0; j < n; j++)
+                        row[j] *= beta;
+            }
+        }, grain);
+    }
+}
+
+template <typename T>
+void gemm(Trans trans_a, Trans trans_b, size_t m, size_t n, size_t k,
+    T alpha, const T* a, size_t lda, const T* b, size_t ldb,
+    T beta, T* c, size_t ldc)
+{
+    if (m == 0 || n == 0)
+        return;
+    if (beta != T(1))
+        detail::gemm_scale(m, n, beta, c, ldc);
+    if (k == 0 || alpha == T(0))
+        return;
+
+#if NUMCPP_SIMD_X86
+    if constexpr (simd::Vectorizable<T>) {
+        switch (simd_level()) {
+        case SimdLevel::AVX512:
+            return detail::gemm_blocked<8, 128 / sizeof(T)>(trans_a, trans_b, m, n, k, alpha, a, lda,
+                b, ldb, c, ldc, &detail::gemm_macro_avx512<T>);
+        case SimdLevel::AVX2:
+            return detail::gemm_blocked<6, 64 / sizeof(T)>(trans_a, trans_b, m, n, k, alpha, a, lda,
+                b, ldb, c, ldc, &detail::gemm_macro_avx2<T>);
+        case SimdLevel::SSE2:
+            return detail::gemm_blocked<4, 32 / sizeof(T)>(trans_a, trans_b, m, n, k, alpha, a, lda,
+                b, ldb, c, ldc, &detail::gemm_macro_sse2<T>);
+        default:
+            break;
+        }
+    }
+#endif
+    detail::gemm_blocked<4, 4>(trans_a, trans_b, m, n, k, alpha, a, lda, b, ldb, c, ldc,
+        &detail::gemm_macro_scalar<T>);
+}
+
+} // namespace NumCPP
+
+#endif // GEMM_TPP
@@ -0,0 +1,151 @@
+#ifndef MATH_HPP
+#define MATH_HPP
+
+#include "Array.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <type_traits>
+
+namespace NumCPP {
+
+// Element-wise math functions. Each returns a lazy node like the arithmetic
+// operators, so sigmoid(a * w + b) runs as one fused, parallel pass and may
+// take over the buffer of an expiring operand. The two-argument forms write
+// into an existing array of the same shape, which may be the operand itself:
+// exp(a, a) updates a in place. An operand that reads the output at another
+// index, like exp(a.view().transpose(), a), is evaluated into a new buffer
+// that replaces a's (see evaluate() in Expression.hpp).
+//
+// float and double arrays are evaluated on the active SimdLevel with the
+// polynomial approximations of Math.tpp; other value types and
+// SimdLevel::Scalar call the C library per element (and cast the result back
+// to the value type). Largest errors of the SIMD forms in ULP, as measured
+// against a long double reference over each function's domain:
+//
+//              double  float
+//   sqrt       0.5     0.5     correctly rounded
+//   rsqrt      1.5     1.5
+//   exp        1.5     1.5
+//   expm1      2       2
+//   log        1       1
+//   log1p      2.5     2.5
+//   sin, cos   2.5     2.5     |x| < 2^20 (double), 8192 (float); larger
+//                              arguments are reduced by the C library
+//   tanh       2.5     2.5
+//   sigmoid    2.5     2.5
+//   erf        2       2
+//
+// NaN propagates through every function, exp overflows to inf and
+// underflows through the subnormals to 0, and log of a negative number is
+// NaN, as in the C library.
+
+#define NUMCPP_DECLARE_UFUNC(NAME)           \
+    template <Expression E>                  \
+    auto NAME(E&& expr);                     \
+    template <Expression E, typename T>      \
+    void NAME(E&& expr, Array<T>& out);
+
+NUMCPP_DECLARE_UFUNC(abs)
+NUMCPP_DECLARE_UFUNC(sqrt)
+// 1 / sqrt(x)
+NUMCPP_DECLARE_UFUNC(rsqrt)
+NUMCPP_DECLARE_UFUNC(exp)
+// exp(x) - 1, accurate near 0
+NUMCPP_DECLARE_UFUNC(expm1)
+NUMCPP_DECLARE_UFUNC(log)
+// log(1 + x), accurate near 0
+NUMCPP_DECLARE_UFUNC(log1p)
+NUMCPP_DECLARE_UFUNC(sin)
+NUMCPP_DECLARE_UFUNC(cos)
+NUMCPP_DECLARE_UFUNC(tanh)
+// 1 / (1 + exp(-x))
+NUMCPP_DECLARE_UFUNC(sigmoid)
+NUMCPP_DECLARE_UFUNC(erf)
+
+#undef NUMCPP_DECLARE_UFUNC
+
+// Limits every element to [lo, hi]
+template <Expression E>
+auto clip(E&& expr, const std::type_identity_t<expr_value_t<E>>& lo,
+    const std::type_identity_t<expr_value_t<E>>& hi);
+template <Expression E, typename T>
+void clip(E&& expr, const std::type_identity_t<T>& lo, const std::type_identity_t<T>& hi, Array<T>& out);
+
+namespace detail {
+#if NUMCPP_SIMD_VECTOR_EXT
+    // The approximations on one register of float or double lanes
+    template <typename P>
+    struct VectorMath;
+
+    template <typename P>
+    concept FloatPack = std::is_floating_point_v<typename P::value_type>;
+
+#define NUMCPP_PACKET_MATH(FUNCTION)                                      \
+    template <FloatPack P>                                                \
+    static NUMCPP_ALWAYS_INLINE typename P::reg packet(typename P::reg a) \
+    {                                                                     \
+        return VectorMath<P>::FUNCTION(a);                                \
+    }
+#else
+#define NUMCPP_PACKET_MATH(FUNCTION)
+#endif
+
+    // Evaluated through exp(-|x|), which cannot overflow
+    template <typename T>
+    T sigmoid_scalar(const T& a)
+    {
+        auto e = std::exp(-std::abs(a));
+        return static_cast<T>((a < 0 ? e : 1) / (1 + e));
+    }
+
+    // Costs are SIMD-lane operations of the approximations
+#define NUMCPP_MATH_OP(NAME, FUNCTION, OPS, SCALAR)                       \
+    struct NAME {                                                         \
+        static constexpr KernelCost cost { 0, OPS, 0 };                   \
+        template <typename T>                                             \
+        static T apply(const T& a) { return static_cast<T>(SCALAR); }     \
+        NUMCPP_PACKET_MATH(FUNCTION)                                      \
+    };
+
+    NUMCPP_MATH_OP(Sqrt, sqrt, 4, std::sqrt(a))
+    NUMCPP_MATH_OP(Rsqrt, rsqrt, 8, 1 / std::sqrt(a))
+    NUMCPP_MATH_OP(Exp, exp, 20, std::exp(a))
+    NUMCPP_MATH_OP(Expm1, expm1, 24, std::expm1(a))
+    NUMCPP_MATH_OP(Log, log, 28, std::log(a))
+    NUMCPP_MATH_OP(Log1p, log1p, 36, std::log1p(a))
+    NUMCPP_MATH_OP(Sin, sin, 28, std::sin(a))
+    NUMCPP_MATH_OP(Cos, cos, 28, std::cos(a))
+    NUMCPP_MATH_OP(Tanh, tanh, 30, std::tanh(a))
+    NUMCPP_MATH_OP(Sigmoid, sigmoid, 28, sigmoid_scalar(a))
+    NUMCPP_MATH_OP(Erf, erf, 50, std::erf(a))
+
+#undef NUMCPP_MATH_OP
+#undef NUMCPP_PACKET_MATH
+
+    struct Abs {
+        template <typename T>
+        static T apply(const T& a)
+        {
+            if constexpr (std::is_unsigned_v<T>)
+                return a;
+            else
+                return static_cast<T>(std::abs(a));
+        }
+#if NUMCPP_SIMD_VECTOR_EXT
+        template <typename P>
+        static NUMCPP_ALWAYS_INLINE typename P::reg packet(typename P::reg a)
+        {
+            if constexpr (FloatPack<P>)
+                return VectorMath<P>::abs(a);
+            else
+                return P::select(a < P::broadcast(0), -a, a);
+        }
+#endif
+    };
+}
+
+} // namespace NumCPP
+
+#include "Math.tpp"
+
+#endif // MATH_HPP
@@ -0,0 +1,369 @@
+#ifndef MATH_TPP
+#define MATH_TPP
+
+#include "Math.hpp"
+#include <cstdint>
+#include <limits>
+
+namespace NumCPP {
+
+namespace detail {
+    // Constants of the approximations. exp and expm1 are Taylor series on
+    // |r| <= ln2 / 2 after r = x - n ln2; log follows fdlibm on
+    // [sqrt(1/2), sqrt(2)); sin and cos reduce by n pi / 2 in four parts
+    // (Cody-Waite, all but the last short enough that n * part is exact below
+    // trig_limit) and use the fdlibm (double) and Cephes (float) kernels on
+    // |r| <= pi / 4; erf is Chebyshev-fitted, as x P(x^2) below erf_split
+    // and as 1 - exp(-x^2) Q(1 / x) above.
+    template <typename T>
+    struct MathConstants;
+
+    template <>
+    struct MathConstants<double> {
+        using bits = std::int64_t;
+        static constexpr int mantissa = 52;
+        static constexpr int bias = 1023;
+
+        static constexpr double log2e = 1.4426950408889634;
+        // ln2 with a short high part, so n * ln2_hi is exact
+        static constexpr double ln2_hi = 6.93147180369123816490e-01;
+        static constexpr double ln2_lo = 1.90821492927058770002e-10;
+        // exp rounds to 0 below and to inf above
+        static constexpr double exp_min = -746;
+        static constexpr double exp_max = 710;
+        // expm1 is -1 below, and exp(x) - 1 is exact enough above
+        static constexpr double expm1_min = -40;
+        static constexpr double expm1_max = 36;
+        static constexpr double exp[] = { 1.0, 1.0, 1.0 / 2, 1.0 / 6, 1.0 / 24, 1.0 / 120, 1.0 / 720, 1.0 / 5040,
+            1.0 / 40320, 1.0 / 362880, 1.0 / 3628800, 1.0 / 39916800, 1.0 / 479001600, 1.0 / 6227020800 };
+        // (expm1(r) - r) / r^2
+        static constexpr double expm1[] = { 1.0 / 2, 1.0 / 6, 1.0 / 24, 1.0 / 120, 1.0 / 720, 1.0 / 5040,
+            1.0 / 40320, 1.0 / 362880, 1.0 / 3628800, 1.0 / 39916800, 1.0 / 479001600, 1.0 / 6227020800 };
+
+        static constexpr bits one_bits = 0x3ff0000000000000;
+        static constexpr bits sqrt_half_bits = 0x3fe6a09e00000000;
+        static constexpr double log[] = { 6.666666666666735130e-01, 3.999999999940941908e-01,
+            2.857142874366239149e-01, 2.222219843214978396e-01, 1.818357216161805012e-01,
+            1.531383769920937332e-01, 1.479819860511658591e-01 };
+
+        static constexpr double two_over_pi = 6.36619772367581382433e-01;
+        static constexpr double pio2_1 = 1.57079632673412561417e+00;
+        static constexpr double pio2_2 = 6.07710050630396597660e-11;
+        static constexpr double pio2_3 = 2.02226624871116645580e-21;
+        static constexpr double pio2_4 = 8.47842766036889956997e-32;
+        static constexpr double trig_limit = 1048576;
+        static constexpr double sin[] = { -1.66666666666666324348e-01, 8.33333333332248946124e-03,
+            -1.98412698298579493134e-04, 2.75573137070700676789e-06, -2.50507602534068634195e-08,
+            1.58969099521155010221e-10 };
+        static constexpr double cos[] = { 4.16666666666666019037e-02, -1.38888888888741095749e-03,
+            2.48015872894767294178e-05, -2.75573143513906633035e-07, 2.08757232129817482790e-09,
+            -1.13596475577881948265e-11 };
+
+        static constexpr double erf_split = 1.25;
+        // erf is 1 above
+        static constexpr double erf_max = 6;
+        // Maps x^2 in [0, 1.25^2] and 1 / x in [1 / 6, 1 / 1.25] to [-1, 1]
+        static constexpr double erf_small_scale = 1.28;
+        static constexpr double erf_large_scale = 3.1578947368421053;
+        static constexpr double erf_large_offset = 1.5263157894736843;
+        static constexpr double erf_small[] = { 0.89231270144837271, -0.18785153701199006, 0.039988334902665852,
+            -0.0070474879771367143, 0.0010344964249648383, -0.00012916310199243011, 1.3987572600495908e-05,
+            -1.3353422520467851e-06, 1.1388354164820064e-07, -8.7719459662596172e-09, 6.1582151530958917e-10,
+            -3.9740545923483417e-11, 2.3653023983882804e-12, -1.094783985688963e-13, 7.2164496600635175e-15,
+            -5.7592819402429996e-15 };
+        static constexpr double erf_large[] = { 0.24822427604712274, 0.13723950555296513, -0.018707650540205636,
+            0.00058090028134976279, 0.00072542522908067221, -0.00029881063805862877, 6.4310524825801876e-05,
+            -1.6040195103960049e-06, -5.7065305895203936e-06, 3.0757000377742504e-06, -9.7145747447796231e-07,
+            1.5731014307790793e-07, 3.6969199317810063e-08, -4.3261102255706672e-08, 2.0678916952399097e-08,
+            -7.1152064212709478e-09, 1.9330251510574214e-09, 2.7005013225611664e-10, -7.2745123258499691e-10,
+            2.4524322572716529e-10 };
+    };
+
+    template <>
+    struct MathConstants<float> {
+        using bits = std::int32_t;
+        static constexpr int mantissa = 23;
+        static constexpr int bias = 127;
+
+        static constexpr float log2e = 1.44269504f;
+        static constexpr float ln2_hi = 0.693359375f;
+        static constexpr float ln2_lo = -2.12194440e-4f;
+        static constexpr float exp_min = -104;
+        static constexpr float exp_max = 89;
+        static constexpr float expm1_min = -18;
+        static constexpr float expm1_max = 16;
+        static constexpr float exp[] = { 1.0f, 1.0f, 1.0f / 2, 1.0f / 6, 1.0f / 24, 1.0f / 120, 1.0f / 720,
+            1.0f / 5040 };
+        static constexpr float expm1[] = { 1.0f / 2, 1.0f / 6, 1.0f / 24, 1.0f / 120, 1.0f / 720, 1.0f / 5040 };
+
+        static constexpr bits one_bits = 0x3f800000;
+        static constexpr bits sqrt_half_bits = 0x3f3504f3;
+        static constexpr float log[] = { 0xaaaaaa.0p-24f, 0xccce13.0p-25f, 0x91e9ee.0p-25f, 0xf89e26.0p-26f };
+
+        static constexpr float two_over_pi = 0.636619772f;
+        static constexpr float pio2_1 = 1.5703125f;
+        static constexpr float pio2_2 = 4.837512969970703125e-4f;
+        static constexpr float pio2_3 = 0x1.444p-24f;
+        static constexpr float pio2_4 = 0x1.68c234p-39f;
+        static constexpr float trig_limit = 8192;
+        static constexpr float sin[] = { -1.6666654611e-1f, 8.3321608736e-3f, -1.9515295891e-4f };
+        static constexpr float cos[] = { 4.166664568298827e-2f, -1.388731625493765e-3f, 2.443315711809948e-5f };
+
+        static constexpr float erf_split = 1.25f;
+        static constexpr float erf_max = 4;
+        static constexpr float erf_small_scale = 1.28f;
+        static constexpr float erf_large_scale = 3.63636364f;
+        static constexpr float erf_large_offset = 1.90909091f;
+        static constexpr float erf_small[] = { 0.892312706f, -0.187851533f, 0.039988365f, -0.00704749022f,
+            0.0010343527f, -0.000129152046f, 1.42170411e-05f, -1.35299581e-06f };
+        static constexpr float erf_large[] = { 0.265959769f, 0.114937946f, -0.0138839381f, 0.0005986701f,
+            0.000311656739f, -0.000123865393f, 2.37204258e-05f, -1.02337538e-06f };
+    };
+
+#if NUMCPP_SIMD_VECTOR_EXT
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+    template <typename P>
+    struct VectorMath {
+        using T = typename P::value_type;
+        using C = MathConstants<T>;
+        using reg = typename P::reg;
+        // Integer lanes of the same width
+        using ireg = typename P::mask;
+        typedef std::make_unsigned_t<typename C::bits> ureg __attribute__((vector_size(P::bytes)));
+
+        static NUMCPP_ALWAYS_INLINE reg abs(reg x)
+        {
+            return from_bits(bits(x) & ~sign_bit());
+        }
+
+        static NUMCPP_ALWAYS_INLINE reg sqrt(reg x) { return P::sqrt(x); }
+
+        static NUMCPP_ALWAYS_INLINE reg rsqrt(reg x) { return T(1) / P::sqrt(x); }
+
+        static NUMCPP_ALWAYS_INLINE reg exp(reg x)
+        {
+            // NaN passes the clamp
+            reg clamped = P::min(P::max(x, P::broadcast(C::exp_min)), P::broadcast(C::exp_max));
+            ireg n;
+            reg fn = round(clamped * C::log2e, n);
+            reg r = (clamped - fn * C::ln2_hi) - fn * C::ln2_lo;
+            // 2^n in two factors: subnormal results round once, and results
+            // near the overflow threshold do not overflow early
+            ireg half = n >> 1;
+            return horner(r, C::exp) * pow2(half) * pow2(n - half);
+        }
+
+        static NUMCPP_ALWAYS_INLINE reg expm1(reg x)
+        {
+            reg clamped = P::min(P::max(x, P::broadcast(C::expm1_min)), P::broadcast(C::expm1_max));
+            ireg n;
+            reg fn = round(clamped * C::log2e, n);
+            reg r = (clamped - fn * C::ln2_hi) - fn * C::ln2_lo;
+            reg q = r + r * r * horner(r, C::expm1);
+            reg scale = pow2(n);
+            reg result = scale * q + (scale - T(1));
+            ireg large = x > P::broadcast(C::expm1_max);
+            if (any(large))
+                result = P::select(large, exp(x) - T(1), result);
+            return result;
+        }
+
+        static NUMCPP_ALWAYS_INLINE reg log(reg x)
+        {
+            // Subnormals are scaled into the normal range
+            constexpr int shift = C::mantissa + 2;
+            ireg tiny = x < P::broadcast(std::numeric_limits<T>::min());
+            reg scaled = P::select(tiny, x * T(std::uint64_t(1) << shift), x);
+
+            // x = 2^k m with m in [sqrt(1/2), sqrt(2))
+            // Unsigned lanes: negative and NaN inputs wrap instead of overflowing
+            typedef std::make_unsigned_t<typename C::bits> ubits;
+            ureg ux = reinterpret_cast<ureg>(bits(scaled)) + ubits(C::one_bits - C::sqrt_half_bits);
+            ireg ix = reinterpret_cast<ireg>(ux);
+            ireg k = reinterpret_cast<ireg>(ux >> C::mantissa) - C::bias - (tiny & shift);
+            constexpr typename C::bits fraction = (typename C::bits(1) << C::mantissa) - 1;
+            reg f = from_bits((ix & fraction) + C::sqrt_half_bits) - T(1);
+
+            reg hfsq = T(0.5) * f * f;
+            reg s = f / (T(2) + f);
+            reg z = s * s;
+            reg R = z * horner(z, C::log);
+            reg dk = to_real(k);
+            reg result = s * (hfsq + R) + dk * C::ln2_lo - hfsq + f + dk * C::ln2_hi;
+
+            const T inf = std::numeric_limits<T>::infinity();
+            result = P::select(x == inf, x, result);
+            result = P::select(x == T(0), P::broadcast(-inf), result);
+            return P::select((x < T(0)) | (x != x), P::broadcast(std::numeric_limits<T>::quiet_NaN()), result);
+        }
+
+        static NUMCPP_ALWAYS_INLINE reg log1p(reg x)
+        {
+            // log(u) (x / (u - 1)) with u = 1 + x cancels the rounding of u
+            reg u = T(1) + x;
+            reg result = log(u) * (x / (u - T(1)));
+            result = P::select(u == T(1), x, result);
+            return P::select(x == std::numeric_limits<T>::infinity(), x, result);
+        }
+
+        static NUMCPP_ALWAYS_INLINE reg sin(reg x) { return trig(x, 0); }
+
+        static NUMCPP_ALWAYS_INLINE reg cos(reg x) { return trig(x, 1); }
+
+        static NUMCPP_ALWAYS_INLINE reg tanh(reg x)
+        {
+            // -expm1(-2|x|) / (2 + expm1(-2|x|)) stays accurate near 0
+            reg t = expm1(T(-2) * abs(x));
+            return copysign(-t / (T(2) + t), x);
+        }
+
+        static NUMCPP_ALWAYS_INLINE reg sigmoid(reg x)
+        {
+            // exp(x) / (1 + exp(x)) for negative x keeps tiny results; one
+            // division rounds once where e * (1 / (1 + e)) rounds twice
+            reg e = exp(-abs(x));
+            reg d = T(1) + e;
+            return P::select(x < T(0), e, P::broadcast(T(1))) / d;
+        }
+
+        static NUMCPP_ALWAYS_INLINE reg erf(reg x)
+        {
+            reg a = abs(x);
+            reg result = P::broadcast(T(1));
+            ireg small = a < P::broadcast(C::erf_split);
+            if (any(small))
+                result = P::select(small, a * horner(a * a * C::erf_small_scale - T(1), C::erf_small), result);
+            ireg large = ~small & (a < P::broadcast(C::erf_max));
+            if (any(large)) {
+                reg q = horner((T(1) / a) * C::erf_large_scale - C::erf_large_offset, C::erf_large);
+                result = P::select(large, T(1) - exp(-(a * a)) * q, result);
+            }
+            return copysign(P::select(a != a, a, result), x);
+        }
+
+    private:
+        // Vector casts rather than std::bit_cast, which unoptimized builds
+        // call out of line without the AVX target of the register
+        static NUMCPP_ALWAYS_INLINE ireg bits(reg x) { return reinterpret_cast<ireg>(x); }
+        static NUMCPP_ALWAYS_INLINE reg from_bits(ireg b) { return reinterpret_cast<reg>(b); }
+        static NUMCPP_ALWAYS_INLINE ireg sign_bit() { return ireg {} + std::numeric_limits<typename C::bits>::min(); }
+
+        static NUMCPP_ALWAYS_INLINE reg copysign(reg magnitude, reg sign)
+        {
+            return from_bits((bits(magnitude) & ~sign_bit()) | (bits(sign) & sign_bit()));
+        }
+
+        static NUMCPP_ALWAYS_INLINE bool any(ireg m)
+        {
+            ireg folded = m;
+            for (size_t k = 1; k < P::width; k++)
+                folded[0] |= m[k];
+            return folded[0] != 0;
+        }
+
+        // Nearest integer of x as a float and as integer lanes n; adding
+        // 1.5 * 2^mantissa leaves it in the low bits. Valid for
+        // |x| < 2^(mantissa - 1).
+        static NUMCPP_ALWAYS_INLINE reg round(reg x, ireg& n)
+        {
+            const reg shift = P::broadcast(T(1.5) * T(std::uint64_t(1) << C::mantissa));
+            reg t = x + shift;
+            n = bits(t) - bits(shift);
+            return t - shift;
+        }
+
+        // Inverse of round() for small integers
+        static NUMCPP_ALWAYS_INLINE reg to_real(ireg n)
+        {
+            const reg shift = P::broadcast(T(1.5) * T(std::uint64_t(1) << C::mantissa));
+            return from_bits(n + bits(shift)) - shift;
+        }
+
+        // 2^n for n in the normal exponent range
+        static NUMCPP_ALWAYS_INLINE reg pow2(ireg n) { return from_bits((n + C::bias) << C::mantissa); }
+
+        // c[0] + c[1] x + c[2] x^2 + ...
+        template <size_t N>
+        static NUMCPP_ALWAYS_INLINE reg horner(reg x, const T (&c)[N])
+        {
+            reg result = P::broadcast(c[N - 1]);
+            for (size_t k = N - 1; k-- > 0;)
+                result = result * x + c[k];
+            return result;
+        }
+
+        // sin(x) for quadrant offset 0, cos(x) = sin(x + pi / 2) for 1
+        static NUMCPP_ALWAYS_INLINE reg trig(reg x, int offset)
+        {
+            ireg n;
+            reg fn = round(x * C::two_over_pi, n);
+            reg r = (((x - fn * C::pio2_1) - fn * C::pio2_2) - fn * C::pio2_3) - fn * C::pio2_4;
+            reg z = r * r;
+            reg s = r + r * z * horner(z, C::sin);
+            reg hz = T(0.5) * z;
+            reg w = T(1) - hz;
+            reg c = w + (((T(1) - w) - hz) + z * z * horner(z, C::cos));
+
+            n = n + offset;
+            reg result = P::select((n & 1) == 0, s, c);
+            result = P::select((n & 2) == 0, result, -result);
+
+            // inf and arguments too large to reduce exactly above
+            ireg huge = abs(x) > P::broadcast(C::trig_limit);
+            if (any(huge)) {
+                for (size_t k = 0; k < P::width; k++)
+                    if (huge[k])
+                        result[k] = offset ? std::cos(x[k]) : std::sin(x[k]);
+            }
+            return result;
+        }
+    };
+#pragma GCC diagnostic pop
+#endif
+}
+
+#define NUMCPP_DEFINE_UFUNC(NAME, FUNCTOR)                                       \
+    template <Expression E>                                                      \
+    auto NAME(E&& expr)                                                          \
+    {                                                                            \
+        return UnaryExpr<detail::FUNCTOR, operand_t<E>>(std::forward<E>(expr));  \
+    }                                                                            \
+    template <Expression E, typename T>                                          \
+    void NAME(E&& expr, Array<T>& out)                                           \
+    {                                                                            \
+        evaluate(NAME(std::forward<E>(expr)), out);                              \
+    }
+
+NUMCPP_DEFINE_UFUNC(abs, Abs)
+NUMCPP_DEFINE_UFUNC(sqrt, Sqrt)
+NUMCPP_DEFINE_UFUNC(rsqrt, Rsqrt)
+NUMCPP_DEFINE_UFUNC(exp, Exp)
+NUMCPP_DEFINE_UFUNC(expm1, Expm1)
+NUMCPP_DEFINE_UFUNC(log, Log)
+NUMCPP_DEFINE_UFUNC(log1p, Log1p)
+NUMCPP_DEFINE_UFUNC(sin, Sin)
+NUMCPP_DEFINE_UFUNC(cos, Cos)
+NUMCPP_DEFINE_UFUNC(tanh, Tanh)
+NUMCPP_DEFINE_UFUNC(sigmoid, Sigmoid)
+NUMCPP_DEFINE_UFUNC(erf, Erf)
+
+#undef NUMCPP_DEFINE_UFUNC
+
+template <Expression E>
+auto clip(E&& expr, const std::type_identity_t<expr_value_t<E>>& lo,
+    const std::type_identity_t<expr_value_t<E>>& hi)
+{
+    using Lower = ScalarExpr<detail::Maximum, operand_t<E>, false>;
+    return ScalarExpr<detail::Minimum, Lower, false>(Lower(std::forward<E>(expr), lo), hi);
+}
+
+template <Expression E, typename T>
+void clip(E&& expr, const std::type_identity_t<T>& lo, const std::type_identity_t<T>& hi, Array<T>& out)
+{
+    evaluate(clip(std::forward<E>(expr), lo, hi), out);
+}
+
+} // namespace NumCPP
+
+#endif // MATH_TPP
@@ -2,24 +2,32 @@
 #define MATRIX_HPP
 
 #include "Array.hpp"
+#include "Gemm.hpp"
 #include <stdexcept>
 #include <vector>
 
 namespace NumCPP {
 
+template <typename T>
+class CsrMatrix;
+
+// A 2D Array with matrix operations. A Matrix owns its Array by value, so
+// it shares storage the way Arrays do: constructing one from an Array, copying
+// it, or returning it copies no elements, and a write to any of them first
+// gives the writer its own buffer (copy-on-write). The element buffer is
+// released with the last Array or Matrix using it.
 template <typename T>
 class Matrix {
 public:
-    // Constructor and Destructor
-    Matrix();
-    ~Matrix();
-    Matrix(Array<T>& arr);
-
-    Matrix(const Matrix<T>& other);
-    Matrix(Matrix<T>&& other) noexcept;
+    // Empty matrix without a shape
+    Matrix() = default;
+    // Shares arr's storage; throws std::invalid_argument unless arr is 2D
+    Matrix(Array<T> arr);
 
-    Matrix<T>& operator=(const Matrix<T>& other);
-    Matrix<T>& operator=(Matrix<T>&& other) noexcept;
+    Matrix(const Matrix<T>& other) = default;
+    Matrix(Matrix<T>&& other) noexcept = default;
+    Matrix<T>& operator=(const Matrix<T>& other) = default;
+    Matrix<T>& operator=(Matrix<T>&& other) noexcept = default;
 
     Matrix(const std::vector<size_t>& shape, const T& init_val = T());
     Matrix(std::initializer_list<size_t> shape, const T& init_val = T());
@@ -27,6 +35,9 @@ public:
     Matrix(const std::vector<size_t>& shape, const std::vector<T>& data);
     Matrix(std::initializer_list<size_t> shape, const std::vector<T>& data);
 
+    // The underlying Array, sharing this matrix's storage
+    const Array<T>& array() const { return arr_; }
+
     // Basic Matrix Properties
     std::vector<size_t> shape() const;
     size_t ndim() const;
@@ -75,17 +86,32 @@ public:
 
     // Matrix-specific operations
     Matrix<T> transpose() const;
-    Matrix<T> dot(const Matrix<T>& other) const;
-
-    // Arithmetic Operators (element-wise)
-    Matrix<T> operator+(const Matrix<T>& other) const;
-    Matrix<T> operator-(const Matrix<T>& other) const;
-    Matrix<T> operator*(const Matrix<T>& other) const;
-    Matrix<T> operator/(const Matrix<T>& other) const;
-    Matrix<T> operator+(const T& scalar) const;
-    Matrix<T> operator-(const T& scalar) const;
-    Matrix<T> operator*(const T& scalar) const;
-    Matrix<T> operator/(const T& scalar) const;
+    // Matrix product op(this) * op(other); a transposed operand is read in
+    // place rather than copied
+    Array<T> dot(const Matrix<T>& other, Trans trans_self = Trans::No,
+        Trans trans_other = Trans::No) const;
+    // this * sparse, visiting only the stored entries (defined in Sparse.hpp)
+    Array<T> dot(const CsrMatrix<T>& other) const;
+
+    // Arithmetic Operators (element-wise). The && forms write into the
+    // expiring left operand's buffer when it is not shared, so chains such
+    // as (a + b) * c allocate one result.
+    Matrix<T> operator+(const Matrix<T>& other) const&;
+    Matrix<T> operator-(const Matrix<T>& other) const&;
+    Matrix<T> operator*(const Matrix<T>& other) const&;
+    Matrix<T> operator/(const Matrix<T>& other) const&;
+    Matrix<T> operator+(const Matrix<T>& other) &&;
+    Matrix<T> operator-(const Matrix<T>& other) &&;
+    Matrix<T> operator*(const Matrix<T>& other) &&;
+    Matrix<T> operator/(const Matrix<T>& other) &&;
+    Matrix<T> operator+(const T& scalar) const&;
+    Matrix<T> operator-(const T& scalar) const&;
+    Matrix<T> operator*(const T& scalar) const&;
+    Matrix<T> operator/(const T& scalar) const&;
+    Matrix<T> operator+(const T& scalar) &&;
+    Matrix<T> operator-(const T& scalar) &&;
+    Matrix<T> operator*(const T& scalar) &&;
+    Matrix<T> operator/(const T& scalar) &&;
     Matrix<T>& operator+=(const Matrix<T>& other);
     Matrix<T>& operator-=(const Matrix<T>& other);
     Matrix<T>& operator*=(const Matrix<T>& other);
@@ -94,10 +120,11 @@ public:
     Matrix<T>& operator-=(const T& scalar);
     Matrix<T>& operator*=(const T& scalar);
     Matrix<T>& operator/=(const T& scalar);
-    Matrix<T> operator-() const;
+    Matrix<T> operator-() const&;
+    Matrix<T> operator-() &&;
     Matrix<T> operator+() const;
-    Matrix<T> operator++();
-    Matrix<T> operator--();
+    Matrix<T>& operator++();
+    Matrix<T>& operator--();
     Matrix<T> operator++(int);
     Matrix<T> operator--(int);
     Matrix<T> operator!() const;
@@ -136,13 +163,12 @@ public:
     void print_shape() const;
     void print_strides() const;
 
-    // Matrix-specific operation
-    Array<T> dot(const Matrix<T>& other) const;
-
-private:
-    Array<T>& arr_; // Reference to underlying Array
+protected:
+    Array<T> arr_;
 };
 
 } // namespace NumCPP
 
+#include "Matrix.tpp"
+
 #endif // MATRIX_HPP
\ No newline at end of file
@@ -4,64 +4,22 @@
 #include "Matrix.hpp"
 #include <iostream>
 #include <stdexcept>
+#include <utility>
 
 namespace NumCPP {
 
-// Constructors and Destructor
+// Constructors
 template <typename T>
-Matrix<T>::Matrix()
-    : arr_(*(new Array<T>({ 0, 0 })))
+Matrix<T>::Matrix(Array<T> arr)
+    : arr_(std::move(arr))
 {
-    // Default constructor creates an empty 2D array
-}
-
-template <typename T>
-Matrix<T>::~Matrix()
-{
-    // Since arr_ is a reference, we don't delete it here
-}
-
-template <typename T>
-Matrix<T>::Matrix(Array<T>& arr)
-    : arr_(arr)
-{
-    if (arr.ndim() != 2)
+    if (arr_.ndim() != 2)
         throw std::invalid_argument("Array must be 2D for Matrix");
 }
 
-template <typename T>
-Matrix<T>::Matrix(const Matrix<T>& other)
-    : arr_(other.arr_)
-{
-}
-
-template <typename T>
-Matrix<T>::Matrix(Matrix<T>&& other) noexcept
-    : arr_(other.arr_)
-{
-}
-
-template <typename T>
-Matrix<T>& Matrix<T>::operator=(const Matrix<T>& other)
-{
-    if (this != &other) {
-        arr_ = other.arr_; // Reference reassignment
-    }
-    return *this;
-}
-
-template <typename T>
-Matrix<T>& Matrix<T>::operator=(Matrix<T>&& other) noexcept
-{
-    if (this != &other) {
-        arr_ = other.arr_; // Reference reassignment
-    }
-    return *this;
-}
-
 template <typename T>
 Matrix<T>::Matrix(const std::vector<size_t>& shape, const T& init_val)
-    : arr_(*(new Array<T>(shape, init_val)))
+    : arr_(shape, init_val)
 {
     if (shape.size() != 2)
         throw std::invalid_argument("Matrix must be 2D");
@@ -69,7 +27,7 @@ Matrix<T>::Matrix(const std::vector<size_t>& shape, const T& init_val)
 
 template <typename T>
 Matrix<T>::Matrix(std::initializer_list<size_t> shape, const T& init_val)
-    : arr_(*(new Array<T>(shape, init_val)))
+    : arr_(shape, init_val)
 {
     if (shape.size() != 2)
         throw std::invalid_argument("Matrix must be 2D");
@@ -77,7 +35,7 @@ Matrix<T>::Matrix(std::initializer_list<size_t> shape, const T& init_val)
 
 template <typename T>
 Matrix<T>::Matrix(const std::vector<size_t>& shape, const std::vector<T>& data)
-    : arr_(*(new Array<T>(shape, data)))
+    : arr_(shape, data)
 {
     if (shape.size() != 2)
         throw std::invalid_argument("Matrix must be 2D");
@@ -85,7 +43,7 @@ Matrix<T>::Matrix(const std::vector<size_t>& shape, const std::vector<T>& data)
 
 template <typename T>
 Matrix<T>::Matrix(std::initializer_list<size_t> shape, const std::vector<T>& data)
-    : arr_(*(new Array<T>(shape, data)))
+    : arr_(shape, data)
 {
     if (shape.size() != 2)
         throw std::invalid_argument("Matrix must be 2D");
@@ -120,24 +78,28 @@ std::vector<size_t> Matrix<T>::strides() const
 template <typename T>
 T Matrix<T>::sum() const
 {
+    NUMCPP_PROFILE("Matrix::sum", size());
     return arr_.sum();
 }
 
 template <typename T>
 T Matrix<T>::mean() const
 {
+    NUMCPP_PROFILE("Matrix::mean", size());
     return arr_.mean();
 }
 
 template <typename T>
 T Matrix<T>::min() const
 {
+    NUMCPP_PROFILE("Matrix::min", size());
     return arr_.min();
 }
 
 template <typename T>
 T Matrix<T>::max() const
 {
+    NUMCPP_PROFILE("Matrix::max", size());
     return arr_.max();
 }
 
@@ -150,52 +112,59 @@ bool Matrix<T>::is_square() const
 template <typename T>
 Matrix<T> Matrix<T>::reshape(const std::vector<size_t>& new_shape) const
 {
+    NUMCPP_PROFILE("Matrix::reshape", size());
     if (new_shape.size() != 2)
         throw std::invalid_argument("Matrix must be 2D");
-    Array<T>& new_arr = *(new Array<T>(arr_.reshape(new_shape)));
-    return Matrix<T>(new_arr);
+    return Matrix<T>(arr_.reshape(new_shape));
 }
 
 template <typename T>
 Array<T> Matrix<T>::flatten() const
 {
-    return arr_.flatten();
+    NUMCPP_PROFILE("Matrix::flatten", size());
+    return Array<T>({ arr_.size() }, arr_.flatten());
 }
 
 // Modification Methods
 template <typename T>
 void Matrix<T>::fill(const T& value)
 {
+    NUMCPP_PROFILE("Matrix::fill", size());
     arr_.fill(value);
 }
 
 template <typename T>
 void Matrix<T>::zeros()
 {
+    NUMCPP_PROFILE("Matrix::zeros", size());
     arr_.zeros();
 }
 
 template <typename T>
 void Matrix<T>::ones()
 {
+    NUMCPP_PROFILE("Matrix::ones", size());
     arr_.ones();
 }
 
 template <typename T>
 void Matrix<T>::transpose()
 {
+    NUMCPP_PROFILE("Matrix::transpose", size());
     arr_.transpose();
 }
 
 template <typename T>
 void Matrix<T>::reverse()
 {
+    NUMCPP_PROFILE("Matrix::reverse", size());
     arr_.reverse();
 }
 
 template <typename T>
 void Matrix<T>::pow(const T& exponent)
 {
+    NUMCPP_PROFILE("Matrix::pow", size());
     arr_.pow(exponent);
 }
 
@@ -203,51 +172,51 @@ void Matrix<T>::pow(const T& exponent)
 template <typename T>
 Matrix<T> Matrix<T>::filled(const T& value) const
 {
-    Array<T>& new_arr = *(new Array<T>(arr_.filled(value)));
-    return Matrix<T>(new_arr);
+    NUMCPP_PROFILE("Matrix::filled", size());
+    return Matrix<T>(arr_.filled(value));
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::zeros_like() const
 {
-    Array<T>& new_arr = *(new Array<T>(arr_.zeros_like()));
-    return Matrix<T>(new_arr);
+    NUMCPP_PROFILE("Matrix::zeros_like", size());
+    return Matrix<T>(arr_.zeros_like());
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::ones_like() const
 {
-    Array<T>& new_arr = *(new Array<T>(arr_.ones_like()));
-    return Matrix<T>(new_arr);
+    NUMCPP_PROFILE("Matrix::ones_like", size());
+    return Matrix<T>(arr_.ones_like());
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::transposed() const
 {
-    Array<T>& new_arr = *(new Array<T>(arr_.transposed()));
-    return Matrix<T>(new_arr);
+    NUMCPP_PROFILE("Matrix::transposed", size());
+    return Matrix<T>(arr_.transposed());
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::powed(const T& exponent) const
 {
-    Array<T>& new_arr = *(new Array<T>(arr_.powed(exponent)));
-    return Matrix<T>(new_arr);
+    NUMCPP_PROFILE("Matrix::powed", size());
+    return Matrix<T>(arr_.powed(exponent));
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::reversed() const
 {
-    Array<T>& new_arr = *(new Array<T>(arr_.reversed()));
-    return Matrix<T>(new_arr);
+    NUMCPP_PROFILE("Matrix::reversed", size());
+    return Matrix<T>(arr_.reversed());
 }
 
 // Return a Copy of the Matrix
 template <typename T>
 Matrix<T> Matrix<T>::copy() const
 {
-    Array<T>& new_arr = *(new Array<T>(arr_.copy()));
-    return Matrix<T>(new_arr);
+    NUMCPP_PROFILE("Matrix::copy", size());
+    return Matrix<T>(arr_.copy());
 }
 
 // Element Access
@@ -311,114 +280,161 @@ const T& Matrix<T>::operator()(Indices... indices) const
 template <typename T>
 Matrix<T> Matrix<T>::transpose() const
 {
+    NUMCPP_PROFILE("Matrix::transpose", size());
     return transposed(); // Delegates to transposed() for consistency
 }
 
 template <typename T>
-Matrix<T> Matrix<T>::dot(const Matrix<T>& other) const
+Array<T> Matrix<T>::dot(const Matrix<T>& other, Trans trans_self, Trans trans_other) const
 {
+    NUMCPP_PROFILE("Matrix::dot", size());
     const auto& shape1 = arr_.shape();
     const auto& shape2 = other.arr_.shape();
-    if (shape1[1] != shape2[0])
+    size_t m = trans_self == Trans::No ? shape1[0] : shape1[1];
+    size_t n = trans_self == Trans::No ? shape1[1] : shape1[0];
+    size_t n2 = trans_other == Trans::No ? shape2[0] : shape2[1];
+    size_t p = trans_other == Trans::No ? shape2[1] : shape2[0];
+    if (n != n2)
         throw std::runtime_error("Shapes do not align for dot product");
-    size_t m = shape1[0];
-    size_t n = shape1[1];
-    size_t p = shape2[1];
     Array<T> result({ m, p }, T(0));
-
-    size_t total_elements = m * p;
-    if (total_elements > 1000) {
-// Multithreaded implementation
-#pragma omp parallel for collapse(2)
-        for (size_t i = 0; i < m; ++i) {
-            for (size_t j = 0; j < p; ++j) {
-                for (size_t k = 0; k < n; ++k) {
-#pragma omp atomic
-                    result({ i, j }) += arr_({ i, k }) * other.arr_({ k, j });
-                }
-            }
-        }
-    } else {
-        // Single-threaded implementation
-        for (size_t i = 0; i < m; ++i) {
-            for (size_t j = 0; j < p; ++j) {
-                for (size_t k = 0; k < n; ++k) {
-                    result({ i, j }) += arr_({ i, k }) * other.arr_({ k, j });
-                }
-            }
-        }
-    }
+    gemm(trans_self, trans_other, m, p, n, T(1), arr_.data(), shape1[1],
+        other.arr_.data(), shape2[1], T(0), detail::writable_data(result), p);
     return result;
 }
 
 // Arithmetic Operators (Element-wise)
 template <typename T>
-Matrix<T> Matrix<T>::operator+(const Matrix<T>& other) const
+Matrix<T> Matrix<T>::operator+(const Matrix<T>& other) const&
 {
+    NUMCPP_PROFILE("Matrix::operator+", size());
     if (shape() != other.shape())
         throw std::runtime_error("Shapes do not match for addition");
-    Array<T>& result = *(new Array<T>(arr_ + other.arr_));
-    return Matrix<T>(result);
+    return Matrix<T>(arr_ + other.arr_);
 }
 
 template <typename T>
-Matrix<T> Matrix<T>::operator-(const Matrix<T>& other) const
+Matrix<T> Matrix<T>::operator+(const Matrix<T>& other) &&
 {
+    NUMCPP_PROFILE("Matrix::operator+", size());
+    if (shape() != other.shape())
+        throw std::runtime_error("Shapes do not match for addition");
+    return Matrix<T>(std::move(arr_) + other.arr_);
+}
+
+template <typename T>
+Matrix<T> Matrix<T>::operator-(const Matrix<T>& other) const&
+{
+    NUMCPP_PROFILE("Matrix::operator-", size());
     if (shape() != other.shape())
         throw std::runtime_error("Shapes do not match for subtraction");
-    Array<T>& result = *(new Array<T>(arr_ - other.arr_));
-    return Matrix<T>(result);
+    return Matrix<T>(arr_ - other.arr_);
 }
 
 template <typename T>
-Matrix<T> Matrix<T>::operator*(const Matrix<T>& other) const
+Matrix<T> Matrix<T>::operator-(const Matrix<T>& other) &&
 {
+    NUMCPP_PROFILE("Matrix::operator-", size());
+    if (shape() != other.shape())
+        throw std::runtime_error("Shapes do not match for subtraction");
+    return Matrix<T>(std::move(arr_) - other.arr_);
+}
+
+template <typename T>
+Matrix<T> Matrix<T>::operator*(const Matrix<T>& other) const&
+{
+    NUMCPP_PROFILE("Matrix::operator*", size());
+    if (shape() != other.shape())
+        throw std::runtime_error("Shapes do not match for multiplication");
+    return Matrix<T>(arr_ * other.arr_);
+}
+
+template <typename T>
+Matrix<T> Matrix<T>::operator*(const Matrix<T>& other) &&
+{
+    NUMCPP_PROFILE("Matrix::operator*", size());
     if (shape() != other.shape())
         throw std::runtime_error("Shapes do not match for multiplication");
-    Array<T>& result = *(new Array<T>(arr_ * other.arr_));
-    return Matrix<T>(result);
+    return Matrix<T>(std::move(arr_) * other.arr_);
 }
 
 template <typename T>
-Matrix<T> Matrix<T>::operator/(const Matrix<T>& other) const
+Matrix<T> Matrix<T>::operator/(const Matrix<T>& other) const&
 {
+    NUMCPP_PROFILE("Matrix::operator/", size());
     if (shape() != other.shape())
         throw std::runtime_error("Shapes do not match for division");
-    Array<T>& result = *(new Array<T>(arr_ / other.arr_));
-    return Matrix<T>(result);
+    return Matrix<T>(arr_ / other.arr_);
 }
 
 template <typename T>
-Matrix<T> Matrix<T>::operator+(const T& scalar) const
+Matrix<T> Matrix<T>::operator/(const Matrix<T>& other) &&
 {
-    Array<T>& result = *(new Array<T>(arr_ + scalar));
-    return Matrix<T>(result);
+    NUMCPP_PROFILE("Matrix::operator/", size());
+    if (shape() != other.shape())
+        throw std::runtime_error("Shapes do not match for division");
+    return Matrix<T>(std::move(arr_) / other.arr_);
 }
 
 template <typename T>
-Matrix<T> Matrix<T>::operator-(const T& scalar) const
+Matrix<T> Matrix<T>::operator+(const T& scalar) const&
 {
-    Array<T>& result = *(new Array<T>(arr_ - scalar));
-    return Matrix<T>(result);
+    NUMCPP_PROFILE("Matrix::operator+", size());
+    return Matrix<T>(arr_ + scalar);
 }
 
 template <typename T>
-Matrix<T> Matrix<T>::operator*(const T& scalar) const
+Matrix<T> Matrix<T>::operator+(const T& scalar) &&
 {
-    Array<T>& result = *(new Array<T>(arr_ * scalar));
-    return Matrix<T>(result);
+    NUMCPP_PROFILE("Matrix::operator+", size());
+    return Matrix<T>(std::move(arr_) + scalar);
 }
 
 template <typename T>
-Matrix<T> Matrix<T>::operator/(const T& scalar) const
+Matrix<T> Matrix<T>::operator-(const T& scalar) const&
 {
-    Array<T>& result = *(new Array<T>(arr_ / scalar));
-    return Matrix<T>(result);
+    NUMCPP_PROFILE("Matrix::operator-", size());
+    return Matrix<T>(arr_ - scalar);
+}
+
+template <typename T>
+Matrix<T> Matrix<T>::operator-(const T& scalar) &&
+{
+    NUMCPP_PROFILE("Matrix::operator-", size());
+    return Matrix<T>(std::move(arr_) - scalar);
+}
+
+template <typename T>
+Matrix<T> Matrix<T>::operator*(const T& scalar) const&
+{
+    NUMCPP_PROFILE("Matrix::operator*", size());
+    return Matrix<T>(arr_ * scalar);
+}
+
+template <typename T>
+Matrix<T> Matrix<T>::operator*(const T& scalar) &&
+{
+    NUMCPP_PROFILE("Matrix::operator*", size());
+    return Matrix<T>(std::move(arr_) * scalar);
+}
+
+template <typename T>
+Matrix<T> Matrix<T>::operator/(const T& scalar) const&
+{
+    NUMCPP_PROFILE("Matrix::operator/", size());
+    return Matrix<T>(arr_ / scalar);
+}
+
+template <typename T>
+Matrix<T> Matrix<T>::operator/(const T& scalar) &&
+{
+    NUMCPP_PROFILE("Matrix::operator/", size());
+    return Matrix<T>(std::move(arr_) / scalar);
 }
 
 template <typename T>
 Matrix<T>& Matrix<T>::operator+=(const Matrix<T>& other)
 {
+    NUMCPP_PROFILE("Matrix::operator+=", size());
     if (shape() != other.shape())
         throw std::runtime_error("Shapes do not match for addition");
     arr_ += other.arr_;
@@ -428,6 +444,7 @@ Matrix<T>& Matrix<T>::operator+=(const Matrix<T>& other)
 template <typename T>
 Matrix<T>& Matrix<T>::operator-=(const Matrix<T>& other)
 {
+    NUMCPP_PROFILE("Matrix::operator-=", size());
     if (shape() != other.shape())
         throw std::runtime_error("Shapes do not match for subtraction");
     arr_ -= other.arr_;
@@ -437,6 +454,7 @@ Matrix<T>& Matrix<T>::operator-=(const Matrix<T>& other)
 template <typename T>
 Matrix<T>& Matrix<T>::operator*=(const Matrix<T>& other)
 {
+    NUMCPP_PROFILE("Matrix::operator*=", size());
     if (shape() != other.shape())
         throw std::runtime_error("Shapes do not match for multiplication");
     arr_ *= other.arr_;
@@ -446,6 +464,7 @@ Matrix<T>& Matrix<T>::operator*=(const Matrix<T>& other)
 template <typename T>
 Matrix<T>& Matrix<T>::operator/=(const Matrix<T>& other)
 {
+    NUMCPP_PROFILE("Matrix::operator/=", size());
     if (shape() != other.shape())
         throw std::runtime_error("Shapes do not match for division");
     arr_ /= other.arr_;
@@ -455,6 +474,7 @@ Matrix<T>& Matrix<T>::operator/=(const Matrix<T>& other)
 template <typename T>
 Matrix<T>& Matrix<T>::operator+=(const T& scalar)
 {
+    NUMCPP_PROFILE("Matrix::operator+=", size());
     arr_ += scalar;
     return *this;
 }
@@ -462,6 +482,7 @@ Matrix<T>& Matrix<T>::operator+=(const T& scalar)
 template <typename T>
 Matrix<T>& Matrix<T>::operator-=(const T& scalar)
 {
+    NUMCPP_PROFILE("Matrix::operator-=", size());
     arr_ -= scalar;
     return *this;
 }
@@ -469,6 +490,7 @@ Matrix<T>& Matrix<T>::operator-=(const T& scalar)
 template <typename T>
 Matrix<T>& Matrix<T>::operator*=(const T& scalar)
 {
+    NUMCPP_PROFILE("Matrix::operator*=", size());
     arr_ *= scalar;
     return *this;
 }
@@ -476,97 +498,107 @@ Matrix<T>& Matrix<T>::operator*=(const T& scalar)
 template <typename T>
 Matrix<T>& Matrix<T>::operator/=(const T& scalar)
 {
+    NUMCPP_PROFILE("Matrix::operator/=", size());
     arr_ /= scalar;
     return *this;
 }
 
 template <typename T>
-Matrix<T> Matrix<T>::operator-() const
+Matrix<T> Matrix<T>::operator-() const&
+{
+    NUMCPP_PROFILE("Matrix::operator-(unary)", size());
+    return Matrix<T>(-arr_);
+}
+
+template <typename T>
+Matrix<T> Matrix<T>::operator-() &&
 {
-    Array<T>& result = *(new Array<T>(-arr_));
-    return Matrix<T>(result);
+    NUMCPP_PROFILE("Matrix::operator-(unary)", size());
+    return Matrix<T>(-std::move(arr_));
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator+() const
 {
+    NUMCPP_PROFILE("Matrix::operator+(unary)", size());
     return *this;
 }
 
 template <typename T>
-Matrix<T> Matrix<T>::operator++()
+Matrix<T>& Matrix<T>::operator++()
 {
-    arr_++;
+    NUMCPP_PROFILE("Matrix::operator++", size());
+    ++arr_;
     return *this;
 }
 
 template <typename T>
-Matrix<T> Matrix<T>::operator--()
+Matrix<T>& Matrix<T>::operator--()
 {
-    arr_--;
+    NUMCPP_PROFILE("Matrix::operator--", size());
+    --arr_;
     return *this;
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator++(int)
 {
-    Matrix<T> temp(*this);
-    arr_++;
-    return temp;
+    NUMCPP_PROFILE("Matrix::operator++(int)", size());
+    return Matrix<T>(arr_++);
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator--(int)
 {
-    Matrix<T> temp(*this);
-    arr_--;
-    return temp;
+    NUMCPP_PROFILE("Matrix::operator--(int)", size());
+    return Matrix<T>(arr_--);
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator!() const
 {
-    Array<T>& result = *(new Array<T>(!arr_));
-    return Matrix<T>(result);
+    NUMCPP_PROFILE("Matrix::operator!", size());
+    return Matrix<T>(!arr_);
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator~() const
 {
-    Array<T>& result = *(new Array<T>(~arr_));
-    return Matrix<T>(result);
+    NUMCPP_PROFILE("Matrix::operator~", size());
+    return Matrix<T>(~arr_);
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator&(const Matrix<T>& other) const
 {
+    NUMCPP_PROFILE("Matrix::operator&", size());
     if (shape() != other.shape())
         throw std::runtime_error("Shapes do not match for bitwise AND");
-    Array<T>& result = *(new Array<T>(arr_ & other.arr_));
-    return Matrix<T>(result);
+    return Matrix<T>(arr_ & other.arr_);
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator|(const Matrix<T>& other) const
 {
+    NUMCPP_PROFILE("Matrix::operator|", size());
     if (shape() != other.shape())
         throw std::runtime_error("Shapes do not match for bitwise OR");
-    Array<T>& result = *(new Array<T>(arr_ | other.arr_));
-    return Matrix<T>(result);
+    return Matrix<T>(arr_ | other.arr_);
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator^(const Matrix<T>& other) const
 {
+    NUMCPP_PROFILE("Matrix::operator^", size());
     if (shape() != other.shape())
         throw std::runtime_error("Shapes do not match for bitwise XOR");
-    Array<T>& result = *(new Array<T>(arr_ ^ other.arr_));
-    return Matrix<T>(result);
+    return Matrix<T>(arr_ ^ other.arr_);
 }
 
 template <typename T>
 Matrix<T>& Matrix<T>::operator&=(const Matrix<T>& other)
 {
+    NUMCPP_PROFILE("Matrix::operator&=", size());
     if (shape() != other.shape())
         throw std::runtime_error("Shapes do not match for bitwise AND");
     arr_ &= other.arr_;
@@ -576,6 +608,7 @@ Matrix<T>& Matrix<T>::operator&=(const Matrix<T>& other)
 template <typename T>
 Matrix<T>& Matrix<T>::operator|=(const Matrix<T>& other)
 {
+    NUMCPP_PROFILE("Matrix::operator|=", size());
     if (shape() != other.shape())
         throw std::runtime_error("Shapes do not match for bitwise OR");
     arr_ |= other.arr_;
@@ -585,6 +618,7 @@ Matrix<T>& Matrix<T>::operator|=(const Matrix<T>& other)
 template <typename T>
 Matrix<T>& Matrix<T>::operator^=(const Matrix<T>& other)
 {
+    NUMCPP_PROFILE("Matrix::operator^=", size());
     if (shape() != other.shape())
         throw std::runtime_error("Shapes do not match for bitwise XOR");
     arr_ ^= other.arr_;
@@ -594,27 +628,28 @@ Matrix<T>& Matrix<T>::operator^=(const Matrix<T>& other)
 template <typename T>
 Matrix<T> Matrix<T>::operator&(const T& scalar) const
 {
-    Array<T>& result = *(new Array<T>(arr_ & scalar));
-    return Matrix<T>(result);
+    NUMCPP_PROFILE("Matrix::operator&", size());
+    return Matrix<T>(arr_ & scalar);
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator|(const T& scalar) const
 {
-    Array<T>& result = *(new Array<T>(arr_ | scalar));
-    return Matrix<T>(result);
+    NUMCPP_PROFILE("Matrix::operator|", size());
+    return Matrix<T>(arr_ | scalar);
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator^(const T& scalar) const
 {
-    Array<T>& result = *(new Array<T>(arr_ ^ scalar));
-    return Matrix<T>(result);
+    NUMCPP_PROFILE("Matrix::operator^", size());
+    return Matrix<T>(arr_ ^ scalar);
 }
 
 template <typename T>
 Matrix<T>& Matrix<T>::operator&=(const T& scalar)
 {
+    NUMCPP_PROFILE("Matrix::operator&=", size());
     arr_ &= scalar;
     return *this;
 }
@@ -622,6 +657,7 @@ Matrix<T>& Matrix<T>::operator&=(const T& scalar)
 template <typename T>
 Matrix<T>& Matrix<T>::operator|=(const T& scalar)
 {
+    NUMCPP_PROFILE("Matrix::operator|=", size());
     arr_ |= scalar;
     return *this;
 }
@@ -629,6 +665,7 @@ Matrix<T>& Matrix<T>::operator|=(const T& scalar)
 template <typename T>
 Matrix<T>& Matrix<T>::operator^=(const T& scalar)
 {
+    NUMCPP_PROFILE("Matrix::operator^=", size());
     arr_ ^= scalar;
     return *this;
 }
@@ -636,129 +673,129 @@ Matrix<T>& Matrix<T>::operator^=(const T& scalar)
 template <typename T>
 Matrix<T> Matrix<T>::operator==(const Matrix<T>& other) const
 {
+    NUMCPP_PROFILE("Matrix::operator==", size());
     if (shape() != other.shape())
         throw std::runtime_error("Shapes do not match for equality comparison");
-    Array<T>& result = *(new Array<T>(arr_ == other.arr_));
-    return Matrix<T>(result);
+    return Matrix<T>(arr_ == other.arr_);
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator!=(const Matrix<T>& other) const
 {
+    NUMCPP_PROFILE("Matrix::operator!=", size());
     if (shape() != other.shape())
         throw std::runtime_error("Shapes do not match for inequality comparison");
-    Array<T>& result = *(new Array<T>(arr_ != other.arr_));
-    return Matrix<T>(result);
+    return Matrix<T>(arr_ != other.arr_);
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator<(const Matrix<T>& other) const
 {
+    NUMCPP_PROFILE("Matrix::operator<", size());
     if (shape() != other.shape())
         throw std::runtime_error("Shapes do not match for less-than comparison");
-    Array<T>& result = *(new Array<T>(arr_ < other.arr_));
-    return Matrix<T>(result);
+    return Matrix<T>(arr_ < other.arr_);
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator<=(const Matrix<T>& other) const
 {
+    NUMCPP_PROFILE("Matrix::operator<=", size());
     if (shape() != other.shape())
         throw std::runtime_error("Shapes do not match for less-than-or-equal comparison");
-    Array<T>& result = *(new Array<T>(arr_ <= other.arr_));
-    return Matrix<T>(result);
+    return Matrix<T>(arr_ <= other.arr_);
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator>(const Matrix<T>& other) const
 {
+    NUMCPP_PROFILE("Matrix::operator>", size());
     if (shape() != other.shape())
         throw std::runtime_error("Shapes do not match for greater-than comparison");
-    Array<T>& result = *(new Array<T>(arr_ > other.arr_));
-    return Matrix<T>(result);
+    return Matrix<T>(arr_ > other.arr_);
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator>=(const Matrix<T>& other) const
 {
+    NUMCPP_PROFILE("Matrix::operator>=", size());
     if (shape() != other.shape())
         throw std::runtime_error("Shapes do not match for greater-than-or-equal comparison");
-    Array<T>& result = *(new Array<T>(arr_ >= other.arr_));
-    return Matrix<T>(result);
+    return Matrix<T>(arr_ >= other.arr_);
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator==(const T& scalar) const
 {
-    Array<T>& result = *(new Array<T>(arr_ == scalar));
-    return Matrix<T>(result);
+    NUMCPP_PROFILE("Matrix::operator==", size());
+    return Matrix<T>(arr_ == scalar);
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator!=(const T& scalar) const
 {
-    Array<T>& result = *(new Array<T>(arr_ != scalar));
-    return Matrix<T>(result);
+    NUMCPP_PROFILE("Matrix::operator!=", size());
+    return Matrix<T>(arr_ != scalar);
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator<(const T& scalar) const
 {
-    Array<T>& result = *(new Array<T>(arr_ < scalar));
-    return Matrix<T>(result);
+    NUMCPP_PROFILE("Matrix::operator<", size());
+    return Matrix<T>(arr_ < scalar);
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator<=(const T& scalar) const
 {
-    Array<T>& result = *(new Array<T>(arr_ <= scalar));
-    return Matrix<T>(result);
+    NUMCPP_PROFILE("Matrix::operator<=", size());
+    return Matrix<T>(arr_ <= scalar);
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator>(const T& scalar) const
 {
-    Array<T>& result = *(new Array<T>(arr_ > scalar));
-    return Matrix<T>(result);
+    NUMCPP_PROFILE("Matrix::operator>", size());
+    return Matrix<T>(arr_ > scalar);
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator>=(const T& scalar) const
 {
-    Array<T>& result = *(new Array<T>(arr_ >= scalar));
-    return Matrix<T>(result);
+    NUMCPP_PROFILE("Matrix::operator>=", size());
+    return Matrix<T>(arr_ >= scalar);
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator&&(const Matrix<T>& other) const
 {
+    NUMCPP_PROFILE("Matrix::operator&&", size());
     if (shape() != other.shape())
         throw std::runtime_error("Shapes do not match for logical AND");
-    Array<T>& result = *(new Array<T>(arr_ && other.arr_));
-    return Matrix<T>(result);
+    return Matrix<T>(arr_ && other.arr_);
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator||(const Matrix<T>& other) const
 {
+    NUMCPP_PROFILE("Matrix::operator||", size());
     if (shape() != other.shape())
         throw std::runtime_error("Shapes do not match for logical OR");
-    Array<T>& result = *(new Array<T>(arr_ || other.arr_));
-    return Matrix<T>(result);
+    return Matrix<T>(arr_ || other.arr_);
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator&&(const T& scalar) const
 {
-    Array<T>& result = *(new Array<T>(arr_ && scalar));
-    return Matrix<T>(result);
+    NUMCPP_PROFILE("Matrix::operator&&", size());
+    return Matrix<T>(arr_ && scalar);
 }
 
 template <typename T>
 Matrix<T> Matrix<T>::operator||(const T& scalar) const
 {
-    Array<T>& result = *(new Array<T>(arr_ || scalar));
-    return Matrix<T>(result);
+    NUMCPP_PROFILE("Matrix::operator||", size());
+    return Matrix<T>(arr_ || scalar);
 }
 
 // Utility
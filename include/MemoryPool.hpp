@@ -0,0 +1,111 @@
+#ifndef MEMORYPOOL_HPP
+#define MEMORYPOOL_HPP
+
+#include "Allocator.hpp"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace NumCPP {
+
+// Recycles freed buffers by size class instead of returning them to the
+// system, so loops that create and drop same-sized temporaries stop paying
+// for page faults and munmap. Sizes are rounded up to one of four classes per
+// power of two (at most 25% slack). Each thread works on its own cache shard
+// and falls back to the other shards before allocating upstream. Freed
+// buffers beyond `max_retained_bytes` go straight back upstream.
+//
+// Opt in process-wide with set_default_allocator(pool) or per scope with
+// ScopedAllocator. The pool must outlive every buffer it handed out.
+class PoolAllocator : public Allocator {
+public:
+    static constexpr size_t min_block = 64;
+    // Larger requests, and alignments above this, bypass the pool
+    static constexpr size_t max_block = size_t(1) << 30;
+    static constexpr size_t pool_alignment = 64;
+
+    explicit PoolAllocator(size_t max_retained_bytes = size_t(256) << 20,
+        Allocator& upstream = detail::aligned_allocator());
+    ~PoolAllocator() override;
+
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment) override;
+    void deallocate(void* ptr, size_t bytes, size_t alignment) noexcept override;
+    AllocatorStats stats() const override;
+
+    // Return every retained buffer upstream
+    void trim();
+
+    // Block size a request of `bytes` is rounded up to
+    static size_t block_size(size_t bytes);
+
+private:
+    struct Shard {
+        std::mutex mutex;
+        std::vector<std::vector<void*>> bins;
+    };
+
+    Allocator& upstream_;
+    size_t max_retained_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::atomic<size_t> allocations_ { 0 };
+    std::atomic<size_t> hits_ { 0 };
+    std::atomic<size_t> in_use_ { 0 };
+    std::atomic<size_t> retained_ { 0 };
+
+    static size_t class_index(size_t bytes);
+    static size_t class_size(size_t index);
+    static bool pooled(size_t bytes, size_t alignment);
+    Shard& local_shard();
+    void* take(Shard& shard, size_t index);
+};
+
+// Bump allocator for per-request scratch arrays. Allocation carves aligned
+// blocks out of large chunks; deallocate() only updates the counters, and
+// reset() releases everything at once. Every array allocated from the arena
+// must be destroyed before reset() or the arena's destruction.
+class ArenaAllocator : public Allocator {
+public:
+    explicit ArenaAllocator(size_t chunk_bytes = size_t(1) << 20,
+        Allocator& upstream = detail::aligned_allocator());
+    ~ArenaAllocator() override;
+
+    ArenaAllocator(const ArenaAllocator&) = delete;
+    ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment) override;
+    void deallocate(void* ptr, size_t bytes, size_t alignment) noexcept override;
+    AllocatorStats stats() const override;
+
+    // Release all blocks; the first chunk is kept for reuse
+    void reset();
+    // Bytes reserved from upstream
+    size_t capacity() const;
+
+private:
+    static constexpr size_t chunk_alignment = 64;
+
+    struct Chunk {
+        char* data;
+        size_t size;
+    };
+
+    Allocator& upstream_;
+    size_t chunk_bytes_;
+    mutable std::mutex mutex_;
+    std::vector<Chunk> chunks_;
+    size_t used_ = 0; // offset into chunks_.back()
+    size_t allocations_ = 0;
+    size_t hits_ = 0;
+    size_t in_use_ = 0;
+};
+
+} // namespace NumCPP
+
+#include "MemoryPool.tpp"
+
+#endif // MEMORYPOOL_HPP
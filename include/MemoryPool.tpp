@@ -0,0 +1,252 @@
+#ifndef MEMORYPOOL_TPP
+#define MEMORYPOOL_TPP
+
+#include "MemoryPool.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <thread>
+
+namespace NumCPP {
+
+namespace detail {
+    // Round-robin shard assignment, fixed per thread
+    inline size_t pool_thread_slot()
+    {
+        static std::atomic<size_t> next { 0 };
+        thread_local size_t slot = next.fetch_add(1, std::memory_order_relaxed);
+        return slot;
+    }
+}
+
+inline PoolAllocator::PoolAllocator(size_t max_retained_bytes, Allocator& upstream)
+    : upstream_(upstream)
+    , max_retained_(max_retained_bytes)
+{
+    size_t shards = std::max<size_t>(1, std::thread::hardware_concurrency());
+    size_t classes = class_index(max_block) + 1;
+    shards_.reserve(shards);
+    for (size_t i = 0; i < shards; ++i) {
+        shards_.push_back(std::make_unique<Shard>());
+        shards_.back()->bins.resize(classes);
+    }
+}
+
+inline PoolAllocator::~PoolAllocator()
+{
+    trim();
+}
+
+// Four classes per power of two above min_block: 64, 80, 96, 112, 128, 160, ...
+inline size_t PoolAllocator::class_index(size_t bytes)
+{
+    if (bytes <= min_block)
+        return 0;
+    size_t exponent = std::bit_width(bytes - 1) - 1;
+    size_t base = size_t(1) << exponent;
+    size_t sub = (bytes - 1 - base) / (base / 4);
+    return (exponent - std::bit_width(min_block) + 1) * 4 + sub + 1;
+}
+
+inline size_t PoolAllocator::class_size(size_t index)
+{
+    if (index == 0)
+        return min_block;
+    size_t exponent = (index - 1) / 4 + std::bit_width(min_block) - 1;
+    size_t base = size_t(1) << exponent;
+    return base + ((index - 1) % 4 + 1) * (base / 4);
+}
+
+inline size_t PoolAllocator::block_size(size_t bytes)
+{
+    return class_size(class_index(bytes));
+}
+
+inline bool PoolAllocator::pooled(size_t bytes, size_t alignment)
+{
+    return bytes <= max_block && alignment <= pool_alignment;
+}
+
+inline PoolAllocator::Shard& PoolAllocator::local_shard()
+{
+    return *shards_[detail::pool_thread_slot() % shards_.size()];
+}
+
+inline void* PoolAllocator::take(Shard& shard, size_t index)
+{
+    auto& bin = shard.bins[index];
+    if (bin.empty())
+        return nullptr;
+    void* ptr = bin.back();
+    bin.pop_back();
+    return ptr;
+}
+
+inline void* PoolAllocator::allocate(size_t bytes, size_t alignment)
+{
+    allocations_.fetch_add(1, std::memory_order_relaxed);
+    if (!pooled(bytes, alignment)) {
+        void* ptr = upstream_.allocate(bytes, alignment);
+        in_use_.fetch_add(bytes, std::memory_order_relaxed);
+        return ptr;
+    }
+
+    size_t index = class_index(bytes);
+    size_t size = block_size(bytes);
+    Shard& local = local_shard();
+    void* ptr = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(local.mutex);
+        ptr = take(local, index);
+    }
+    // Buffers freed on other threads land in their shards
+    for (size_t i = 0; !ptr && i < shards_.size(); ++i) {
+        Shard& shard = *shards_[i];
+        if (&shard == &local || retained_.load(std::memory_order_relaxed) < size)
+            continue;
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        ptr = take(shard, index);
+    }
+
+    if (ptr) {
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        retained_.fetch_sub(size, std::memory_order_relaxed);
+    } else {
+        ptr = upstream_.allocate(size, pool_alignment);
+    }
+    in_use_.fetch_add(size, std::memory_order_relaxed);
+    return ptr;
+}
+
+inline void PoolAllocator::deallocate(void* ptr, size_t bytes, size_t alignment) noexcept
+{
+    if (!pooled(bytes, alignment)) {
+        in_use_.fetch_sub(bytes, std::memory_order_relaxed);
+        upstream_.deallocate(ptr, bytes, alignment);
+        return;
+    }
+
+    size_t size = block_size(bytes);
+    in_use_.fetch_sub(size, std::memory_order_relaxed);
+    if (retained_.fetch_add(size, std::memory_order_relaxed) + size <= max_retained_) {
+        Shard& local = local_shard();
+        try {
+            std::lock_guard<std::mutex> lock(local.mutex);
+            local.bins[class_index(bytes)].push_back(ptr);
+            return;
+        } catch (...) {
+        }
+    }
+    retained_.fetch_sub(size, std::memory_order_relaxed);
+    upstream_.deallocate(ptr, size, pool_alignment);
+}
+
+inline AllocatorStats PoolAllocator::stats() const
+{
+    AllocatorStats stats;
+    stats.allocations = allocations_.load(std::memory_order_relaxed);
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.bytes_in_use = in_use_.load(std::memory_order_relaxed);
+    stats.bytes_retained = retained_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+inline void PoolAllocator::trim()
+{
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        for (size_t index = 0; index < shard->bins.size(); ++index) {
+            auto& bin = shard->bins[index];
+            if (bin.empty())
+                continue;
+            size_t size = class_size(index);
+            for (void* ptr : bin)
+                upstream_.deallocate(ptr, size, pool_alignment);
+            retained_.fetch_sub(size * bin.size(), std::memory_order_relaxed);
+            bin.clear();
+        }
+    }
+}
+
+inline ArenaAllocator::ArenaAllocator(size_t chunk_bytes, Allocator& upstream)
+    : upstream_(upstream)
+    , chunk_bytes_(std::max<size_t>(chunk_bytes, 64))
+{
+}
+
+inline ArenaAllocator::~ArenaAllocator()
+{
+    for (const Chunk& chunk : chunks_)
+        upstream_.deallocate(chunk.data, chunk.size, chunk_alignment);
+}
+
+inline void* ArenaAllocator::allocate(size_t bytes, size_t alignment)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    allocations_++;
+    if (!chunks_.empty()) {
+        const Chunk& chunk = chunks_.back();
+        auto address = reinterpret_cast<uintptr_t>(chunk.data) + used_;
+        size_t padding = (alignment - address % alignment) % alignment;
+        if (used_ + padding + bytes <= chunk.size) {
+            used_ += padding + bytes;
+            in_use_ += bytes;
+            hits_++;
+            return chunk.data + used_ - bytes;
+        }
+    }
+
+    size_t size = std::max(chunk_bytes_, bytes + alignment);
+    char* data = static_cast<char*>(upstream_.allocate(size, chunk_alignment));
+    chunks_.push_back({ data, size });
+    auto address = reinterpret_cast<uintptr_t>(data);
+    size_t padding = (alignment - address % alignment) % alignment;
+    used_ = padding + bytes;
+    in_use_ += bytes;
+    return data + padding;
+}
+
+inline void ArenaAllocator::deallocate(void*, size_t bytes, size_t) noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    in_use_ -= std::min(bytes, in_use_);
+}
+
+inline AllocatorStats ArenaAllocator::stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    AllocatorStats stats;
+    stats.allocations = allocations_;
+    stats.hits = hits_;
+    stats.bytes_in_use = in_use_;
+    size_t reserved = 0;
+    for (const Chunk& chunk : chunks_)
+        reserved += chunk.size;
+    stats.bytes_retained = reserved - std::min(reserved, in_use_);
+    return stats;
+}
+
+inline void ArenaAllocator::reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (chunks_.empty())
+        return;
+    for (size_t i = 1; i < chunks_.size(); ++i)
+        upstream_.deallocate(chunks_[i].data, chunks_[i].size, chunk_alignment);
+    chunks_.resize(1);
+    used_ = 0;
+    in_use_ = 0;
+}
+
+inline size_t ArenaAllocator::capacity() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t reserved = 0;
+    for (const Chunk& chunk : chunks_)
+        reserved += chunk.size;
+    return reserved;
+}
+
+} // namespace NumCPP
+
+#endif // MEMORYPOOL_TPP
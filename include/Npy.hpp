@@ -0,0 +1,113 @@
+#ifndef NPY_HPP
+#define NPY_HPP
+
+#include "Array.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace NumCPP {
+
+// How load_npy / load_npz hand the file's payload to the Array.
+enum class MapMode {
+    // Map the file privately and writable: the Array adopts the mapping
+    // without copying, and pages are copied by the kernel only when written
+    // (the file itself never changes)
+    CopyOnWrite,
+    // Map the file read-only; the Array copies its buffer before the first
+    // write
+    ReadOnly,
+    // Read the payload into a freshly allocated buffer
+    Copy
+};
+
+// Load a NumPy .npy file. The payload is adopted in place (see MapMode) when
+// its dtype is T in native byte order, it is C-ordered and suitably aligned;
+// other numeric dtypes, big-endian data and Fortran order are converted into
+// a new buffer. A 0-d array loads with shape {1} and an array with a zero
+// extent loads as an empty Array. Throws std::runtime_error for unreadable,
+// malformed or unsupported (complex, object, string) files.
+template <typename T>
+Array<T> load_npy(const std::string& path, MapMode mode = MapMode::CopyOnWrite);
+
+// Write arr as a version 1.0 .npy file (2.0 for very long headers), streaming
+// the elements straight from the buffer.
+template <typename T>
+void save_npy(const std::string& path, const Array<T>& arr);
+
+// Load every member of an uncompressed .npz archive (numpy.savez), keyed by
+// name without the ".npy" suffix. Members share one mapping of the archive.
+// Compressed members (numpy.savez_compressed) throw std::runtime_error; CRCs
+// are not verified so that loading never touches the payload.
+template <typename T>
+std::map<std::string, Array<T>> load_npz(const std::string& path, MapMode mode = MapMode::CopyOnWrite);
+
+// Write an uncompressed .npz archive (ZIP64 when needed) readable by numpy.load.
+template <typename T>
+void save_npz(const std::string& path, const std::map<std::string, Array<T>>& arrays);
+
+namespace detail {
+    struct NpyHeader {
+        char kind = 0; // 'f', 'i', 'u' or 'b'
+        size_t item_size = 0;
+        bool big_endian = false;
+        bool fortran_order = false;
+        std::vector<size_t> shape;
+        size_t data_offset = 0; // bytes from the magic string to the payload
+    };
+
+    // A whole file mapped privately (or read into memory where mmap is not
+    // available); unmapped when the last Array using it goes away
+    class MappedFile {
+    public:
+        MappedFile(const std::string& path, bool writable);
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        char* data() const { return data_; }
+        size_t size() const { return size_; }
+
+    private:
+        char* data_ = nullptr;
+        size_t size_ = 0;
+        bool mapped_ = false;
+    };
+
+    // A stored member of a zip archive; data_offset is from the archive start
+    struct ZipEntry {
+        std::string name;
+        unsigned method = 0; // 0 = stored
+        size_t size = 0;
+        size_t data_offset = 0;
+    };
+
+    NpyHeader parse_npy_header(const char* bytes, size_t size, const std::string& what);
+    // Magic string, version and the header dict, padded to 64 bytes
+    std::string npy_preamble(const std::string& descr, const std::vector<size_t>& shape);
+    std::uint32_t crc32(std::uint32_t crc, const void* data, size_t size);
+
+    std::vector<ZipEntry> zip_entries(const char* data, size_t size, const std::string& what);
+    std::string zip_local_header(const std::string& name, std::uint32_t crc, std::uint64_t size, bool zip64);
+    std::string zip_central_header(const std::string& name, std::uint32_t crc, std::uint64_t size,
+        std::uint64_t offset, bool zip64);
+    std::string zip_end_records(std::uint64_t entries, std::uint64_t directory_size, std::uint64_t directory_offset);
+
+    template <typename T>
+    std::string npy_descr();
+
+    // Build an Array from the .npy bytes [bytes, bytes + size), adopting the
+    // payload when possible and `mapping` is set
+    template <typename T>
+    Array<T> decode_npy(char* bytes, size_t size, const std::shared_ptr<MappedFile>& mapping, MapMode mode,
+        const std::string& what);
+}
+
+} // namespace NumCPP
+
+#include "Npy.tpp"
+
+#endif // NPY_HPP
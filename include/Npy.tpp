@@ -0,0 +1,637 @@
+#ifndef NPY_TPP
+#define NPY_TPP
+
+#include "CostModel.hpp"
+#include "Npy.hpp"
+#include "Permute.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define NUMCPP_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define NUMCPP_HAS_MMAP 0
+#endif
+
+namespace NumCPP {
+
+namespace detail {
+    inline std::uint64_t read_le(const char* p, size_t bytes)
+    {
+        std::uint64_t value = 0;
+        for (size_t i = 0; i < bytes; i++)
+            value |= std::uint64_t(static_cast<unsigned char>(p[i])) << (8 * i);
+        return value;
+    }
+
+    inline void put_le(std::string& out, std::uint64_t value, size_t bytes)
+    {
+        for (size_t i = 0; i < bytes; i++)
+            out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+
+    inline MappedFile::MappedFile(const std::string& path, bool writable)
+    {
+#if NUMCPP_HAS_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("Cannot open file: " + path);
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot read file size: " + path);
+        }
+        size_ = static_cast<size_t>(info.st_size);
+        if (size_ > 0) {
+            // Private mappings never write back, so a writable one is
+            // copy-on-write at page granularity
+            int protection = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+            void* address = ::mmap(nullptr, size_, protection, MAP_PRIVATE, fd, 0);
+            if (address == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Cannot map file: " + path);
+            }
+            data_ = static_cast<char*>(address);
+            mapped_ = true;
+        }
+        ::close(fd);
+#else
+        (void)writable;
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in)
+            throw std::runtime_error("Cannot open file: " + path);
+        size_ = static_cast<size_t>(in.tellg());
+        data_ = new char[size_ > 0 ? size_ : 1];
+        in.seekg(0);
+        if (!in.read(data_, static_cast<std::streamsize>(size_))) {
+            delete[] data_;
+            throw std::runtime_error("Cannot read file: " + path);
+        }
+#endif
+    }
+
+    inline MappedFile::~MappedFile()
+    {
+#if NUMCPP_HAS_MMAP
+        if (mapped_)
+            ::munmap(data_, size_);
+#else
+        delete[] data_;
+#endif
+    }
+
+    // Position just past `key`: in the header dict, or npos
+    inline size_t npy_dict_value(const std::string& dict, const char* key)
+    {
+        for (char quote : { '\'', '"' }) {
+            std::string quoted = std::string(1, quote) + key + quote;
+            size_t pos = dict.find(quoted);
+            if (pos == std::string::npos)
+                continue;
+            pos = dict.find(':', pos + quoted.size());
+            if (pos == std::string::npos)
+                return pos;
+            pos = dict.find_first_not_of(' ', pos + 1);
+            return pos;
+        }
+        return std::string::npos;
+    }
+
+    inline NpyHeader parse_npy_header(const char* bytes, size_t size, const std::string& what)
+    {
+        auto fail = [&](const std::string& message) { return std::runtime_error(what + ": " + message); };
+        if (size < 10 || std::memcmp(bytes, "\x93NUMPY", 6) != 0)
+            throw fail("not a .npy file");
+        unsigned major = static_cast<unsigned char>(bytes[6]);
+        size_t prefix, header_len;
+        if (major == 1) {
+            prefix = 10;
+            header_len = read_le(bytes + 8, 2);
+        } else if ((major == 2 || major == 3) && size >= 12) {
+            prefix = 12;
+            header_len = read_le(bytes + 8, 4);
+        } else {
+            throw fail("unsupported .npy version " + std::to_string(major));
+        }
+        if (header_len > size - prefix)
+            throw fail("truncated header");
+        std::string dict(bytes + prefix, header_len);
+
+        NpyHeader header;
+        header.data_offset = prefix + header_len;
+
+        size_t pos = npy_dict_value(dict, "descr");
+        if (pos == std::string::npos || (dict[pos] != '\'' && dict[pos] != '"'))
+            throw fail("unsupported dtype (only simple numeric dtypes can be loaded)");
+        size_t close = dict.find(dict[pos], pos + 1);
+        std::string descr = dict.substr(pos + 1, close == std::string::npos ? 0 : close - pos - 1);
+        if (descr.size() < 3 || std::string("<>|=").find(descr[0]) == std::string::npos)
+            throw fail("unsupported dtype '" + descr + "'");
+        header.big_endian = descr[0] == '>' || (descr[0] == '=' && std::endian::native == std::endian::big);
+        header.kind = descr[1];
+        header.item_size = std::strtoul(descr.c_str() + 2, nullptr, 10);
+        bool supported = (header.kind == 'f' && (header.item_size == 4 || header.item_size == 8))
+            || ((header.kind == 'i' || header.kind == 'u')
+                && (header.item_size == 1 || header.item_size == 2 || header.item_size == 4 || header.item_size == 8))
+            || (header.kind == 'b' && header.item_size == 1);
+        if (!supported)
+            throw fail("unsupported dtype '" + descr + "'");
+
+        pos = npy_dict_value(dict, "fortran_order");
+        if (pos == std::string::npos)
+            throw fail("missing fortran_order");
+        header.fortran_order = dict.compare(pos, 4, "True") == 0;
+
+        pos = npy_dict_value(dict, "shape");
+        if (pos == std::string::npos || dict[pos] != '(')
+            throw fail("missing shape");
+        size_t end = dict.find(')', pos);
+        if (end == std::string::npos)
+            throw fail("malformed shape");
+        for (size_t i = pos + 1; i < end;) {
+            if (std::isdigit(static_cast<unsigned char>(dict[i]))) {
+                char* stop = nullptr;
+                header.shape.push_back(std::strtoull(dict.c_str() + i, &stop, 10));
+                i = static_cast<size_t>(stop - dict.c_str());
+            } else if (dict[i] == ',' || dict[i] == ' ' || dict[i] == 'L') {
+                i++;
+            } else {
+                throw fail("malformed shape");
+            }
+        }
+        // The element count must fit in size_t, or the truncation check on
+        // the payload would pass for a wrapped-around count
+        bool empty = std::find(header.shape.begin(), header.shape.end(), size_t(0)) != header.shape.end();
+        size_t count = 1;
+        for (size_t extent : header.shape) {
+            if (empty)
+                break;
+            if (extent > std::numeric_limits<size_t>::max() / count)
+                throw fail("shape too large");
+            count *= extent;
+        }
+        return header;
+    }
+
+    inline std::string npy_preamble(const std::string& descr, const std::vector<size_t>& shape)
+    {
+        std::string dict = "{'descr': '" + descr + "', 'fortran_order': False, 'shape': (";
+        for (size_t i = 0; i < shape.size(); i++) {
+            dict += std::to_string(shape[i]);
+            if (shape.size() == 1 || i + 1 < shape.size())
+                dict += shape.size() == 1 ? "," : ", ";
+        }
+        dict += "), }";
+
+        // Pad with spaces so the payload starts on a 64-byte boundary
+        size_t prefix = dict.size() + 1 + 10 > 65535 ? 12 : 10;
+        size_t total = (prefix + dict.size() + 1 + 63) / 64 * 64;
+        dict.append(total - prefix - dict.size() - 1, ' ');
+        dict += '\n';
+
+        std::string preamble("\x93NUMPY", 6);
+        preamble += static_cast<char>(prefix == 10 ? 1 : 2);
+        preamble += '\0';
+        put_le(preamble, dict.size(), prefix - 8);
+        return preamble + dict;
+    }
+
+    // Slicing-by-8 tables of the reflected CRC-32 used by zip
+    inline const std::array<std::array<std::uint32_t, 256>, 8>& crc32_tables()
+    {
+        static const auto tables = [] {
+            std::array<std::array<std::uint32_t, 256>, 8> t {};
+            for (std::uint32_t i = 0; i < 256; i++) {
+                std::uint32_t c = i;
+                for (int k = 0; k < 8; k++)
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                t[0][i] = c;
+            }
+            for (size_t i = 0; i < 256; i++) {
+                for (size_t s = 1; s < 8; s++)
+                    t[s][i] = (t[s - 1][i] >> 8) ^ t[0][t[s - 1][i] & 0xFF];
+            }
+            return t;
+        }();
+        return tables;
+    }
+
+    inline std::uint32_t crc32(std::uint32_t crc, const void* data, size_t size)
+    {
+        const auto& t = crc32_tables();
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        crc = ~crc;
+        if constexpr (std::endian::native == std::endian::little) {
+            for (; size >= 8; size -= 8, p += 8) {
+                std::uint32_t lo, hi;
+                std::memcpy(&lo, p, 4);
+                std::memcpy(&hi, p + 4, 4);
+                lo ^= crc;
+                crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24]
+                    ^ t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+            }
+        }
+        for (; size > 0; size--)
+            crc = t[0][(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    inline std::vector<ZipEntry> zip_entries(const char* data, size_t size, const std::string& what)
+    {
+        auto fail = [&](const std::string& message) { return std::runtime_error(what + ": " + message); };
+        if (size < 22)
+            throw fail("not a zip archive");
+
+        // End of central directory record, followed by at most 64 KiB of comment
+        size_t eocd = std::string::npos;
+        size_t lowest = size > 22 + 65535 ? size - 22 - 65535 : 0;
+        for (size_t pos = size - 22 + 1; pos-- > lowest;) {
+            if (read_le(data + pos, 4) == 0x06054b50) {
+                eocd = pos;
+                break;
+            }
+        }
+        if (eocd == std::string::npos)
+            throw fail("not a zip archive");
+        std::uint64_t entries = read_le(data + eocd + 10, 2);
+        std::uint64_t directory_size = read_le(data + eocd + 12, 4);
+        std::uint64_t directory_offset = read_le(data + eocd + 16, 4);
+        if (eocd >= 20 && read_le(data + eocd - 20, 4) == 0x07064b50) {
+            std::uint64_t record = read_le(data + eocd - 20 + 8, 8);
+            if (record > size || size - record < 56 || read_le(data + record, 4) != 0x06064b50)
+                throw fail("corrupt zip64 directory");
+            entries = read_le(data + record + 32, 8);
+            directory_size = read_le(data + record + 40, 8);
+            directory_offset = read_le(data + record + 48, 8);
+        }
+        if (directory_offset > size || directory_size > size - directory_offset)
+            throw fail("corrupt central directory");
+
+        std::vector<ZipEntry> result;
+        size_t pos = directory_offset;
+        const size_t end = directory_offset + directory_size;
+        for (std::uint64_t e = 0; e < entries; e++) {
+            if (end - pos < 46 || read_le(data + pos, 4) != 0x02014b50)
+                throw fail("corrupt central directory");
+            unsigned method = static_cast<unsigned>(read_le(data + pos + 10, 2));
+            std::uint64_t stored_size = read_le(data + pos + 20, 4);
+            std::uint64_t local = read_le(data + pos + 42, 4);
+            size_t name_len = read_le(data + pos + 28, 2);
+            size_t extra_len = read_le(data + pos + 30, 2);
+            size_t comment_len = read_le(data + pos + 32, 2);
+            if (end - pos - 46 < name_len + extra_len + comment_len)
+                throw fail("corrupt central directory");
+            std::string name(data + pos + 46, name_len);
+
+            // Zip64 extended information replaces the saturated 32-bit fields
+            const char* extra = data + pos + 46 + name_len;
+            for (size_t x = 0; x + 4 <= extra_len;) {
+                size_t id = read_le(extra + x, 2);
+                size_t len = std::min<size_t>(read_le(extra + x + 2, 2), extra_len - x - 4);
+                if (id == 1) {
+                    const char* field = extra + x + 4;
+                    size_t k = 0;
+                    if (read_le(data + pos + 24, 4) == 0xFFFFFFFF && k + 8 <= len)
+                        k += 8; // uncompressed size (equal for stored members)
+                    if (stored_size == 0xFFFFFFFF && k + 8 <= len) {
+                        stored_size = read_le(field + k, 8);
+                        k += 8;
+                    }
+                    if (local == 0xFFFFFFFF && k + 8 <= len)
+                        local = read_le(field + k, 8);
+                }
+                x += 4 + len;
+            }
+
+            if (local > size || size - local < 30 || read_le(data + local, 4) != 0x04034b50)
+                throw fail("corrupt local header for " + name);
+            std::uint64_t data_offset = local + 30 + read_le(data + local + 26, 2) + read_le(data + local + 28, 2);
+            if (data_offset > size || stored_size > size - data_offset)
+                throw fail("truncated member " + name);
+            result.push_back({ name, method, static_cast<size_t>(stored_size), static_cast<size_t>(data_offset) });
+            pos += 46 + name_len + extra_len + comment_len;
+        }
+        return result;
+    }
+
+    // DOS date 1980-01-01, time 00:00
+    inline constexpr std::uint32_t zip_dos_date = 0x21;
+
+    inline std::string zip_local_header(const std::string& name, std::uint32_t crc, std::uint64_t size, bool zip64)
+    {
+        std::string header;
+        put_le(header, 0x04034b50, 4);
+        put_le(header, zip64 ? 45 : 20, 2); // version needed
+        put_le(header, 0, 2); // flags
+        put_le(header, 0, 2); // stored
+        put_le(header, 0, 2);
+        put_le(header, zip_dos_date, 2);
+        put_le(header, crc, 4);
+        put_le(header, zip64 ? 0xFFFFFFFF : size, 4);
+        put_le(header, zip64 ? 0xFFFFFFFF : size, 4);
+        put_le(header, name.size(), 2);
+        put_le(header, zip64 ? 20 : 0, 2);
+        header += name;
+        if (zip64) {
+            put_le(header, 1, 2);
+            put_le(header, 16, 2);
+            put_le(header, size, 8);
+            put_le(header, size, 8);
+        }
+        return header;
+    }
+
+    inline std::string zip_central_header(const std::string& name, std::uint32_t crc, std::uint64_t size,
+        std::uint64_t offset, bool zip64)
+    {
+        std::string header;
+        put_le(header, 0x02014b50, 4);
+        put_le(header, 45, 2); // version made by
+        put_le(header, zip64 ? 45 : 20, 2);
+        put_le(header, 0, 2);
+        put_le(header, 0, 2);
+        put_le(header, 0, 2);
+        put_le(header, zip_dos_date, 2);
+        put_le(header, crc, 4);
+        put_le(header, zip64 ? 0xFFFFFFFF : size, 4);
+        put_le(header, zip64 ? 0xFFFFFFFF : size, 4);
+        put_le(header, name.size(), 2);
+        put_le(header, zip64 ? 28 : 0, 2);
+        put_le(header, 0, 2); // comment
+        put_le(header, 0, 2); // disk
+        put_le(header, 0, 2); // internal attributes
+        put_le(header, 0, 4); // external attributes
+        put_le(header, zip64 ? 0xFFFFFFFF : offset, 4);
+        header += name;
+        if (zip64) {
+            put_le(header, 1, 2);
+            put_le(header, 24, 2);
+            put_le(header, size, 8);
+            put_le(header, size, 8);
+            put_le(header, offset, 8);
+        }
+        return header;
+    }
+
+    inline std::string zip_end_records(std::uint64_t entries, std::uint64_t directory_size, std::uint64_t directory_offset)
+    {
+        std::string records;
+        bool zip64 = entries >= 0xFFFF || directory_size >= 0xFFFFFFFF || directory_offset >= 0xFFFFFFFF;
+        if (zip64) {
+            std::uint64_t record = directory_offset + directory_size;
+            put_le(records, 0x06064b50, 4);
+            put_le(records, 44, 8);
+            put_le(records, 45, 2);
+            put_le(records, 45, 2);
+            put_le(records, 0, 4);
+            put_le(records, 0, 4);
+            put_le(records, entries, 8);
+            put_le(records, entries, 8);
+            put_le(records, directory_size, 8);
+            put_le(records, directory_offset, 8);
+            put_le(records, 0x07064b50, 4);
+            put_le(records, 0, 4);
+            put_le(records, record, 8);
+            put_le(records, 1, 4);
+        }
+        put_le(records, 0x06054b50, 4);
+        put_le(records, 0, 2);
+        put_le(records, 0, 2);
+        put_le(records, std::min<std::uint64_t>(entries, 0xFFFF), 2);
+        put_le(records, std::min<std::uint64_t>(entries, 0xFFFF), 2);
+        put_le(records, std::min<std::uint64_t>(directory_size, 0xFFFFFFFF), 4);
+        put_le(records, std::min<std::uint64_t>(directory_offset, 0xFFFFFFFF), 4);
+        put_le(records, 0, 2);
+        return records;
+    }
+
+    template <typename T>
+    constexpr char npy_kind()
+    {
+        if constexpr (std::is_same_v<T, bool>)
+            return 'b';
+        else if constexpr (std::is_floating_point_v<T>)
+            return 'f';
+        else if constexpr (std::is_signed_v<T>)
+            return 'i';
+        else
+            return 'u';
+    }
+
+    template <typename T>
+    std::string npy_descr()
+    {
+        static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, long double>,
+            ".npy files hold bool, integer, float or double elements");
+        char order = sizeof(T) == 1 ? '|' : (std::endian::native == std::endian::little ? '<' : '>');
+        return std::string { order, npy_kind<T>() } + std::to_string(sizeof(T));
+    }
+
+    template <typename S>
+    S byteswap_value(S value)
+    {
+        unsigned char bytes[sizeof(S)];
+        std::memcpy(bytes, &value, sizeof(S));
+        std::reverse(bytes, bytes + sizeof(S));
+        std::memcpy(&value, bytes, sizeof(S));
+        return value;
+    }
+
+    // out[i] = T(i-th S in src); src may be unaligned and byte-swapped
+    template <typename S, typename T>
+    void convert_npy_elements(const char* src, size_t count, bool swap, T* out)
+    {
+        parallel_for(0, count, [&](size_t start, size_t end) {
+            if constexpr (std::is_same_v<S, T>) {
+                if (!swap) {
+                    std::memcpy(out + start, src + start * sizeof(S), (end - start) * sizeof(S));
+                    return;
+                }
+            }
+            for (size_t i = start; i < end; i++) {
+                S value;
+                std::memcpy(&value, src + i * sizeof(S), sizeof(S));
+                if (swap)
+                    value = byteswap_value(value);
+                out[i] = static_cast<T>(value);
+            }
+        }, parallel_grain(KernelCost { double(sizeof(S) + sizeof(T)), swap ? double(sizeof(S)) : 0.0, 0 }));
+    }
+
+    template <typename T>
+    void convert_npy(const char* payload, const NpyHeader& header, size_t count, T* out)
+    {
+        bool swap = header.item_size > 1 && header.big_endian != (std::endian::native == std::endian::big);
+        switch (header.kind) {
+        case 'f':
+            if (header.item_size == 4)
+                return convert_npy_elements<float>(payload, count, swap, out);
+            return convert_npy_elements<double>(payload, count, swap, out);
+        case 'i':
+            switch (header.item_size) {
+            case 1:
+                return convert_npy_elements<std::int8_t>(payload, count, swap, out);
+            case 2:
+                return convert_npy_elements<std::int16_t>(payload, count, swap, out);
+            case 4:
+                return convert_npy_elements<std::int32_t>(payload, count, swap, out);
+            default:
+                return convert_npy_elements<std::int64_t>(payload, count, swap, out);
+            }
+        case 'u':
+            switch (header.item_size) {
+            case 1:
+                return convert_npy_elements<std::uint8_t>(payload, count, swap, out);
+            case 2:
+                return convert_npy_elements<std::uint16_t>(payload, count, swap, out);
+            case 4:
+                return convert_npy_elements<std::uint32_t>(payload, count, swap, out);
+            default:
+                return convert_npy_elements<std::uint64_t>(payload, count, swap, out);
+            }
+        default:
+            if constexpr (std::is_same_v<T, bool>)
+                return convert_npy_elements<bool>(payload, count, false, out);
+            else
+                return convert_npy_elements<std::uint8_t>(payload, count, false, out);
+        }
+    }
+
+    template <typename T>
+    Array<T> decode_npy(char* bytes, size_t size, const std::shared_ptr<MappedFile>& mapping, MapMode mode,
+        const std::string& what)
+    {
+        NpyHeader header = parse_npy_header(bytes, size, what);
+        std::vector<size_t> shape = header.shape.empty() ? std::vector<size_t> { 1 } : header.shape;
+        size_t count = shape_size(shape);
+        if (count == 0)
+            return Array<T>();
+        if (count > (size - header.data_offset) / header.item_size)
+            throw std::runtime_error(what + ": truncated data");
+        char* payload = bytes + header.data_offset;
+
+        bool native = header.item_size == 1 || header.big_endian == (std::endian::native == std::endian::big);
+        bool same_type = header.kind == npy_kind<T>() && header.item_size == sizeof(T) && native;
+        bool c_order = !header.fortran_order || shape.size() == 1;
+        bool aligned = reinterpret_cast<std::uintptr_t>(payload) % alignof(T) == 0;
+        if (mapping && mode != MapMode::Copy && same_type && c_order && aligned) {
+            // The deleter holds the mapping until the last Array lets go
+            Storage<T> storage = Storage<T>::adopt(reinterpret_cast<T*>(payload), count,
+                [mapping](T*) {}, mode == MapMode::ReadOnly);
+            return Array<T>(shape, storage);
+        }
+
+        Storage<T> storage(count);
+        if (c_order) {
+            convert_npy(payload, header, count, storage.data());
+        } else {
+            // Column-major: decode in file order, then reorder with the
+            // tiled strided copy
+            Storage<T> column_major(count);
+            convert_npy(payload, header, count, column_major.data());
+            std::vector<size_t> strides(shape.size());
+            size_t stride = 1;
+            for (size_t d = 0; d < shape.size(); d++) {
+                strides[d] = stride;
+                stride *= shape[d];
+            }
+            copy_strided<T>(column_major.data(), shape, strides, storage.data());
+        }
+        return Array<T>(shape, storage);
+    }
+
+    template <typename T>
+    std::vector<size_t> npy_shape(const Array<T>& arr)
+    {
+        return arr.size() == 0 ? std::vector<size_t> { 0 } : arr.shape();
+    }
+}
+
+template <typename T>
+Array<T> load_npy(const std::string& path, MapMode mode)
+{
+    NUMCPP_PROFILE("load_npy", 0);
+    auto mapping = std::make_shared<detail::MappedFile>(path, mode == MapMode::CopyOnWrite);
+    return detail::decode_npy<T>(mapping->data(), mapping->size(), mapping, mode, path);
+}
+
+template <typename T>
+void save_npy(const std::string& path, const Array<T>& arr)
+{
+    NUMCPP_PROFILE("save_npy", arr.size());
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        throw std::runtime_error("Cannot open file for writing: " + path);
+    std::string preamble = detail::npy_preamble(detail::npy_descr<T>(), detail::npy_shape(arr));
+    out.write(preamble.data(), static_cast<std::streamsize>(preamble.size()));
+    out.write(reinterpret_cast<const char*>(arr.data()), static_cast<std::streamsize>(arr.size() * sizeof(T)));
+    if (!out)
+        throw std::runtime_error("Cannot write file: " + path);
+}
+
+template <typename T>
+std::map<std::string, Array<T>> load_npz(const std::string& path, MapMode mode)
+{
+    NUMCPP_PROFILE("load_npz", 0);
+    auto mapping = std::make_shared<detail::MappedFile>(path, mode == MapMode::CopyOnWrite);
+    std::map<std::string, Array<T>> arrays;
+    for (const auto& entry : detail::zip_entries(mapping->data(), mapping->size(), path)) {
+        if (entry.method != 0)
+            throw std::runtime_error(path + ": compressed member " + entry.name + " is not supported");
+        std::string name = entry.name;
+        if (name.size() > 4 && name.compare(name.size() - 4, 4, ".npy") == 0)
+            name.resize(name.size() - 4);
+        arrays.emplace(name, detail::decode_npy<T>(mapping->data() + entry.data_offset, entry.size, mapping,
+            mode, path + "/" + entry.name));
+    }
+    return arrays;
+}
+
+template <typename T>
+void save_npz(const std::string& path, const std::map<std::string, Array<T>>& arrays)
+{
+    NUMCPP_PROFILE("save_npz", 0);
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        throw std::runtime_error("Cannot open file for writing: " + path);
+    std::string directory;
+    std::uint64_t offset = 0;
+    for (const auto& [name, arr] : arrays) {
+        std::string member = name + ".npy";
+        std::string preamble = detail::npy_preamble(detail::npy_descr<T>(), detail::npy_shape(arr));
+        const char* payload = reinterpret_cast<const char*>(arr.data());
+        std::uint64_t payload_size = arr.size() * sizeof(T);
+        std::uint64_t size = preamble.size() + payload_size;
+        std::uint32_t crc = detail::crc32(detail::crc32(0, preamble.data(), preamble.size()), payload, payload_size);
+        bool zip64 = size >= 0xFFFFFFFF || offset >= 0xFFFFFFFF;
+
+        std::string local = detail::zip_local_header(member, crc, size, zip64);
+        out.write(local.data(), static_cast<std::streamsize>(local.size()));
+        out.write(preamble.data(), static_cast<std::streamsize>(preamble.size()));
+        out.write(payload, static_cast<std::streamsize>(payload_size));
+        directory += detail::zip_central_header(member, crc, size, offset, zip64);
+        offset += local.size() + size;
+    }
+    std::string end = detail::zip_end_records(arrays.size(), directory.size(), offset);
+    out.write(directory.data(), static_cast<std::streamsize>(directory.size()));
+    out.write(end.data(), static_cast<std::streamsize>(end.size()));
+    if (!out)
+        throw std::runtime_error("Cannot write file: " + path);
+}
+
+} // namespace NumCPP
+
+#endif // NPY_TPP
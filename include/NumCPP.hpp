@@ -1,4 +1,19 @@
 #include "Array.hpp"
+#include "ArraySpan.hpp"
+#include "Async.hpp"
+#include "Batched.hpp"
+#include "CostModel.hpp"
+#include "Decomposition.hpp"
+#include "FixedMatrix.hpp"
+#include "FixedRankArray.hpp"
+#include "Math.hpp"
 #include "Matrix.hpp"
+#include "MemoryPool.hpp"
+#include "Npy.hpp"
+#include "Numa.hpp"
+#include "Permute.hpp"
+#include "Profiler.hpp"
+#include "Reduce.hpp"
+#include "Sparse.hpp"
 #include "SquareMatrix.hpp"
-#include "Storage.hpp"
\ No newline at end of file
+#include "Storage.hpp"
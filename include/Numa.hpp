@@ -0,0 +1,99 @@
+#ifndef NUMA_HPP
+#define NUMA_HPP
+
+#include "Allocator.hpp"
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace NumCPP {
+
+// One memory node and the CPUs this process may run on there
+struct NumaNode {
+    size_t id = 0;
+    std::vector<size_t> cpus;
+};
+
+// Memory nodes as seen by this process. Machines without NUMA, and other
+// systems than Linux, appear as a single node.
+struct NumaTopology {
+    std::vector<NumaNode> nodes;
+
+    size_t num_nodes() const { return nodes.size(); }
+    // Usable CPUs, node by node
+    std::vector<size_t> cpus() const;
+
+    // Placement of thread `thread` of a team of `num_threads`: threads are
+    // spread evenly over the CPUs, so consecutive threads share a node and
+    // every node gets its share of the team.
+    size_t cpu_for_thread(size_t thread, size_t num_threads) const;
+    size_t node_for_thread(size_t thread, size_t num_threads) const;
+};
+
+// Reads the nodes under `sysfs_root` (nodeN/cpulist), keeping the CPUs in
+// `allowed_cpus` and the nodes left with any. Falls back to one node holding
+// `allowed_cpus` when there is nothing to read.
+NumaTopology detect_numa_topology(const std::string& sysfs_root, const std::vector<size_t>& allowed_cpus);
+
+// Topology of this machine restricted to the process's CPU affinity, read
+// once
+const NumaTopology& numa_topology();
+
+// Restricts the calling thread to `cpu`; returns false where that is not
+// possible. ThreadPool pins its workers with this when pinning is enabled;
+// callers of parallel kernels may pin themselves to
+// numa_topology().cpu_for_thread(0, num_threads).
+bool pin_current_thread(size_t cpu);
+
+// Page placement of buffers from a NumaAllocator
+enum class NumaPolicy {
+    // Pages go to the node of the thread touching them first; Array
+    // initialization is parallel, so that is the worker that later
+    // processes them
+    Local,
+    // Pages round-robin over all nodes, for data every thread reads
+    Interleave,
+    // The buffer is cut into one part per ThreadPool thread, each placed on
+    // its thread's node. ThreadPool gives thread t the t-th part of every
+    // parallel loop, so with pinned workers each thread keeps working on
+    // node-local pages.
+    Partitioned,
+};
+
+// Places large buffers on NUMA nodes by `policy` (with mmap and mbind).
+// Buffers below `min_bytes`, alignments above a page, single-node machines
+// and systems without mbind are served by `upstream` unchanged.
+//
+// Use with set_default_allocator(numa) or ScopedAllocator, together with
+// ThreadPool::set_pinned(true). The allocator must outlive its buffers.
+class NumaAllocator : public Allocator {
+public:
+    explicit NumaAllocator(NumaPolicy policy = NumaPolicy::Partitioned, size_t min_bytes = size_t(1) << 20,
+        Allocator& upstream = detail::aligned_allocator());
+
+    NumaAllocator(const NumaAllocator&) = delete;
+    NumaAllocator& operator=(const NumaAllocator&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment) override;
+    void deallocate(void* ptr, size_t bytes, size_t alignment) noexcept override;
+    AllocatorStats stats() const override;
+
+    NumaPolicy policy() const { return policy_; }
+
+private:
+    NumaPolicy policy_;
+    size_t min_bytes_;
+    Allocator& upstream_;
+    std::atomic<size_t> allocations_ { 0 };
+    std::atomic<size_t> in_use_ { 0 };
+
+    bool mapped(size_t bytes, size_t alignment) const;
+    void place(void* ptr, size_t bytes) const;
+};
+
+} // namespace NumCPP
+
+#include "Numa.tpp"
+
+#endif // NUMA_HPP
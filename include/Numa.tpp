@@ -0,0 +1,268 @@
+#ifndef NUMA_TPP
+#define NUMA_TPP
+
+#include "Numa.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(SYS_mbind)
+#define NUMCPP_HAS_NUMA 1
+#else
+#define NUMCPP_HAS_NUMA 0
+#endif
+
+namespace NumCPP {
+
+namespace detail {
+    // Memory policy modes of mbind(2)
+    constexpr int mpol_preferred = 1;
+    constexpr int mpol_interleave = 3;
+    constexpr int mpol_local = 4;
+
+    // "0-3,8,10-11" -> { 0, 1, 2, 3, 8, 10, 11 }
+    inline std::vector<size_t> parse_cpu_list(const std::string& text)
+    {
+        std::vector<size_t> cpus;
+        std::stringstream in(text);
+        std::string item;
+        while (std::getline(in, item, ',')) {
+            size_t dash = item.find('-');
+            try {
+                size_t first = std::stoul(item.substr(0, dash));
+                size_t last = dash == std::string::npos ? first : std::stoul(item.substr(dash + 1));
+                for (size_t cpu = first; cpu <= last; cpu++)
+                    cpus.push_back(cpu);
+            } catch (const std::exception&) {
+                // Skip blank or malformed entries
+            }
+        }
+        return cpus;
+    }
+
+    inline std::vector<size_t> allowed_cpus()
+    {
+        std::vector<size_t> cpus;
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (::sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (size_t cpu = 0; cpu < CPU_SETSIZE; cpu++)
+                if (CPU_ISSET(cpu, &set))
+                    cpus.push_back(cpu);
+        }
+#endif
+        if (cpus.empty()) {
+            size_t count = std::max(1u, std::thread::hardware_concurrency());
+            for (size_t cpu = 0; cpu < count; cpu++)
+                cpus.push_back(cpu);
+        }
+        return cpus;
+    }
+
+    inline size_t page_size()
+    {
+#if NUMCPP_HAS_NUMA
+        static const size_t size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        return size;
+#else
+        return 4096;
+#endif
+    }
+
+    inline bool set_memory_policy(void* ptr, size_t bytes, int mode, const std::vector<size_t>& nodes)
+    {
+#if NUMCPP_HAS_NUMA
+        constexpr size_t bits = 8 * sizeof(unsigned long);
+        size_t highest = nodes.empty() ? 0 : *std::max_element(nodes.begin(), nodes.end());
+        std::vector<unsigned long> mask(highest / bits + 1, 0);
+        for (size_t node : nodes)
+            mask[node / bits] |= 1ul << (node % bits);
+        // The kernel reads maxnode - 1 bits
+        unsigned long maxnode = nodes.empty() ? 0 : mask.size() * bits + 1;
+        return ::syscall(SYS_mbind, ptr, bytes, mode, nodes.empty() ? nullptr : mask.data(), maxnode, 0) == 0;
+#else
+        (void)ptr, (void)bytes, (void)mode, (void)nodes;
+        return false;
+#endif
+    }
+}
+
+inline std::vector<size_t> NumaTopology::cpus() const
+{
+    std::vector<size_t> all;
+    for (const auto& node : nodes)
+        all.insert(all.end(), node.cpus.begin(), node.cpus.end());
+    return all;
+}
+
+inline size_t NumaTopology::cpu_for_thread(size_t thread, size_t num_threads) const
+{
+    std::vector<size_t> all = cpus();
+    if (all.empty())
+        return 0;
+    if (num_threads > all.size())
+        return all[thread % all.size()];
+    return all[thread * all.size() / num_threads];
+}
+
+inline size_t NumaTopology::node_for_thread(size_t thread, size_t num_threads) const
+{
+    size_t cpu = cpu_for_thread(thread, num_threads);
+    for (const auto& node : nodes)
+        if (std::find(node.cpus.begin(), node.cpus.end(), cpu) != node.cpus.end())
+            return node.id;
+    return nodes.empty() ? 0 : nodes.front().id;
+}
+
+inline NumaTopology detect_numa_topology(const std::string& sysfs_root, const std::vector<size_t>& allowed_cpus)
+{
+    NumaTopology topology;
+    std::ifstream online(sysfs_root + "/online");
+    std::string list;
+    if (online && std::getline(online, list)) {
+        for (size_t id : detail::parse_cpu_list(list)) {
+            std::ifstream cpulist(sysfs_root + "/node" + std::to_string(id) + "/cpulist");
+            std::string text;
+            if (!cpulist || !std::getline(cpulist, text))
+                continue;
+            NumaNode node { id, {} };
+            for (size_t cpu : detail::parse_cpu_list(text))
+                if (std::find(allowed_cpus.begin(), allowed_cpus.end(), cpu) != allowed_cpus.end())
+                    node.cpus.push_back(cpu);
+            // Nodes with memory only, or outside our affinity, run no threads
+            if (!node.cpus.empty())
+                topology.nodes.push_back(std::move(node));
+        }
+    }
+    if (topology.nodes.empty())
+        topology.nodes.push_back({ 0, allowed_cpus });
+    return topology;
+}
+
+inline const NumaTopology& numa_topology()
+{
+    static const NumaTopology topology = detect_numa_topology("/sys/devices/system/node", detail::allowed_cpus());
+    return topology;
+}
+
+inline bool pin_current_thread(size_t cpu)
+{
+#if defined(__linux__)
+    if (cpu >= CPU_SETSIZE)
+        return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return ::sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+inline NumaAllocator::NumaAllocator(NumaPolicy policy, size_t min_bytes, Allocator& upstream)
+    : policy_(policy)
+    , min_bytes_(min_bytes)
+    , upstream_(upstream)
+{
+}
+
+inline bool NumaAllocator::mapped(size_t bytes, size_t alignment) const
+{
+    // One node: the default placement is already local, so mapping the
+    // buffer would only add an mmap/munmap pair and fresh page faults. The
+    // topology is read once, so deallocate() sees the same answer.
+    return NUMCPP_HAS_NUMA && bytes > 0 && bytes >= min_bytes_ && alignment <= detail::page_size()
+        && numa_topology().num_nodes() > 1;
+}
+
+inline void NumaAllocator::place(void* ptr, size_t bytes) const
+{
+    const NumaTopology& topology = numa_topology();
+    // Placement is advice; failures leave the kernel's default in place
+    switch (policy_) {
+    case NumaPolicy::Local:
+        detail::set_memory_policy(ptr, bytes, detail::mpol_local, {});
+        break;
+    case NumaPolicy::Interleave: {
+        std::vector<size_t> ids;
+        for (const auto& node : topology.nodes)
+            ids.push_back(node.id);
+        detail::set_memory_policy(ptr, bytes, detail::mpol_interleave, ids);
+        break;
+    }
+    case NumaPolicy::Partitioned: {
+        ThreadPool& pool = ThreadPool::instance();
+        size_t parts = pool.is_inline() ? 1 : pool.num_threads();
+        size_t page = detail::page_size();
+        size_t pages = bytes / page;
+        char* base = static_cast<char*>(ptr);
+        for (size_t t = 0; t < parts; t++) {
+            size_t first = t * pages / parts;
+            size_t last = (t + 1) * pages / parts;
+            if (first == last)
+                continue;
+            detail::set_memory_policy(base + first * page, (last - first) * page, detail::mpol_preferred,
+                { topology.node_for_thread(t, parts) });
+        }
+        break;
+    }
+    }
+}
+
+inline void* NumaAllocator::allocate(size_t bytes, size_t alignment)
+{
+    void* ptr = nullptr;
+    if (mapped(bytes, alignment)) {
+#if NUMCPP_HAS_NUMA
+        size_t page = detail::page_size();
+        size_t length = (bytes + page - 1) / page * page;
+        // Fresh anonymous pages: nothing is placed until first touched
+        ptr = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED)
+            throw std::bad_alloc();
+        place(ptr, length);
+#endif
+    } else {
+        ptr = upstream_.allocate(bytes, alignment);
+    }
+    allocations_.fetch_add(1, std::memory_order_relaxed);
+    in_use_.fetch_add(bytes, std::memory_order_relaxed);
+    return ptr;
+}
+
+inline void NumaAllocator::deallocate(void* ptr, size_t bytes, size_t alignment) noexcept
+{
+    in_use_.fetch_sub(bytes, std::memory_order_relaxed);
+    if (mapped(bytes, alignment)) {
+#if NUMCPP_HAS_NUMA
+        size_t page = detail::page_size();
+        ::munmap(ptr, (bytes + page - 1) / page * page);
+#endif
+    } else {
+        upstream_.deallocate(ptr, bytes, alignment);
+    }
+}
+
+inline AllocatorStats NumaAllocator::stats() const
+{
+    AllocatorStats stats;
+    stats.allocations = allocations_.load(std::memory_order_relaxed);
+    stats.bytes_in_use = in_use_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace NumCPP
+
+#endif // NUMA_TPP
@@ -0,0 +1,51 @@
+#ifndef PERMUTE_HPP
+#define PERMUTE_HPP
+
+#include "Simd.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace NumCPP {
+
+// dst = src^T, where src is rows x cols with row stride lds and dst is
+// cols x rows with row stride ldd (strides in elements; buffers must not
+// overlap).
+//
+// The matrix is cut into 256 x 256 blocks that run in parallel; each block is
+// split recursively (cache-oblivious) down to 32 x 32 tiles, which are
+// transposed as W x W register blocks on the active SimdLevel for 4- and
+// 8-byte element types.
+template <typename T>
+void transpose(const T* src, size_t rows, size_t cols, size_t lds, T* dst, size_t ldd);
+
+// Transposes the n x n row-major matrix `data` in place by swapping mirrored
+// register blocks; parallel over pairs of 64 x 64 tiles.
+template <typename T>
+void transpose_inplace(T* data, size_t n);
+
+// Writes the elements of a strided layout (shape and per-axis strides in
+// elements, as in ArrayView) to dst in row-major order. Axes that are
+// contiguous in both layouts are merged; when the source's unit-stride axis
+// is not the last one the copy becomes a batch of tiled 2D transposes.
+template <typename T>
+void copy_strided(const T* src, const std::vector<size_t>& shape, const std::vector<size_t>& strides, T* dst);
+
+// dst = src with its axes reordered: dst's axis i is src's axis axes[i].
+// src is row-major with the given shape. Throws std::invalid_argument if
+// axes is not a permutation of 0..ndim-1.
+template <typename T>
+void permute(const T* src, const std::vector<size_t>& shape, const std::vector<size_t>& axes, T* dst);
+
+namespace detail {
+    // Recursion stops at leaf x leaf tiles; parallel tasks are block x block
+    inline constexpr size_t transpose_leaf = 32;
+    inline constexpr size_t transpose_block = 256;
+    // Tile edge of the in-place transpose (a multiple of every register width)
+    inline constexpr size_t transpose_inplace_tile = 64;
+}
+
+} // namespace NumCPP
+
+#include "Permute.tpp"
+
+#endif // PERMUTE_HPP
@@ -0,0 +1,377 @@
+#ifndef PERMUTE_TPP
+#define PERMUTE_TPP
+
+#include "CostModel.hpp"
+#include "Permute.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace NumCPP {
+
+namespace detail {
+    template <typename T>
+    constexpr bool simd_transposable = simd::Vectorizable<T> && (sizeof(T) == 4 || sizeof(T) == 8);
+
+    template <typename T>
+    void transpose_tile_scalar(const T* src, size_t lds, T* dst, size_t ldd, size_t rows, size_t cols)
+    {
+        for (size_t j = 0; j < cols; j++) {
+            T* out = dst + j * ldd;
+            for (size_t i = 0; i < rows; i++)
+                out[i] = src[i * lds + j];
+        }
+    }
+
+    // Swaps a[r][c] with a[c][r] for r in [r0, r1), c in [c0, c1); a
+    // diagonal tile (r0 == c0) only visits c > r
+    template <typename T>
+    void swap_tile_scalar(T* a, size_t ld, size_t r0, size_t r1, size_t c0, size_t c1, bool diagonal)
+    {
+        for (size_t r = r0; r < r1; r++) {
+            for (size_t c = diagonal ? r + 1 : c0; c < c1; c++)
+                std::swap(a[r * ld + c], a[c * ld + r]);
+        }
+    }
+
+#if NUMCPP_SIMD_VECTOR_EXT
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+    // Lane j of the result takes lo's lane j, or hi's lane j - H when bit H
+    // of j is set (and the mirror image for interleave_high)
+    template <typename P, size_t H, size_t... Is>
+    NUMCPP_ALWAYS_INLINE typename P::reg interleave_low(typename P::reg lo, typename P::reg hi,
+        std::index_sequence<Is...>)
+    {
+        return __builtin_shufflevector(lo, hi, ((Is & H) ? P::width + Is - H : Is)...);
+    }
+
+    template <typename P, size_t H, size_t... Is>
+    NUMCPP_ALWAYS_INLINE typename P::reg interleave_high(typename P::reg lo, typename P::reg hi,
+        std::index_sequence<Is...>)
+    {
+        return __builtin_shufflevector(lo, hi, ((Is & H) ? P::width + Is : Is + H)...);
+    }
+
+    // log2(W) butterfly stages turn W rows of W lanes into W columns
+    template <typename P, size_t H = P::width / 2>
+    NUMCPP_ALWAYS_INLINE void transpose_registers(typename P::reg* r)
+    {
+        if constexpr (H > 0) {
+            constexpr auto lanes = std::make_index_sequence<P::width> {};
+            for (size_t i = 0; i < P::width; i++) {
+                if (i & H)
+                    continue;
+                typename P::reg lo = r[i], hi = r[i + H];
+                r[i] = interleave_low<P, H>(lo, hi, lanes);
+                r[i + H] = interleave_high<P, H>(lo, hi, lanes);
+            }
+            transpose_registers<P, H / 2>(r);
+        }
+    }
+
+    template <typename P, typename T>
+    NUMCPP_ALWAYS_INLINE void transpose_register_block(const T* src, size_t lds, T* dst, size_t ldd)
+    {
+        typename P::reg r[P::width];
+        for (size_t i = 0; i < P::width; i++)
+            r[i] = P::load(src + i * lds);
+        transpose_registers<P>(r);
+        for (size_t i = 0; i < P::width; i++)
+            P::store(dst + i * ldd, r[i]);
+    }
+
+    // Exchanges the W x W blocks at a and b, transposing both; a == b
+    // transposes a diagonal block since all loads precede the stores
+    template <typename P, typename T>
+    NUMCPP_ALWAYS_INLINE void swap_transpose_block(T* a, T* b, size_t ld)
+    {
+        typename P::reg x[P::width], y[P::width];
+        for (size_t i = 0; i < P::width; i++) {
+            x[i] = P::load(a + i * ld);
+            y[i] = P::load(b + i * ld);
+        }
+        transpose_registers<P>(x);
+        transpose_registers<P>(y);
+        for (size_t i = 0; i < P::width; i++) {
+            P::store(b + i * ld, x[i]);
+            P::store(a + i * ld, y[i]);
+        }
+    }
+
+    template <typename P, typename T>
+    NUMCPP_ALWAYS_INLINE void transpose_tile_body(const T* src, size_t lds, T* dst, size_t ldd, size_t rows, size_t cols)
+    {
+        constexpr size_t W = P::width;
+        size_t rb = rows - rows % W, cb = cols - cols % W;
+        for (size_t i = 0; i < rb; i += W) {
+            for (size_t j = 0; j < cb; j += W)
+                transpose_register_block<P>(src + i * lds + j, lds, dst + j * ldd + i, ldd);
+        }
+        if (cb < cols)
+            transpose_tile_scalar(src + cb, lds, dst + cb * ldd, ldd, rows, cols - cb);
+        if (rb < rows)
+            transpose_tile_scalar(src + rb * lds, lds, dst + rb, ldd, rows - rb, cb);
+    }
+
+    // Tile bounds are multiples of the register width
+    template <typename P, typename T>
+    NUMCPP_ALWAYS_INLINE void swap_tile_body(T* a, size_t ld, size_t r0, size_t r1, size_t c0, size_t c1, bool diagonal)
+    {
+        constexpr size_t W = P::width;
+        for (size_t r = r0; r < r1; r += W) {
+            for (size_t c = diagonal ? r : c0; c < c1; c += W)
+                swap_transpose_block<P>(a + r * ld + c, a + c * ld + r, ld);
+        }
+    }
+
+#if NUMCPP_SIMD_X86
+#define NUMCPP_TRANSPOSE_ENTRY_POINTS(SUFFIX, TARGET, BYTES)                                  \
+    template <typename T>                                                                     \
+    TARGET void transpose_tile_##SUFFIX(const T* src, size_t lds, T* dst, size_t ldd,         \
+        size_t rows, size_t cols)                                                             \
+    {                                                                                         \
+        transpose_tile_body<simd::Pack<T, BYTES>>(src, lds, dst, ldd, rows, cols);            \
+    }                                                                                         \
+    template <typename T>                                                                     \
+    TARGET void swap_tile_##SUFFIX(T* a, size_t ld, size_t r0, size_t r1, size_t c0,          \
+        size_t c1, bool diagonal)                                                             \
+    {                                                                                         \
+        swap_tile_body<simd::Pack<T, BYTES>>(a, ld, r0, r1, c0, c1, diagonal);                \
+    }
+
+    NUMCPP_TRANSPOSE_ENTRY_POINTS(sse2, NUMCPP_TARGET_SSE2, 16)
+    NUMCPP_TRANSPOSE_ENTRY_POINTS(avx2, NUMCPP_TARGET_AVX2, 32)
+    NUMCPP_TRANSPOSE_ENTRY_POINTS(avx512, NUMCPP_TARGET_AVX512, 64)
+
+#undef NUMCPP_TRANSPOSE_ENTRY_POINTS
+#endif
+#pragma GCC diagnostic pop
+#endif
+
+    template <typename T>
+    void transpose_tile(const T* src, size_t lds, T* dst, size_t ldd, size_t rows, size_t cols)
+    {
+#if NUMCPP_SIMD_X86
+        if constexpr (simd_transposable<T>) {
+            switch (simd_level()) {
+            case SimdLevel::AVX512:
+                transpose_tile_avx512(src, lds, dst, ldd, rows, cols);
+                return;
+            case SimdLevel::AVX2:
+                transpose_tile_avx2(src, lds, dst, ldd, rows, cols);
+                return;
+            case SimdLevel::SSE2:
+                transpose_tile_sse2(src, lds, dst, ldd, rows, cols);
+                return;
+            default:
+                break;
+            }
+        }
+#endif
+        transpose_tile_scalar(src, lds, dst, ldd, rows, cols);
+    }
+
+    template <typename T>
+    void swap_tile(T* a, size_t ld, size_t r0, size_t r1, size_t c0, size_t c1, bool diagonal)
+    {
+#if NUMCPP_SIMD_X86
+        if constexpr (simd_transposable<T>) {
+            switch (simd_level()) {
+            case SimdLevel::AVX512:
+                swap_tile_avx512(a, ld, r0, r1, c0, c1, diagonal);
+                return;
+            case SimdLevel::AVX2:
+                swap_tile_avx2(a, ld, r0, r1, c0, c1, diagonal);
+                return;
+            case SimdLevel::SSE2:
+                swap_tile_sse2(a, ld, r0, r1, c0, c1, diagonal);
+                return;
+            default:
+                break;
+            }
+        }
+#endif
+        swap_tile_scalar(a, ld, r0, r1, c0, c1, diagonal);
+    }
+
+    // Halves the longer side (at a multiple of 16, so register blocks stay
+    // whole) until the tile fits in cache at every level
+    template <typename T>
+    void transpose_recursive(const T* src, size_t lds, T* dst, size_t ldd, size_t rows, size_t cols)
+    {
+        if (rows <= transpose_leaf && cols <= transpose_leaf) {
+            transpose_tile(src, lds, dst, ldd, rows, cols);
+            return;
+        }
+        if (rows >= cols) {
+            size_t half = (rows / 2 + 15) & ~size_t(15);
+            transpose_recursive(src, lds, dst, ldd, half, cols);
+            transpose_recursive(src + half * lds, lds, dst + half, ldd, rows - half, cols);
+        } else {
+            size_t half = (cols / 2 + 15) & ~size_t(15);
+            transpose_recursive(src, lds, dst, ldd, rows, half);
+            transpose_recursive(src + half, lds, dst + half * ldd, ldd, rows, cols - half);
+        }
+    }
+}
+
+template <typename T>
+void transpose(const T* src, size_t rows, size_t cols, size_t lds, T* dst, size_t ldd)
+{
+    constexpr size_t B = detail::transpose_block;
+    size_t block_rows = (rows + B - 1) / B;
+    size_t block_cols = (cols + B - 1) / B;
+    parallel_for(0, block_rows * block_cols, [&](size_t start, size_t end) {
+        for (size_t b = start; b < end; b++) {
+            size_t i0 = (b / block_cols) * B;
+            size_t j0 = (b % block_cols) * B;
+            detail::transpose_recursive(src + i0 * lds + j0, lds, dst + j0 * ldd + i0, ldd,
+                std::min(B, rows - i0), std::min(B, cols - j0));
+        }
+    }, parallel_grain(KernelCost::stream<T>(1, 1) * double(B * B)));
+}
+
+template <typename T>
+void transpose_inplace(T* data, size_t n)
+{
+    constexpr size_t B = detail::transpose_inplace_tile;
+    size_t tiles = n / B;
+    // Tile pairs (I, J) with I <= J, numbered row by row of the upper triangle
+    size_t pairs = tiles * (tiles + 1) / 2;
+    size_t grain = parallel_grain(KernelCost::stream<T>(2, 2) * double(B * B));
+    parallel_for(0, pairs, [&](size_t start, size_t end) {
+        size_t I = 0, first = 0;
+        while (first + (tiles - I) <= start)
+            first += tiles - I++;
+        size_t J = I + (start - first);
+        for (size_t p = start; p < end; p++) {
+            detail::swap_tile(data, n, I * B, I * B + B, J * B, J * B + B, I == J);
+            if (++J == tiles)
+                J = ++I;
+        }
+    }, grain);
+    // Rows and columns past the last whole tile
+    for (size_t i = tiles * B; i < n; i++) {
+        for (size_t j = 0; j < i; j++)
+            std::swap(data[i * n + j], data[j * n + i]);
+    }
+}
+
+template <typename T>
+void copy_strided(const T* src, const std::vector<size_t>& shape, const std::vector<size_t>& strides, T* dst)
+{
+    size_t total = 1;
+    for (auto s : shape)
+        total *= s;
+    if (shape.empty() || total == 0)
+        return;
+
+    // Drop unit axes and merge an axis into its predecessor when stepping
+    // over the whole axis equals one step of the predecessor
+    std::vector<size_t> dims, steps;
+    for (size_t d = 0; d < shape.size(); d++) {
+        if (shape[d] == 1)
+            continue;
+        if (!dims.empty() && steps.back() == strides[d] * shape[d]) {
+            dims.back() *= shape[d];
+            steps.back() = strides[d];
+        } else {
+            dims.push_back(shape[d]);
+            steps.push_back(strides[d]);
+        }
+    }
+    if (dims.empty()) {
+        dst[0] = src[0];
+        return;
+    }
+
+    const size_t nd = dims.size();
+    const size_t last = nd - 1;
+    size_t unit = std::min_element(steps.begin(), steps.end()) - steps.begin();
+
+    if (steps[last] == 1 || steps[unit] != 1) {
+        // Row copies along the last axis
+        size_t inner = dims[last];
+        size_t step = steps[last];
+        size_t grain = parallel_grain(KernelCost::stream<T>(1, 1) * double(inner));
+        parallel_for(0, total / inner, [&](size_t start, size_t end) {
+            for (size_t row = start; row < end; row++) {
+                size_t off = 0, rem = row;
+                for (size_t d = last; d-- > 0;) {
+                    off += (rem % dims[d]) * steps[d];
+                    rem /= dims[d];
+                }
+                const T* in = src + off;
+                T* out = dst + row * inner;
+                if (step == 1) {
+                    std::copy(in, in + inner, out);
+                } else {
+                    for (size_t j = 0; j < inner; j++)
+                        out[j] = in[j * step];
+                }
+            }
+        }, grain);
+        return;
+    }
+
+    // The source is contiguous along `unit` but the destination along `last`:
+    // every combination of the other axes is one 2D transpose of a
+    // dims[last] x dims[unit] source block
+    std::vector<size_t> dst_strides(nd);
+    size_t stride = 1;
+    for (size_t d = nd; d-- > 0;) {
+        dst_strides[d] = stride;
+        stride *= dims[d];
+    }
+    size_t rows = dims[last], cols = dims[unit];
+    size_t lds = steps[last], ldd = dst_strides[unit];
+    size_t blocks = total / (rows * cols);
+    size_t grain = parallel_grain(KernelCost::stream<T>(1, 1) * double(rows * cols));
+    parallel_for(0, blocks, [&](size_t start, size_t end) {
+        for (size_t b = start; b < end; b++) {
+            size_t src_off = 0, dst_off = 0, rem = b;
+            for (size_t d = last; d-- > 0;) {
+                if (d == unit)
+                    continue;
+                size_t idx = rem % dims[d];
+                rem /= dims[d];
+                src_off += idx * steps[d];
+                dst_off += idx * dst_strides[d];
+            }
+            transpose(src + src_off, rows, cols, lds, dst + dst_off, ldd);
+        }
+    }, grain);
+}
+
+template <typename T>
+void permute(const T* src, const std::vector<size_t>& shape, const std::vector<size_t>& axes, T* dst)
+{
+    const size_t nd = shape.size();
+    if (axes.size() != nd)
+        throw std::invalid_argument("Invalid axes permutation");
+    std::vector<bool> seen(nd, false);
+    for (auto a : axes) {
+        if (a >= nd || seen[a])
+            throw std::invalid_argument("Invalid axes permutation");
+        seen[a] = true;
+    }
+
+    std::vector<size_t> src_strides(nd);
+    size_t stride = 1;
+    for (size_t d = nd; d-- > 0;) {
+        src_strides[d] = stride;
+        stride *= shape[d];
+    }
+    std::vector<size_t> dst_shape(nd), dst_strides(nd);
+    for (size_t i = 0; i < nd; i++) {
+        dst_shape[i] = shape[axes[i]];
+        dst_strides[i] = src_strides[axes[i]];
+    }
+    copy_strided(src, dst_shape, dst_strides, dst);
+}
+
+} // namespace NumCPP
+
+#endif // PERMUTE_TPP
@@ -0,0 +1,145 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace NumCPP {
+
+// Aggregated counters for one operation name
+struct OpStats {
+    std::string name;
+    size_t calls = 0;
+    size_t parallel_calls = 0; // calls that dispatched work to the thread pool
+    size_t elements = 0;
+    size_t bytes_allocated = 0;
+    uint64_t total_ns = 0;
+    uint64_t max_ns = 0;
+};
+
+// One timed call, kept while tracing is on
+struct TraceEvent {
+    const char* name;
+    uint64_t start_ns; // since the profiler was created
+    uint64_t duration_ns;
+    uint32_t thread;
+    size_t elements;
+    size_t bytes_allocated;
+    bool parallel;
+};
+
+// Collects per-operation timings from the NUMCPP_PROFILE hooks placed in the
+// public Array, Matrix and SquareMatrix operations.
+//
+// The hooks are compiled in only when NUMCPP_PROFILING is defined (the
+// CMake option of the same name); otherwise they expand to nothing. When
+// compiled in, recording starts disabled unless the NUMCPP_PROFILE
+// environment variable is set to a non-zero value, and a disabled hook costs
+// one relaxed atomic load. Times, bytes and the parallel flag are inclusive
+// of nested operations.
+class Profiler {
+public:
+    static Profiler& instance();
+
+    bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+    void set_enabled(bool enabled);
+
+    // Keep individual events for write_chrome_trace(). At most `capacity`
+    // events are kept; later ones are counted in dropped_events().
+    bool tracing() const { return tracing_.load(std::memory_order_relaxed); }
+    void set_tracing(bool enabled, size_t capacity = size_t(1) << 20);
+
+    // All operations seen so far, most total time first
+    std::vector<OpStats> stats() const;
+    // Counters for one operation (all zero if it never ran)
+    OpStats stats(std::string_view name) const;
+    std::vector<TraceEvent> events() const;
+    size_t dropped_events() const;
+    void reset();
+
+    // Chrome trace-event JSON ("X" complete events), loadable in
+    // chrome://tracing and Perfetto
+    void write_chrome_trace(std::ostream& out) const;
+
+    // Called by the hooks
+    void record(const TraceEvent& event);
+    uint64_t now_ns() const;
+
+private:
+    Profiler();
+
+    std::atomic<bool> enabled_ { false };
+    std::atomic<bool> tracing_ { false };
+    uint64_t epoch_ns_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string_view, OpStats> ops_;
+    std::vector<TraceEvent> events_;
+    size_t capacity_ = 0;
+    size_t dropped_ = 0;
+};
+
+namespace detail {
+    // Times one operation on the current thread. Scopes nest; allocations
+    // and parallel dispatches are charged to the innermost one and rolled
+    // up into its parents when it ends.
+    class ProfileScope {
+    public:
+        ProfileScope(const char* name, size_t elements);
+        ~ProfileScope();
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+        static ProfileScope*& current();
+        void add_bytes(size_t bytes) { bytes_ += bytes; }
+        void mark_parallel() { parallel_ = true; }
+
+    private:
+        const char* name_;
+        size_t elements_;
+        size_t bytes_ = 0;
+        bool parallel_ = false;
+        bool active_;
+        uint64_t start_ = 0;
+        ProfileScope* parent_ = nullptr;
+    };
+
+    inline void profile_bytes(size_t bytes)
+    {
+        if (ProfileScope* scope = ProfileScope::current())
+            scope->add_bytes(bytes);
+    }
+
+    inline void profile_parallel()
+    {
+        if (ProfileScope* scope = ProfileScope::current())
+            scope->mark_parallel();
+    }
+}
+
+} // namespace NumCPP
+
+#define NUMCPP_PROFILE_CONCAT_(a, b) a##b
+#define NUMCPP_PROFILE_CONCAT(a, b) NUMCPP_PROFILE_CONCAT_(a, b)
+
+#ifdef NUMCPP_PROFILING
+#define NUMCPP_PROFILE(name, elements) \
+    ::NumCPP::detail::ProfileScope NUMCPP_PROFILE_CONCAT(numcpp_profile_, __LINE__)(name, elements)
+#define NUMCPP_PROFILE_BYTES(bytes) ::NumCPP::detail::profile_bytes(bytes)
+#define NUMCPP_PROFILE_PARALLEL() ::NumCPP::detail::profile_parallel()
+#else
+#define NUMCPP_PROFILE(name, elements) ((void)0)
+#define NUMCPP_PROFILE_BYTES(bytes) ((void)0)
+#define NUMCPP_PROFILE_PARALLEL() ((void)0)
+#endif
+
+#include "Profiler.tpp"
+
+#endif // PROFILER_HPP
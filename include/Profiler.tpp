@@ -0,0 +1,198 @@
+#ifndef PROFILER_TPP
+#define PROFILER_TPP
+
+#include "Profiler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <utility>
+
+namespace NumCPP {
+
+namespace detail {
+    inline uint64_t steady_ns()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+                .count());
+    }
+
+    // Small stable id per thread for trace output
+    inline uint32_t profile_thread_id()
+    {
+        static std::atomic<uint32_t> next { 1 };
+        thread_local uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    inline void write_json_string(std::ostream& out, std::string_view text)
+    {
+        out << '"';
+        for (char c : text) {
+            if (c == '"' || c == '\\')
+                out << '\\';
+            out << c;
+        }
+        out << '"';
+    }
+}
+
+inline Profiler::Profiler()
+    : epoch_ns_(detail::steady_ns())
+{
+    const char* env = std::getenv("NUMCPP_PROFILE");
+    if (env && *env && std::string_view(env) != "0")
+        enabled_.store(true, std::memory_order_relaxed);
+}
+
+inline Profiler& Profiler::instance()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+inline void Profiler::set_enabled(bool enabled)
+{
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+inline void Profiler::set_tracing(bool enabled, size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    if (enabled)
+        events_.reserve(std::min<size_t>(capacity, 4096));
+    tracing_.store(enabled, std::memory_order_relaxed);
+}
+
+inline uint64_t Profiler::now_ns() const
+{
+    return detail::steady_ns() - epoch_ns_;
+}
+
+inline void Profiler::record(const TraceEvent& event)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [it, inserted] = ops_.try_emplace(event.name);
+    OpStats& op = it->second;
+    if (inserted)
+        op.name = event.name;
+    op.calls++;
+    op.parallel_calls += event.parallel ? 1 : 0;
+    op.elements += event.elements;
+    op.bytes_allocated += event.bytes_allocated;
+    op.total_ns += event.duration_ns;
+    op.max_ns = std::max(op.max_ns, event.duration_ns);
+
+    if (tracing_.load(std::memory_order_relaxed)) {
+        if (events_.size() < capacity_)
+            events_.push_back(event);
+        else
+            dropped_++;
+    }
+}
+
+inline std::vector<OpStats> Profiler::stats() const
+{
+    std::vector<OpStats> result;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        result.reserve(ops_.size());
+        for (const auto& [name, op] : ops_)
+            result.push_back(op);
+    }
+    std::sort(result.begin(), result.end(),
+        [](const OpStats& a, const OpStats& b) { return a.total_ns > b.total_ns; });
+    return result;
+}
+
+inline OpStats Profiler::stats(std::string_view name) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = ops_.find(name);
+    if (it != ops_.end())
+        return it->second;
+    OpStats empty;
+    empty.name = std::string(name);
+    return empty;
+}
+
+inline std::vector<TraceEvent> Profiler::events() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return events_;
+}
+
+inline size_t Profiler::dropped_events() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dropped_;
+}
+
+inline void Profiler::reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ops_.clear();
+    events_.clear();
+    dropped_ = 0;
+}
+
+inline void Profiler::write_chrome_trace(std::ostream& out) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    for (size_t i = 0; i < events_.size(); ++i) {
+        const TraceEvent& e = events_[i];
+        out << (i ? ",\n" : "\n") << "{\"name\": ";
+        detail::write_json_string(out, e.name);
+        // Trace timestamps are microseconds
+        out << ", \"cat\": \"numcpp\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << e.thread
+            << ", \"ts\": " << double(e.start_ns) / 1000.0
+            << ", \"dur\": " << double(e.duration_ns) / 1000.0
+            << ", \"args\": {\"elements\": " << e.elements
+            << ", \"bytes_allocated\": " << e.bytes_allocated
+            << ", \"parallel\": " << (e.parallel ? "true" : "false") << "}}";
+    }
+    out << "\n]}\n";
+}
+
+namespace detail {
+    inline ProfileScope*& ProfileScope::current()
+    {
+        thread_local ProfileScope* scope = nullptr;
+        return scope;
+    }
+
+    inline ProfileScope::ProfileScope(const char* name, size_t elements)
+        : name_(name)
+        , elements_(elements)
+        , active_(Profiler::instance().enabled())
+    {
+        if (!active_)
+            return;
+        parent_ = std::exchange(current(), this);
+        start_ = Profiler::instance().now_ns();
+    }
+
+    inline ProfileScope::~ProfileScope()
+    {
+        if (!active_)
+            return;
+        Profiler& profiler = Profiler::instance();
+        uint64_t end = profiler.now_ns();
+        current() = parent_;
+        if (parent_) {
+            parent_->bytes_ += bytes_;
+            parent_->parallel_ = parent_->parallel_ || parallel_;
+        }
+        try {
+            profiler.record({ name_, start_, end - start_, profile_thread_id(), elements_, bytes_, parallel_ });
+        } catch (...) {
+            // Losing a sample is better than terminating from a destructor
+        }
+    }
+}
+
+} // namespace NumCPP
+
+#endif // PROFILER_TPP
@@ -0,0 +1,99 @@
+#ifndef REDUCE_HPP
+#define REDUCE_HPP
+
+#include "Simd.hpp"
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace NumCPP {
+
+// Reduces the row-major array `src` of the given shape over the axes flagged
+// in `reduced` with policy R (simd::Sum, Min or Max), writing the kept axes
+// to dst in row-major order. Reducing over an empty range yields R's
+// identity.
+//
+// Unit axes are dropped and neighbouring axes of the same kind merged. When
+// the last axis is reduced, every output is a SIMD tree reduction of
+// contiguous rows, parallel over the outputs (or within the row when there
+// are few). When the last axis is kept, whole source rows are combined into
+// column blocks of dst with register-wide operations, parallel over output
+// rows and column blocks.
+template <typename R, typename T>
+void reduce_axes(const T* src, const std::vector<size_t>& shape, const std::vector<bool>& reduced, T* dst);
+
+// Index along `axis` of the first minimum (simd::Min) or maximum (simd::Max)
+// for every position of the other axes, written to dst in row-major order.
+// The extent of `axis` must be non-zero.
+template <typename R, typename T>
+void arg_reduce_axis(const T* src, const std::vector<size_t>& shape, size_t axis, size_t* dst);
+
+// How floating-point sums (sum(), mean() and sums over the last axis) are
+// accumulated.
+enum class SumMode {
+    // Independent SIMD accumulators over per-thread chunks: fastest, but the
+    // rounding depends on the thread count and the SimdLevel
+    Fast,
+    // Compensated (TwoSum) sums over fixed blocks, merged in a fixed pairwise
+    // tree: bit-identical for any thread count and instruction set
+    Reproducible
+};
+
+// Mode currently used. Defaults to Fast and can be changed with the
+// NUMCPP_SUM_MODE environment variable (fast, reproducible) or set_sum_mode().
+SumMode sum_mode();
+void set_sum_mode(SumMode mode);
+
+// Compensated sum of data[0, count) with the fixed block tree of
+// SumMode::Reproducible, whatever the current mode.
+template <typename T>
+T reproducible_sum(const T* data, size_t count);
+
+// Statistics computed with integer element types use double
+template <typename T>
+using moment_type = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+
+// Count, mean and the central sums m_k = sum((x - mean)^k) for k = 2..4,
+// mergeable across partitions (Chan / Pebay update).
+template <typename T>
+struct Moments {
+    size_t count = 0;
+    T mean = T(0);
+    T m2 = T(0);
+    T m3 = T(0);
+    T m4 = T(0);
+
+    // NaN when count <= ddof
+    T variance(size_t ddof = 0) const;
+    T stddev(size_t ddof = 0) const;
+    T skewness() const;
+    // Excess kurtosis (0 for a normal distribution)
+    T kurtosis() const;
+
+    void merge(const Moments& other);
+};
+
+// Moments of data[0, count) in one pass over memory: every fixed block is
+// reduced from cache in two passes and the blocks are merged in a fixed
+// pairwise tree, so the result is independent of the thread count.
+template <typename T>
+Moments<moment_type<T>> compute_moments(const T* data, size_t count);
+
+namespace detail {
+    // Columns of dst accumulated per task when the last axis is kept
+    inline constexpr size_t reduce_column_block = 1024;
+    // Fixed partition of reproducible sums and moments: blocks of
+    // sum_block elements, each accumulated in sum_lanes interleaved lanes
+    inline constexpr size_t sum_block = 2048;
+    inline constexpr size_t sum_lanes = 8;
+
+    // reproducible_sum() of kernel(i), e.g. an unevaluated expression
+    template <typename T, typename K>
+    T reproducible_sum(const K& kernel, size_t count);
+}
+
+} // namespace NumCPP
+
+#include "Reduce.tpp"
+
+#endif // REDUCE_HPP
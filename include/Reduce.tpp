@@ -0,0 +1,626 @@
+#ifndef REDUCE_TPP
+#define REDUCE_TPP
+
+#include "CostModel.hpp"
+#include "Reduce.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// The fixed-order kernels below must round identically on every build, so
+// Clang (which contracts a * b + c by default) may not fuse them
+#if defined(__clang__)
+#define NUMCPP_NO_FP_CONTRACT _Pragma("clang fp contract(off)")
+#else
+#define NUMCPP_NO_FP_CONTRACT
+#endif
+
+namespace NumCPP {
+
+namespace detail {
+    // Contiguous row read by simd::reduce
+    template <typename T>
+    struct ReduceRowKernel {
+        const T* data;
+        T operator()(size_t i) const { return data[i]; }
+        template <typename P>
+        NUMCPP_ALWAYS_INLINE typename P::reg packet(size_t i) const { return P::load(data + i); }
+        template <typename P>
+        NUMCPP_ALWAYS_INLINE typename P::reg packet(size_t i, size_t count) const
+        {
+            return P::load_partial(data + i, count, T(0));
+        }
+    };
+
+    // acc[i] combined with src[i] under policy R, for simd::assign into acc
+    template <typename R, typename T>
+    struct CombineKernel {
+        const T* acc;
+        const T* src;
+        T operator()(size_t i) const { return simd::Reducer<R>::combine(acc[i], src[i]); }
+        template <typename P>
+        NUMCPP_ALWAYS_INLINE typename P::reg packet(size_t i) const
+        {
+            return simd::Reducer<R>::template combine_packet<P>(P::load(acc + i), P::load(src + i));
+        }
+        template <typename P>
+        NUMCPP_ALWAYS_INLINE typename P::reg packet(size_t i, size_t count) const
+        {
+            return simd::Reducer<R>::template combine_packet<P>(P::load_partial(acc + i, count, T(0)),
+                P::load_partial(src + i, count, T(0)));
+        }
+    };
+
+    // Offset of the index-th combination of the axes `which` (row-major
+    // over their extents)
+    inline size_t axes_offset(size_t index, const std::vector<size_t>& which, const std::vector<size_t>& dims,
+        const std::vector<size_t>& strides)
+    {
+        size_t off = 0;
+        for (size_t k = which.size(); k-- > 0;) {
+            size_t d = which[k];
+            off += (index % dims[d]) * strides[d];
+            index /= dims[d];
+        }
+        return off;
+    }
+
+    template <typename R, typename T>
+    bool arg_better(const T& candidate, const T& best)
+    {
+        if constexpr (std::is_same_v<R, simd::Min>)
+            return candidate < best;
+        else
+            return candidate > best;
+    }
+
+    // First index of the extreme of row[0, n): a SIMD reduction finds the
+    // value, then a search finds its position. A value the reduction skips
+    // (NaN) falls back to a scalar scan. Both passes run in parallel when
+    // `parallel` is set.
+    template <typename R, typename T>
+    size_t arg_row(const T* row, size_t n, bool parallel)
+    {
+        size_t grain = parallel ? parallel_grain(KernelCost::stream<T>(1)) : n;
+        T extreme = parallel_reduce(
+            0, n, simd::Reducer<R>::template identity<T>(),
+            [row](size_t start, size_t end) { return simd::reduce<R, T>(ReduceRowKernel<T> { row }, start, end); },
+            [](const T& a, const T& b) { return simd::Reducer<R>::combine(a, b); }, grain);
+        size_t found = parallel_reduce(
+            0, n, n,
+            [row, extreme](size_t start, size_t end) {
+                return size_t(std::find(row + start, row + end, extreme) - row);
+            },
+            [n](size_t a, size_t b) { return a != n ? a : b; }, grain);
+        if (found != n)
+            return found;
+        size_t best = 0;
+        for (size_t i = 1; i < n; i++) {
+            if (arg_better<R>(row[i], row[best]))
+                best = i;
+        }
+        return best;
+    }
+
+    inline std::atomic<int>& active_sum_mode()
+    {
+        static std::atomic<int> mode([] {
+            const char* env = std::getenv("NUMCPP_SUM_MODE");
+            bool reproducible = env && std::string(env) == "reproducible";
+            return static_cast<int>(reproducible ? SumMode::Reproducible : SumMode::Fast);
+        }());
+        return mode;
+    }
+
+    // Per-element work of a compensated sum: a load and the six operations
+    // of TwoSum
+    template <typename T>
+    constexpr KernelCost compensated_cost()
+    {
+        return KernelCost::stream<T>(1) + KernelCost { 0, 6, 0 };
+    }
+
+    // Per-element work of block_moments: the mean pass and the deviation
+    // powers accumulated in the second
+    template <typename T>
+    constexpr KernelCost moments_cost()
+    {
+        return KernelCost::stream<T>(1) + KernelCost { 0, 10, 0 };
+    }
+
+    // Running sum plus the accumulated rounding error of every addition,
+    // recovered exactly and without branches by Knuth's TwoSum (the same
+    // correction Neumaier's variant of Kahan summation computes)
+    template <typename T>
+    struct CompensatedSum {
+        T sum = T(0);
+        T comp = T(0);
+
+        void add(T x)
+        {
+            NUMCPP_NO_FP_CONTRACT
+            T t = sum + x;
+            T z = t - sum;
+            comp += (sum - (t - z)) + (x - z);
+            sum = t;
+        }
+        void merge(const CompensatedSum& other)
+        {
+            add(other.sum);
+            comp += other.comp;
+        }
+        // An infinite or NaN sum poisons the correction, so it is returned as is
+        T value() const { return std::isfinite(sum) ? sum + comp : sum; }
+    };
+
+    // Merges parts[0..n) as a balanced binary tree whose shape depends only on n
+    template <typename Acc>
+    Acc merge_tree(std::vector<Acc>& parts)
+    {
+        for (size_t step = 1; step < parts.size(); step *= 2) {
+            for (size_t i = 0; i + step < parts.size(); i += 2 * step)
+                parts[i].merge(parts[i + step]);
+        }
+        return parts.empty() ? Acc {} : parts[0];
+    }
+
+#if NUMCPP_SIMD_VECTOR_EXT
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+    // The sum_lanes lanes spread over registers of P; each lane sees exactly
+    // the operations of the scalar code, whatever the register width
+    template <typename T>
+    using SumLanes = simd::Pack<T, 16>;
+
+    // Runs whole groups of sum_lanes from `begin`, storing the lanes and
+    // returning where it stopped
+    template <typename P, typename T, typename K>
+    NUMCPP_ALWAYS_INLINE size_t compensated_lanes(const K& kernel, size_t begin, size_t end, CompensatedSum<T>* lanes)
+    {
+        NUMCPP_NO_FP_CONTRACT
+        using reg = typename P::reg;
+        constexpr size_t R = sum_lanes / P::width;
+        reg sum[R], comp[R];
+        for (size_t r = 0; r < R; r++)
+            sum[r] = comp[r] = P::broadcast(T(0));
+        size_t i = begin;
+        for (; i + sum_lanes <= end; i += sum_lanes) {
+            for (size_t r = 0; r < R; r++) {
+                reg x = kernel.template packet<P>(i + r * P::width);
+                reg t = sum[r] + x;
+                reg z = t - sum[r];
+                comp[r] += (sum[r] - (t - z)) + (x - z);
+                sum[r] = t;
+            }
+        }
+        for (size_t k = 0; k < sum_lanes; k++)
+            lanes[k] = { sum[k / P::width][k % P::width], comp[k / P::width][k % P::width] };
+        return i;
+    }
+
+#if NUMCPP_SIMD_X86
+    // Only plain loads run on the wider targets: they enable FMA, which could
+    // otherwise be contracted into an expression and change its rounding
+#define NUMCPP_SUM_ENTRY_POINTS(SUFFIX, TARGET, BYTES)                                          \
+    template <typename T>                                                                       \
+    TARGET size_t compensated_lanes_##SUFFIX(const T* data, size_t begin, size_t end,           \
+        CompensatedSum<T>* lanes)                                                               \
+    {                                                                                           \
+        using P = simd::Pack<T, std::min<size_t>(BYTES, sum_lanes * sizeof(T))>;                \
+        return compensated_lanes<P>(ReduceRowKernel<T> { data }, begin, end, lanes);            \
+    }
+
+    NUMCPP_SUM_ENTRY_POINTS(avx2, NUMCPP_TARGET_AVX2, 32)
+    NUMCPP_SUM_ENTRY_POINTS(avx512, NUMCPP_TARGET_AVX512, 64)
+
+#undef NUMCPP_SUM_ENTRY_POINTS
+#endif
+#pragma GCC diagnostic pop
+#endif
+
+    // Element i goes to lane (i - begin) % sum_lanes; lanes merge pairwise
+    template <typename T, typename K>
+    CompensatedSum<T> block_sum(const K& kernel, size_t begin, size_t end)
+    {
+        CompensatedSum<T> lanes[sum_lanes];
+        size_t i = begin;
+#if NUMCPP_SIMD_VECTOR_EXT
+        if constexpr (simd::VectorKernel<K, T>) {
+            switch (simd_level()) {
+#if NUMCPP_SIMD_X86
+            case SimdLevel::AVX512:
+                if constexpr (std::is_same_v<K, ReduceRowKernel<T>>) {
+                    i = compensated_lanes_avx512(kernel.data, begin, end, lanes);
+                    break;
+                }
+                [[fallthrough]];
+            case SimdLevel::AVX2:
+                if constexpr (std::is_same_v<K, ReduceRowKernel<T>>) {
+                    i = compensated_lanes_avx2(kernel.data, begin, end, lanes);
+                    break;
+                }
+                [[fallthrough]];
+#endif
+            default:
+                i = compensated_lanes<SumLanes<T>>(kernel, begin, end, lanes);
+                break;
+            }
+        }
+#endif
+        for (; i + sum_lanes <= end; i += sum_lanes) {
+            for (size_t k = 0; k < sum_lanes; k++)
+                lanes[k].add(T(kernel(i + k)));
+        }
+        for (size_t k = 0; i < end; i++, k++)
+            lanes[k].add(T(kernel(i)));
+        for (size_t step = 1; step < sum_lanes; step *= 2) {
+            for (size_t k = 0; k + step < sum_lanes; k += 2 * step)
+                lanes[k].merge(lanes[k + step]);
+        }
+        return lanes[0];
+    }
+
+    template <typename U, typename T>
+    Moments<U> block_moments(const T* data, size_t count)
+    {
+        NUMCPP_NO_FP_CONTRACT
+        U lanes[sum_lanes] = {};
+        size_t i = 0;
+#if NUMCPP_SIMD_VECTOR_EXT
+        if constexpr (std::is_same_v<T, U>) {
+            using P = SumLanes<U>;
+            constexpr size_t R = sum_lanes / P::width;
+            typename P::reg acc[R];
+            for (size_t r = 0; r < R; r++)
+                acc[r] = P::broadcast(U(0));
+            for (; i + sum_lanes <= count; i += sum_lanes) {
+                for (size_t r = 0; r < R; r++)
+                    acc[r] += P::load(data + i + r * P::width);
+            }
+            for (size_t k = 0; k < sum_lanes; k++)
+                lanes[k] = acc[k / P::width][k % P::width];
+        }
+#endif
+        for (; i + sum_lanes <= count; i += sum_lanes) {
+            for (size_t k = 0; k < sum_lanes; k++)
+                lanes[k] += U(data[i + k]);
+        }
+        for (size_t k = 0; i < count; i++, k++)
+            lanes[k] += U(data[i]);
+        for (size_t step = 1; step < sum_lanes; step *= 2) {
+            for (size_t k = 0; k + step < sum_lanes; k += 2 * step)
+                lanes[k] += lanes[k + step];
+        }
+
+        // Second pass over the block, still in cache
+        Moments<U> block;
+        block.count = count;
+        block.mean = lanes[0] / U(count);
+        U s2[sum_lanes] = {}, s3[sum_lanes] = {}, s4[sum_lanes] = {};
+        i = 0;
+#if NUMCPP_SIMD_VECTOR_EXT
+        if constexpr (std::is_same_v<T, U>) {
+            using P = SumLanes<U>;
+            constexpr size_t R = sum_lanes / P::width;
+            const typename P::reg mean = P::broadcast(block.mean);
+            typename P::reg a2[R], a3[R], a4[R];
+            for (size_t r = 0; r < R; r++)
+                a2[r] = a3[r] = a4[r] = P::broadcast(U(0));
+            for (; i + sum_lanes <= count; i += sum_lanes) {
+                for (size_t r = 0; r < R; r++) {
+                    typename P::reg d = P::load(data + i + r * P::width) - mean;
+                    typename P::reg d2 = d * d;
+                    a2[r] += d2;
+                    a3[r] += d2 * d;
+                    a4[r] += d2 * d2;
+                }
+            }
+            for (size_t k = 0; k < sum_lanes; k++) {
+                s2[k] = a2[k / P::width][k % P::width];
+                s3[k] = a3[k / P::width][k % P::width];
+                s4[k] = a4[k / P::width][k % P::width];
+            }
+        }
+#endif
+        for (; i + sum_lanes <= count; i += sum_lanes) {
+            for (size_t k = 0; k < sum_lanes; k++) {
+                U d = U(data[i + k]) - block.mean;
+                U d2 = d * d;
+                s2[k] += d2;
+                s3[k] += d2 * d;
+                s4[k] += d2 * d2;
+            }
+        }
+        for (size_t k = 0; i < count; i++, k++) {
+            U d = U(data[i]) - block.mean;
+            U d2 = d * d;
+            s2[k] += d2;
+            s3[k] += d2 * d;
+            s4[k] += d2 * d2;
+        }
+        for (size_t step = 1; step < sum_lanes; step *= 2) {
+            for (size_t k = 0; k + step < sum_lanes; k += 2 * step) {
+                s2[k] += s2[k + step];
+                s3[k] += s3[k + step];
+                s4[k] += s4[k + step];
+            }
+        }
+        block.m2 = s2[0];
+        block.m3 = s3[0];
+        block.m4 = s4[0];
+        return block;
+    }
+}
+
+inline SumMode sum_mode()
+{
+    return static_cast<SumMode>(detail::active_sum_mode().load(std::memory_order_relaxed));
+}
+
+inline void set_sum_mode(SumMode mode)
+{
+    detail::active_sum_mode().store(static_cast<int>(mode), std::memory_order_relaxed);
+}
+
+template <typename T>
+T reproducible_sum(const T* data, size_t count)
+{
+    return detail::reproducible_sum<T>(detail::ReduceRowKernel<T> { data }, count);
+}
+
+template <typename T, typename K>
+T detail::reproducible_sum(const K& kernel, size_t count)
+{
+    constexpr size_t B = detail::sum_block;
+    size_t blocks = (count + B - 1) / B;
+    std::vector<detail::CompensatedSum<T>> parts(blocks);
+    parallel_for(0, blocks, [&](size_t start, size_t end) {
+        for (size_t b = start; b < end; b++)
+            parts[b] = detail::block_sum<T>(kernel, b * B, std::min(count, b * B + B));
+    }, parallel_grain(detail::compensated_cost<T>() * double(B)));
+    return detail::merge_tree(parts).value();
+}
+
+template <typename T>
+T Moments<T>::variance(size_t ddof) const
+{
+    if (count <= ddof)
+        return std::numeric_limits<T>::quiet_NaN();
+    return m2 / T(count - ddof);
+}
+
+template <typename T>
+T Moments<T>::stddev(size_t ddof) const
+{
+    return std::sqrt(variance(ddof));
+}
+
+template <typename T>
+T Moments<T>::skewness() const
+{
+    return std::sqrt(T(count)) * m3 / std::pow(m2, T(1.5));
+}
+
+template <typename T>
+T Moments<T>::kurtosis() const
+{
+    return T(count) * m4 / (m2 * m2) - T(3);
+}
+
+template <typename T>
+void Moments<T>::merge(const Moments& other)
+{
+    NUMCPP_NO_FP_CONTRACT
+    if (other.count == 0)
+        return;
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+    T na = T(count), nb = T(other.count), n = na + nb;
+    T delta = other.mean - mean;
+    T dn = delta / n;
+    T dn2 = dn * dn;
+    T cross = delta * dn * na * nb;
+    T new_m2 = m2 + other.m2 + cross;
+    T new_m3 = m3 + other.m3 + cross * dn * (na - nb) + T(3) * dn * (na * other.m2 - nb * m2);
+    m4 = m4 + other.m4 + cross * dn2 * (na * na - na * nb + nb * nb)
+        + T(6) * dn2 * (na * na * other.m2 + nb * nb * m2) + T(4) * dn * (na * other.m3 - nb * m3);
+    m3 = new_m3;
+    m2 = new_m2;
+    mean += nb * dn;
+    count += other.count;
+}
+
+template <typename T>
+Moments<moment_type<T>> compute_moments(const T* data, size_t count)
+{
+    using U = moment_type<T>;
+    constexpr size_t B = detail::sum_block;
+    size_t blocks = (count + B - 1) / B;
+    std::vector<Moments<U>> parts(blocks);
+    parallel_for(0, blocks, [&](size_t start, size_t end) {
+        for (size_t b = start; b < end; b++)
+            parts[b] = detail::block_moments<U>(data + b * B, std::min(B, count - b * B));
+    }, parallel_grain(detail::moments_cost<T>() * double(B)));
+    return detail::merge_tree(parts);
+}
+
+template <typename R, typename T>
+void reduce_axes(const T* src, const std::vector<size_t>& shape, const std::vector<bool>& reduced, T* dst)
+{
+    using Red = simd::Reducer<R>;
+    size_t out_count = 1, reduce_count = 1;
+    for (size_t d = 0; d < shape.size(); d++)
+        (reduced[d] ? reduce_count : out_count) *= shape[d];
+    if (out_count == 0)
+        return;
+    if (reduce_count == 0) {
+        std::fill(dst, dst + out_count, Red::template identity<T>());
+        return;
+    }
+
+    // Drop unit axes and merge neighbours of the same kind
+    std::vector<size_t> dims;
+    std::vector<bool> red;
+    for (size_t d = 0; d < shape.size(); d++) {
+        if (shape[d] == 1)
+            continue;
+        if (!dims.empty() && red.back() == reduced[d]) {
+            dims.back() *= shape[d];
+        } else {
+            dims.push_back(shape[d]);
+            red.push_back(reduced[d]);
+        }
+    }
+    if (dims.empty()) {
+        dst[0] = src[0];
+        return;
+    }
+
+    const size_t nd = dims.size();
+    std::vector<size_t> strides(nd);
+    size_t stride = 1;
+    for (size_t d = nd; d-- > 0;) {
+        strides[d] = stride;
+        stride *= dims[d];
+    }
+    std::vector<size_t> kept_axes, reduced_axes;
+    for (size_t d = 0; d + 1 < nd; d++)
+        (red[d] ? reduced_axes : kept_axes).push_back(d);
+
+    if (red.back()) {
+        // Every output reduces reduce_count / n contiguous rows of n
+        const size_t n = dims.back();
+        // Reproducible sums merge the rows' block trees in row order
+        if constexpr (std::is_same_v<R, simd::Sum> && std::is_floating_point_v<T>) {
+            if (sum_mode() == SumMode::Reproducible) {
+                size_t rows = reduce_count / n;
+                parallel_for(0, out_count, [&](size_t start, size_t end) {
+                    for (size_t o = start; o < end; o++) {
+                        size_t base = detail::axes_offset(o, kept_axes, dims, strides);
+                        detail::CompensatedSum<T> acc;
+                        for (size_t r = 0; r < rows; r++) {
+                            const T* row = src + base + detail::axes_offset(r, reduced_axes, dims, strides);
+                            acc.add(reproducible_sum(row, n));
+                        }
+                        dst[o] = acc.value();
+                    }
+                }, parallel_grain(detail::compensated_cost<T>() * double(reduce_count)));
+                return;
+            }
+        }
+        auto reduce_range = [&](size_t base, size_t start, size_t end) {
+            T acc = Red::template identity<T>();
+            while (start < end) {
+                size_t r = start / n, j = start % n;
+                size_t len = std::min(n - j, end - start);
+                const T* row = src + base + detail::axes_offset(r, reduced_axes, dims, strides);
+                acc = Red::combine(acc, simd::reduce<R, T>(detail::ReduceRowKernel<T> { row }, j, j + len));
+                start += len;
+            }
+            return acc;
+        };
+        // With fewer outputs than threads, split each output's range instead
+        bool split = out_count < ThreadPool::instance().num_threads();
+        const KernelCost element = KernelCost::stream<T>(1);
+        size_t grain = parallel_grain(element * double(reduce_count));
+        parallel_for(0, out_count, [&](size_t start, size_t end) {
+            for (size_t o = start; o < end; o++) {
+                size_t base = detail::axes_offset(o, kept_axes, dims, strides);
+                if (!split) {
+                    dst[o] = reduce_range(base, 0, reduce_count);
+                    continue;
+                }
+                dst[o] = parallel_reduce(
+                    0, reduce_count, Red::template identity<T>(),
+                    [&](size_t s, size_t e) { return reduce_range(base, s, e); },
+                    [](const T& a, const T& b) { return Red::combine(a, b); }, parallel_grain(element));
+            }
+        }, grain);
+        return;
+    }
+
+    // The last axis is kept: fold whole source rows into column blocks of
+    // each output row, which stay in cache across the reduced combinations
+    const size_t m = dims.back();
+    constexpr size_t C = detail::reduce_column_block;
+    const size_t block_width = std::min(m, C);
+    const size_t blocks_per_row = (m + C - 1) / C;
+    const size_t out_rows = out_count / m;
+    size_t grain = parallel_grain(KernelCost::stream<T>(2, 1) * double(reduce_count * block_width));
+    parallel_for(0, out_rows * blocks_per_row, [&](size_t start, size_t end) {
+        for (size_t t = start; t < end; t++) {
+            size_t row = t / blocks_per_row;
+            size_t c0 = (t % blocks_per_row) * C, c1 = std::min(m, c0 + C);
+            size_t base = detail::axes_offset(row, kept_axes, dims, strides);
+            T* out = dst + row * m;
+            std::copy(src + base + c0, src + base + c1, out + c0);
+            for (size_t r = 1; r < reduce_count; r++) {
+                const T* in = src + base + detail::axes_offset(r, reduced_axes, dims, strides);
+                simd::assign(out, detail::CombineKernel<R, T> { out, in }, c0, c1);
+            }
+        }
+    }, grain);
+}
+
+template <typename R, typename T>
+void arg_reduce_axis(const T* src, const std::vector<size_t>& shape, size_t axis, size_t* dst)
+{
+    size_t outer = 1, inner = 1;
+    for (size_t d = 0; d < axis; d++)
+        outer *= shape[d];
+    for (size_t d = axis + 1; d < shape.size(); d++)
+        inner *= shape[d];
+    const size_t n = shape[axis];
+    if (outer * inner == 0)
+        return;
+
+    if (inner == 1) {
+        bool split = outer < ThreadPool::instance().num_threads();
+        size_t grain = parallel_grain(KernelCost::stream<T>(1) * double(n));
+        parallel_for(0, outer, [&](size_t start, size_t end) {
+            for (size_t o = start; o < end; o++)
+                dst[o] = detail::arg_row<R>(src + o * n, n, split);
+        }, grain);
+        return;
+    }
+
+    // Track the best value per column of a block while walking the axis
+    constexpr size_t C = detail::reduce_column_block;
+    const size_t blocks_per_row = (inner + C - 1) / C;
+    // A scalar compare and select per element
+    size_t grain = parallel_grain((KernelCost::stream<T>(1) + KernelCost { 0, 2, 0 }) * double(n * std::min(inner, C)));
+    parallel_for(0, outer * blocks_per_row, [&](size_t start, size_t end) {
+        std::vector<T> best;
+        for (size_t t = start; t < end; t++) {
+            size_t o = t / blocks_per_row;
+            size_t c0 = (t % blocks_per_row) * C, c1 = std::min(inner, c0 + C);
+            const T* base = src + o * n * inner;
+            size_t* out = dst + o * inner;
+            best.assign(base + c0, base + c1);
+            std::fill(out + c0, out + c1, size_t(0));
+            for (size_t k = 1; k < n; k++) {
+                const T* in = base + k * inner;
+                for (size_t j = c0; j < c1; j++) {
+                    if (detail::arg_better<R>(in[j], best[j - c0])) {
+                        best[j - c0] = in[j];
+                        out[j] = k;
+                    }
+                }
+            }
+        }
+    }, grain);
+}
+
+} // namespace NumCPP
+
+#undef NUMCPP_NO_FP_CONTRACT
+
+#endif // REDUCE_TPP
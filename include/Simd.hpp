@@ -0,0 +1,125 @@
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Generic vector types (GCC/Clang vector extensions) are lowered to the
+// instruction set of the function they are inlined into, so one kernel
+// template yields SSE2, AVX2 and AVX-512 code through the target-specific
+// entry points below.
+#if defined(__GNUC__) || defined(__clang__)
+#define NUMCPP_SIMD_VECTOR_EXT 1
+#define NUMCPP_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define NUMCPP_SIMD_VECTOR_EXT 0
+#define NUMCPP_ALWAYS_INLINE inline
+#endif
+
+#if NUMCPP_SIMD_VECTOR_EXT && (defined(__x86_64__) || defined(__i386__))
+#define NUMCPP_SIMD_X86 1
+#define NUMCPP_TARGET_SSE2 __attribute__((target("sse2")))
+#define NUMCPP_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define NUMCPP_TARGET_AVX512 __attribute__((target("avx512f,avx512dq,avx512bw,avx512vl")))
+#else
+#define NUMCPP_SIMD_X86 0
+#endif
+
+namespace NumCPP {
+
+// Instruction set used by the element-wise kernels and reductions.
+enum class SimdLevel {
+    Scalar = 0,
+    SSE2 = 1,
+    AVX2 = 2,
+    AVX512 = 3
+};
+
+// Best level supported by the CPU, detected once through CPUID.
+SimdLevel detected_simd_level();
+
+// Level currently used by the kernels. Defaults to the detected level and can
+// be lowered with the NUMCPP_SIMD environment variable
+// (scalar, sse2, avx2, avx512) or set_simd_level().
+SimdLevel simd_level();
+
+// Select a level; requests above the detected level are clamped.
+void set_simd_level(SimdLevel level);
+
+const char* simd_level_name(SimdLevel level);
+
+namespace simd {
+    template <typename T>
+    concept Vectorizable = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>
+        && !std::is_same_v<T, long double>;
+
+#if NUMCPP_SIMD_VECTOR_EXT
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+    // A register of Bytes / sizeof(T) lanes
+    template <typename T, size_t Bytes>
+    struct Pack {
+        using value_type = T;
+        typedef T reg __attribute__((vector_size(Bytes)));
+        using mask = decltype(reg {} < reg {});
+
+        static constexpr size_t bytes = Bytes;
+        static constexpr size_t width = Bytes / sizeof(T);
+
+        static NUMCPP_ALWAYS_INLINE reg broadcast(T value);
+        static NUMCPP_ALWAYS_INLINE reg load(const T* ptr);
+        // Loads `count` lanes, filling the rest with `fill`
+        static NUMCPP_ALWAYS_INLINE reg load_partial(const T* ptr, size_t count, T fill);
+        static NUMCPP_ALWAYS_INLINE void store(T* ptr, reg value);
+        static NUMCPP_ALWAYS_INLINE void store_aligned(T* ptr, reg value);
+        // Stores only the first `count` lanes
+        static NUMCPP_ALWAYS_INLINE void store_partial(T* ptr, reg value, size_t count);
+
+        // Lanes [0, count) set
+        static NUMCPP_ALWAYS_INLINE mask first_lanes(size_t count);
+        static NUMCPP_ALWAYS_INLINE reg select(mask m, reg a, reg b);
+        // 1 where the mask is set, 0 elsewhere
+        static NUMCPP_ALWAYS_INLINE reg from_mask(mask m);
+        static NUMCPP_ALWAYS_INLINE reg min(reg a, reg b);
+        static NUMCPP_ALWAYS_INLINE reg max(reg a, reg b);
+        // Correctly rounded square root of floating-point lanes
+        static NUMCPP_ALWAYS_INLINE reg sqrt(reg value);
+
+        static NUMCPP_ALWAYS_INLINE T horizontal_sum(reg value);
+        static NUMCPP_ALWAYS_INLINE T horizontal_min(reg value);
+        static NUMCPP_ALWAYS_INLINE T horizontal_max(reg value);
+    };
+#pragma GCC diagnostic pop
+
+    // True when every node of kernel K can be evaluated on whole registers
+    template <typename K, typename T>
+    concept VectorKernel = Vectorizable<T> && requires(const K& kernel, size_t i) {
+        kernel.template packet<Pack<T, 16>>(i);
+        kernel.template packet<Pack<T, 16>>(i, i);
+    };
+#else
+    template <typename K, typename T>
+    concept VectorKernel = false;
+#endif
+
+    // Reduction policies
+    struct Sum { };
+    struct Min { };
+    struct Max { };
+
+    // dst[i] = kernel(i) for i in [begin, end), on the active SIMD level
+    template <typename T, typename K>
+    void assign(T* dst, const K& kernel, size_t begin, size_t end);
+
+    // Reduces kernel(i) over [begin, end) with policy R (Sum, Min or Max),
+    // using several independent accumulators
+    template <typename R, typename T, typename K>
+    T reduce(const K& kernel, size_t begin, size_t end);
+}
+
+} // namespace NumCPP
+
+#include "Simd.tpp"
+
+#endif // SIMD_HPP
@@ -0,0 +1,386 @@
+#ifndef SIMD_TPP
+#define SIMD_TPP
+
+#include "Simd.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#if NUMCPP_SIMD_X86
+// Declares the square root builtins of every x86 register width
+#include <immintrin.h>
+#endif
+
+namespace NumCPP {
+
+namespace detail {
+    inline SimdLevel parse_simd_level(const char* name, SimdLevel fallback)
+    {
+        std::string value(name);
+        if (value == "scalar")
+            return SimdLevel::Scalar;
+        if (value == "sse2")
+            return SimdLevel::SSE2;
+        if (value == "avx2")
+            return SimdLevel::AVX2;
+        if (value == "avx512")
+            return SimdLevel::AVX512;
+        return fallback;
+    }
+
+    inline std::atomic<int>& active_simd_level()
+    {
+        static std::atomic<int> level([] {
+            SimdLevel detected = detected_simd_level();
+            SimdLevel chosen = detected;
+            if (const char* env = std::getenv("NUMCPP_SIMD"))
+                chosen = std::min(parse_simd_level(env, detected), detected);
+            return static_cast<int>(chosen);
+        }());
+        return level;
+    }
+}
+
+inline SimdLevel detected_simd_level()
+{
+    static const SimdLevel level = [] {
+#if NUMCPP_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")
+            && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl"))
+            return SimdLevel::AVX512;
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return SimdLevel::AVX2;
+        if (__builtin_cpu_supports("sse2"))
+            return SimdLevel::SSE2;
+#endif
+        return SimdLevel::Scalar;
+    }();
+    return level;
+}
+
+inline SimdLevel simd_level()
+{
+    return static_cast<SimdLevel>(detail::active_simd_level().load(std::memory_order_relaxed));
+}
+
+inline void set_simd_level(SimdLevel level)
+{
+    level = std::min(level, detected_simd_level());
+    detail::active_simd_level().store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+inline const char* simd_level_name(SimdLevel level)
+{
+    switch (level) {
+    case SimdLevel::SSE2:
+        return "sse2";
+    case SimdLevel::AVX2:
+        return "avx2";
+    case SimdLevel::AVX512:
+        return "avx512";
+    default:
+        return "scalar";
+    }
+}
+
+namespace simd {
+    template <typename R>
+    struct Reducer;
+
+    template <>
+    struct Reducer<Sum> {
+        template <typename T>
+        static T identity() { return T(0); }
+        template <typename T>
+        static T combine(T a, T b) { return a + b; }
+        template <typename P>
+        static NUMCPP_ALWAYS_INLINE typename P::reg combine_packet(typename P::reg a, typename P::reg b) { return a + b; }
+        template <typename P>
+        static NUMCPP_ALWAYS_INLINE typename P::value_type horizontal(typename P::reg v) { return P::horizontal_sum(v); }
+    };
+
+    template <>
+    struct Reducer<Min> {
+        template <typename T>
+        static T identity() { return std::numeric_limits<T>::max(); }
+        template <typename T>
+        static T combine(T a, T b) { return b < a ? b : a; }
+        template <typename P>
+        static NUMCPP_ALWAYS_INLINE typename P::reg combine_packet(typename P::reg a, typename P::reg b) { return P::min(a, b); }
+        template <typename P>
+        static NUMCPP_ALWAYS_INLINE typename P::value_type horizontal(typename P::reg v) { return P::horizontal_min(v); }
+    };
+
+    template <>
+    struct Reducer<Max> {
+        template <typename T>
+        static T identity() { return std::numeric_limits<T>::lowest(); }
+        template <typename T>
+        static T combine(T a, T b) { return b > a ? b : a; }
+        template <typename P>
+        static NUMCPP_ALWAYS_INLINE typename P::reg combine_packet(typename P::reg a, typename P::reg b) { return P::max(a, b); }
+        template <typename P>
+        static NUMCPP_ALWAYS_INLINE typename P::value_type horizontal(typename P::reg v) { return P::horizontal_max(v); }
+    };
+
+#if NUMCPP_SIMD_VECTOR_EXT
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+    template <typename T, size_t Bytes>
+    NUMCPP_ALWAYS_INLINE typename Pack<T, Bytes>::reg Pack<T, Bytes>::broadcast(T value)
+    {
+        return reg {} + value;
+    }
+
+    template <typename T, size_t Bytes>
+    NUMCPP_ALWAYS_INLINE typename Pack<T, Bytes>::reg Pack<T, Bytes>::load(const T* ptr)
+    {
+        reg value;
+        std::memcpy(&value, ptr, Bytes);
+        return value;
+    }
+
+    template <typename T, size_t Bytes>
+    NUMCPP_ALWAYS_INLINE typename Pack<T, Bytes>::reg Pack<T, Bytes>::load_partial(const T* ptr, size_t count, T fill)
+    {
+        reg value = broadcast(fill);
+        std::memcpy(&value, ptr, count * sizeof(T));
+        return value;
+    }
+
+    template <typename T, size_t Bytes>
+    NUMCPP_ALWAYS_INLINE void Pack<T, Bytes>::store(T* ptr, reg value)
+    {
+        std::memcpy(ptr, &value, Bytes);
+    }
+
+    template <typename T, size_t Bytes>
+    NUMCPP_ALWAYS_INLINE void Pack<T, Bytes>::store_aligned(T* ptr, reg value)
+    {
+        std::memcpy(__builtin_assume_aligned(ptr, Bytes), &value, Bytes);
+    }
+
+    template <typename T, size_t Bytes>
+    NUMCPP_ALWAYS_INLINE void Pack<T, Bytes>::store_partial(T* ptr, reg value, size_t count)
+    {
+        std::memcpy(ptr, &value, count * sizeof(T));
+    }
+
+    template <typename T, size_t Bytes>
+    NUMCPP_ALWAYS_INLINE typename Pack<T, Bytes>::mask Pack<T, Bytes>::first_lanes(size_t count)
+    {
+        // Comparison masks use signed integer lanes of the same width as T
+        using lane = std::conditional_t<sizeof(T) == 8, std::int64_t,
+            std::conditional_t<sizeof(T) == 4, std::int32_t,
+                std::conditional_t<sizeof(T) == 2, std::int16_t, std::int8_t>>>;
+        mask index {};
+        for (size_t k = 0; k < width; k++)
+            index[k] = static_cast<lane>(k);
+        return index < static_cast<lane>(count);
+    }
+
+    template <typename T, size_t Bytes>
+    NUMCPP_ALWAYS_INLINE typename Pack<T, Bytes>::reg Pack<T, Bytes>::select(mask m, reg a, reg b)
+    {
+        return m ? a : b;
+    }
+
+    template <typename T, size_t Bytes>
+    NUMCPP_ALWAYS_INLINE typename Pack<T, Bytes>::reg Pack<T, Bytes>::from_mask(mask m)
+    {
+        return m ? broadcast(T(1)) : broadcast(T(0));
+    }
+
+    template <typename T, size_t Bytes>
+    NUMCPP_ALWAYS_INLINE typename Pack<T, Bytes>::reg Pack<T, Bytes>::min(reg a, reg b)
+    {
+        return b < a ? b : a;
+    }
+
+    template <typename T, size_t Bytes>
+    NUMCPP_ALWAYS_INLINE typename Pack<T, Bytes>::reg Pack<T, Bytes>::max(reg a, reg b)
+    {
+        return b > a ? b : a;
+    }
+
+    template <typename T, size_t Bytes>
+    NUMCPP_ALWAYS_INLINE typename Pack<T, Bytes>::reg Pack<T, Bytes>::sqrt(reg value)
+    {
+#if NUMCPP_SIMD_X86
+        // Vector extensions have no square root, so use the instruction of
+        // each register width; 64-byte registers go as two halves
+        if constexpr (Bytes == 64) {
+            typename Pack<T, 32>::reg half[2];
+            std::memcpy(half, &value, Bytes);
+            half[0] = Pack<T, 32>::sqrt(half[0]);
+            half[1] = Pack<T, 32>::sqrt(half[1]);
+            std::memcpy(&value, half, Bytes);
+            return value;
+        } else if constexpr (std::is_same_v<T, double> && Bytes == 32) {
+            return __builtin_ia32_sqrtpd256(value);
+        } else if constexpr (std::is_same_v<T, double> && Bytes == 16) {
+            return __builtin_ia32_sqrtpd(value);
+        } else if constexpr (std::is_same_v<T, float> && Bytes == 32) {
+            return __builtin_ia32_sqrtps256(value);
+        } else if constexpr (std::is_same_v<T, float> && Bytes == 16) {
+            return __builtin_ia32_sqrtps(value);
+        }
+#endif
+        for (size_t k = 0; k < width; k++)
+            value[k] = std::sqrt(value[k]);
+        return value;
+    }
+
+    template <typename T, size_t Bytes>
+    NUMCPP_ALWAYS_INLINE T Pack<T, Bytes>::horizontal_sum(reg value)
+    {
+        T total = T(0);
+        for (size_t k = 0; k < width; k++)
+            total += value[k];
+        return total;
+    }
+
+    template <typename T, size_t Bytes>
+    NUMCPP_ALWAYS_INLINE T Pack<T, Bytes>::horizontal_min(reg value)
+    {
+        T result = value[0];
+        for (size_t k = 1; k < width; k++)
+            if (value[k] < result)
+                result = value[k];
+        return result;
+    }
+
+    template <typename T, size_t Bytes>
+    NUMCPP_ALWAYS_INLINE T Pack<T, Bytes>::horizontal_max(reg value)
+    {
+        T result = value[0];
+        for (size_t k = 1; k < width; k++)
+            if (value[k] > result)
+                result = value[k];
+        return result;
+    }
+
+    // Peels an unaligned head as a partial register so the body can use
+    // aligned stores, then finishes with a partial (masked) tail.
+    template <typename P, typename T, typename K>
+    NUMCPP_ALWAYS_INLINE void assign_body(T* dst, const K& kernel, size_t begin, size_t end)
+    {
+        size_t i = begin;
+        size_t misalign = (reinterpret_cast<std::uintptr_t>(dst + i) % P::bytes) / sizeof(T);
+        if (misalign != 0 && i < end) {
+            size_t head = std::min(end - i, P::width - misalign);
+            P::store_partial(dst + i, kernel.template packet<P>(i, head), head);
+            i += head;
+        }
+        for (; i + P::width <= end; i += P::width)
+            P::store_aligned(dst + i, kernel.template packet<P>(i));
+        if (i < end)
+            P::store_partial(dst + i, kernel.template packet<P>(i, end - i), end - i);
+    }
+
+    template <typename P, typename R, typename T, typename K>
+    NUMCPP_ALWAYS_INLINE T reduce_body(const K& kernel, size_t begin, size_t end)
+    {
+        using Red = Reducer<R>;
+        using reg = typename P::reg;
+        const reg identity = P::broadcast(Red::template identity<T>());
+        reg acc0 = identity, acc1 = identity, acc2 = identity, acc3 = identity;
+        size_t i = begin;
+        for (; i + 4 * P::width <= end; i += 4 * P::width) {
+            acc0 = Red::template combine_packet<P>(acc0, kernel.template packet<P>(i));
+            acc1 = Red::template combine_packet<P>(acc1, kernel.template packet<P>(i + P::width));
+            acc2 = Red::template combine_packet<P>(acc2, kernel.template packet<P>(i + 2 * P::width));
+            acc3 = Red::template combine_packet<P>(acc3, kernel.template packet<P>(i + 3 * P::width));
+        }
+        for (; i + P::width <= end; i += P::width)
+            acc0 = Red::template combine_packet<P>(acc0, kernel.template packet<P>(i));
+        if (i < end) {
+            size_t count = end - i;
+            reg tail = P::select(P::first_lanes(count), kernel.template packet<P>(i, count), identity);
+            acc1 = Red::template combine_packet<P>(acc1, tail);
+        }
+        acc0 = Red::template combine_packet<P>(Red::template combine_packet<P>(acc0, acc1),
+            Red::template combine_packet<P>(acc2, acc3));
+        return Red::template horizontal<P>(acc0);
+    }
+
+#if NUMCPP_SIMD_X86
+#define NUMCPP_SIMD_ENTRY_POINTS(SUFFIX, TARGET, BYTES)                                     \
+    template <typename T, typename K>                                                       \
+    TARGET void assign_##SUFFIX(T* dst, const K& kernel, size_t begin, size_t end)          \
+    {                                                                                       \
+        assign_body<Pack<T, BYTES>>(dst, kernel, begin, end);                               \
+    }                                                                                       \
+    template <typename R, typename T, typename K>                                           \
+    TARGET T reduce_##SUFFIX(const K& kernel, size_t begin, size_t end)                     \
+    {                                                                                       \
+        return reduce_body<Pack<T, BYTES>, R, T>(kernel, begin, end);                       \
+    }
+
+    NUMCPP_SIMD_ENTRY_POINTS(sse2, NUMCPP_TARGET_SSE2, 16)
+    NUMCPP_SIMD_ENTRY_POINTS(avx2, NUMCPP_TARGET_AVX2, 32)
+    NUMCPP_SIMD_ENTRY_POINTS(avx512, NUMCPP_TARGET_AVX512, 64)
+
+#undef NUMCPP_SIMD_ENTRY_POINTS
+#endif
+#pragma GCC diagnostic pop
+#endif
+
+    template <typename T, typename K>
+    void assign(T* dst, const K& kernel, size_t begin, size_t end)
+    {
+#if NUMCPP_SIMD_X86
+        if constexpr (VectorKernel<K, T>) {
+            switch (simd_level()) {
+            case SimdLevel::AVX512:
+                assign_avx512(dst, kernel, begin, end);
+                return;
+            case SimdLevel::AVX2:
+                assign_avx2(dst, kernel, begin, end);
+                return;
+            case SimdLevel::SSE2:
+                assign_sse2(dst, kernel, begin, end);
+                return;
+            default:
+                break;
+            }
+        }
+#endif
+        for (size_t j = begin; j < end; j++) {
+            dst[j] = kernel(j);
+        }
+    }
+
+    template <typename R, typename T, typename K>
+    T reduce(const K& kernel, size_t begin, size_t end)
+    {
+#if NUMCPP_SIMD_X86
+        if constexpr (VectorKernel<K, T>) {
+            switch (simd_level()) {
+            case SimdLevel::AVX512:
+                return reduce_avx512<R, T>(kernel, begin, end);
+            case SimdLevel::AVX2:
+                return reduce_avx2<R, T>(kernel, begin, end);
+            case SimdLevel::SSE2:
+                return reduce_sse2<R, T>(kernel, begin, end);
+            default:
+                break;
+            }
+        }
+#endif
+        T result = Reducer<R>::template identity<T>();
+        for (size_t j = begin; j < end; j++) {
+            result = Reducer<R>::combine(result, T(kernel(j)));
+        }
+        return result;
+    }
+}
+
+} // namespace NumCPP
+
+#endif // SIMD_TPP
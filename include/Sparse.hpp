@@ -0,0 +1,136 @@
+#ifndef SPARSE_HPP
+#define SPARSE_HPP
+
+#include "Array.hpp"
+#include "CostModel.hpp"
+#include "Matrix.hpp"
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace NumCPP {
+
+template <typename T>
+class CsrMatrix;
+
+// Coordinate-format sparse matrix for assembling entries in any order.
+// Entries are kept as appended, duplicates included; to_csr() sorts them and
+// sums duplicates.
+template <typename T>
+class CooMatrix {
+public:
+    // Throws std::invalid_argument unless both extents are positive
+    CooMatrix(size_t rows, size_t cols);
+    // The nonzero elements of a 2D array
+    explicit CooMatrix(const Array<T>& dense);
+
+    void reserve(size_t nnz);
+    // Appends value at (row, col); throws std::out_of_range outside the shape
+    void add(size_t row, size_t col, const T& value);
+
+    std::vector<size_t> shape() const { return { rows_, cols_ }; }
+    size_t nnz() const { return values_.size(); }
+    const std::vector<size_t>& row_indices() const { return row_; }
+    const std::vector<size_t>& col_indices() const { return col_; }
+    const std::vector<T>& values() const { return values_; }
+
+    CsrMatrix<T> to_csr() const;
+    Array<T> to_array() const;
+
+private:
+    size_t rows_;
+    size_t cols_;
+    std::vector<size_t> row_;
+    std::vector<size_t> col_;
+    std::vector<T> values_;
+};
+
+// Compressed sparse row matrix: the column indices and values of row r are
+// indices()[indptr()[r] .. indptr()[r + 1]), sorted by column without
+// duplicates. Only stored entries cost memory or work.
+//
+// Products with dense vectors and matrices run in parallel over blocks of
+// rows holding roughly equal numbers of entries, so a few dense rows do not
+// serialize the rest. Element-wise operators follow Matrix and throw
+// std::runtime_error when shapes differ.
+template <typename T>
+class CsrMatrix {
+public:
+    // All zeros; throws std::invalid_argument unless both extents are positive
+    CsrMatrix(size_t rows, size_t cols);
+    // Adopts CSR arrays; throws std::invalid_argument unless indptr has
+    // rows + 1 non-decreasing offsets from 0 to nnz and every row's column
+    // indices are below cols and strictly increasing
+    CsrMatrix(size_t rows, size_t cols, std::vector<size_t> indptr, std::vector<size_t> indices,
+        std::vector<T> values);
+    // The nonzero elements of a 2D array or matrix. Templates so a braced
+    // list never converts to an Array or Matrix.
+    template <typename A>
+        requires std::is_base_of_v<Array<T>, A>
+    explicit CsrMatrix(const A& dense);
+    template <typename M>
+        requires std::is_base_of_v<Matrix<T>, M>
+    explicit CsrMatrix(const M& dense);
+
+    Array<T> to_array() const;
+    Matrix<T> to_matrix() const;
+    CooMatrix<T> to_coo() const;
+
+    std::vector<size_t> shape() const { return { rows_, cols_ }; }
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    size_t nnz() const { return values_.size(); }
+    const std::vector<size_t>& indptr() const { return indptr_; }
+    const std::vector<size_t>& indices() const { return indices_; }
+    const std::vector<T>& values() const { return values_; }
+
+    // Stored value or zero; throws std::out_of_range outside the shape
+    T at(size_t row, size_t col) const;
+
+    CsrMatrix<T> transposed() const;
+
+    // this * x for x of shape {cols} (result {rows}) or {cols, k} (result
+    // {rows, k}); throws std::runtime_error when the shapes do not align. The
+    // `out` overload writes into an array of the result's shape
+    // (std::invalid_argument otherwise).
+    Array<T> dot(const Array<T>& x) const;
+    void dot(const Array<T>& x, Array<T>& out) const;
+    Array<T> dot(const Matrix<T>& x) const;
+
+    // Element-wise; + and - keep the union of the stored entries, * their
+    // intersection
+    CsrMatrix<T> operator+(const CsrMatrix<T>& other) const;
+    CsrMatrix<T> operator-(const CsrMatrix<T>& other) const;
+    CsrMatrix<T> operator*(const CsrMatrix<T>& other) const;
+    CsrMatrix<T> operator*(const T& scalar) const;
+    CsrMatrix<T> operator/(const T& scalar) const;
+    CsrMatrix<T> operator-() const;
+
+private:
+    template <typename F>
+    CsrMatrix<T> map_values(F&& f) const;
+    template <typename F>
+    CsrMatrix<T> combine(const CsrMatrix<T>& other, bool keep_union, const char* what, F&& op) const;
+    void dot_into(const T* x, size_t k, T* out) const;
+
+    size_t rows_;
+    size_t cols_;
+    std::vector<size_t> indptr_;
+    std::vector<size_t> indices_;
+    std::vector<T> values_;
+};
+
+namespace detail {
+    // Splits the rows of a CSR matrix into parallel blocks of about equal
+    // work, counting each row as one unit plus one per stored entry, and
+    // calls body(row_begin, row_end) for each block. `cost` is the work of
+    // one unit.
+    template <typename F>
+    void for_row_blocks(const std::vector<size_t>& indptr, const KernelCost& cost, F&& body);
+}
+
+} // namespace NumCPP
+
+#include "Sparse.tpp"
+
+#endif // SPARSE_HPP
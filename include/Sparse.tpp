@@ -0,0 +1,492 @@
+#ifndef SPARSE_TPP
+#define SPARSE_TPP
+
+#include "Profiler.hpp"
+#include "Sparse.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace NumCPP {
+
+namespace detail {
+    inline void check_sparse_extents(size_t rows, size_t cols)
+    {
+        if (rows == 0 || cols == 0)
+            throw std::invalid_argument("Sparse matrix extents must be positive");
+    }
+
+    template <typename T>
+    void check_dense_2d(const Array<T>& dense)
+    {
+        if (dense.ndim() != 2)
+            throw std::invalid_argument("Sparse matrices convert from 2D arrays only");
+    }
+
+    template <typename F>
+    void for_row_blocks(const std::vector<size_t>& indptr, const KernelCost& cost, F&& body)
+    {
+        const size_t rows = indptr.size() - 1;
+        const size_t total = indptr.back() + rows;
+        // indptr[r] + r increases strictly, so every row starts in exactly
+        // one block
+        auto first_row = [&](size_t work) {
+            size_t lo = 0, hi = rows;
+            while (lo < hi) {
+                size_t mid = lo + (hi - lo) / 2;
+                if (indptr[mid] + mid < work)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            return lo;
+        };
+        parallel_for(0, total, [&](size_t start, size_t stop) {
+            size_t begin = first_row(start), end = first_row(stop);
+            if (begin < end)
+                body(begin, end);
+        }, parallel_grain(cost));
+    }
+
+    // Turns per-row counts (in indptr[1..rows]) into offsets
+    inline void counts_to_offsets(std::vector<size_t>& indptr)
+    {
+        for (size_t r = 1; r < indptr.size(); r++)
+            indptr[r] += indptr[r - 1];
+    }
+}
+
+// CooMatrix
+
+template <typename T>
+CooMatrix<T>::CooMatrix(size_t rows, size_t cols)
+    : rows_(rows)
+    , cols_(cols)
+{
+    detail::check_sparse_extents(rows, cols);
+}
+
+template <typename T>
+CooMatrix<T>::CooMatrix(const Array<T>& dense)
+    : rows_(0)
+    , cols_(0)
+{
+    detail::check_dense_2d(dense);
+    rows_ = dense.shape()[0];
+    cols_ = dense.shape()[1];
+    const T* data = dense.data();
+    for (size_t r = 0; r < rows_; r++)
+        for (size_t c = 0; c < cols_; c++)
+            if (data[r * cols_ + c] != T(0))
+                add(r, c, data[r * cols_ + c]);
+}
+
+template <typename T>
+void CooMatrix<T>::reserve(size_t nnz)
+{
+    row_.reserve(nnz);
+    col_.reserve(nnz);
+    values_.reserve(nnz);
+}
+
+template <typename T>
+void CooMatrix<T>::add(size_t row, size_t col, const T& value)
+{
+    if (row >= rows_ || col >= cols_)
+        throw std::out_of_range("Index out of bounds");
+    row_.push_back(row);
+    col_.push_back(col);
+    values_.push_back(value);
+}
+
+template <typename T>
+CsrMatrix<T> CooMatrix<T>::to_csr() const
+{
+    NUMCPP_PROFILE("CooMatrix::to_csr", nnz());
+    // Bucket the entries by row, then sort and merge each row on its own
+    std::vector<size_t> bucket(rows_ + 1, 0);
+    for (size_t row : row_)
+        bucket[row + 1]++;
+    detail::counts_to_offsets(bucket);
+    std::vector<std::pair<size_t, T>> entries(nnz());
+    std::vector<size_t> next(bucket.begin(), bucket.end() - 1);
+    for (size_t i = 0; i < nnz(); i++)
+        entries[next[row_[i]]++] = { col_[i], values_[i] };
+
+    std::vector<size_t> indptr(rows_ + 1, 0);
+    KernelCost sort_cost { 2.0 * sizeof(entries[0]), 16, 0 };
+    detail::for_row_blocks(bucket, sort_cost, [&](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; r++) {
+            auto first = entries.begin() + bucket[r], last = entries.begin() + bucket[r + 1];
+            std::sort(first, last, [](const auto& a, const auto& b) { return a.first < b.first; });
+            auto out = first;
+            for (auto it = first; it != last; ++it) {
+                if (out != first && (out - 1)->first == it->first)
+                    (out - 1)->second += it->second;
+                else
+                    *out++ = *it;
+            }
+            indptr[r + 1] = size_t(out - first);
+        }
+    });
+    detail::counts_to_offsets(indptr);
+
+    std::vector<size_t> indices(indptr.back());
+    std::vector<T> values(indptr.back());
+    detail::for_row_blocks(indptr, KernelCost::stream<T>(1, 1) * 2.0, [&](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; r++)
+            for (size_t i = 0; i < indptr[r + 1] - indptr[r]; i++) {
+                indices[indptr[r] + i] = entries[bucket[r] + i].first;
+                values[indptr[r] + i] = entries[bucket[r] + i].second;
+            }
+    });
+    return CsrMatrix<T>(rows_, cols_, std::move(indptr), std::move(indices), std::move(values));
+}
+
+template <typename T>
+Array<T> CooMatrix<T>::to_array() const
+{
+    Array<T> result({ rows_, cols_ }, T(0));
+    T* data = detail::writable_data(result);
+    for (size_t i = 0; i < nnz(); i++)
+        data[row_[i] * cols_ + col_[i]] += values_[i];
+    return result;
+}
+
+// CsrMatrix
+
+template <typename T>
+CsrMatrix<T>::CsrMatrix(size_t rows, size_t cols)
+    : rows_(rows)
+    , cols_(cols)
+    , indptr_(rows + 1, 0)
+{
+    detail::check_sparse_extents(rows, cols);
+}
+
+template <typename T>
+CsrMatrix<T>::CsrMatrix(size_t rows, size_t cols, std::vector<size_t> indptr, std::vector<size_t> indices,
+    std::vector<T> values)
+    : rows_(rows)
+    , cols_(cols)
+    , indptr_(std::move(indptr))
+    , indices_(std::move(indices))
+    , values_(std::move(values))
+{
+    detail::check_sparse_extents(rows, cols);
+    if (indptr_.size() != rows + 1 || indptr_.front() != 0 || indptr_.back() != values_.size()
+        || indices_.size() != values_.size())
+        throw std::invalid_argument("CSR arrays do not match the shape");
+    for (size_t r = 0; r < rows; r++) {
+        if (indptr_[r] > indptr_[r + 1])
+            throw std::invalid_argument("CSR row offsets must be non-decreasing");
+        for (size_t i = indptr_[r]; i < indptr_[r + 1]; i++)
+            if (indices_[i] >= cols || (i > indptr_[r] && indices_[i] <= indices_[i - 1]))
+                throw std::invalid_argument("CSR column indices must be in range and increasing within a row");
+    }
+}
+
+template <typename T>
+template <typename A>
+    requires std::is_base_of_v<Array<T>, A>
+CsrMatrix<T>::CsrMatrix(const A& dense)
+    : rows_(0)
+    , cols_(0)
+{
+    NUMCPP_PROFILE("CsrMatrix::from_dense", dense.size());
+    detail::check_dense_2d(dense);
+    rows_ = dense.shape()[0];
+    cols_ = dense.shape()[1];
+    const T* data = dense.data();
+    indptr_.assign(rows_ + 1, 0);
+    size_t grain = parallel_grain(KernelCost::stream<T>(1) * double(cols_));
+    parallel_for(0, rows_, [&](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; r++)
+            indptr_[r + 1] = size_t(std::count_if(data + r * cols_, data + (r + 1) * cols_,
+                [](const T& v) { return v != T(0); }));
+    }, grain);
+    detail::counts_to_offsets(indptr_);
+    indices_.resize(indptr_.back());
+    values_.resize(indptr_.back());
+    parallel_for(0, rows_, [&](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; r++) {
+            size_t out = indptr_[r];
+            for (size_t c = 0; c < cols_; c++) {
+                const T& v = data[r * cols_ + c];
+                if (v != T(0)) {
+                    indices_[out] = c;
+                    values_[out++] = v;
+                }
+            }
+        }
+    }, grain);
+}
+
+template <typename T>
+template <typename M>
+    requires std::is_base_of_v<Matrix<T>, M>
+CsrMatrix<T>::CsrMatrix(const M& dense)
+    : CsrMatrix(dense.array())
+{
+}
+
+template <typename T>
+Array<T> CsrMatrix<T>::to_array() const
+{
+    Array<T> result({ rows_, cols_ }, T(0));
+    T* data = detail::writable_data(result);
+    detail::for_row_blocks(indptr_, KernelCost::stream<T>(1, 1), [&](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; r++)
+            for (size_t i = indptr_[r]; i < indptr_[r + 1]; i++)
+                data[r * cols_ + indices_[i]] = values_[i];
+    });
+    return result;
+}
+
+template <typename T>
+Matrix<T> CsrMatrix<T>::to_matrix() const
+{
+    return Matrix<T>(to_array());
+}
+
+template <typename T>
+CooMatrix<T> CsrMatrix<T>::to_coo() const
+{
+    CooMatrix<T> result(rows_, cols_);
+    result.reserve(nnz());
+    for (size_t r = 0; r < rows_; r++)
+        for (size_t i = indptr_[r]; i < indptr_[r + 1]; i++)
+            result.add(r, indices_[i], values_[i]);
+    return result;
+}
+
+template <typename T>
+T CsrMatrix<T>::at(size_t row, size_t col) const
+{
+    if (row >= rows_ || col >= cols_)
+        throw std::out_of_range("Index out of bounds");
+    auto first = indices_.begin() + indptr_[row], last = indices_.begin() + indptr_[row + 1];
+    auto it = std::lower_bound(first, last, col);
+    return it != last && *it == col ? values_[size_t(it - indices_.begin())] : T(0);
+}
+
+template <typename T>
+CsrMatrix<T> CsrMatrix<T>::transposed() const
+{
+    NUMCPP_PROFILE("CsrMatrix::transposed", nnz());
+    // Counting sort by column; visiting rows in order keeps each new row sorted
+    std::vector<size_t> indptr(cols_ + 1, 0);
+    for (size_t c : indices_)
+        indptr[c + 1]++;
+    detail::counts_to_offsets(indptr);
+    std::vector<size_t> indices(nnz());
+    std::vector<T> values(nnz());
+    std::vector<size_t> next(indptr.begin(), indptr.end() - 1);
+    for (size_t r = 0; r < rows_; r++)
+        for (size_t i = indptr_[r]; i < indptr_[r + 1]; i++) {
+            size_t out = next[indices_[i]]++;
+            indices[out] = r;
+            values[out] = values_[i];
+        }
+    return CsrMatrix<T>(cols_, rows_, std::move(indptr), std::move(indices), std::move(values));
+}
+
+template <typename T>
+void CsrMatrix<T>::dot_into(const T* x, size_t k, T* out) const
+{
+    // Per entry: its index and value, and a gathered row of x
+    KernelCost cost { double(sizeof(size_t) + sizeof(T) + k * sizeof(T)), 2.0 * double(k), 0 };
+    detail::for_row_blocks(indptr_, cost, [&](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; r++) {
+            if (k == 1) {
+                T acc = T(0);
+                for (size_t i = indptr_[r]; i < indptr_[r + 1]; i++)
+                    acc += values_[i] * x[indices_[i]];
+                out[r] = acc;
+                continue;
+            }
+            T* row = out + r * k;
+            std::fill(row, row + k, T(0));
+            for (size_t i = indptr_[r]; i < indptr_[r + 1]; i++) {
+                const T value = values_[i];
+                const T* x_row = x + indices_[i] * k;
+                for (size_t j = 0; j < k; j++)
+                    row[j] += value * x_row[j];
+            }
+        }
+    });
+}
+
+template <typename T>
+Array<T> CsrMatrix<T>::dot(const Array<T>& x) const
+{
+    size_t k = x.ndim() == 2 ? x.shape()[1] : 1;
+    std::vector<size_t> shape = x.ndim() == 2 ? std::vector<size_t> { rows_, k } : std::vector<size_t> { rows_ };
+    Array<T> result(shape, Storage<T>(rows_ * k));
+    dot(x, result);
+    return result;
+}
+
+template <typename T>
+void CsrMatrix<T>::dot(const Array<T>& x, Array<T>& out) const
+{
+    NUMCPP_PROFILE("CsrMatrix::dot", nnz());
+    if ((x.ndim() != 1 && x.ndim() != 2) || x.shape()[0] != cols_)
+        throw std::runtime_error("Shapes do not align for dot product");
+    size_t k = x.ndim() == 2 ? x.shape()[1] : 1;
+    std::vector<size_t> expected = x.ndim() == 2 ? std::vector<size_t> { rows_, k } : std::vector<size_t> { rows_ };
+    if (out.shape() != expected)
+        throw std::invalid_argument("Output array has the wrong shape");
+    T* dst = detail::writable_data(out);
+    const T* src = x.data();
+    std::less<const T*> before;
+    if (before(src, dst + out.size()) && before(dst, src + x.size())) {
+        // out overlaps x, which is still read after rows are written
+        Array<T> result(expected, Storage<T>(rows_ * k));
+        dot_into(src, k, detail::writable_data(result));
+        out = std::move(result);
+        return;
+    }
+    dot_into(src, k, dst);
+}
+
+template <typename T>
+Array<T> CsrMatrix<T>::dot(const Matrix<T>& x) const
+{
+    return dot(x.array());
+}
+
+template <typename T>
+Array<T> Matrix<T>::dot(const CsrMatrix<T>& other) const
+{
+    NUMCPP_PROFILE("Matrix::dot", size());
+    const auto& shape1 = arr_.shape();
+    if (shape1[1] != other.rows())
+        throw std::runtime_error("Shapes do not align for dot product");
+    const size_t m = shape1[0], inner = shape1[1], n = other.cols();
+    const auto& indptr = other.indptr();
+    const auto& indices = other.indices();
+    const auto& values = other.values();
+    Array<T> result({ m, n }, T(0));
+    const T* a = arr_.data();
+    T* c = detail::writable_data(result);
+    // Row i of the result is row i of this times the sparse matrix: each
+    // nonzero a(i, p) scatters a scaled copy of sparse row p
+    double nnz = double(other.nnz());
+    KernelCost cost { nnz * double(sizeof(size_t) + 2 * sizeof(T)), 2.0 * nnz, 0 };
+    parallel_for(0, m, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            T* row = c + i * n;
+            for (size_t p = 0; p < inner; p++) {
+                const T scale = a[i * inner + p];
+                if (scale == T(0))
+                    continue;
+                for (size_t q = indptr[p]; q < indptr[p + 1]; q++)
+                    row[indices[q]] += scale * values[q];
+            }
+        }
+    }, parallel_grain(cost));
+    return result;
+}
+
+template <typename T>
+template <typename F>
+CsrMatrix<T> CsrMatrix<T>::map_values(F&& f) const
+{
+    std::vector<T> values(values_.size());
+    std::transform(values_.begin(), values_.end(), values.begin(), f);
+    return CsrMatrix<T>(rows_, cols_, indptr_, indices_, std::move(values));
+}
+
+template <typename T>
+template <typename F>
+CsrMatrix<T> CsrMatrix<T>::combine(const CsrMatrix<T>& other, bool keep_union, const char* what, F&& op) const
+{
+    NUMCPP_PROFILE("CsrMatrix::combine", nnz() + other.nnz());
+    if (shape() != other.shape())
+        throw std::runtime_error(std::string("Shapes do not match for ") + what);
+    // Walks row r of both operands in column order, calling emit(col, value)
+    // for every entry of the result
+    auto merge = [&](size_t r, auto&& emit) {
+        size_t p = indptr_[r], p_end = indptr_[r + 1];
+        size_t q = other.indptr_[r], q_end = other.indptr_[r + 1];
+        while (p < p_end || q < q_end) {
+            size_t cp = p < p_end ? indices_[p] : cols_;
+            size_t cq = q < q_end ? other.indices_[q] : cols_;
+            if (cp == cq)
+                emit(cp, op(values_[p++], other.values_[q++]));
+            else if (cp < cq) {
+                if (keep_union)
+                    emit(cp, op(values_[p], T(0)));
+                p++;
+            } else {
+                if (keep_union)
+                    emit(cq, op(T(0), other.values_[q]));
+                q++;
+            }
+        }
+    };
+    // Count each row of the result, then fill it
+    KernelCost cost { 2.0 * double(sizeof(size_t) + sizeof(T)), 1, 0 };
+    std::vector<size_t> indptr(rows_ + 1, 0);
+    detail::for_row_blocks(indptr_, cost, [&](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; r++)
+            merge(r, [&](size_t, const T&) { indptr[r + 1]++; });
+    });
+    detail::counts_to_offsets(indptr);
+    std::vector<size_t> indices(indptr.back());
+    std::vector<T> values(indptr.back());
+    detail::for_row_blocks(indptr_, cost, [&](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; r++) {
+            size_t out = indptr[r];
+            merge(r, [&](size_t col, const T& value) {
+                indices[out] = col;
+                values[out++] = value;
+            });
+        }
+    });
+    return CsrMatrix<T>(rows_, cols_, std::move(indptr), std::move(indices), std::move(values));
+}
+
+template <typename T>
+CsrMatrix<T> CsrMatrix<T>::operator+(const CsrMatrix<T>& other) const
+{
+    return combine(other, true, "addition", [](const T& a, const T& b) { return a + b; });
+}
+
+template <typename T>
+CsrMatrix<T> CsrMatrix<T>::operator-(const CsrMatrix<T>& other) const
+{
+    return combine(other, true, "subtraction", [](const T& a, const T& b) { return a - b; });
+}
+
+template <typename T>
+CsrMatrix<T> CsrMatrix<T>::operator*(const CsrMatrix<T>& other) const
+{
+    return combine(other, false, "multiplication", [](const T& a, const T& b) { return a * b; });
+}
+
+template <typename T>
+CsrMatrix<T> CsrMatrix<T>::operator*(const T& scalar) const
+{
+    return map_values([&](const T& v) { return v * scalar; });
+}
+
+template <typename T>
+CsrMatrix<T> CsrMatrix<T>::operator/(const T& scalar) const
+{
+    return map_values([&](const T& v) { return v / scalar; });
+}
+
+template <typename T>
+CsrMatrix<T> CsrMatrix<T>::operator-() const
+{
+    return map_values([](const T& v) { return -v; });
+}
+
+} // namespace NumCPP
+
+#endif // SPARSE_TPP
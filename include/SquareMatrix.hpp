@@ -1,6 +1,7 @@
 #ifndef SQUAREMATRIX_HPP
 #define SQUAREMATRIX_HPP
 
+#include "Decomposition.hpp"
 #include "Matrix.hpp"
 #include <cmath>
 #include <vector>
@@ -15,13 +16,21 @@ private:
 public:
     // Constructors
     SquareMatrix(size_t n);
-    SquareMatrix(const Array<T>& arr);
+    SquareMatrix(Array<T> arr);
 
     // Determinant
     T determinant() const;
 
-    // Inverse
+    // Inverse; prefer solve() or lu() when the inverse only multiplies
+    // vectors, as it is slower and less accurate
     SquareMatrix<T> inverse() const;
+
+    // Solve A * X = B for B of shape {n} or {n, k}
+    Array<T> solve(const Array<T>& b) const;
+
+    // Reusable factorizations for repeated solves
+    LU<T> lu() const;
+    Cholesky<T> cholesky() const;
 };
 
 } // namespace NumCPP
@@ -0,0 +1,100 @@
+#ifndef STORAGE_HPP
+#define STORAGE_HPP
+
+#include "Allocator.hpp"
+#include "Profiler.hpp"
+#include <atomic>
+#include <cstddef>
+#include <functional>
+
+namespace NumCPP {
+
+namespace detail {
+    // Shared control block: the buffer plus how to release it
+    template <typename T>
+    struct StorageBlock {
+        std::atomic<size_t> refs { 1 };
+        T* data = nullptr;
+        size_t count = 0;
+        size_t alignment = 0;
+        // Set for buffers this library allocated and constructed
+        Allocator* allocator = nullptr;
+        // Set for adopted external memory
+        std::function<void(T*)> deleter;
+        // Adopted memory that must not be written (e.g. a read-only mapping)
+        bool read_only = false;
+        // An owner handed out a reference into the buffer (see leak())
+        bool leaked = false;
+    };
+}
+
+// A reference-counted element buffer. Copying a Storage shares the buffer;
+// clone() and make_unique() copy it. Owners implement copy-on-write by
+// calling make_unique() before writing, and by taking share() rather than
+// a plain copy when they are copied themselves.
+template <typename T>
+class Storage {
+public:
+    static constexpr size_t default_alignment = 64;
+
+    // Constructors and Destructor
+    Storage();
+    ~Storage();
+
+    // `count` default-initialized elements
+    explicit Storage(size_t count, Allocator& allocator = default_allocator(),
+        size_t alignment = default_alignment);
+    Storage(size_t count, const T& value, Allocator& allocator = default_allocator(),
+        size_t alignment = default_alignment);
+
+    Storage(const Storage<T>& other) noexcept;
+    Storage(Storage<T>&& other) noexcept;
+    Storage<T>& operator=(const Storage<T>& other) noexcept;
+    Storage<T>& operator=(Storage<T>&& other) noexcept;
+
+    // Take ownership of external memory; deleter(data) runs when the last
+    // reference goes away. Read-only memory is copied before the first
+    // write, even by its only owner.
+    static Storage<T> adopt(T* data, size_t count, std::function<void(T*)> deleter,
+        bool read_only = false);
+    // Refer to external memory without owning it; the caller keeps it alive
+    // for as long as any Storage (or Array) uses it.
+    static Storage<T> wrap(T* data, size_t count);
+
+    // Properties
+    T* data() const { return block_ ? block_->data : nullptr; }
+    size_t size() const { return block_ ? block_->count : 0; }
+    size_t alignment() const { return block_ ? block_->alignment : 0; }
+    size_t use_count() const;
+    bool unique() const { return use_count() <= 1; }
+    bool read_only() const { return block_ && block_->read_only; }
+    // Unique and not read-only: owners may write in place
+    bool writable() const { return unique() && !read_only(); }
+    bool owns_memory() const { return block_ && (block_->allocator || block_->deleter); }
+
+    // A new buffer with the same elements, allocated like this one (adopted
+    // and wrapped memory is copied into the default allocator)
+    Storage<T> clone() const;
+    // Ensure the buffer is writable(), copying it if it is shared or read-only
+    void make_unique();
+    // make_unique(), then record that a reference or pointer into the buffer
+    // escaped its owner. Writes through it bypass copy-on-write, so from
+    // now on share() copies the buffer instead of sharing it.
+    void leak();
+    bool leaked() const { return block_ && block_->leaked; }
+    // The buffer for a new owner: this one, or a clone() once leaked
+    Storage<T> share() const;
+
+private:
+    detail::StorageBlock<T>* block_;
+
+    explicit Storage(detail::StorageBlock<T>* block);
+    static detail::StorageBlock<T>* allocate(size_t count, Allocator& allocator, size_t alignment);
+    void release() noexcept;
+};
+
+} // namespace NumCPP
+
+#include "Storage.tpp"
+
+#endif // STORAGE_HPP
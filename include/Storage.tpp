@@ -0,0 +1,220 @@
+#ifndef STORAGE_TPP
+#define STORAGE_TPP
+
+#include "CostModel.hpp"
+#include "Storage.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace NumCPP {
+
+namespace detail {
+    // Writing a fresh buffer decides which NUMA node its pages land on, so
+    // large ones are filled and copied by the pool, in the chunks later
+    // kernels use
+    template <typename T>
+    void first_touch_fill(T* dst, size_t count, const T& value)
+    {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            parallel_for(0, count, [dst, &value](size_t start, size_t end) {
+                std::uninitialized_fill(dst + start, dst + end, value);
+            }, parallel_grain(KernelCost::stream<T>(0, 1)));
+        } else {
+            std::uninitialized_fill_n(dst, count, value);
+        }
+    }
+
+    template <typename T>
+    void first_touch_copy(const T* src, size_t count, T* dst)
+    {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            parallel_for(0, count, [src, dst](size_t start, size_t end) {
+                std::uninitialized_copy(src + start, src + end, dst + start);
+            }, parallel_grain(KernelCost::stream<T>(1, 1)));
+        } else {
+            std::uninitialized_copy_n(src, count, dst);
+        }
+    }
+}
+
+template <typename T>
+Storage<T>::Storage()
+    : block_(nullptr)
+{
+}
+
+template <typename T>
+Storage<T>::Storage(detail::StorageBlock<T>* block)
+    : block_(block)
+{
+}
+
+template <typename T>
+Storage<T>::~Storage()
+{
+    release();
+}
+
+template <typename T>
+detail::StorageBlock<T>* Storage<T>::allocate(size_t count, Allocator& allocator, size_t alignment)
+{
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+        throw std::invalid_argument("Storage alignment must be a power of two");
+    alignment = std::max(alignment, alignof(T));
+    auto block = std::make_unique<detail::StorageBlock<T>>();
+    block->count = count;
+    block->alignment = alignment;
+    block->allocator = &allocator;
+    if (count > 0) {
+        block->data = static_cast<T*>(allocator.allocate(count * sizeof(T), alignment));
+        NUMCPP_PROFILE_BYTES(count * sizeof(T));
+    }
+    return block.release();
+}
+
+template <typename T>
+Storage<T>::Storage(size_t count, Allocator& allocator, size_t alignment)
+    : block_(allocate(count, allocator, alignment))
+{
+    try {
+        std::uninitialized_default_construct_n(block_->data, count);
+    } catch (...) {
+        block_->allocator->deallocate(block_->data, count * sizeof(T), block_->alignment);
+        delete block_;
+        throw;
+    }
+}
+
+template <typename T>
+Storage<T>::Storage(size_t count, const T& value, Allocator& allocator, size_t alignment)
+    : block_(allocate(count, allocator, alignment))
+{
+    try {
+        detail::first_touch_fill(block_->data, count, value);
+    } catch (...) {
+        block_->allocator->deallocate(block_->data, count * sizeof(T), block_->alignment);
+        delete block_;
+        throw;
+    }
+}
+
+template <typename T>
+Storage<T>::Storage(const Storage<T>& other) noexcept
+    : block_(other.block_)
+{
+    if (block_)
+        block_->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename T>
+Storage<T>::Storage(Storage<T>&& other) noexcept
+    : block_(std::exchange(other.block_, nullptr))
+{
+}
+
+template <typename T>
+Storage<T>& Storage<T>::operator=(const Storage<T>& other) noexcept
+{
+    if (block_ != other.block_) {
+        Storage<T> temp(other);
+        std::swap(block_, temp.block_);
+    }
+    return *this;
+}
+
+template <typename T>
+Storage<T>& Storage<T>::operator=(Storage<T>&& other) noexcept
+{
+    if (this != std::addressof(other)) {
+        release();
+        block_ = std::exchange(other.block_, nullptr);
+    }
+    return *this;
+}
+
+template <typename T>
+Storage<T> Storage<T>::adopt(T* data, size_t count, std::function<void(T*)> deleter, bool read_only)
+{
+    auto block = new detail::StorageBlock<T>();
+    block->data = data;
+    block->count = count;
+    block->alignment = alignof(T);
+    block->deleter = deleter ? std::move(deleter) : [](T*) {};
+    block->read_only = read_only;
+    return Storage<T>(block);
+}
+
+template <typename T>
+Storage<T> Storage<T>::wrap(T* data, size_t count)
+{
+    auto block = new detail::StorageBlock<T>();
+    block->data = data;
+    block->count = count;
+    block->alignment = alignof(T);
+    return Storage<T>(block);
+}
+
+template <typename T>
+size_t Storage<T>::use_count() const
+{
+    return block_ ? block_->refs.load(std::memory_order_acquire) : 0;
+}
+
+template <typename T>
+Storage<T> Storage<T>::clone() const
+{
+    if (!block_)
+        return Storage<T>();
+    Allocator& allocator = block_->allocator ? *block_->allocator : default_allocator();
+    size_t alignment = block_->allocator ? block_->alignment : default_alignment;
+    Storage<T> copy(allocate(block_->count, allocator, alignment));
+    detail::first_touch_copy(block_->data, block_->count, copy.block_->data);
+    return copy;
+}
+
+template <typename T>
+void Storage<T>::make_unique()
+{
+    if (block_ && !writable())
+        *this = clone();
+}
+
+template <typename T>
+void Storage<T>::leak()
+{
+    make_unique();
+    if (block_)
+        block_->leaked = true;
+}
+
+template <typename T>
+Storage<T> Storage<T>::share() const
+{
+    return leaked() ? clone() : *this;
+}
+
+template <typename T>
+void Storage<T>::release() noexcept
+{
+    if (!block_)
+        return;
+    if (block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        if (block_->allocator) {
+            std::destroy_n(block_->data, block_->count);
+            if (block_->data)
+                block_->allocator->deallocate(block_->data, block_->count * sizeof(T), block_->alignment);
+        } else if (block_->deleter) {
+            block_->deleter(block_->data);
+        }
+        delete block_;
+    }
+    block_ = nullptr;
+}
+
+} // namespace NumCPP
+
+#endif // STORAGE_TPP
@@ -0,0 +1,153 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include "Profiler.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace NumCPP {
+
+// Library-wide work-stealing executor used by every parallel kernel.
+//
+// Workers are started lazily on the first parallel call. The calling thread
+// always takes part in the work it submits, so a pool of N threads runs N-1
+// workers. Nested parallel calls made from inside a worker are pushed onto
+// that worker's own queue and claimed by whoever is idle, so nesting never
+// creates additional threads.
+//
+// A parallel loop of N chunks gives thread t (the caller is thread 0) the
+// t-th contiguous share of the chunks first, and idle threads take chunks
+// from the others' shares once theirs is done. Loops over the same range
+// therefore hand the same elements to the same threads, which keeps their
+// caches, and with pinned workers their NUMA-local pages, warm.
+class ThreadPool {
+public:
+    // Range size below which a call without a grain runs serially on the
+    // caller. Library kernels derive their grains from the CostModel.
+    static constexpr size_t default_grain = 1000;
+
+    static ThreadPool& instance();
+
+    explicit ThreadPool(size_t num_threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Total concurrency (workers + caller). 0 selects the hardware default,
+    // overridable with the NUMCPP_NUM_THREADS environment variable.
+    size_t num_threads() const;
+    void set_num_threads(size_t num_threads);
+
+    // When enabled, every parallel call runs inline on the caller thread.
+    bool is_inline() const;
+    void set_inline(bool enabled);
+
+    // When enabled, worker t is restricted to the CPU
+    // numa_topology().cpu_for_thread(t + 1, num_threads()), spreading the
+    // workers over the NUMA nodes. Defaults to the NUMCPP_PIN_THREADS
+    // environment variable; changing it restarts the workers.
+    bool is_pinned() const;
+    void set_pinned(bool enabled);
+
+    // True when called from one of this pool's worker threads.
+    bool in_worker() const;
+
+    // Runs body(chunk) for every chunk in [0, num_chunks).
+    template <typename F>
+    void parallel_chunks(size_t num_chunks, F&& body);
+
+    // Splits [begin, end) into chunks of at least `grain` elements and runs
+    // body(start, stop) for each of them.
+    template <typename F>
+    void parallel_for(size_t begin, size_t end, F&& body, size_t grain = default_grain);
+
+    // Reduces [begin, end) with map(start, stop) -> R per chunk, combining the
+    // partial results in chunk order.
+    template <typename R, typename Map, typename Combine>
+    R parallel_reduce(size_t begin, size_t end, R identity, Map&& map, Combine&& combine,
+        size_t grain = default_grain);
+
+    // Number of chunks parallel_for/parallel_reduce use for a range.
+    size_t chunk_count(size_t count, size_t grain = default_grain) const;
+
+    // Queues task() on a worker and returns without waiting for it; runs it
+    // on the caller when the pool has no workers. task must not throw.
+    // Queued tasks still run when the pool is stopped or resized.
+    template <typename F>
+    void submit(F&& task);
+
+    // From a worker thread: runs one queued job, if any, and returns whether
+    // it did. Lets a worker that has to wait keep the pool busy.
+    bool run_pending();
+
+private:
+    // Chunks [next, end) of one thread's share of a job
+    struct alignas(64) Share {
+        std::atomic<size_t> next { 0 };
+        size_t end = 0;
+    };
+
+    struct Job {
+        std::function<void(size_t)> body;
+        size_t num_chunks = 0;
+        size_t num_shares = 0;
+        size_t share_capacity = 0;
+        std::unique_ptr<Share[]> shares;
+        std::atomic<size_t> done { 0 };
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        // Owner pushes and pops at the back, thieves take the front. A
+        // vector keeps its capacity, so queueing never allocates once warm.
+        std::vector<std::shared_ptr<Job>> jobs;
+    };
+
+    void start();
+    void stop();
+    void worker_loop(size_t id);
+    // With `reuse`, recycles one of the calling thread's earlier jobs that
+    // no worker holds any more, so steady-state loops do not allocate
+    std::shared_ptr<Job> make_job(size_t num_chunks, size_t num_shares, bool reuse);
+    void push(const std::shared_ptr<Job>& job, size_t copies, bool spread);
+    // Takes back the copies push() queued that no worker has picked up
+    void retract(const std::shared_ptr<Job>& job, size_t copies);
+    std::shared_ptr<Job> pop(size_t id);
+    std::shared_ptr<Job> steal(size_t thief);
+    static void run_chunks(Job& job, size_t share);
+
+    size_t requested_;
+    std::atomic<bool> inline_ { false };
+    bool pinned_;
+    std::atomic<bool> started_ { false };
+    std::mutex state_mutex_;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::atomic<size_t> pending_ { 0 };
+    std::atomic<size_t> next_victim_ { 0 };
+    bool stopping_ = false;
+};
+
+// Convenience wrappers around ThreadPool::instance().
+template <typename F>
+void parallel_for(size_t begin, size_t end, F&& body, size_t grain = ThreadPool::default_grain);
+
+template <typename R, typename Map, typename Combine>
+R parallel_reduce(size_t begin, size_t end, R identity, Map&& map, Combine&& combine,
+    size_t grain = ThreadPool::default_grain);
+
+} // namespace NumCPP
+
+#include "ThreadPool.tpp"
+
+#endif // THREADPOOL_HPP
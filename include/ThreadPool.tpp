@@ -0,0 +1,425 @@
+#ifndef THREADPOOL_TPP
+#define THREADPOOL_TPP
+
+#include "Numa.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <exception>
+#include <string>
+#include <type_traits>
+
+namespace NumCPP {
+
+namespace detail {
+    // Identifies the pool (and worker slot) the current thread belongs to.
+    struct WorkerContext {
+        const ThreadPool* pool = nullptr;
+        size_t id = 0;
+    };
+
+    inline thread_local WorkerContext worker_context;
+
+    inline size_t resolve_thread_count(size_t requested)
+    {
+        if (requested != 0)
+            return requested;
+        if (const char* env = std::getenv("NUMCPP_NUM_THREADS")) {
+            try {
+                size_t value = std::stoul(env);
+                if (value != 0)
+                    return value;
+            } catch (const std::exception&) {
+                // Ignore malformed values and fall back to the hardware default
+            }
+        }
+        unsigned hw = std::thread::hardware_concurrency();
+        return hw == 0 ? 2 : hw;
+    }
+
+    inline bool pin_threads_from_env()
+    {
+        const char* env = std::getenv("NUMCPP_PIN_THREADS");
+        return env && *env && std::string(env) != "0";
+    }
+
+    struct JobError {
+        std::mutex mutex;
+        std::exception_ptr error;
+    };
+}
+
+inline ThreadPool& ThreadPool::instance()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+inline ThreadPool::ThreadPool(size_t num_threads)
+    : requested_(detail::resolve_thread_count(num_threads))
+    , pinned_(detail::pin_threads_from_env())
+{
+}
+
+inline ThreadPool::~ThreadPool()
+{
+    stop();
+}
+
+inline size_t ThreadPool::num_threads() const
+{
+    return requested_;
+}
+
+inline void ThreadPool::set_num_threads(size_t num_threads)
+{
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    stop();
+    requested_ = detail::resolve_thread_count(num_threads);
+}
+
+inline bool ThreadPool::is_inline() const
+{
+    return inline_.load(std::memory_order_relaxed);
+}
+
+inline void ThreadPool::set_inline(bool enabled)
+{
+    inline_.store(enabled, std::memory_order_relaxed);
+}
+
+inline bool ThreadPool::is_pinned() const
+{
+    return pinned_;
+}
+
+inline void ThreadPool::set_pinned(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    if (pinned_ == enabled)
+        return;
+    stop();
+    pinned_ = enabled;
+}
+
+inline bool ThreadPool::in_worker() const
+{
+    return detail::worker_context.pool == this;
+}
+
+inline size_t ThreadPool::chunk_count(size_t count, size_t grain) const
+{
+    if (count == 0)
+        return 0;
+    size_t threads = is_inline() ? 1 : num_threads();
+    if (grain == 0)
+        grain = 1;
+    if (threads <= 1 || count <= grain)
+        return 1;
+    size_t chunks = (count + grain - 1) / grain;
+    return std::min(chunks, threads * 4);
+}
+
+template <typename F>
+void ThreadPool::parallel_chunks(size_t num_chunks, F&& body)
+{
+    if (num_chunks == 0)
+        return;
+    if (num_chunks == 1 || is_inline() || num_threads() <= 1) {
+        for (size_t c = 0; c < num_chunks; c++)
+            body(c);
+        return;
+    }
+    NUMCPP_PROFILE_PARALLEL();
+    if (!started_.load(std::memory_order_acquire))
+        start();
+
+    auto job = make_job(num_chunks, std::min(num_chunks, workers_.size() + 1), true);
+    detail::JobError failure;
+    job->body = [&body, &failure](size_t chunk) {
+        try {
+            body(chunk);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(failure.mutex);
+            if (!failure.error)
+                failure.error = std::current_exception();
+        }
+    };
+
+    size_t copies = std::min(num_chunks - 1, workers_.size());
+    push(job, copies, false);
+    run_chunks(*job, 0);
+    retract(job, copies);
+
+    // Only chunks already claimed by other threads can be outstanding here.
+    size_t done = job->done.load(std::memory_order_acquire);
+    while (done != num_chunks) {
+        job->done.wait(done, std::memory_order_acquire);
+        done = job->done.load(std::memory_order_acquire);
+    }
+    if (failure.error)
+        std::rethrow_exception(failure.error);
+}
+
+template <typename F>
+void ThreadPool::submit(F&& task)
+{
+    if (is_inline() || num_threads() <= 1) {
+        task();
+        return;
+    }
+    if (!started_.load(std::memory_order_acquire))
+        start();
+    auto fn = std::make_shared<std::decay_t<F>>(std::forward<F>(task));
+    auto job = make_job(1, 1, false);
+    job->body = [fn](size_t) { (*fn)(); };
+    push(job, 1, true);
+}
+
+inline bool ThreadPool::run_pending()
+{
+    if (!in_worker())
+        return false;
+    size_t id = detail::worker_context.id;
+    auto job = pop(id);
+    if (!job)
+        job = steal(id);
+    if (!job)
+        return false;
+    run_chunks(*job, id + 1);
+    return true;
+}
+
+template <typename F>
+void ThreadPool::parallel_for(size_t begin, size_t end, F&& body, size_t grain)
+{
+    if (end <= begin)
+        return;
+    size_t count = end - begin;
+    size_t chunks = chunk_count(count, grain);
+    if (chunks <= 1) {
+        body(begin, end);
+        return;
+    }
+    parallel_chunks(chunks, [&](size_t c) {
+        size_t start = begin + c * count / chunks;
+        size_t stop = begin + (c + 1) * count / chunks;
+        body(start, stop);
+    });
+}
+
+template <typename R, typename Map, typename Combine>
+R ThreadPool::parallel_reduce(size_t begin, size_t end, R identity, Map&& map, Combine&& combine,
+    size_t grain)
+{
+    if (end <= begin)
+        return identity;
+    size_t count = end - begin;
+    size_t chunks = chunk_count(count, grain);
+    if (chunks <= 1)
+        return combine(identity, map(begin, end));
+    std::vector<R> partials(chunks, identity);
+    parallel_chunks(chunks, [&](size_t c) {
+        size_t start = begin + c * count / chunks;
+        size_t stop = begin + (c + 1) * count / chunks;
+        partials[c] = map(start, stop);
+    });
+    R result = identity;
+    for (const auto& partial : partials)
+        result = combine(result, partial);
+    return result;
+}
+
+inline void ThreadPool::start()
+{
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    if (started_.load(std::memory_order_relaxed))
+        return;
+    stopping_ = false;
+    size_t count = requested_ > 1 ? requested_ - 1 : 0;
+    workers_.clear();
+    for (size_t i = 0; i < count; i++)
+        workers_.push_back(std::make_unique<Worker>());
+    for (size_t i = 0; i < count; i++)
+        threads_.emplace_back([this, i]() { worker_loop(i); });
+    started_.store(true, std::memory_order_release);
+}
+
+inline void ThreadPool::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& t : threads_)
+        t.join();
+    threads_.clear();
+    workers_.clear();
+    pending_.store(0, std::memory_order_relaxed);
+    started_.store(false, std::memory_order_release);
+}
+
+inline std::shared_ptr<ThreadPool::Job> ThreadPool::make_job(size_t num_chunks, size_t num_shares, bool reuse)
+{
+    // A worker may still hold the last job for a moment after finishing
+    // its chunks, so keep a few
+    thread_local std::array<std::shared_ptr<Job>, 4> spares;
+    std::shared_ptr<Job> job;
+    if (reuse) {
+        if (!spares[0])
+            for (auto& spare : spares)
+                spare = std::make_shared<Job>();
+        for (auto& spare : spares) {
+            if (spare.use_count() == 1) {
+                // Workers drop their references after their last access
+                std::atomic_thread_fence(std::memory_order_acquire);
+                job = spare;
+                job->done.store(0, std::memory_order_relaxed);
+                break;
+            }
+        }
+    }
+    if (!job)
+        job = std::make_shared<Job>();
+    job->num_chunks = num_chunks;
+    job->num_shares = num_shares;
+    if (job->share_capacity < num_shares) {
+        job->shares = std::make_unique<Share[]>(num_shares);
+        job->share_capacity = num_shares;
+    }
+    for (size_t t = 0; t < num_shares; t++) {
+        job->shares[t].next.store(t * num_chunks / num_shares, std::memory_order_relaxed);
+        job->shares[t].end = (t + 1) * num_chunks / num_shares;
+    }
+    return job;
+}
+
+inline void ThreadPool::run_chunks(Job& job, size_t share)
+{
+    // Own share first, then whatever is left of the others'
+    for (size_t i = 0; i < job.num_shares; i++) {
+        Share& current = job.shares[(share + i) % job.num_shares];
+        for (;;) {
+            size_t chunk = current.next.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= current.end)
+                break;
+            job.body(chunk);
+            if (job.done.fetch_add(1, std::memory_order_acq_rel) + 1 == job.num_chunks)
+                job.done.notify_all();
+        }
+    }
+}
+
+inline void ThreadPool::push(const std::shared_ptr<Job>& job, size_t copies, bool spread)
+{
+    if (copies == 0 || workers_.empty())
+        return;
+    if (in_worker()) {
+        // Nested call: keep the work local, idle workers will steal it
+        Worker& own = *workers_[detail::worker_context.id];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        for (size_t i = 0; i < copies; i++)
+            own.jobs.push_back(job);
+    } else {
+        // Loops go to workers 0, 1, ... so worker t - 1 runs share t
+        // while it is idle; single tasks rotate over the workers
+        size_t first = spread ? next_victim_.fetch_add(copies, std::memory_order_relaxed) : 0;
+        for (size_t i = 0; i < copies; i++) {
+            Worker& target = *workers_[(first + i) % workers_.size()];
+            std::lock_guard<std::mutex> lock(target.mutex);
+            target.jobs.push_back(job);
+        }
+    }
+    pending_.fetch_add(copies, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+    }
+    wake_.notify_all();
+}
+
+inline void ThreadPool::retract(const std::shared_ptr<Job>& job, size_t copies)
+{
+    if (copies == 0 || workers_.empty())
+        return;
+    auto take_back = [this, &job](Worker& worker) {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        auto kept = std::remove(worker.jobs.begin(), worker.jobs.end(), job);
+        pending_.fetch_sub(size_t(worker.jobs.end() - kept), std::memory_order_relaxed);
+        worker.jobs.erase(kept, worker.jobs.end());
+    };
+    if (in_worker()) {
+        take_back(*workers_[detail::worker_context.id]);
+    } else {
+        for (size_t i = 0; i < copies; i++)
+            take_back(*workers_[i % workers_.size()]);
+    }
+}
+
+inline std::shared_ptr<ThreadPool::Job> ThreadPool::pop(size_t id)
+{
+    Worker& own = *workers_[id];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (own.jobs.empty())
+        return nullptr;
+    auto job = std::move(own.jobs.back());
+    own.jobs.pop_back();
+    pending_.fetch_sub(1, std::memory_order_relaxed);
+    return job;
+}
+
+inline std::shared_ptr<ThreadPool::Job> ThreadPool::steal(size_t thief)
+{
+    size_t count = workers_.size();
+    for (size_t i = 1; i < count; i++) {
+        Worker& victim = *workers_[(thief + i) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.jobs.empty())
+            continue;
+        auto job = std::move(victim.jobs.front());
+        victim.jobs.erase(victim.jobs.begin());
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        return job;
+    }
+    return nullptr;
+}
+
+inline void ThreadPool::worker_loop(size_t id)
+{
+    detail::worker_context = { this, id };
+    if (pinned_)
+        pin_current_thread(numa_topology().cpu_for_thread(id + 1, requested_));
+    for (;;) {
+        auto job = pop(id);
+        if (!job)
+            job = steal(id);
+        if (job) {
+            run_chunks(*job, id + 1);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        wake_.wait(lock, [this]() { return stopping_ || pending_.load(std::memory_order_acquire) > 0; });
+        // Submitted tasks have no caller waiting on them, so drain the
+        // queues before exiting
+        if (stopping_ && pending_.load(std::memory_order_acquire) == 0)
+            return;
+    }
+}
+
+template <typename F>
+void parallel_for(size_t begin, size_t end, F&& body, size_t grain)
+{
+    ThreadPool::instance().parallel_for(begin, end, std::forward<F>(body), grain);
+}
+
+template <typename R, typename Map, typename Combine>
+R parallel_reduce(size_t begin, size_t end, R identity, Map&& map, Combine&& combine, size_t grain)
+{
+    return ThreadPool::instance().parallel_reduce(begin, end, std::move(identity),
+        std::forward<Map>(map), std::forward<Combine>(combine), grain);
+}
+
+} // namespace NumCPP
+
+#endif // THREADPOOL_TPP
@@ -0,0 +1,131 @@
+#include "NumCPP.hpp"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace NumCPP;
+
+TEST(PoolAllocator, SizeClasses)
+{
+    EXPECT_EQ(PoolAllocator::block_size(1), 64u);
+    EXPECT_EQ(PoolAllocator::block_size(64), 64u);
+    EXPECT_EQ(PoolAllocator::block_size(65), 80u);
+    EXPECT_EQ(PoolAllocator::block_size(128), 128u);
+    EXPECT_EQ(PoolAllocator::block_size(129), 160u);
+    EXPECT_EQ(PoolAllocator::block_size(8000), 8192u);
+    for (size_t bytes = 1; bytes < 100000; bytes += 37) {
+        size_t size = PoolAllocator::block_size(bytes);
+        EXPECT_GE(size, bytes);
+        EXPECT_LE(size, bytes + bytes / 4 + 64);
+    }
+}
+
+TEST(PoolAllocator, RecyclesFreedBuffers)
+{
+    PoolAllocator pool;
+    void* first = pool.allocate(1000, 64);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(first) % 64, 0u);
+    pool.deallocate(first, 1000, 64);
+    EXPECT_EQ(pool.stats().bytes_retained, PoolAllocator::block_size(1000));
+
+    void* second = pool.allocate(1010, 64);
+    EXPECT_EQ(first, second);
+    AllocatorStats stats = pool.stats();
+    EXPECT_EQ(stats.allocations, 2u);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_DOUBLE_EQ(stats.hit_rate(), 0.5);
+    EXPECT_EQ(stats.bytes_retained, 0u);
+    EXPECT_EQ(stats.bytes_in_use, PoolAllocator::block_size(1000));
+    pool.deallocate(second, 1010, 64);
+
+    pool.trim();
+    EXPECT_EQ(pool.stats().bytes_retained, 0u);
+    EXPECT_EQ(pool.stats().bytes_in_use, 0u);
+}
+
+TEST(PoolAllocator, RetentionLimitAndBypass)
+{
+    PoolAllocator pool(4096);
+    void* a = pool.allocate(4096, 64);
+    void* b = pool.allocate(4096, 64);
+    pool.deallocate(a, 4096, 64);
+    pool.deallocate(b, 4096, 64);
+    EXPECT_EQ(pool.stats().bytes_retained, 4096u);
+
+    void* wide = pool.allocate(100, 256);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(wide) % 256, 0u);
+    pool.deallocate(wide, 100, 256);
+    EXPECT_EQ(pool.stats().bytes_retained, 4096u);
+}
+
+TEST(PoolAllocator, ArrayTemporariesHitThePool)
+{
+    PoolAllocator pool;
+    {
+        ScopedAllocator scope(pool);
+        Array<double> a({ 256 }, 1.0);
+        for (int i = 0; i < 10; ++i) {
+            Array<double> t = a * 2.0 + 1.0;
+            EXPECT_DOUBLE_EQ(t(255), 3.0);
+        }
+    }
+    AllocatorStats stats = pool.stats();
+    EXPECT_EQ(stats.allocations, 11u);
+    EXPECT_EQ(stats.hits, 9u);
+    EXPECT_EQ(stats.bytes_in_use, 0u);
+    EXPECT_EQ(&default_allocator(), &detail::aligned_allocator());
+}
+
+TEST(PoolAllocator, FreesAcrossThreads)
+{
+    PoolAllocator pool;
+    std::vector<void*> blocks(64);
+    for (auto& block : blocks)
+        block = pool.allocate(512, 64);
+    std::thread releaser([&] {
+        for (void* block : blocks)
+            pool.deallocate(block, 512, 64);
+    });
+    releaser.join();
+    for (auto& block : blocks)
+        block = pool.allocate(512, 64);
+    EXPECT_EQ(pool.stats().hits, 64u);
+    for (void* block : blocks)
+        pool.deallocate(block, 512, 64);
+}
+
+TEST(ArenaAllocator, BumpAllocatesAndResets)
+{
+    ArenaAllocator arena(4096);
+    void* a = arena.allocate(100, 64);
+    void* b = arena.allocate(100, 64);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(a) % 64, 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b) % 64, 0u);
+    EXPECT_EQ(static_cast<char*>(b) - static_cast<char*>(a), 128);
+
+    void* big = arena.allocate(10000, 64);
+    EXPECT_NE(big, nullptr);
+    EXPECT_GE(arena.capacity(), 4096u + 10000u);
+    arena.deallocate(a, 100, 64);
+    arena.deallocate(b, 100, 64);
+    arena.deallocate(big, 10000, 64);
+    EXPECT_EQ(arena.stats().bytes_in_use, 0u);
+
+    arena.reset();
+    EXPECT_EQ(arena.capacity(), 4096u);
+    EXPECT_EQ(arena.allocate(100, 64), a);
+}
+
+TEST(ArenaAllocator, ScopedScratchArrays)
+{
+    ArenaAllocator arena;
+    {
+        ScopedAllocator scope(arena);
+        Array<float> x({ 64, 64 }, 2.0f);
+        Array<float> y = x * x;
+        EXPECT_FLOAT_EQ(y.sum(), 4.0f * 64 * 64);
+        EXPECT_EQ(arena.stats().allocations, 2u);
+    }
+    EXPECT_EQ(arena.stats().bytes_in_use, 0u);
+    arena.reset();
+}
@@ -0,0 +1,77 @@
+#include "NumCPP.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <new>
+
+using namespace NumCPP;
+
+// Counts every heap allocation of the test binary
+namespace {
+std::atomic<size_t> heap_allocations { 0 };
+
+void* counted(size_t bytes, size_t alignment)
+{
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = nullptr;
+    if (alignment <= alignof(std::max_align_t))
+        ptr = std::malloc(bytes ? bytes : 1);
+    else if (posix_memalign(&ptr, alignment, bytes ? bytes : 1) != 0)
+        ptr = nullptr;
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+}
+
+void* operator new(size_t bytes) { return counted(bytes, 0); }
+void* operator new[](size_t bytes) { return counted(bytes, 0); }
+void* operator new(size_t bytes, std::align_val_t alignment) { return counted(bytes, size_t(alignment)); }
+void* operator new[](size_t bytes, std::align_val_t alignment) { return counted(bytes, size_t(alignment)); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+
+TEST(Allocations, SteadyStateLoopDoesNotAllocate)
+{
+#ifdef NUMCPP_PROFILING
+    GTEST_SKIP() << "Profiling hooks record into maps";
+#endif
+    ThreadPool& pool = ThreadPool::instance();
+    size_t previous = pool.num_threads();
+    pool.set_num_threads(4);
+    {
+        Array<double> a({ 256, 256 }, 1.5);
+        Array<double> b({ 256, 256 }, 2.0);
+        Array<double> c({ 256, 256 }, 0.5);
+        Array<double> row({ 256 }, 1.0);
+        Array<double> out({ 256, 256 });
+        auto step = [&]() {
+            out = a * b + c;
+            add(a, b, out);
+            multiply(out, 0.5, out);
+            out += a * c;
+            out -= row;
+            evaluate(-out + 2.0, out);
+            ++out;
+            --out;
+        };
+        for (bool serial : { false, true }) {
+            pool.set_inline(serial);
+            // Warm up: starts the workers and fills per-thread caches
+            step();
+            size_t before = heap_allocations.load();
+            for (int i = 0; i < 10; ++i)
+                step();
+            EXPECT_EQ(heap_allocations.load() - before, 0u) << (serial ? "inline" : "parallel");
+        }
+        pool.set_inline(false);
+        EXPECT_DOUBLE_EQ(out(0, 0), 0.5);
+    }
+    pool.set_num_threads(previous);
+}
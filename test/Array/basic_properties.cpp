@@ -66,6 +66,14 @@ TEST(BasicArrayProperties, ReshapeTo1D)
     EXPECT_EQ(reshaped(5), 6.0);
 }
 
+TEST(BasicArrayProperties, ReshapeRejectsDifferentSize)
+{
+    Array<double> arr({ 4 }, 1.0);
+    EXPECT_THROW(arr.reshape({ 2, 3 }), std::invalid_argument);
+    EXPECT_THROW(arr.reshape({}), std::invalid_argument);
+    EXPECT_EQ(arr.reshape({ 2, 2 }).size(), 4u);
+}
+
 TEST(BasicArrayProperties, Flatten)
 {
     Array<double> arr({ 2, 3 }, { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 });
@@ -0,0 +1,112 @@
+#include "FixedRankArray.hpp"
+#include <gtest/gtest.h>
+#include <numeric>
+#include <utility>
+
+using namespace NumCPP;
+
+TEST(FixedRankArray, ConstructAndIndex)
+{
+    FixedRankArray<double, 3> a({ 2, 3, 4 }, 1.5);
+    EXPECT_EQ(a.size(), 24u);
+    EXPECT_EQ((FixedRankArray<double, 3>::ndim()), 3u);
+    EXPECT_EQ(a.strides(), (std::array<size_t, 3> { 12, 4, 1 }));
+    EXPECT_EQ(a(1, 2, 3), 1.5);
+    a(1, 2, 3) = 7.0;
+    EXPECT_EQ(a.at_unchecked(1, 2, 3), 7.0);
+    EXPECT_EQ(a.data()[23], 7.0);
+    EXPECT_THROW(a(2, 0, 0), std::out_of_range);
+    EXPECT_THROW(a(0, 0, 4), std::out_of_range);
+    EXPECT_THROW((FixedRankArray<double, 2>({ 2, 0 })), std::invalid_argument);
+    EXPECT_THROW((FixedRankArray<double, 2>({ 2, 2 }, std::vector<double>(3))), std::invalid_argument);
+}
+
+TEST(FixedRankArray, SharesStorageWithArray)
+{
+    std::vector<int> values(12);
+    std::iota(values.begin(), values.end(), 0);
+    Array<int> arr({ 3, 4 }, values);
+    FixedRankArray<int, 2> fixed(arr);
+    EXPECT_EQ(fixed.storage().data(), arr.storage().data());
+    EXPECT_EQ(std::as_const(fixed)(2, 1), 9);
+
+    // Writes unshare the buffer (copy-on-write)
+    fixed(2, 1) = -1;
+    EXPECT_EQ(arr({ 2, 1 }), 9);
+
+    // fixed(2, 1) handed out a reference, so a conversion copies the buffer
+    Array<int> back = fixed.to_array();
+    EXPECT_EQ(back.shape(), (std::vector<size_t> { 3, 4 }));
+    EXPECT_NE(back.storage().data(), fixed.storage().data());
+    EXPECT_EQ(back({ 2, 1 }), -1);
+    FixedRankArray<int, 2> shared(Array<int>({ 3, 4 }, values));
+    EXPECT_EQ(std::as_const(shared).to_array().storage().data(), shared.storage().data());
+    EXPECT_THROW((FixedRankArray<int, 3>(arr)), std::invalid_argument);
+}
+
+TEST(FixedRankArray, SpanIsUncheckedView)
+{
+    FixedRankArray<float, 2> a({ 3, 5 }, 0.0f);
+    ArraySpan<float, 2> s = a.span();
+    for (size_t i = 0; i < s.extent(0); i++) {
+        for (size_t j = 0; j < s.extent(1); j++)
+            s(i, j) = static_cast<float>(i * 10 + j);
+    }
+    EXPECT_EQ(a(2, 4), 24.0f);
+    ArraySpan<const float, 2> cs = s;
+    EXPECT_EQ((cs[{ 1, 3 }]), 13.0f);
+    EXPECT_EQ(cs.size(), 15u);
+}
+
+TEST(FixedRankArray, ConstexprIndexing)
+{
+    constexpr std::array<size_t, 3> strides = detail::row_major_strides<3>({ 4, 5, 6 });
+    static_assert(strides[0] == 30 && strides[1] == 6 && strides[2] == 1);
+    static_assert(detail::linear_index(strides, 1, 2, 3) == 45);
+}
+
+TEST(ArrayUnchecked, AtUncheckedAndSpan)
+{
+    Array<double> a({ 4, 3 }, 0.0);
+    ArraySpan<double, 2> s = a.span<2>();
+    s(3, 2) = 5.0;
+    EXPECT_EQ(a({ 3, 2 }), 5.0);
+    EXPECT_EQ(a.at_unchecked(3, 2), 5.0);
+    EXPECT_EQ(a.at_unchecked(size_t(11)), 5.0);
+    EXPECT_THROW(a.span<3>(), std::invalid_argument);
+
+    // Spans of a shared buffer point at this array's own copy
+    Array<double> b = a;
+    b.span<2>()(0, 0) = 1.0;
+    EXPECT_EQ(a({ 0, 0 }), 0.0);
+    EXPECT_EQ(b({ 0, 0 }), 1.0);
+}
+
+TEST(ArrayUnchecked, VariadicIndexChecks)
+{
+    Array<int> a({ 2, 3 }, 1);
+    EXPECT_EQ(a(1, 2), 1);
+    EXPECT_THROW(a(2, 0), std::runtime_error);
+    EXPECT_THROW(a(0, 3), std::runtime_error);
+    EXPECT_THROW(a(0, 0, 0), std::invalid_argument);
+    EXPECT_EQ(a.size(), 6u);
+    EXPECT_EQ(a.reshape({ 3, 2 }).size(), 6u);
+    Array<int> moved = std::move(a);
+    EXPECT_EQ(moved.size(), 6u);
+    EXPECT_EQ(a.size(), 0u);
+}
+
+TEST(FixedRankArray, ReferencesTakenBeforeACopyStayPrivate)
+{
+    FixedRankArray<double, 2> a({ 2, 2 }, 1.0);
+    double& r = a(0, 0);
+    FixedRankArray<double, 2> b = a;
+    FixedRankArray<double, 2> c;
+    c = a;
+    Array<double> d = a.to_array();
+    r = 5.0;
+    EXPECT_EQ(std::as_const(a)(0, 0), 5.0);
+    EXPECT_EQ(std::as_const(b)(0, 0), 1.0);
+    EXPECT_EQ(std::as_const(c)(0, 0), 1.0);
+    EXPECT_EQ(std::as_const(d)(0, 0), 1.0);
+}
@@ -0,0 +1,173 @@
+#include "Array.hpp"
+#include <gtest/gtest.h>
+
+using namespace NumCPP;
+
+namespace {
+// Reference reduction by walking every element through operator()
+template <typename T, typename F>
+std::vector<T> naive_reduce(const Array<T>& arr, const std::vector<bool>& reduced, T init, F combine)
+{
+    const auto& shape = arr.shape();
+    std::vector<size_t> out_shape;
+    for (size_t d = 0; d < shape.size(); d++) {
+        if (!reduced[d])
+            out_shape.push_back(shape[d]);
+    }
+    size_t out_count = 1;
+    for (auto s : out_shape)
+        out_count *= s;
+    std::vector<T> out(out_count, init);
+    std::vector<size_t> index(shape.size(), 0);
+    for (size_t flat = 0; flat < arr.size(); flat++) {
+        size_t o = 0;
+        for (size_t d = 0; d < shape.size(); d++) {
+            if (!reduced[d])
+                o = o * shape[d] + index[d];
+        }
+        out[o] = combine(out[o], arr(index));
+        for (size_t d = shape.size(); d-- > 0;) {
+            if (++index[d] < shape[d])
+                break;
+            index[d] = 0;
+        }
+    }
+    return out;
+}
+
+Array<int> iota_array(const std::vector<size_t>& shape)
+{
+    size_t count = 1;
+    for (auto s : shape)
+        count *= s;
+    std::vector<int> values(count);
+    // Scrambled so extremes are not at the ends
+    for (size_t i = 0; i < count; i++)
+        values[i] = static_cast<int>((i * 7919) % 1009) - 500;
+    return Array<int>(shape, values);
+}
+}
+
+TEST(AxisReductions, SumRowsAndColumns)
+{
+    Array<double> arr({ 2, 3 }, std::vector<double> { 1, 2, 3, 4, 5, 6 });
+    EXPECT_EQ(arr.sum(0).flatten(), std::vector<double>({ 5, 7, 9 }));
+    EXPECT_EQ(arr.sum(1).flatten(), std::vector<double>({ 6, 15 }));
+    EXPECT_EQ(arr.sum(0).shape(), std::vector<size_t>({ 3 }));
+    EXPECT_EQ(arr.sum(1, true).shape(), std::vector<size_t>({ 2, 1 }));
+}
+
+TEST(AxisReductions, MeanMinMax)
+{
+    Array<double> arr({ 2, 3 }, std::vector<double> { 1, 8, 3, 4, 5, 6 });
+    EXPECT_EQ(arr.mean(0).flatten(), std::vector<double>({ 2.5, 6.5, 4.5 }));
+    EXPECT_EQ(arr.mean(1).flatten(), std::vector<double>({ 4, 5 }));
+    EXPECT_EQ(arr.min(0).flatten(), std::vector<double>({ 1, 5, 3 }));
+    EXPECT_EQ(arr.max(1).flatten(), std::vector<double>({ 8, 6 }));
+}
+
+TEST(AxisReductions, AllAxes)
+{
+    Array<double> arr({ 2, 3 }, std::vector<double> { 1, 2, 3, 4, 5, 6 });
+    Array<double> total = arr.sum({ 0, 1 });
+    EXPECT_EQ(total.shape(), std::vector<size_t>({ 1 }));
+    EXPECT_EQ(total.data()[0], 21);
+    EXPECT_EQ(arr.sum({ 1, 0 }, true).shape(), std::vector<size_t>({ 1, 1 }));
+    EXPECT_EQ(arr.sum(std::vector<size_t> {}).flatten(), arr.flatten());
+}
+
+TEST(AxisReductions, MatchesNaiveForEveryAxisSubset)
+{
+    for (auto shape : { std::vector<size_t> { 3, 1, 4, 5 }, std::vector<size_t> { 2, 70, 3, 33 } }) {
+        Array<int> arr = iota_array(shape);
+        const size_t nd = shape.size();
+        for (size_t mask = 0; mask < (size_t(1) << nd); mask++) {
+            std::vector<size_t> axes;
+            std::vector<bool> reduced(nd, false);
+            for (size_t d = 0; d < nd; d++) {
+                if (mask & (size_t(1) << d)) {
+                    axes.push_back(d);
+                    reduced[d] = true;
+                }
+            }
+            auto add = [](int a, int b) { return a + b; };
+            auto lo = [](int a, int b) { return std::min(a, b); };
+            auto hi = [](int a, int b) { return std::max(a, b); };
+            EXPECT_EQ(arr.sum(axes).flatten(), naive_reduce(arr, reduced, 0, add)) << "mask " << mask;
+            EXPECT_EQ(arr.min(axes).flatten(), naive_reduce(arr, reduced, 1 << 30, lo)) << "mask " << mask;
+            EXPECT_EQ(arr.max(axes).flatten(), naive_reduce(arr, reduced, -(1 << 30), hi)) << "mask " << mask;
+        }
+    }
+}
+
+TEST(AxisReductions, LargeOuterAndInnerAxes)
+{
+    // Wide enough for several column blocks and long rows split across threads
+    Array<double> arr({ 3, 5000 }, 0.0);
+    double* values = arr.data();
+    for (size_t i = 0; i < arr.size(); i++)
+        values[i] = static_cast<double>(i % 97);
+    Array<double> columns = arr.sum(0);
+    Array<double> rows = arr.sum(1);
+    for (size_t j = 0; j < 5000; j += 499)
+        EXPECT_EQ(columns.data()[j], double(j % 97) + double((j + 5000) % 97) + double((j + 10000) % 97));
+    for (size_t i = 0; i < 3; i++) {
+        double expected = 0;
+        for (size_t j = 0; j < 5000; j++)
+            expected += static_cast<double>((i * 5000 + j) % 97);
+        EXPECT_EQ(rows.data()[i], expected);
+    }
+}
+
+TEST(AxisReductions, ArgminArgmax)
+{
+    Array<double> arr({ 2, 3 }, std::vector<double> { 1, 8, 3, 9, 5, 0 });
+    EXPECT_EQ(arr.argmax(), 3);
+    EXPECT_EQ(arr.argmin(), 5);
+    EXPECT_EQ(arr.argmax(0).flatten(), std::vector<size_t>({ 1, 0, 0 }));
+    EXPECT_EQ(arr.argmin(1).flatten(), std::vector<size_t>({ 0, 2 }));
+    EXPECT_EQ(arr.argmax(1, true).shape(), std::vector<size_t>({ 2, 1 }));
+}
+
+TEST(AxisReductions, ArgReturnsFirstOccurrence)
+{
+    Array<int> arr({ 2, 4 }, std::vector<int> { 2, 7, 7, 1, 7, 1, 1, 7 });
+    EXPECT_EQ(arr.argmax(), 1);
+    EXPECT_EQ(arr.argmin(), 3);
+    EXPECT_EQ(arr.argmax(1).flatten(), std::vector<size_t>({ 1, 0 }));
+    EXPECT_EQ(arr.argmin(0).flatten(), std::vector<size_t>({ 0, 1, 1, 0 }));
+}
+
+TEST(AxisReductions, ArgMatchesNaive)
+{
+    Array<int> arr = iota_array({ 4, 300, 7 });
+    for (size_t axis = 0; axis < 3; axis++) {
+        Array<size_t> best = arr.argmax(axis);
+        Array<int> values = arr.max(axis);
+        const auto& shape = arr.shape();
+        for (size_t o = 0; o < best.size(); o++) {
+            std::vector<size_t> index;
+            size_t rem = o;
+            for (size_t d = 3; d-- > 0;) {
+                if (d == axis)
+                    continue;
+                index.insert(index.begin(), rem % shape[d]);
+                rem /= shape[d];
+            }
+            index.insert(index.begin() + axis, best.data()[o]);
+            EXPECT_EQ(arr(index), values.data()[o]);
+            for (size_t k = 0; k < best.data()[o]; k++) {
+                index[axis] = k;
+                EXPECT_LT(arr(index), values.data()[o]);
+            }
+        }
+    }
+}
+
+TEST(AxisReductions, InvalidAxes)
+{
+    Array<double> arr({ 2, 3 });
+    EXPECT_THROW(arr.sum(2), std::out_of_range);
+    EXPECT_THROW(arr.argmax(2), std::out_of_range);
+    EXPECT_THROW(arr.sum({ 1, 1 }), std::invalid_argument);
+}
@@ -0,0 +1,151 @@
+#include "Array.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace NumCPP;
+
+namespace {
+// Runs body under SumMode::Reproducible, restoring the previous settings
+template <typename F>
+void reproducibly(F&& body)
+{
+    SumMode saved = sum_mode();
+    set_sum_mode(SumMode::Reproducible);
+    body();
+    set_sum_mode(saved);
+}
+
+Array<double> noisy(size_t count)
+{
+    std::vector<double> values(count);
+    for (size_t i = 0; i < count; i++)
+        values[i] = std::sin(double(i)) * std::pow(10.0, double(i % 17) - 8);
+    return Array<double>({ count }, values);
+}
+}
+
+TEST(ReproducibleSum, IdenticalAcrossThreadCountsAndSimdLevels)
+{
+    Array<double> arr = noisy(100003);
+    reproducibly([&] {
+        SimdLevel saved_level = simd_level();
+        double reference = arr.sum();
+        for (size_t threads : { 1, 2, 3, 7 }) {
+            ThreadPool::instance().set_num_threads(threads);
+            for (int level = 0; level <= static_cast<int>(detected_simd_level()); level++) {
+                set_simd_level(static_cast<SimdLevel>(level));
+                EXPECT_EQ(arr.sum(), reference) << threads << " threads, level " << level;
+                EXPECT_EQ((arr * 2.0).sum(), 2.0 * reference);
+            }
+        }
+        ThreadPool::instance().set_num_threads(0);
+        set_simd_level(saved_level);
+    });
+}
+
+TEST(ReproducibleSum, CompensatesCancellation)
+{
+    Array<double> arr({ 4 }, std::vector<double> { 1.0, 1e100, 1.0, -1e100 });
+    reproducibly([&] { EXPECT_EQ(arr.sum(), 2.0); });
+
+    // 0.1 is not representable; a compensated sum stays within an ulp
+    Array<double> tenths({ 1000000 }, 0.1);
+    reproducibly([&] { EXPECT_NEAR(tenths.sum(), 100000.0, 1e-9); });
+}
+
+TEST(ReproducibleSum, PropagatesInfinity)
+{
+    Array<double> arr({ 3 }, std::vector<double> { 1.0, INFINITY, 2.0 });
+    reproducibly([&] { EXPECT_EQ(arr.sum(), INFINITY); });
+}
+
+TEST(ReproducibleSum, AxisSumsIdenticalAcrossThreadCounts)
+{
+    Array<double> arr = noisy(3 * 40000).reshape({ 3, 40000 });
+    reproducibly([&] {
+        std::vector<double> reference = arr.sum(1).flatten();
+        ThreadPool::instance().set_num_threads(1);
+        EXPECT_EQ(arr.sum(1).flatten(), reference);
+        ThreadPool::instance().set_num_threads(0);
+        EXPECT_EQ(arr.sum(1).data()[0], arr.slice(0, 0, 1).copy().sum());
+    });
+}
+
+TEST(Statistics, VarianceAndStddev)
+{
+    Array<double> arr({ 4 }, std::vector<double> { 1, 2, 3, 4 });
+    EXPECT_DOUBLE_EQ(arr.var(), 1.25);
+    EXPECT_DOUBLE_EQ(arr.var(1), 5.0 / 3.0);
+    EXPECT_DOUBLE_EQ(arr.stddev(), std::sqrt(1.25));
+    EXPECT_TRUE(std::isnan(arr.var(4)));
+}
+
+TEST(Statistics, IntegerArraysUseDouble)
+{
+    Array<int> arr({ 2 }, std::vector<int> { 1, 2 });
+    double variance = arr.var();
+    EXPECT_DOUBLE_EQ(variance, 0.25);
+}
+
+TEST(Statistics, HigherMoments)
+{
+    Array<double> symmetric({ 5 }, std::vector<double> { -2, -1, 0, 1, 2 });
+    Moments<double> m = symmetric.moments();
+    EXPECT_EQ(m.count, 5);
+    EXPECT_DOUBLE_EQ(m.mean, 0.0);
+    EXPECT_DOUBLE_EQ(m.skewness(), 0.0);
+    // m2 = 10, m4 = 34: 5 * 34 / 100 - 3
+    EXPECT_DOUBLE_EQ(m.kurtosis(), -1.3);
+}
+
+TEST(Statistics, MatchesTwoPassAcrossBlocks)
+{
+    const size_t n = 50001;
+    std::vector<double> values(n);
+    for (size_t i = 0; i < n; i++)
+        values[i] = 1e6 + std::cos(double(i) * 0.37) * double(i % 13);
+    Array<double> arr({ n }, values);
+
+    long double mean = 0;
+    for (double v : values)
+        mean += v;
+    mean /= n;
+    long double m2 = 0, m3 = 0, m4 = 0;
+    for (double v : values) {
+        long double d = v - mean;
+        m2 += d * d;
+        m3 += d * d * d;
+        m4 += d * d * d * d;
+    }
+
+    Moments<double> m = arr.moments();
+    EXPECT_NEAR(m.mean, double(mean), 1e-9);
+    EXPECT_NEAR(m.m2 / double(m2), 1.0, 1e-10);
+    EXPECT_NEAR(m.m3 / double(m3), 1.0, 1e-6);
+    EXPECT_NEAR(m.m4 / double(m4), 1.0, 1e-10);
+
+    ThreadPool::instance().set_num_threads(1);
+    Moments<double> serial = arr.moments();
+    ThreadPool::instance().set_num_threads(0);
+    EXPECT_EQ(serial.m2, m.m2);
+    EXPECT_EQ(serial.m4, m.m4);
+}
+
+TEST(Statistics, MergeMatchesWhole)
+{
+    Array<double> arr = noisy(9000);
+    Moments<double> whole = arr.moments();
+    Moments<double> left = compute_moments(arr.data(), 2500);
+    left.merge(compute_moments(arr.data() + 2500, 6500));
+    EXPECT_EQ(left.count, whole.count);
+    EXPECT_NEAR(left.mean / whole.mean, 1.0, 1e-12);
+    EXPECT_NEAR(left.m2 / whole.m2, 1.0, 1e-12);
+    EXPECT_NEAR(left.m4 / whole.m4, 1.0, 1e-12);
+}
+
+TEST(Statistics, EmptyThrows)
+{
+    Array<double> arr;
+    EXPECT_THROW(arr.var(), std::runtime_error);
+    EXPECT_THROW(arr.moments(), std::runtime_error);
+}
@@ -0,0 +1,154 @@
+#include "NumCPP.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <utility>
+
+using namespace NumCPP;
+
+namespace {
+Array<double> ramp(size_t n)
+{
+    std::vector<double> values(n);
+    for (size_t i = 0; i < n; ++i)
+        values[i] = double(i);
+    return Array<double>({ n }, values);
+}
+}
+
+TEST(Temporaries, ExpiringOperandLendsItsBuffer)
+{
+    Array<double> t = ramp(1000);
+    const double* buffer = std::as_const(t).data();
+    Array<double> r = std::move(t) * 2.0 + 1.0;
+    EXPECT_EQ(std::as_const(r).data(), buffer);
+    EXPECT_EQ(r(999), 1999.0);
+
+    // A function result is a temporary too
+    Array<double> other = ramp(1000);
+    Array<double> s = other - ramp(1000) * 3.0;
+    EXPECT_EQ(s(10), -20.0);
+
+    // Reassigning a moved-from array takes its buffer back
+    Array<double> x = ramp(100);
+    buffer = std::as_const(x).data();
+    x = -std::move(x) + 5.0;
+    EXPECT_EQ(std::as_const(x).data(), buffer);
+    EXPECT_EQ(x(7), -2.0);
+}
+
+TEST(Temporaries, SharedOrBroadcastOperandsAreNotReused)
+{
+    Array<double> shared = ramp(100);
+    Array<double> copy = shared;
+    const double* buffer = std::as_const(shared).data();
+    Array<double> r = std::move(shared) + 1.0;
+    EXPECT_NE(std::as_const(r).data(), buffer);
+    EXPECT_EQ(copy(3), 3.0);
+    EXPECT_EQ(r(3), 4.0);
+
+    Array<double> row({ 4 }, 1.0);
+    Array<double> grid({ 3, 4 }, 2.0);
+    buffer = std::as_const(row).data();
+    Array<double> sum = std::move(row) + grid;
+    EXPECT_EQ(sum.shape(), (std::vector<size_t> { 3, 4 }));
+    EXPECT_NE(std::as_const(sum).data(), buffer);
+    EXPECT_EQ(sum(2, 3), 3.0);
+
+    // Wrapped memory stays with its owner
+    std::vector<double> external(8, 1.0);
+    Array<double> wrapped({ 8 }, Storage<double>::wrap(external.data(), 8));
+    Array<double> scaled = std::move(wrapped) * 4.0;
+    EXPECT_NE(std::as_const(scaled).data(), external.data());
+    EXPECT_EQ(external[0], 1.0);
+
+    // Nor is a buffer that the expression also reads transposed
+    Array<double> square = ramp(64 * 64).reshape({ 64, 64 });
+    auto transposed = std::as_const(square).view().transpose();
+    Array<double> symmetric = std::move(square) + transposed;
+    for (size_t i = 0; i < 64; ++i)
+        for (size_t j = 0; j < 64; ++j)
+            EXPECT_EQ(symmetric(i, j), double(i * 64 + j + j * 64 + i));
+}
+
+TEST(Temporaries, OutParameterFunctions)
+{
+    Array<double> a = ramp(64);
+    Array<double> b({ 64 }, 2.0);
+    Array<double> out({ 64 });
+    const double* buffer = std::as_const(out).data();
+
+    add(a, b, out);
+    EXPECT_EQ(out(5), 7.0);
+    subtract(a, 1.0, out);
+    EXPECT_EQ(out(5), 4.0);
+    multiply(3.0, a, out);
+    EXPECT_EQ(out(5), 15.0);
+    divide(a, b, out);
+    EXPECT_EQ(out(5), 2.5);
+    evaluate(a * b + out, out);
+    EXPECT_EQ(out(5), 12.5);
+    // out may be an operand
+    multiply(out, out, out);
+    EXPECT_EQ(out(5), 156.25);
+    EXPECT_EQ(std::as_const(out).data(), buffer);
+
+    // A view of out in the same layout keeps the buffer; a transposed one
+    // is read before out is overwritten
+    Array<double> square = ramp(9).reshape({ 3, 3 });
+    buffer = std::as_const(square).data();
+    evaluate(square.view() * 2.0, square);
+    EXPECT_EQ(std::as_const(square).data(), buffer);
+    EXPECT_EQ(square(1, 2), 10.0);
+    evaluate(square.view().transpose() * 1.0, square);
+    EXPECT_EQ(square.flatten(), std::vector<double>({ 0, 6, 12, 2, 8, 14, 4, 10, 16 }));
+    add(square, square.slice(0, 0, 1), square);
+    EXPECT_EQ(square.flatten(), std::vector<double>({ 0, 12, 24, 2, 14, 26, 4, 16, 28 }));
+
+    Array<double> wrong({ 63 });
+    EXPECT_THROW(add(a, b, wrong), std::invalid_argument);
+    Array<double> grid({ 2, 64 });
+    add(Array<double>({ 2, 64 }, 1.0), a, grid);
+    EXPECT_EQ(grid(1, 63), 64.0);
+}
+
+TEST(Temporaries, IncrementsWorkInPlace)
+{
+    Array<double> a = ramp(16);
+    const double* buffer = std::as_const(a).data();
+    EXPECT_EQ(std::addressof(++a), std::addressof(a));
+    EXPECT_EQ(std::addressof(--a), std::addressof(a));
+    EXPECT_EQ(std::as_const(a).data(), buffer);
+    EXPECT_EQ(std::as_const(a)(3), 3.0);
+
+    Array<double> old = a++;
+    EXPECT_EQ(old(3), 3.0);
+    EXPECT_EQ(a(3), 4.0);
+    EXPECT_EQ(std::as_const(old).data(), buffer);
+    old = a--;
+    EXPECT_EQ(old(3), 4.0);
+    EXPECT_EQ(a(3), 3.0);
+
+    Matrix<double> m({ 2, 2 }, 1.0);
+    EXPECT_EQ(std::addressof(++m), std::addressof(m));
+    EXPECT_EQ(m(1, 1), 2.0);
+    Matrix<double> before = m--;
+    EXPECT_EQ(before(1, 1), 2.0);
+    EXPECT_EQ(m(1, 1), 1.0);
+}
+
+TEST(Temporaries, MatrixRvalueOperatorsReuseTheLeftOperand)
+{
+    Matrix<double> a({ 3, 3 }, 2.0);
+    Matrix<double> b({ 3, 3 }, 3.0);
+    Matrix<double> c({ 3, 3 }, 4.0);
+    Matrix<double> chained = (a + b) * c - 1.0;
+    EXPECT_EQ(chained(2, 2), 19.0);
+
+    Matrix<double> t({ 3, 3 }, 5.0);
+    const double* buffer = t.array().data();
+    Matrix<double> r = -(std::move(t) / b);
+    EXPECT_EQ(r.array().data(), buffer);
+    EXPECT_DOUBLE_EQ(r(0, 1), -5.0 / 3.0);
+    EXPECT_EQ(a(0, 0), 2.0);
+    EXPECT_THROW(Matrix<double>({ 3, 3 }, 1.0) + Matrix<double>({ 3, 2 }, 1.0), std::runtime_error);
+}
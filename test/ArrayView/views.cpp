@@ -0,0 +1,144 @@
+#include "Array.hpp"
+#include <gtest/gtest.h>
+
+using namespace NumCPP;
+
+namespace {
+Array<double> iota(const std::vector<size_t>& shape)
+{
+    size_t total = 1;
+    for (auto s : shape)
+        total *= s;
+    std::vector<double> values(total);
+    for (size_t i = 0; i < total; i++)
+        values[i] = static_cast<double>(i);
+    return Array<double>(shape, values);
+}
+}
+
+TEST(ArrayView, ViewSharesBuffer)
+{
+    Array<double> a = iota({ 2, 3 });
+    ArrayView<double> v = a.view();
+    EXPECT_EQ(v.data(), a.data());
+    EXPECT_TRUE(v.is_contiguous());
+    v(1, 2) = 42.0;
+    EXPECT_DOUBLE_EQ(a(1, 2), 42.0);
+}
+
+TEST(ArrayView, ReshapeIsMetadataOnly)
+{
+    Array<double> a = iota({ 2, 6 });
+    auto r = a.view().reshape({ 3, 2, 2 });
+    EXPECT_EQ(r.data(), a.data());
+    EXPECT_EQ(r.shape(), std::vector<size_t>({ 3, 2, 2 }));
+    EXPECT_EQ(r.strides(), std::vector<size_t>({ 4, 2, 1 }));
+    EXPECT_DOUBLE_EQ(r(2, 1, 0), 10.0);
+    EXPECT_THROW(a.view().reshape({ 5, 2 }), std::invalid_argument);
+}
+
+TEST(ArrayView, TransposeSwapsStrides)
+{
+    Array<double> a = iota({ 2, 3 });
+    auto t = a.view().transpose();
+    EXPECT_EQ(t.shape(), std::vector<size_t>({ 3, 2 }));
+    EXPECT_EQ(t.strides(), std::vector<size_t>({ 1, 3 }));
+    EXPECT_FALSE(t.is_contiguous());
+    for (size_t i = 0; i < 3; i++)
+        for (size_t j = 0; j < 2; j++)
+            EXPECT_DOUBLE_EQ(t(i, j), a(j, i));
+    EXPECT_THROW(t.reshape({ 6 }), std::runtime_error);
+    Array<double> materialized = t.copy();
+    EXPECT_EQ(materialized.shape(), std::vector<size_t>({ 3, 2 }));
+    EXPECT_DOUBLE_EQ(materialized(0, 1), 3.0);
+    EXPECT_DOUBLE_EQ(materialized(2, 0), 2.0);
+}
+
+TEST(ArrayView, PermuteAxes)
+{
+    Array<double> a = iota({ 2, 3, 4 });
+    auto p = a.view().permute({ 2, 0, 1 });
+    EXPECT_EQ(p.shape(), std::vector<size_t>({ 4, 2, 3 }));
+    EXPECT_DOUBLE_EQ(p(3, 1, 2), a(1, 2, 3));
+    EXPECT_THROW(a.view().permute({ 0, 0, 1 }), std::invalid_argument);
+}
+
+TEST(ArrayView, RangeAndStepSlicing)
+{
+    Array<double> a = iota({ 4, 5 });
+    auto rows = a.slice(0, 1, 3);
+    EXPECT_EQ(rows.shape(), std::vector<size_t>({ 2, 5 }));
+    EXPECT_TRUE(rows.is_contiguous());
+    EXPECT_DOUBLE_EQ(rows(0, 0), 5.0);
+
+    auto cols = a.slice(1, 0, 5, 2);
+    EXPECT_EQ(cols.shape(), std::vector<size_t>({ 4, 3 }));
+    EXPECT_FALSE(cols.is_contiguous());
+    EXPECT_DOUBLE_EQ(cols(3, 2), 19.0);
+
+    auto window = cols.slice(0, 1, 100, 2);
+    EXPECT_EQ(window.shape(), std::vector<size_t>({ 2, 3 }));
+    EXPECT_DOUBLE_EQ(window(1, 1), 17.0);
+    EXPECT_THROW(a.slice(2, 0, 1), std::out_of_range);
+    EXPECT_THROW(a.slice(0, 0, 1, 0), std::invalid_argument);
+}
+
+TEST(ArrayView, ViewsTakePartInExpressions)
+{
+    Array<double> a = iota({ 3, 4 });
+    auto t = a.view().transpose();
+    Array<double> b = iota({ 4, 3 });
+    Array<double> sum = t + b * 2.0;
+    for (size_t i = 0; i < 4; i++)
+        for (size_t j = 0; j < 3; j++)
+            EXPECT_DOUBLE_EQ(sum(i, j), a(j, i) + 2.0 * b(i, j));
+    EXPECT_DOUBLE_EQ(a.slice(1, 1, 4, 2).sum(), 1 + 3 + 5 + 7 + 9 + 11);
+    EXPECT_DOUBLE_EQ(t.max(), 11.0);
+}
+
+TEST(ArrayView, WritesThroughStridedView)
+{
+    Array<double> a({ 3, 4 }, 0.0);
+    auto cols = a.slice(1, 1, 4, 2);
+    cols.fill(1.0);
+    Array<double> ones({ 3, 2 }, 1.0);
+    cols.assign(cols + ones);
+    for (size_t i = 0; i < 3; i++) {
+        EXPECT_DOUBLE_EQ(a(i, 0), 0.0);
+        EXPECT_DOUBLE_EQ(a(i, 1), 2.0);
+        EXPECT_DOUBLE_EQ(a(i, 2), 0.0);
+        EXPECT_DOUBLE_EQ(a(i, 3), 2.0);
+    }
+    EXPECT_THROW(cols.assign(Array<double>({ 2, 2 }, 1.0)), std::runtime_error);
+}
+
+TEST(ArrayView, ConstViewsAreReadOnly)
+{
+    const Array<double> a = iota({ 2, 2 });
+    ArrayView<const double> v = a.view();
+    EXPECT_DOUBLE_EQ(v(1, 0), 2.0);
+    Array<double> b = iota({ 2, 2 });
+    ArrayView<const double> c = b.view();
+    EXPECT_DOUBLE_EQ(c.transpose()(0, 1), 2.0);
+}
+
+TEST(ArrayView, AssigningAViewOfItselfReadsTheOriginal)
+{
+    Array<double> a = iota({ 3, 3 });
+    a = a.view().transpose();
+    EXPECT_EQ(a.flatten(), std::vector<double>({ 0, 3, 6, 1, 4, 7, 2, 5, 8 }));
+
+    Array<double> b = iota({ 3, 3 });
+    const double* buffer = b.data();
+    auto t = b.view().transpose();
+    b = t * 2.0 + b;
+    EXPECT_EQ(b.flatten(), std::vector<double>({ 0, 7, 14, 5, 12, 19, 10, 17, 24 }));
+    EXPECT_NE(b.data(), buffer);
+
+    // A view in the same layout reads each element before it is written
+    Array<double> c = iota({ 3, 3 });
+    buffer = c.data();
+    c = c.view() + 1.0;
+    EXPECT_EQ(c.flatten(), std::vector<double>({ 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+    EXPECT_EQ(c.data(), buffer);
+}
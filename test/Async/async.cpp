@@ -0,0 +1,168 @@
+#include "NumCPP.hpp"
+#include <gtest/gtest.h>
+#include <coroutine>
+#include <future>
+#include <thread>
+
+using namespace NumCPP;
+
+namespace {
+// Runs with workers whatever the machine, so tasks really run concurrently
+class Async : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        previous_ = ThreadPool::instance().num_threads();
+        ThreadPool::instance().set_num_threads(4);
+    }
+    void TearDown() override { ThreadPool::instance().set_num_threads(previous_); }
+
+private:
+    size_t previous_ = 0;
+};
+
+// Minimal eagerly started coroutine type for co_await tests
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() { return {}; }
+        std::suspend_never initial_suspend() { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() { }
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+Detached sum_then_scale(Array<double> arr, std::promise<double>& result)
+{
+    Task<double> total = async_sum(arr);
+    double value = co_await total;
+    Task<Array<double>> scale = async([arr, value]() { return Array<double>(arr * value); });
+    Array<double> scaled = co_await scale;
+    result.set_value(scaled.sum());
+}
+}
+
+TEST_F(Async, KernelsMatchSynchronousCalls)
+{
+    Array<double> a({ 3, 3 }, { 4, 1, 0, 1, 3, 1, 0, 1, 2 });
+    Array<double> b({ 3 }, { 1, 2, 3 });
+    SquareMatrix<double> square(a);
+    Matrix<double> matrix(a);
+
+    Task<double> sum = async_sum(a);
+    Task<Array<double>> dot = async_dot(matrix, matrix, Trans::No, Trans::Yes);
+    Task<SquareMatrix<double>> inverse = async_inverse(square);
+    Task<Array<double>> solved = async_solve(square, b);
+
+    EXPECT_DOUBLE_EQ(sum.get(), a.sum());
+    EXPECT_EQ(dot.get().flatten(), matrix.dot(matrix, Trans::No, Trans::Yes).flatten());
+    EXPECT_EQ(inverse.get().flatten().flatten(), square.inverse().flatten().flatten());
+    EXPECT_EQ(solved.get().flatten(), square.solve(b).flatten());
+    EXPECT_TRUE(sum.ready());
+    EXPECT_DOUBLE_EQ(sum.get(), a.sum());
+}
+
+TEST_F(Async, ThenChainsAndPropagatesErrors)
+{
+    Task<int> chained = async([]() { return 2; }).then([](int x) { return x * 3; }).then([](int x) {
+        return x + 1;
+    });
+    EXPECT_EQ(chained.get(), 7);
+
+    std::atomic<bool> called { false };
+    Task<int> failed = async([]() -> int { throw std::invalid_argument("bad input"); }).then([&](int x) {
+        called = true;
+        return x;
+    });
+    EXPECT_THROW(failed.get(), std::invalid_argument);
+    EXPECT_FALSE(called);
+
+    Task<void> done = async([]() { }).then([]() { });
+    EXPECT_NO_THROW(done.get());
+    EXPECT_THROW(Task<int>().get(), std::runtime_error);
+}
+
+TEST_F(Async, WhenAllCombinesResultsInOrder)
+{
+    Task<std::tuple<int, double>> both = when_all(async([]() { return 1; }), async_sum(Array<double>({ 4 }, 0.5)));
+    EXPECT_EQ(both.get(), std::make_tuple(1, 2.0));
+
+    std::vector<Task<size_t>> tasks;
+    for (size_t i = 0; i < 20; ++i)
+        tasks.push_back(async([i]() { return i * i; }));
+    std::vector<size_t> squares = when_all(tasks).get();
+    ASSERT_EQ(squares.size(), 20u);
+    for (size_t i = 0; i < 20; ++i)
+        EXPECT_EQ(squares[i], i * i);
+    EXPECT_TRUE(when_all(std::vector<Task<int>>()).get().empty());
+
+    tasks.push_back(async([]() -> size_t { throw std::out_of_range("missing"); }));
+    EXPECT_THROW(when_all(tasks).get(), std::out_of_range);
+}
+
+TEST_F(Async, CancelSkipsStepsNotYetStarted)
+{
+    std::promise<void> started, release;
+    std::shared_future<void> gate = release.get_future().share();
+    Task<int> first = async([&started, gate]() {
+        started.set_value();
+        gate.wait();
+        return 1;
+    });
+    Task<int> second = first.then([](int x) { return x + 1; });
+    started.get_future().wait();
+    second.cancel();
+    release.set_value();
+    EXPECT_EQ(first.get(), 1);
+    EXPECT_THROW(second.get(), TaskCancelled);
+
+    // Work taking a stop token sees the request while running
+    std::promise<void> running;
+    Task<int> polling = async([&running](std::stop_token token) {
+        running.set_value();
+        while (!token.stop_requested())
+            std::this_thread::yield();
+        return 42;
+    });
+    running.get_future().wait();
+    polling.cancel();
+    EXPECT_EQ(polling.get(), 42);
+}
+
+TEST_F(Async, DefaultConstructedTaskThrows)
+{
+    Task<int> empty;
+    EXPECT_FALSE(empty.valid());
+    EXPECT_THROW(empty.ready(), std::runtime_error);
+    EXPECT_THROW(empty.wait(), std::runtime_error);
+    EXPECT_THROW(empty.get(), std::runtime_error);
+    EXPECT_THROW(empty.cancel(), std::runtime_error);
+    EXPECT_THROW(empty.stop_token(), std::runtime_error);
+    EXPECT_THROW(empty.then([](int x) { return x; }), std::runtime_error);
+    EXPECT_THROW(when_all(async([]() { return 1; }), empty), std::runtime_error);
+    EXPECT_THROW(when_all(std::vector<Task<int>> { empty }), std::runtime_error);
+}
+
+TEST_F(Async, CancellingWhenAllCancelsInputs)
+{
+    std::promise<void> release;
+    std::shared_future<void> gate = release.get_future().share();
+    Task<int> blocker = async([gate]() {
+        gate.wait();
+        return 0;
+    });
+    Task<int> waiting = blocker.then([](int x) { return x; });
+    Task<std::tuple<int>> all = when_all(waiting);
+    all.cancel();
+    release.set_value();
+    EXPECT_THROW(waiting.get(), TaskCancelled);
+    EXPECT_THROW(all.get(), TaskCancelled);
+}
+
+TEST_F(Async, CoroutinesAwaitTasks)
+{
+    std::promise<double> result;
+    std::future<double> value = result.get_future();
+    sum_then_scale(Array<double>({ 100 }, 2.0), result);
+    EXPECT_DOUBLE_EQ(value.get(), 200.0 * 200.0);
+}
@@ -0,0 +1,151 @@
+#include "Array.hpp"
+#include "CostModel.hpp"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+
+using namespace NumCPP;
+
+namespace {
+// Restores the global cost model and pool size after each test
+class CostModelTest : public ::testing::Test {
+protected:
+    CostModel::Parameters saved;
+
+    void SetUp() override
+    {
+        saved = CostModel::instance().parameters();
+        CostModel::Parameters params;
+        params.dispatch_ns = 1000;
+        params.ns_per_byte = 0.1;
+        params.ns_per_op = 0.5;
+        params.ns_per_call = 20;
+        CostModel::instance().set_parameters(params);
+    }
+
+    void TearDown() override
+    {
+        CostModel::instance().set_parameters(saved);
+        ThreadPool::instance().set_num_threads(0);
+    }
+
+    std::string path(const std::string& name) const
+    {
+        return (std::filesystem::temp_directory_path() / ("numcpp_cost_" + name)).string();
+    }
+};
+}
+
+TEST_F(CostModelTest, ItemTimeIsBoundByMemoryOrArithmetic)
+{
+    CostModel& model = CostModel::instance();
+    EXPECT_DOUBLE_EQ(model.item_ns({ 24, 1, 0 }), 2.4);
+    EXPECT_DOUBLE_EQ(model.item_ns({ 24, 10, 0 }), 5.0);
+    EXPECT_DOUBLE_EQ(model.item_ns({ 24, 1, 2 }), 42.4);
+}
+
+TEST_F(CostModelTest, GrainCoversDispatch)
+{
+    CostModel& model = CostModel::instance();
+    // 1000 ns at 2.4 ns per element
+    EXPECT_EQ(model.grain(KernelCost::stream<double>(2, 1)), 417u);
+    EXPECT_EQ(model.grain(KernelCost { 0, 0, 1 }), 50u);
+    EXPECT_EQ(model.grain(KernelCost { 0, 0, 1000 }), 1u);
+    EXPECT_GT(model.grain(KernelCost {}), size_t(1) << 40);
+}
+
+TEST_F(CostModelTest, ThreadsGrowWithWork)
+{
+    ThreadPool::instance().set_num_threads(4);
+    CostModel& model = CostModel::instance();
+    KernelCost add = KernelCost::stream<double>(2, 1) + KernelCost { 0, 1, 0 };
+    EXPECT_EQ(model.threads(100, add), 1u);
+    EXPECT_EQ(model.threads(1000, add), 3u);
+    EXPECT_EQ(model.threads(1000000, add), 4u);
+    // Expensive elements parallelize much smaller ranges
+    EXPECT_EQ(model.threads(100, add + KernelCost { 0, 0, 1 }), 3u);
+}
+
+TEST_F(CostModelTest, GemmDecisionIncludesInnerDimension)
+{
+    ThreadPool::instance().set_num_threads(4);
+    CostModel& model = CostModel::instance();
+    EXPECT_EQ(model.threads(16 * 16, KernelCost { 0, 2.0 * 2, 0 }), 1u);
+    EXPECT_EQ(model.threads(16 * 16, KernelCost { 0, 2.0 * 512, 0 }), 4u);
+}
+
+TEST_F(CostModelTest, ExpressionCost)
+{
+    Array<double> a({ 8 }, 1.0), b({ 8 }, 2.0);
+    KernelCost sum = detail::kernel_cost(detail::kernel_of(a + b * 2.0));
+    EXPECT_EQ(sum.bytes, 16);
+    EXPECT_EQ(sum.ops, 2);
+    EXPECT_EQ(sum.calls, 0);
+    KernelCost quotient = detail::kernel_cost(detail::kernel_of(a / b));
+    EXPECT_EQ(quotient.ops, 4);
+}
+
+TEST_F(CostModelTest, ResultsIndependentOfGrains)
+{
+    Array<double> a({ 37, 53 }, 0.0);
+    for (size_t i = 0; i < a.size(); i++)
+        a.data()[i] = double(i % 101) - 50.0;
+    Array<double> sum = a * 3.0 + a;
+    double total = a.sum();
+    Array<double> columns = a.sum(0);
+    std::vector<double> flat = a.transposed().flatten();
+
+    ThreadPool::instance().set_num_threads(4);
+    CostModel::Parameters tiny = CostModel::instance().parameters();
+    tiny.dispatch_ns = 1e-3;
+    CostModel::instance().set_parameters(tiny);
+    EXPECT_EQ(Array<double>(a * 3.0 + a).flatten(), sum.flatten());
+    EXPECT_EQ(a.sum(), total);
+    EXPECT_EQ(a.sum(0).flatten(), columns.flatten());
+    EXPECT_EQ(a.transposed().flatten(), flat);
+}
+
+TEST_F(CostModelTest, SaveAndLoad)
+{
+    std::string file = path("roundtrip");
+    CostModel::instance().save(file);
+    CostModel::Parameters params = CostModel::instance().parameters();
+    params.dispatch_ns = 123456.5;
+    CostModel::instance().set_parameters(params);
+    CostModel::instance().load(file);
+    EXPECT_EQ(CostModel::instance().parameters().dispatch_ns, 1000);
+    EXPECT_EQ(CostModel::instance().parameters().ns_per_op, 0.5);
+
+    std::ofstream(file) << "# partial\nns_per_call 7.5\n";
+    CostModel::instance().load(file);
+    EXPECT_EQ(CostModel::instance().parameters().ns_per_call, 7.5);
+    EXPECT_EQ(CostModel::instance().parameters().dispatch_ns, 1000);
+    std::filesystem::remove(file);
+}
+
+TEST_F(CostModelTest, RejectsInvalidParameters)
+{
+    std::string file = path("invalid");
+    std::ofstream(file) << "bandwidth 3\n";
+    EXPECT_THROW(CostModel::instance().load(file), std::runtime_error);
+    std::ofstream(file) << "ns_per_op -1\n";
+    EXPECT_THROW(CostModel::instance().load(file), std::runtime_error);
+    std::filesystem::remove(file);
+    EXPECT_THROW(CostModel::instance().load(file), std::runtime_error);
+
+    CostModel::Parameters params;
+    params.ns_per_byte = 0;
+    EXPECT_THROW(CostModel::instance().set_parameters(params), std::invalid_argument);
+    EXPECT_EQ(CostModel::instance().parameters().ns_per_byte, 0.1);
+}
+
+TEST_F(CostModelTest, CalibrationMeasuresPositiveCosts)
+{
+    ThreadPool::instance().set_num_threads(2);
+    CostModel::Parameters measured = CostModel::instance().calibrate();
+    EXPECT_GT(measured.dispatch_ns, 0);
+    EXPECT_GT(measured.ns_per_byte, 0);
+    EXPECT_GT(measured.ns_per_op, 0);
+    EXPECT_GT(measured.ns_per_call, 0);
+    EXPECT_EQ(CostModel::instance().parameters().ns_per_call, measured.ns_per_call);
+}
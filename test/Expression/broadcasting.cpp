@@ -0,0 +1,129 @@
+#include "Array.hpp"
+#include <gtest/gtest.h>
+
+using namespace NumCPP;
+
+namespace {
+Array<double> iota(const std::vector<size_t>& shape, double start = 0.0)
+{
+    size_t total = 1;
+    for (auto s : shape)
+        total *= s;
+    std::vector<double> values(total);
+    for (size_t i = 0; i < total; i++)
+        values[i] = start + static_cast<double>(i);
+    return Array<double>(shape, values);
+}
+}
+
+TEST(Broadcasting, ResultShape)
+{
+    EXPECT_EQ(detail::broadcast_shapes({ 4, 1, 3 }, { 5, 1 }, "test"), std::vector<size_t>({ 4, 5, 3 }));
+    EXPECT_EQ(detail::broadcast_shapes({ 3 }, { 2, 3 }, "test"), std::vector<size_t>({ 2, 3 }));
+    EXPECT_THROW(detail::broadcast_shapes({ 2, 2 }, { 2, 3 }, "test"), std::runtime_error);
+}
+
+TEST(Broadcasting, RowBiasAddsToEveryRow)
+{
+    Array<double> m = iota({ 3, 37 });
+    Array<double> bias = iota({ 37 }, 100.0);
+    Array<double> result = m + bias;
+    EXPECT_EQ(result.shape(), std::vector<size_t>({ 3, 37 }));
+    for (size_t i = 0; i < 3; i++)
+        for (size_t j = 0; j < 37; j++)
+            EXPECT_DOUBLE_EQ(result(i, j), m(i, j) + bias(j));
+
+    Array<double> left = bias - m;
+    EXPECT_DOUBLE_EQ(left(2, 5), bias(5) - m(2, 5));
+}
+
+TEST(Broadcasting, ColumnScaleMultipliesEveryColumn)
+{
+    Array<double> m = iota({ 5, 19 });
+    Array<double> scale = iota({ 5, 1 }, 1.0);
+    Array<double> result = m * scale;
+    for (size_t i = 0; i < 5; i++)
+        for (size_t j = 0; j < 19; j++)
+            EXPECT_DOUBLE_EQ(result(i, j), m(i, j) * scale(i, 0));
+}
+
+TEST(Broadcasting, OuterProductAndGeneralCase)
+{
+    Array<double> col = iota({ 4, 1 }, 1.0);
+    Array<double> row = iota({ 1, 3 }, 1.0);
+    Array<double> outer = col * row;
+    EXPECT_EQ(outer.shape(), std::vector<size_t>({ 4, 3 }));
+    for (size_t i = 0; i < 4; i++)
+        for (size_t j = 0; j < 3; j++)
+            EXPECT_DOUBLE_EQ(outer(i, j), (i + 1.0) * (j + 1.0));
+
+    Array<double> cube = iota({ 2, 3, 4 });
+    Array<double> mid = iota({ 3, 1 }, 10.0);
+    Array<double> sum = cube + mid;
+    for (size_t i = 0; i < 2; i++)
+        for (size_t j = 0; j < 3; j++)
+            for (size_t k = 0; k < 4; k++)
+                EXPECT_DOUBLE_EQ(sum(i, j, k), cube(i, j, k) + mid(j, 0));
+}
+
+TEST(Broadcasting, CompoundAssignmentBroadcastsRightOperand)
+{
+    Array<double> m = iota({ 2, 3 });
+    m += iota({ 3 }, 1.0);
+    EXPECT_DOUBLE_EQ(m(1, 2), 5.0 + 3.0);
+    m *= Array<double>({ 2, 1 }, { 2.0, 10.0 });
+    EXPECT_DOUBLE_EQ(m(0, 1), (1.0 + 2.0) * 2.0);
+    EXPECT_DOUBLE_EQ(m(1, 0), (3.0 + 1.0) * 10.0);
+
+    // The left operand's shape cannot grow in place
+    Array<double> v = iota({ 3 });
+    EXPECT_THROW(v += iota({ 2, 3 }), std::runtime_error);
+}
+
+TEST(Broadcasting, ChainedNodesAndReductions)
+{
+    Array<double> m = iota({ 4, 8 });
+    Array<double> mean = iota({ 8 });
+    Array<double> stdev({ 4, 1 }, 2.0);
+    auto normalized = (m - mean) / stdev;
+    EXPECT_EQ(normalized.shape(), std::vector<size_t>({ 4, 8 }));
+    EXPECT_DOUBLE_EQ(normalized.sum(), ((m - mean).sum()) / 2.0);
+
+    Array<int> a({ 3, 4 }, 6);
+    Array<int> b({ 4 }, { 1, 2, 3, 6 });
+    Array<int> q = a / b;
+    EXPECT_EQ(q(2, 3), 1);
+    EXPECT_EQ(q(0, 1), 3);
+}
+
+TEST(Broadcasting, ViewsBroadcastOnAssignment)
+{
+    Array<double> m({ 3, 4 }, 0.0);
+    m.slice(1, 0, 4, 2).assign(Array<double>({ 2 }, { 1.0, 2.0 }));
+    EXPECT_DOUBLE_EQ(m(2, 0), 1.0);
+    EXPECT_DOUBLE_EQ(m(2, 2), 2.0);
+    EXPECT_DOUBLE_EQ(m(2, 1), 0.0);
+}
+
+TEST(Broadcasting, OperandsViewingTheDestinationReadOriginalValues)
+{
+    Array<double> a = iota({ 3, 3 });
+    a += a.slice(0, 0, 1);
+    EXPECT_EQ(a.flatten(), std::vector<double>({ 0, 2, 4, 3, 5, 7, 6, 8, 10 }));
+
+    Array<double> b = iota({ 3, 3 });
+    b += b.slice(0, 1, 2);
+    EXPECT_EQ(b.flatten(), std::vector<double>({ 3, 5, 7, 6, 8, 10, 9, 11, 13 }));
+
+    Array<double> c = iota({ 3, 3 });
+    c = c + c.slice(0, 0, 1);
+    EXPECT_EQ(c.flatten(), std::vector<double>({ 0, 2, 4, 3, 5, 7, 6, 8, 10 }));
+
+    Array<double> d = iota({ 3, 3 });
+    d *= d.slice(1, 2, 3);
+    EXPECT_EQ(d.flatten(), std::vector<double>({ 0, 2, 4, 15, 20, 25, 48, 56, 64 }));
+
+    Array<double> e = iota({ 3, 3 });
+    e -= e.view().transpose();
+    EXPECT_EQ(e.flatten(), std::vector<double>({ 0, -2, -4, 2, 0, -2, 4, 2, 0 }));
+}
@@ -0,0 +1,115 @@
+#include "Array.hpp"
+#include <gtest/gtest.h>
+#include <type_traits>
+
+using namespace NumCPP;
+
+TEST(LazyEvaluation, OperatorsReturnExpressionNodes)
+{
+    Array<double> a({ 2, 2 }, 1.0);
+    Array<double> b({ 2, 2 }, 2.0);
+    auto expr = a * b + a;
+    EXPECT_FALSE((std::is_same_v<decltype(expr), Array<double>>));
+    EXPECT_EQ(expr.shape(), std::vector<size_t>({ 2, 2 }));
+    EXPECT_EQ(expr.size(), 4u);
+}
+
+TEST(LazyEvaluation, FusedChainMatchesElementWise)
+{
+    Array<double> a({ 3 }, { 1.0, 2.0, 3.0 });
+    Array<double> b({ 3 }, { 4.0, 5.0, 6.0 });
+    Array<double> c({ 3 }, { 0.5, 0.5, 0.5 });
+    Array<double> result = a * b + c - 2.0;
+    EXPECT_EQ(result.shape(), std::vector<size_t>({ 3 }));
+    EXPECT_DOUBLE_EQ(result(0), 2.5);
+    EXPECT_DOUBLE_EQ(result(1), 8.5);
+    EXPECT_DOUBLE_EQ(result(2), 16.5);
+}
+
+TEST(LazyEvaluation, NodesAreLazy)
+{
+    Array<double> a({ 2 }, { 1.0, 2.0 });
+    auto expr = a + 1.0;
+    a(0) = 10.0;
+    EXPECT_DOUBLE_EQ(expr(0), 11.0);
+}
+
+TEST(LazyEvaluation, ScalarOnTheLeft)
+{
+    Array<double> a({ 2 }, { 1.0, 4.0 });
+    Array<double> result = 2.0 - a / 2.0;
+    EXPECT_DOUBLE_EQ(result(0), 1.5);
+    EXPECT_DOUBLE_EQ(result(1), 0.0);
+}
+
+TEST(LazyEvaluation, FusedReductions)
+{
+    Array<double> a({ 2000 }, 1.0);
+    Array<double> b({ 2000 }, 3.0);
+    EXPECT_DOUBLE_EQ((a + b).sum(), 8000.0);
+    EXPECT_DOUBLE_EQ((a - b).max(), -2.0);
+    EXPECT_DOUBLE_EQ((a * b).min(), 3.0);
+    EXPECT_DOUBLE_EQ((a + b).mean(), 4.0);
+}
+
+TEST(LazyEvaluation, ComparisonsAndUnary)
+{
+    Array<double> a({ 3 }, { 1.0, 2.0, 3.0 });
+    Array<double> b({ 3 }, { 3.0, 2.0, 1.0 });
+    Array<double> lt = a < b;
+    Array<double> eq = a == 2.0;
+    Array<double> neg = -(a + b);
+    Array<double> logical = !(a > b);
+    EXPECT_EQ(lt(0), 1.0);
+    EXPECT_EQ(lt(2), 0.0);
+    EXPECT_EQ(eq(1), 1.0);
+    EXPECT_EQ(neg(0), -4.0);
+    EXPECT_EQ(logical(2), 0.0);
+}
+
+TEST(LazyEvaluation, SelfAssignmentReusesBuffer)
+{
+    Array<double> a({ 3 }, { 1.0, 2.0, 3.0 });
+    Array<double> b({ 3 }, 1.0);
+    const double* before = a.data();
+    a = a * 2.0 + b;
+    EXPECT_EQ(a.data(), before);
+    EXPECT_DOUBLE_EQ(a(2), 7.0);
+}
+
+TEST(LazyEvaluation, AssignmentWithNewShape)
+{
+    Array<double> a({ 2 }, 1.0);
+    Array<double> b({ 2, 3 }, 2.0);
+    a = b + b;
+    EXPECT_EQ(a.shape(), std::vector<size_t>({ 2, 3 }));
+    EXPECT_DOUBLE_EQ(a(1, 2), 4.0);
+}
+
+TEST(LazyEvaluation, TemporaryOperandsAreOwned)
+{
+    Array<double> a({ 2 }, 1.0);
+    auto expr = Array<double>({ 2 }, 5.0) + a;
+    EXPECT_DOUBLE_EQ(expr.sum(), 12.0);
+}
+
+TEST(LazyEvaluation, CompoundAssignmentWithExpression)
+{
+    Array<double> a({ 2 }, { 1.0, 2.0 });
+    Array<double> b({ 2 }, { 3.0, 4.0 });
+    a += b * 2.0;
+    EXPECT_DOUBLE_EQ(a(0), 7.0);
+    EXPECT_DOUBLE_EQ(a(1), 10.0);
+    EXPECT_THROW(a -= Array<double>({ 3 }, 1.0), std::runtime_error);
+}
+
+TEST(LazyEvaluation, IntegerBitwise)
+{
+    Array<int> a({ 3 }, { 1, 2, 3 });
+    Array<int> b({ 3 }, { 3, 3, 3 });
+    Array<int> result = (a & b) | 4;
+    EXPECT_EQ(result(0), 5);
+    EXPECT_EQ(result(2), 7);
+    Array<int> inverted = ~a;
+    EXPECT_EQ(inverted(0), ~1);
+}
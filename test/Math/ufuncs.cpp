@@ -0,0 +1,239 @@
+#include "NumCPP.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <utility>
+
+using namespace NumCPP;
+
+namespace {
+template <typename F>
+void for_each_level(F body)
+{
+    SimdLevel saved = simd_level();
+    for (int level = 0; level <= static_cast<int>(detected_simd_level()); level++) {
+        set_simd_level(static_cast<SimdLevel>(level));
+        SCOPED_TRACE(simd_level_name(simd_level()));
+        body();
+    }
+    set_simd_level(saved);
+}
+
+template <typename T>
+Array<T> linspace(long double lo, long double hi, size_t n)
+{
+    Array<T> a({ n });
+    for (size_t i = 0; i < n; i++)
+        a(i) = static_cast<T>(lo + (hi - lo) * static_cast<long double>(i) / static_cast<long double>(n - 1));
+    return a;
+}
+
+// Distance from the long double reference in units of the last place
+template <typename T>
+double ulp_error(T value, long double reference)
+{
+    T rounded = std::fabs(static_cast<T>(reference));
+    long double ulp = rounded < std::numeric_limits<T>::min()
+        ? std::numeric_limits<T>::denorm_min()
+        : static_cast<long double>(std::nextafter(rounded, std::numeric_limits<T>::infinity())) - rounded;
+    return static_cast<double>(std::fabs(static_cast<long double>(value) - reference) / ulp);
+}
+
+// Largest error of f at n points over [lo, hi] against the reference ref
+template <typename T, typename F, typename R>
+double max_ulp(F f, R ref, long double lo, long double hi, size_t n = 20000)
+{
+    Array<T> x = linspace<T>(lo, hi, n);
+    Array<T> y = f(x);
+    double worst = 0;
+    for (size_t i = 0; i < x.size(); i++)
+        worst = std::max(worst, ulp_error<T>(y(i), ref(static_cast<long double>(x(i)))));
+    return worst;
+}
+
+template <typename T>
+void check_accuracy()
+{
+    using L = long double;
+    constexpr bool is_double = std::is_same_v<T, double>;
+    auto bound = [](double limit, const char* name, double worst) {
+        EXPECT_LE(worst, limit) << name;
+    };
+    bound(0.5, "sqrt", max_ulp<T>([](auto& x) { return Array<T>(sqrt(x)); }, [](L v) { return sqrtl(v); }, 0, 1e6));
+    bound(1.5, "rsqrt", max_ulp<T>([](auto& x) { return Array<T>(rsqrt(x)); }, [](L v) { return 1 / sqrtl(v); }, 1e-6, 1e6));
+    bound(1.5, "exp", max_ulp<T>([](auto& x) { return Array<T>(exp(x)); }, [](L v) { return expl(v); }, is_double ? -708 : -87, is_double ? 709 : 88));
+    bound(2, "expm1", max_ulp<T>([](auto& x) { return Array<T>(expm1(x)); }, [](L v) { return expm1l(v); }, -3, 3));
+    bound(1, "log", max_ulp<T>([](auto& x) { return Array<T>(log(x)); }, [](L v) { return logl(v); }, 1e-6, 1e6));
+    bound(2.5, "log1p", max_ulp<T>([](auto& x) { return Array<T>(log1p(x)); }, [](L v) { return log1pl(v); }, -0.999, 1));
+    bound(2.5, "sin", max_ulp<T>([](auto& x) { return Array<T>(sin(x)); }, [](L v) { return sinl(v); }, -8000, 8000));
+    bound(2.5, "cos", max_ulp<T>([](auto& x) { return Array<T>(cos(x)); }, [](L v) { return cosl(v); }, -10, 10));
+    bound(2.5, "tanh", max_ulp<T>([](auto& x) { return Array<T>(tanh(x)); }, [](L v) { return tanhl(v); }, -20, 20));
+    bound(2.5, "sigmoid", max_ulp<T>([](auto& x) { return Array<T>(sigmoid(x)); }, [](L v) { return 1 / (1 + expl(-v)); }, -40, 40));
+    bound(2.5, "sigmoid", max_ulp<T>([](auto& x) { return Array<T>(sigmoid(x)); }, [](L v) { return 1 / (1 + expl(-v)); }, -4, 4, 1000000));
+    bound(2, "erf", max_ulp<T>([](auto& x) { return Array<T>(erf(x)); }, [](L v) { return erfl(v); }, -7, 7));
+}
+}
+
+TEST(Math, AccuracyDouble)
+{
+    for_each_level([] { check_accuracy<double>(); });
+}
+
+TEST(Math, AccuracyFloat)
+{
+    for_each_level([] { check_accuracy<float>(); });
+}
+
+TEST(Math, SpecialValues)
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    for_each_level([&] {
+        Array<double> x({ 7 }, std::vector<double> { nan, inf, -inf, 0.0, -1.0, 800.0, -800.0 });
+
+        Array<double> e = exp(x);
+        EXPECT_TRUE(std::isnan(e(0)));
+        EXPECT_EQ(e(1), inf);
+        EXPECT_EQ(e(2), 0.0);
+        EXPECT_EQ(e(3), 1.0);
+        EXPECT_EQ(e(5), inf);
+        EXPECT_EQ(e(6), 0.0);
+        // Gradual underflow
+        Array<double> sub = exp(Array<double>({ 1 }, -740.0));
+        EXPECT_GT(sub(0), 0.0);
+        EXPECT_LT(sub(0), std::numeric_limits<double>::min());
+
+        Array<double> l = log(x);
+        EXPECT_TRUE(std::isnan(l(0)));
+        EXPECT_EQ(l(1), inf);
+        EXPECT_TRUE(std::isnan(l(2)));
+        EXPECT_EQ(l(3), -inf);
+        EXPECT_TRUE(std::isnan(l(4)));
+        EXPECT_EQ(Array<double>(log1p(x))(4), -inf);
+        EXPECT_DOUBLE_EQ(Array<double>(log(Array<double>({ 1 }, 4.9e-324)))(0), std::log(4.9e-324));
+
+        Array<double> m = expm1(x);
+        EXPECT_EQ(m(2), -1.0);
+        EXPECT_EQ(m(5), inf);
+
+        Array<double> s = sin(x);
+        EXPECT_TRUE(std::isnan(s(0)) && std::isnan(s(1)) && std::isnan(s(2)));
+        EXPECT_EQ(s(3), 0.0);
+        // Beyond the reduction range the C library takes over
+        Array<double> far = linspace<double>(1e6, 1e22, 9);
+        Array<double> c = cos(far);
+        for (size_t i = 0; i < far.size(); i++)
+            EXPECT_DOUBLE_EQ(c(i), std::cos(far(i)));
+
+        Array<double> t = tanh(x);
+        EXPECT_EQ(t(1), 1.0);
+        EXPECT_EQ(t(2), -1.0);
+        EXPECT_EQ(t(5), 1.0);
+        EXPECT_TRUE(std::isnan(t(0)));
+
+        Array<double> g = sigmoid(x);
+        EXPECT_EQ(g(1), 1.0);
+        EXPECT_EQ(g(2), 0.0);
+        EXPECT_EQ(g(3), 0.5);
+        EXPECT_TRUE(std::isnan(g(0)));
+        Array<double> tiny = sigmoid(Array<double>({ 1 }, -700.0));
+        EXPECT_GT(tiny(0), 0.0);
+
+        Array<double> f = erf(x);
+        EXPECT_EQ(f(1), 1.0);
+        EXPECT_EQ(f(2), -1.0);
+        EXPECT_TRUE(std::isnan(f(0)));
+
+        EXPECT_TRUE(std::isnan(Array<double>(sqrt(x))(4)));
+        EXPECT_EQ(Array<double>(rsqrt(x))(3), inf);
+        EXPECT_EQ(Array<double>(abs(x))(2), inf);
+    });
+}
+
+TEST(Math, FusesWithOperators)
+{
+    for_each_level([] {
+        Array<double> a = linspace<double>(-3, 3, 101);
+        Array<double> w({ 101 }, 0.5);
+        Array<double> y = sigmoid(a * w + 1.0) * 2.0 - exp(-abs(a));
+        for (size_t i = 0; i < a.size(); i++)
+            EXPECT_NEAR(y(i), 2.0 / (1 + std::exp(-(a(i) * 0.5 + 1.0))) - std::exp(-std::fabs(a(i))), 1e-14);
+
+        Array<float> f = linspace<float>(0.5, 4, 33);
+        Array<float> g = log(sqrt(f)) + 1.0f;
+        for (size_t i = 0; i < f.size(); i++)
+            EXPECT_NEAR(g(i), std::log(std::sqrt(f(i))) + 1.0f, 1e-6f);
+    });
+}
+
+TEST(Math, OutParameterAndInPlace)
+{
+    Array<double> a = linspace<double>(0, 2, 64);
+    Array<double> out({ 64 });
+    const double* buffer = std::as_const(out).data();
+    exp(a, out);
+    EXPECT_DOUBLE_EQ(out(63), std::exp(2.0));
+    tanh(a * 2.0, out);
+    EXPECT_DOUBLE_EQ(out(63), std::tanh(4.0));
+    clip(a, 0.5, 1.5, out);
+    EXPECT_EQ(out(0), 0.5);
+    EXPECT_EQ(out(63), 1.5);
+    EXPECT_EQ(std::as_const(out).data(), buffer);
+
+    // The operand may be the output
+    buffer = std::as_const(a).data();
+    exp(a, a);
+    EXPECT_DOUBLE_EQ(a(63), std::exp(2.0));
+    log(a, a);
+    EXPECT_NEAR(a(63), 2.0, 1e-15);
+    EXPECT_EQ(std::as_const(a).data(), buffer);
+
+    // also through a view in another layout, which reads the original values
+    Array<double> square = linspace<double>(0, 1, 64 * 64).reshape({ 64, 64 });
+    Array<double> expected = square.view().transpose().copy();
+    exp(square.view().transpose(), square);
+    for (size_t i = 0; i < 64; i++)
+        for (size_t j = 0; j < 64; j++)
+            EXPECT_DOUBLE_EQ(square(i, j), std::exp(expected(i, j)));
+
+    Array<double> wrong({ 32 });
+    EXPECT_THROW(exp(a, wrong), std::invalid_argument);
+}
+
+TEST(Math, ExpiringOperandLendsItsBuffer)
+{
+    Array<double> a = linspace<double>(0, 1, 1000);
+    const double* buffer = std::as_const(a).data();
+    Array<double> r = sigmoid(std::move(a) * 4.0 - 2.0);
+    EXPECT_EQ(std::as_const(r).data(), buffer);
+    EXPECT_DOUBLE_EQ(r(999), 1 / (1 + std::exp(-2.0)));
+}
+
+TEST(Math, IntegerAbsAndClip)
+{
+    for_each_level([] {
+        Array<int> a({ 9 }, std::vector<int> { -4, -3, -2, -1, 0, 1, 2, 3, 4 });
+        Array<int> b = abs(a);
+        Array<int> c = clip(a * 2, -3, 5);
+        for (size_t i = 0; i < a.size(); i++) {
+            EXPECT_EQ(b(i), std::abs(a(i)));
+            EXPECT_EQ(c(i), std::min(std::max(a(i) * 2, -3), 5));
+        }
+        // Integer arguments of the C library functions
+        Array<int> s = sqrt(Array<int>({ 3 }, std::vector<int> { 0, 9, 16 }));
+        EXPECT_EQ(s(2), 4);
+    });
+}
+
+TEST(Math, ClipPropagatesNaN)
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    for_each_level([&] {
+        Array<double> a({ 5 }, std::vector<double> { -2.0, nan, 0.25, 3.0, -0.0 });
+        Array<double> c = clip(a, -1.0, 1.0);
+        EXPECT_EQ(c(0), -1.0);
+        EXPECT_TRUE(std::isnan(c(1)));
+        EXPECT_EQ(c(2), 0.25);
+        EXPECT_EQ(c(3), 1.0);
+    });
+}
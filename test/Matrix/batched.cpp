@@ -0,0 +1,146 @@
+#include "NumCPP.hpp"
+#include "TestUtils.hpp"
+#include <gtest/gtest.h>
+
+using namespace NumCPP;
+
+namespace {
+// Diagonally dominant when square, so every item is well conditioned
+Array<double> test_stack(size_t batch, size_t rows, size_t cols, unsigned seed)
+{
+    std::vector<double> data(batch * rows * cols);
+    TestRandom random(seed);
+    for (double& value : data)
+        value = random.uniform();
+    if (rows == cols)
+        for (size_t b = 0; b < batch; ++b)
+            for (size_t i = 0; i < rows; ++i)
+                data[(b * rows + i) * cols + i] += 2.0;
+    return Array<double>({ batch, rows, cols }, data);
+}
+
+// Item index of a stack as a 2D (or 1D, for a {batch, n} stack) Array
+Array<double> item(const Array<double>& stack, size_t index)
+{
+    std::vector<size_t> shape(stack.shape().begin() + 1, stack.shape().end());
+    size_t size = stack.size() / stack.shape()[0];
+    const double* first = stack.data() + index * size;
+    return Array<double>(shape, std::vector<double>(first, first + size));
+}
+
+Array<double> product(Array<double> a, Array<double> b)
+{
+    return Matrix<double>(a).dot(Matrix<double>(b));
+}
+}
+
+TEST(Batched, MatmulMatchesPerItemDot)
+{
+    // 3 x 5 x 4 takes the direct loop, 40 x 40 x 40 goes through gemm
+    for (size_t size : { size_t(1), size_t(40) }) {
+        Array<double> a = test_stack(5, 3 * size, 5 * size, 1);
+        Array<double> b = test_stack(5, 5 * size, 4 * size, 2);
+        Array<double> bt = batch_transpose(b);
+        Array<double> c = batch_matmul(a, b);
+        Array<double> ct = batch_matmul(a, bt, Trans::No, Trans::Yes);
+        Array<double> at = batch_matmul(batch_transpose(a), b, Trans::Yes, Trans::No);
+        EXPECT_EQ(c.shape(), (std::vector<size_t> { 5, 3 * size, 4 * size }));
+        for (size_t i = 0; i < 5; ++i) {
+            Array<double> expected = product(item(a, i), item(b, i));
+            expect_near(item(c, i), expected, 1e-12);
+            expect_near(item(ct, i), expected, 1e-12);
+            expect_near(item(at, i), expected, 1e-12);
+        }
+    }
+}
+
+TEST(Batched, MatmulBroadcastsSharedMatrixIntoOutput)
+{
+    Array<double> a = test_stack(4, 2, 3, 3);
+    Array<double> b({ 3, 2 }, { 1, 2, 3, 4, 5, 6 });
+    Array<double> out({ 4, 2, 2 });
+    const double* storage = out.data();
+    batch_matmul(a, b, out);
+    EXPECT_EQ(out.data(), storage);
+    for (size_t i = 0; i < 4; ++i)
+        expect_near(item(out, i), product(item(a, i), b), 1e-12);
+
+    Array<double> wrong({ 4, 2, 3 });
+    EXPECT_THROW(batch_matmul(a, b, wrong), std::invalid_argument);
+    EXPECT_THROW(batch_matmul(a, test_stack(3, 3, 2, 4)), std::invalid_argument);
+    EXPECT_THROW(batch_matmul(a, a), std::invalid_argument);
+    EXPECT_THROW(batch_matmul(b, b), std::invalid_argument);
+    EXPECT_THROW(batch_matmul(a, Array<double>()), std::invalid_argument);
+}
+
+TEST(Batched, TransposeSwapsTrailingAxes)
+{
+    Array<double> a({ 2, 2, 3 }, { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 });
+    Array<double> t = batch_transpose(a);
+    EXPECT_EQ(t.shape(), (std::vector<size_t> { 2, 3, 2 }));
+    EXPECT_EQ(t.flatten(), (std::vector<double> { 1, 4, 2, 5, 3, 6, 7, 10, 8, 11, 9, 12 }));
+}
+
+TEST(Batched, DeterminantInverseAndSolveMatchSquareMatrix)
+{
+    // 1 to 4 use the fixed-size closed forms, 6 and 20 elimination
+    for (size_t n : { 1, 2, 3, 4, 6, 20 }) {
+        Array<double> a = test_stack(7, n, n, unsigned(n));
+        Array<double> b = test_stack(7, n, 3, unsigned(n) + 1);
+        Array<double> v = item(test_stack(1, 7, n, unsigned(n) + 2), 0);
+        Array<double> det = batch_determinant(a);
+        Array<double> inv = batch_inverse(a);
+        Array<double> x = batch_solve(a, b);
+        Array<double> y = batch_solve(a, v);
+        EXPECT_EQ(det.shape(), (std::vector<size_t> { 7 }));
+        EXPECT_EQ(y.shape(), v.shape());
+        for (size_t i = 0; i < 7; ++i) {
+            SquareMatrix<double> m(item(a, i));
+            EXPECT_NEAR(det.data()[i], m.determinant(), 1e-9 * std::abs(m.determinant())) << n;
+            expect_near(item(inv, i), m.inverse().array(), 1e-12);
+            expect_near(item(x, i), m.solve(item(b, i)), 1e-12);
+            expect_near(item(y, i), m.solve(item(v, i)), 1e-12);
+        }
+    }
+}
+
+TEST(Batched, InverseAndSolveWorkInPlace)
+{
+    for (size_t n : { 3, 6, 20 }) {
+        Array<double> a = test_stack(5, n, n, unsigned(n));
+        Array<double> b = test_stack(5, n, 2, unsigned(n) + 1);
+        Array<double> inv = batch_inverse(a);
+        Array<double> x = batch_solve(a, b);
+        Array<double> y = batch_solve(a, inv);
+
+        Array<double> in_place = a.copy();
+        batch_inverse(in_place, in_place);
+        expect_near(in_place, inv, 1e-12);
+        Array<double> rhs = b.copy();
+        batch_solve(a, rhs, rhs);
+        expect_near(rhs, x, 1e-12);
+        // The output may also be the matrices themselves
+        Array<double> lhs = a.copy();
+        batch_solve(lhs, inv, lhs);
+        expect_near(lhs, y, 1e-12);
+    }
+}
+
+TEST(Batched, SingularItemIsNamed)
+{
+    for (size_t n : { 3, 6 }) {
+        Array<double> a = test_stack(4, n, n, 5);
+        double* third = a.data() + 2 * n * n;
+        std::fill(third, third + n, 0.0);
+        EXPECT_EQ(batch_determinant(a).data()[2], 0.0);
+        try {
+            batch_inverse(a);
+            ADD_FAILURE() << "expected std::runtime_error";
+        } catch (const std::runtime_error& e) {
+            EXPECT_STREQ(e.what(), "Matrix 2 of the batch is singular");
+        }
+        EXPECT_THROW(batch_solve(a, test_stack(4, n, 1, 6)), std::runtime_error);
+    }
+    EXPECT_THROW(batch_inverse(test_stack(2, 2, 3, 1)), std::invalid_argument);
+    EXPECT_THROW(batch_solve(test_stack(2, 3, 3, 1), test_stack(2, 4, 1, 1)), std::invalid_argument);
+}
@@ -0,0 +1,109 @@
+#include "NumCPP.hpp"
+#include "TestUtils.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace NumCPP;
+
+namespace {
+// B * B^T + n * I
+Array<double> spd_matrix(size_t n, unsigned seed)
+{
+    Array<double> b = random_array({ n, n }, seed);
+    Array<double> a({ n, n });
+    gemm(Trans::No, Trans::Yes, n, n, n, 1.0, b.data(), n, b.data(), n, 0.0, a.data(), n);
+    for (size_t i = 0; i < n; ++i)
+        a.data()[i * n + i] += double(n);
+    return a;
+}
+
+// Largest |A * X - B| entry
+double residual(const Array<double>& a, const Array<double>& x, const Array<double>& b)
+{
+    size_t n = a.shape()[0];
+    size_t k = x.size() / n;
+    Array<double> ax({ n, k });
+    gemm(Trans::No, Trans::No, n, k, n, 1.0, a.data(), n, x.data(), k, 0.0, ax.data(), k);
+    double worst = 0.0;
+    for (size_t i = 0; i < n * k; ++i)
+        worst = std::max(worst, std::abs(ax.data()[i] - b.data()[i]));
+    return worst;
+}
+}
+
+TEST(LU, SolvesAcrossBlockBoundaries)
+{
+    for (size_t n : { 1u, 5u, 64u, 65u, 200u }) {
+        Array<double> a = random_array({ n, n }, unsigned(n));
+        LU<double> lu(a);
+        EXPECT_FALSE(lu.is_singular());
+
+        Array<double> b = random_array({ n, 1 }, 7).reshape({ n });
+        Array<double> x = lu.solve(b);
+        EXPECT_EQ(x.shape(), b.shape());
+        EXPECT_LT(residual(a, x, b), 1e-10) << "n = " << n;
+
+        Array<double> many = random_array({ n, 9 }, 11);
+        EXPECT_LT(residual(a, lu.solve(many), many), 1e-10) << "n = " << n;
+    }
+}
+
+TEST(LU, DeterminantAndInverse)
+{
+    Array<double> a({ 3, 3 }, { 0, 2, 1, 1, 1, 1, 2, 1, 3 });
+    LU<double> lu(a);
+    EXPECT_NEAR(lu.determinant(), -3.0, 1e-12);
+    EXPECT_EQ(lu.permutation().size(), 3u);
+
+    Array<double> inv = lu.inverse();
+    EXPECT_LT(residual(a, inv, detail::identity<double>(3)), 1e-12);
+}
+
+TEST(LU, SingularAndShapeErrors)
+{
+    LU<double> singular(Array<double>({ 2, 2 }, { 1, 2, 2, 4 }));
+    EXPECT_TRUE(singular.is_singular());
+    EXPECT_DOUBLE_EQ(singular.determinant(), 0.0);
+    EXPECT_THROW(singular.solve(Array<double>({ 2 }, 1.0)), std::runtime_error);
+
+    EXPECT_THROW(LU<double>(Array<double>({ 2, 3 }, 1.0)), std::invalid_argument);
+    LU<double> lu(Array<double>({ 2, 2 }, { 2, 0, 0, 2 }));
+    EXPECT_THROW(lu.solve(Array<double>({ 3 }, 1.0)), std::invalid_argument);
+}
+
+TEST(Cholesky, MatchesLU)
+{
+    for (size_t n : { 3u, 64u, 130u }) {
+        Array<double> a = spd_matrix(n, unsigned(n) + 3);
+        Cholesky<double> chol(a);
+        LU<double> lu(a);
+
+        const double* l = chol.factor().data();
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = i + 1; j < n; ++j)
+                ASSERT_EQ(l[i * n + j], 0.0);
+
+        Array<double> b = random_array({ n, 4 }, 5);
+        EXPECT_LT(residual(a, chol.solve(b), b), 1e-9) << "n = " << n;
+        EXPECT_NEAR(std::log(chol.determinant()), std::log(lu.determinant()), 1e-9);
+        EXPECT_LT(residual(a, chol.inverse(), detail::identity<double>(n)), 1e-9);
+    }
+}
+
+TEST(Cholesky, RejectsIndefinite)
+{
+    EXPECT_THROW(Cholesky<double>(Array<double>({ 2, 2 }, { 1, 2, 2, 1 })), std::runtime_error);
+}
+
+TEST(SquareMatrix, SolveAndFactorizations)
+{
+    Array<double> a = spd_matrix(20, 1);
+    SquareMatrix<double> m(a);
+    Array<double> b = random_array({ 20, 1 }, 2).reshape({ 20 });
+    EXPECT_LT(residual(a, m.solve(b), b), 1e-10);
+    EXPECT_LT(residual(a, m.cholesky().solve(b), b), 1e-10);
+    EXPECT_NEAR(m.lu().determinant(), m.determinant(), std::abs(m.determinant()) * 1e-12);
+
+    SquareMatrix<double> singular(Array<double>({ 2, 2 }, { 1, 2, 2, 4 }));
+    EXPECT_THROW(singular.inverse(), std::runtime_error);
+}
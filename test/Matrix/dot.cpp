@@ -0,0 +1,116 @@
+#include "Matrix.hpp"
+#include "TestUtils.hpp"
+#include <gtest/gtest.h>
+
+using namespace NumCPP;
+
+namespace {
+Array<double> sequence(size_t rows, size_t cols, double scale)
+{
+    std::vector<double> values(rows * cols);
+    for (size_t i = 0; i < values.size(); i++)
+        values[i] = scale * static_cast<double>((i * 7) % 13) - 3.0;
+    return Array<double>({ rows, cols }, values);
+}
+
+// Straightforward triple loop on op(A) * op(B)
+std::vector<double> reference(const Array<double>& a, const Array<double>& b, Trans ta, Trans tb)
+{
+    size_t m = ta == Trans::No ? a.shape()[0] : a.shape()[1];
+    size_t k = ta == Trans::No ? a.shape()[1] : a.shape()[0];
+    size_t n = tb == Trans::No ? b.shape()[1] : b.shape()[0];
+    std::vector<double> c(m * n, 0.0);
+    for (size_t i = 0; i < m; i++)
+        for (size_t j = 0; j < n; j++)
+            for (size_t p = 0; p < k; p++) {
+                double x = ta == Trans::No ? a(i, p) : a(p, i);
+                double y = tb == Trans::No ? b(p, j) : b(j, p);
+                c[i * n + j] += x * y;
+            }
+    return c;
+}
+}
+
+TEST(MatrixDot, SmallProduct)
+{
+    Array<double> a({ 2, 3 }, { 1, 2, 3, 4, 5, 6 });
+    Array<double> b({ 3, 2 }, { 7, 8, 9, 10, 11, 12 });
+    Matrix<double> ma(a);
+    Matrix<double> mb(b);
+    Array<double> c = ma.dot(mb);
+    EXPECT_EQ(c.shape(), std::vector<size_t>({ 2, 2 }));
+    EXPECT_DOUBLE_EQ(c(0, 0), 58);
+    EXPECT_DOUBLE_EQ(c(0, 1), 64);
+    EXPECT_DOUBLE_EQ(c(1, 0), 139);
+    EXPECT_DOUBLE_EQ(c(1, 1), 154);
+}
+
+TEST(MatrixDot, MismatchedShapesThrow)
+{
+    Array<double> a({ 2, 3 }, 1.0);
+    Array<double> b({ 2, 3 }, 1.0);
+    Matrix<double> ma(a);
+    Matrix<double> mb(b);
+    EXPECT_THROW(ma.dot(mb), std::runtime_error);
+    EXPECT_NO_THROW(ma.dot(mb, Trans::No, Trans::Yes));
+}
+
+TEST(MatrixDot, BlockedEdgesMatchReferenceOnEveryLevel)
+{
+    // Sizes straddle the microkernel tile and the KC/MC cache blocks
+    const size_t shapes[][3] = { { 1, 1, 1 }, { 5, 7, 3 }, { 17, 33, 9 }, { 97, 45, 260 }, { 130, 70, 300 } };
+    SimdLevel saved = simd_level();
+    for (int level = 0; level <= static_cast<int>(detected_simd_level()); level++) {
+        set_simd_level(static_cast<SimdLevel>(level));
+        SCOPED_TRACE(simd_level_name(simd_level()));
+        for (const auto& s : shapes) {
+            Array<double> a = sequence(s[0], s[2], 0.5);
+            Array<double> b = sequence(s[2], s[1], 0.25);
+            Matrix<double> ma(a);
+            Matrix<double> mb(b);
+            expect_near(ma.dot(mb), reference(a, b, Trans::No, Trans::No), 1e-9);
+        }
+    }
+    set_simd_level(saved);
+}
+
+TEST(MatrixDot, TransposedOperandsAreReadInPlace)
+{
+    Array<double> a = sequence(40, 23, 0.5); // used as 23 x 40
+    Array<double> b = sequence(31, 40, 1.0); // used as 40 x 31
+    Array<double> c = sequence(40, 31, 1.0);
+    Array<double> d = sequence(23, 40, 0.5);
+    Matrix<double> ma(a);
+    Matrix<double> mb(b);
+    Matrix<double> mc(c);
+    Matrix<double> md(d);
+    expect_near(ma.dot(mc, Trans::Yes, Trans::No), reference(a, c, Trans::Yes, Trans::No), 1e-9);
+    expect_near(md.dot(mb, Trans::No, Trans::Yes), reference(d, b, Trans::No, Trans::Yes), 1e-9);
+    expect_near(ma.dot(mb, Trans::Yes, Trans::Yes), reference(a, b, Trans::Yes, Trans::Yes), 1e-9);
+}
+
+TEST(MatrixDot, IntegerProduct)
+{
+    Array<int> a({ 3, 3 }, { 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+    Array<int> id({ 3, 3 }, { 1, 0, 0, 0, 1, 0, 0, 0, 1 });
+    Matrix<int> ma(a);
+    Matrix<int> mi(id);
+    Array<int> c = ma.dot(mi);
+    for (size_t i = 0; i < 9; i++)
+        EXPECT_EQ(c(i), a(i));
+}
+
+TEST(Gemm, AlphaBetaAndStrides)
+{
+    // C (2 x 2, row stride 3) = 2 * A * B + 1 * C
+    std::vector<double> a = { 1, 2, 3, 4 };
+    std::vector<double> b = { 1, 0, 0, 1 };
+    std::vector<double> c = { 1, 1, -1, 1, 1, -1 };
+    gemm(Trans::No, Trans::No, 2, 2, 2, 2.0, a.data(), 2, b.data(), 2, 1.0, c.data(), 3);
+    EXPECT_DOUBLE_EQ(c[0], 3);
+    EXPECT_DOUBLE_EQ(c[1], 5);
+    EXPECT_DOUBLE_EQ(c[2], -1);
+    EXPECT_DOUBLE_EQ(c[3], 7);
+    EXPECT_DOUBLE_EQ(c[4], 9);
+    EXPECT_DOUBLE_EQ(c[5], -1);
+}
@@ -0,0 +1,91 @@
+#include "NumCPP.hpp"
+#include "TestUtils.hpp"
+#include <gtest/gtest.h>
+
+using namespace NumCPP;
+
+namespace {
+// Diagonally dominant, so every size is well conditioned
+template <size_t N>
+FixedSquareMatrix<double, N> test_matrix(unsigned seed)
+{
+    FixedSquareMatrix<double, N> m;
+    TestRandom random(seed);
+    for (size_t i = 0; i < N * N; ++i)
+        m[i] = random.uniform();
+    for (size_t i = 0; i < N; ++i)
+        m.at_unchecked(i, i) += 2.0;
+    return m;
+}
+
+template <size_t N>
+void expect_inverse_and_determinant()
+{
+    FixedSquareMatrix<double, N> m = test_matrix<N>(N);
+    FixedSquareMatrix<double, N> product = m.dot(m.inverse());
+    for (size_t i = 0; i < N; ++i)
+        for (size_t j = 0; j < N; ++j)
+            EXPECT_NEAR(product(i, j), i == j ? 1.0 : 0.0, 1e-12) << N;
+    SquareMatrix<double> general(m.to_array());
+    EXPECT_NEAR(m.determinant(), general.determinant(), 1e-12) << N;
+}
+}
+
+TEST(FixedMatrix, ConstexprEvaluation)
+{
+    constexpr FixedSquareMatrix<int, 2> a { 1, 2, 3, 4 };
+    static_assert(a.determinant() == -2);
+    static_assert(a.dot(FixedSquareMatrix<int, 2>::identity()) == a);
+    static_assert(a.transposed()(0, 1) == 3);
+    static_assert(a.trace() == 5);
+    constexpr FixedSquareMatrix<double, 2> inv = FixedSquareMatrix<double, 2> { 4, 7, 2, 6 }.inverse();
+    static_assert(inv(0, 0) == 0.6 && inv(1, 1) == 0.4);
+    EXPECT_EQ(sizeof(FixedMatrix<float, 3, 4>), 12 * sizeof(float));
+}
+
+TEST(FixedMatrix, ProductsAndArithmetic)
+{
+    FixedMatrix<double, 2, 3> a { 1, 2, 3, 4, 5, 6 };
+    FixedMatrix<double, 3, 2> b { 7, 8, 9, 10, 11, 12 };
+    EXPECT_EQ(a.dot(b), (FixedSquareMatrix<double, 2> { 58, 64, 139, 154 }));
+    EXPECT_EQ(a.dot(std::array<double, 3> { 1, 0, -1 }), (std::array<double, 2> { -2, -2 }));
+    EXPECT_EQ(a + a, a * 2.0);
+    EXPECT_EQ(a - a, (FixedMatrix<double, 2, 3>()));
+    EXPECT_EQ(-a, a * -1.0);
+    EXPECT_EQ(a.transposed().transposed(), a);
+    EXPECT_EQ(a.transposed()(2, 1), 6);
+}
+
+TEST(FixedMatrix, InverseAndDeterminantMatchGeneralPath)
+{
+    expect_inverse_and_determinant<1>();
+    expect_inverse_and_determinant<2>();
+    expect_inverse_and_determinant<3>();
+    expect_inverse_and_determinant<4>();
+    expect_inverse_and_determinant<5>();
+    expect_inverse_and_determinant<7>();
+}
+
+TEST(FixedMatrix, SingularThrows)
+{
+    EXPECT_THROW((FixedSquareMatrix<double, 3> { 1, 2, 3, 2, 4, 6, 0, 1, 1 }.inverse()), std::runtime_error);
+    FixedSquareMatrix<double, 6> zero;
+    EXPECT_EQ(zero.determinant(), 0.0);
+    EXPECT_THROW(zero.inverse(), std::runtime_error);
+}
+
+TEST(FixedMatrix, ConvertsToAndFromArrayAndMatrix)
+{
+    Array<double> arr({ 2, 3 }, { 1, 2, 3, 4, 5, 6 });
+    FixedMatrix<double, 2, 3> m(arr);
+    EXPECT_EQ(m(1, 0), 4);
+    EXPECT_EQ(m.to_array().flatten(), arr.flatten());
+
+    Matrix<double> general = m.to_matrix();
+    EXPECT_EQ(general.shape(), (std::vector<size_t> { 2, 3 }));
+    EXPECT_EQ((FixedMatrix<double, 2, 3>(general)), m);
+
+    EXPECT_THROW((FixedMatrix<double, 3, 2>(arr)), std::invalid_argument);
+    EXPECT_THROW((FixedMatrix<double, 2, 2> { 1, 2, 3 }), std::invalid_argument);
+    EXPECT_THROW(m(2, 0), std::out_of_range);
+}
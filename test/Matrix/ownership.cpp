@@ -0,0 +1,57 @@
+#include "NumCPP.hpp"
+#include <gtest/gtest.h>
+#include <utility>
+
+using namespace NumCPP;
+
+TEST(MatrixOwnership, SharesArrayStorageUntilWritten)
+{
+    Array<double> a({ 2, 2 }, { 1, 2, 3, 4 });
+    Matrix<double> m(a);
+    EXPECT_EQ(m.array().data(), std::as_const(a).data());
+    EXPECT_EQ(a.storage().use_count(), 2u);
+
+    m += 1.0;
+    EXPECT_EQ(m(0, 0), 2.0);
+    EXPECT_EQ(std::as_const(a)({ 0, 0 }), 1.0);
+    EXPECT_EQ(a.storage().use_count(), 1u);
+    EXPECT_EQ(m.array().storage().use_count(), 1u);
+
+    SquareMatrix<double> s(a);
+    EXPECT_EQ(s.array().data(), std::as_const(a).data());
+    EXPECT_THROW(Matrix<double>(Array<double>({ 2, 2, 2 }, 1.0)), std::invalid_argument);
+}
+
+TEST(MatrixOwnership, ResultsOwnTheirStorage)
+{
+    Matrix<double> m({ 3, 3 }, 1.0);
+    // A leaked result would keep a second reference to its buffer
+    EXPECT_EQ((m + m).array().storage().use_count(), 1u);
+    EXPECT_EQ((m * 2.0).array().storage().use_count(), 1u);
+    EXPECT_EQ((-m).array().storage().use_count(), 1u);
+    EXPECT_EQ((m < m).array().storage().use_count(), 1u);
+    EXPECT_EQ(m.transposed().array().storage().use_count(), 1u);
+    // reshape() shares the buffer, and gives it back when the result goes away
+    EXPECT_EQ(m.reshape({ 1, 9 }).array().data(), m.array().data());
+    EXPECT_EQ(m.array().storage().use_count(), 1u);
+}
+
+TEST(MatrixOwnership, CopiesMovesAndPostfixAreValues)
+{
+    Matrix<double> m({ 2, 2 }, 5.0);
+    Matrix<double> copy = m;
+    Matrix<double> old = copy++;
+    EXPECT_EQ(old(0, 0), 5.0);
+    EXPECT_EQ(copy(0, 0), 6.0);
+    EXPECT_EQ(std::as_const(m)(0, 0), 5.0);
+
+    const double* data = m.array().data();
+    Matrix<double> moved(std::move(m));
+    EXPECT_EQ(moved.array().data(), data);
+    Matrix<double> assigned;
+    EXPECT_EQ(assigned.size(), 0u);
+    assigned = moved;
+    EXPECT_EQ(assigned.array().data(), data);
+    assigned.fill(0.0);
+    EXPECT_EQ(moved(1, 1), 5.0);
+}
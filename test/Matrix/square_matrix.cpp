@@ -0,0 +1,25 @@
+#include "NumCPP.hpp"
+#include <gtest/gtest.h>
+
+using namespace NumCPP;
+
+TEST(SquareMatrix, DeterminantAndInverse)
+{
+    Array<double> a({ 3, 3 }, { 2, 1, 1, 1, 3, 2, 1, 0, 0 });
+    SquareMatrix<double> m(a);
+    EXPECT_NEAR(m.determinant(), -1.0, 1e-12);
+
+    SquareMatrix<double> inv = m.inverse();
+    Array<double> product = m.dot(inv);
+    for (size_t i = 0; i < 3; ++i)
+        for (size_t j = 0; j < 3; ++j)
+            EXPECT_NEAR(product({ i, j }), i == j ? 1.0 : 0.0, 1e-12);
+}
+
+TEST(SquareMatrix, RejectsNonSquare)
+{
+    EXPECT_THROW(SquareMatrix<double>(Array<double>({ 2, 3 }, 1.0)), std::invalid_argument);
+    SquareMatrix<double> zeros(4);
+    EXPECT_EQ(zeros.shape(), (std::vector<size_t> { 4, 4 }));
+    EXPECT_DOUBLE_EQ(zeros.determinant(), 0.0);
+}
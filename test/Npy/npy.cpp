@@ -0,0 +1,204 @@
+#include "Npy.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+
+using namespace NumCPP;
+
+namespace {
+class NpyTest : public ::testing::Test {
+protected:
+    std::filesystem::path dir;
+
+    void SetUp() override
+    {
+        dir = std::filesystem::temp_directory_path()
+            / ("numcpp_npy_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+        std::filesystem::create_directories(dir);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(dir); }
+
+    std::string path(const std::string& name) const { return (dir / name).string(); }
+
+    // A .npy file with a hand-written header dict and raw payload bytes
+    void write_raw(const std::string& name, const std::string& dict, const void* payload, size_t bytes) const
+    {
+        std::string header = dict;
+        while ((10 + header.size() + 1) % 64 != 0)
+            header += ' ';
+        header += '\n';
+        std::ofstream out(path(name), std::ios::binary);
+        out.write("\x93NUMPY\x01\x00", 8);
+        char len[2] = { static_cast<char>(header.size() & 0xFF), static_cast<char>(header.size() >> 8) };
+        out.write(len, 2);
+        out << header;
+        out.write(static_cast<const char*>(payload), static_cast<std::streamsize>(bytes));
+    }
+};
+
+Array<double> sample(const std::vector<size_t>& shape)
+{
+    Array<double> a(shape, 0.0);
+    for (size_t i = 0; i < a.size(); i++)
+        a.data()[i] = 0.5 * static_cast<double>(i) - 3.0;
+    return a;
+}
+}
+
+TEST_F(NpyTest, RoundTripsEveryMode)
+{
+    Array<double> a = sample({ 3, 4, 5 });
+    save_npy(path("a.npy"), a);
+    for (MapMode mode : { MapMode::CopyOnWrite, MapMode::ReadOnly, MapMode::Copy }) {
+        Array<double> b = load_npy<double>(path("a.npy"), mode);
+        EXPECT_EQ(b.shape(), a.shape());
+        EXPECT_EQ(b.flatten(), a.flatten());
+        EXPECT_EQ(b.storage().read_only(), mode == MapMode::ReadOnly);
+    }
+
+    Array<int> i({ 7 }, 3);
+    save_npy(path("i.npy"), i);
+    EXPECT_EQ(load_npy<int>(path("i.npy")).flatten(), i.flatten());
+}
+
+TEST_F(NpyTest, HeaderMatchesNumpyLayout)
+{
+    save_npy(path("h.npy"), sample({ 2, 3 }));
+    std::ifstream in(path("h.npy"), std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    ASSERT_EQ(bytes.size(), 128u + 6 * sizeof(double));
+    EXPECT_EQ(bytes.substr(0, 8), std::string("\x93NUMPY\x01\x00", 8));
+    EXPECT_NE(bytes.find("{'descr': '<f8', 'fortran_order': False, 'shape': (2, 3), }"), std::string::npos);
+    EXPECT_EQ(bytes[127], '\n');
+
+    save_npy(path("v.npy"), Array<float>({ 4 }, 1.0f));
+    std::ifstream vin(path("v.npy"), std::ios::binary);
+    std::string vbytes((std::istreambuf_iterator<char>(vin)), std::istreambuf_iterator<char>());
+    EXPECT_NE(vbytes.find("'descr': '<f4'"), std::string::npos);
+    EXPECT_NE(vbytes.find("'shape': (4,)"), std::string::npos);
+}
+
+TEST_F(NpyTest, MappedWritesNeverReachTheFile)
+{
+    save_npy(path("a.npy"), sample({ 100 }));
+    for (MapMode mode : { MapMode::CopyOnWrite, MapMode::ReadOnly }) {
+        Array<double> b = load_npy<double>(path("a.npy"), mode);
+        b.data()[0] = 42.0;
+        b += 1.0;
+        EXPECT_EQ(b.data()[0], 43.0);
+        EXPECT_FALSE(b.storage().read_only());
+    }
+    EXPECT_EQ(load_npy<double>(path("a.npy")).data()[0], -3.0);
+}
+
+TEST_F(NpyTest, MappingOutlivesOtherCopies)
+{
+    save_npy(path("a.npy"), sample({ 8 }));
+    Array<double> kept;
+    {
+        Array<double> b = load_npy<double>(path("a.npy"), MapMode::ReadOnly);
+        kept = b.reshape({ 2, 4 });
+    }
+    std::filesystem::remove(path("a.npy"));
+    EXPECT_EQ(kept({ 1, 3 }), 0.5);
+}
+
+TEST_F(NpyTest, ConvertsDtypeByteOrderAndFortranOrder)
+{
+    std::int32_t ints[] = { 1, -2, 3, -4 };
+    write_raw("i4.npy", "{'descr': '<i4', 'fortran_order': False, 'shape': (4,), }", ints, sizeof(ints));
+    EXPECT_EQ(load_npy<double>(path("i4.npy")).flatten(), (std::vector<double> { 1, -2, 3, -4 }));
+
+    unsigned char big[16] = { 0x3F, 0xF0, 0, 0, 0, 0, 0, 0, 0xC0, 0, 0, 0, 0, 0, 0, 0 };
+    write_raw("be.npy", "{'descr': '>f8', 'fortran_order': False, 'shape': (2,), }", big, sizeof(big));
+    EXPECT_EQ(load_npy<double>(path("be.npy")).flatten(), (std::vector<double> { 1.0, -2.0 }));
+
+    // Column-major 2 x 3: [[0, 1, 2], [3, 4, 5]] is stored 0 3 1 4 2 5
+    float fortran[] = { 0, 3, 1, 4, 2, 5 };
+    write_raw("f.npy", "{'descr': '<f4', 'fortran_order': True, 'shape': (2, 3), }", fortran, sizeof(fortran));
+    Array<float> f = load_npy<float>(path("f.npy"));
+    EXPECT_EQ(f.shape(), (std::vector<size_t> { 2, 3 }));
+    EXPECT_EQ(f.flatten(), (std::vector<float> { 0, 1, 2, 3, 4, 5 }));
+
+    bool flags[] = { true, false, true };
+    write_raw("b.npy", "{'descr': '|b1', 'fortran_order': False, 'shape': (3,), }", flags, sizeof(flags));
+    EXPECT_EQ(load_npy<int>(path("b.npy")).flatten(), (std::vector<int> { 1, 0, 1 }));
+}
+
+TEST_F(NpyTest, ScalarAndEmptyShapes)
+{
+    double pi = 3.25;
+    write_raw("s.npy", "{'descr': '<f8', 'fortran_order': False, 'shape': (), }", &pi, sizeof(pi));
+    Array<double> s = load_npy<double>(path("s.npy"));
+    EXPECT_EQ(s.shape(), (std::vector<size_t> { 1 }));
+    EXPECT_EQ(s.data()[0], 3.25);
+
+    write_raw("e.npy", "{'descr': '<f8', 'fortran_order': False, 'shape': (0, 3), }", nullptr, 0);
+    EXPECT_EQ(load_npy<double>(path("e.npy")).size(), 0u);
+
+    save_npy(path("empty.npy"), Array<double>());
+    EXPECT_EQ(load_npy<double>(path("empty.npy")).size(), 0u);
+}
+
+TEST_F(NpyTest, RejectsBadFiles)
+{
+    EXPECT_THROW(load_npy<double>(path("missing.npy")), std::runtime_error);
+    std::ofstream(path("junk.npy")) << "not numpy at all";
+    EXPECT_THROW(load_npy<double>(path("junk.npy")), std::runtime_error);
+
+    double one = 1.0;
+    write_raw("short.npy", "{'descr': '<f8', 'fortran_order': False, 'shape': (4,), }", &one, sizeof(one));
+    EXPECT_THROW(load_npy<double>(path("short.npy")), std::runtime_error);
+    write_raw("c.npy", "{'descr': '<c16', 'fortran_order': False, 'shape': (1,), }", &one, sizeof(one));
+    EXPECT_THROW(load_npy<double>(path("c.npy")), std::runtime_error);
+
+    // 2^63 + 1 rows of 2 wrap around to an element count of 2
+    double two[2] = { 1.0, 2.0 };
+    write_raw("wrap.npy", "{'descr': '<f8', 'fortran_order': False, 'shape': (9223372036854775809, 2), }", two,
+        sizeof(two));
+    EXPECT_THROW(load_npy<double>(path("wrap.npy")), std::runtime_error);
+    write_raw("zero.npy", "{'descr': '<f8', 'fortran_order': False, 'shape': (9223372036854775809, 0), }",
+        nullptr, 0);
+    EXPECT_EQ(load_npy<double>(path("zero.npy")).size(), 0u);
+}
+
+TEST_F(NpyTest, NpzRoundTrip)
+{
+    std::map<std::string, Array<double>> arrays;
+    arrays.emplace("weights", sample({ 16, 8 }));
+    arrays.emplace("bias", sample({ 8 }));
+    save_npz(path("m.npz"), arrays);
+
+    for (MapMode mode : { MapMode::CopyOnWrite, MapMode::ReadOnly, MapMode::Copy }) {
+        auto loaded = load_npz<double>(path("m.npz"), mode);
+        ASSERT_EQ(loaded.size(), 2u);
+        EXPECT_EQ(loaded.at("weights").shape(), (std::vector<size_t> { 16, 8 }));
+        EXPECT_EQ(loaded.at("weights").flatten(), arrays.at("weights").flatten());
+        EXPECT_EQ(loaded.at("bias").flatten(), arrays.at("bias").flatten());
+    }
+}
+
+TEST_F(NpyTest, ZipPiecesFollowTheFormat)
+{
+    EXPECT_EQ(detail::crc32(0, "123456789", 9), 0xCBF43926u);
+    EXPECT_EQ(detail::crc32(detail::crc32(0, "1234", 4), "56789", 5), 0xCBF43926u);
+
+    // Zip64 records are written and read back for large offsets
+    std::string end = detail::zip_end_records(1, 100, std::uint64_t(1) << 33);
+    EXPECT_EQ(end.size(), 56u + 20u + 22u);
+    std::string central = detail::zip_central_header("x.npy", 7, 10, std::uint64_t(1) << 33, true);
+    std::string archive = std::string(64, '\0');
+    std::string local = detail::zip_local_header("x.npy", 7, 10, true);
+    archive.replace(0, local.size(), local);
+    std::string directory_end = detail::zip_end_records(1, central.size(), archive.size());
+    // Point the entry back at offset 0 through the zip64 field
+    std::string fixed = detail::zip_central_header("x.npy", 7, 10, 0, true);
+    std::string file = archive + fixed + directory_end;
+    auto entries = detail::zip_entries(file.data(), file.size(), "test");
+    ASSERT_EQ(entries.size(), 1u);
+    EXPECT_EQ(entries[0].name, "x.npy");
+    EXPECT_EQ(entries[0].size, 10u);
+    EXPECT_EQ(entries[0].data_offset, local.size());
+}
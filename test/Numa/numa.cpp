@@ -0,0 +1,175 @@
+#include "NumCPP.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+using namespace NumCPP;
+
+namespace {
+// Fake sysfs node directory: node i gets cpulists[i]
+class FakeNodes {
+public:
+    FakeNodes(const std::string& online, const std::vector<std::string>& cpulists)
+    {
+        root = std::filesystem::temp_directory_path() / "numcpp_numa_test";
+        std::filesystem::remove_all(root);
+        std::filesystem::create_directories(root);
+        std::ofstream(root / "online") << online << "\n";
+        for (size_t i = 0; i < cpulists.size(); ++i) {
+            std::filesystem::create_directories(root / ("node" + std::to_string(i)));
+            std::ofstream(root / ("node" + std::to_string(i)) / "cpulist") << cpulists[i] << "\n";
+        }
+    }
+    ~FakeNodes() { std::filesystem::remove_all(root); }
+
+    std::filesystem::path root;
+};
+
+// Counts the blocks it hands out
+class CountingAllocator : public Allocator {
+public:
+    void* allocate(size_t bytes, size_t alignment) override
+    {
+        live++;
+        return base.allocate(bytes, alignment);
+    }
+    void deallocate(void* ptr, size_t bytes, size_t alignment) noexcept override
+    {
+        live--;
+        base.deallocate(ptr, bytes, alignment);
+    }
+
+    int live = 0;
+    AlignedAllocator base;
+};
+
+std::vector<size_t> range(size_t n)
+{
+    std::vector<size_t> values(n);
+    for (size_t i = 0; i < n; ++i)
+        values[i] = i;
+    return values;
+}
+}
+
+TEST(Numa, ReadsNodesAndSpreadsThreads)
+{
+    FakeNodes fake("0-1", { "0-3", "4-7" });
+    NumaTopology topology = detect_numa_topology(fake.root.string(), range(8));
+    ASSERT_EQ(topology.num_nodes(), 2u);
+    EXPECT_EQ(topology.nodes[1].id, 1u);
+    EXPECT_EQ(topology.nodes[1].cpus, (std::vector<size_t> { 4, 5, 6, 7 }));
+
+    // Four threads: two per node
+    EXPECT_EQ(topology.cpu_for_thread(1, 4), 2u);
+    EXPECT_EQ(topology.cpu_for_thread(2, 4), 4u);
+    EXPECT_EQ(topology.node_for_thread(1, 4), 0u);
+    EXPECT_EQ(topology.node_for_thread(3, 4), 1u);
+    // More threads than CPUs wrap around
+    EXPECT_EQ(topology.cpu_for_thread(9, 16), 1u);
+}
+
+TEST(Numa, AffinityAndMissingSysfsFallBack)
+{
+    FakeNodes fake("0-1", { "0-1,8", "2-3" });
+    NumaTopology restricted = detect_numa_topology(fake.root.string(), { 0, 8 });
+    ASSERT_EQ(restricted.num_nodes(), 1u);
+    EXPECT_EQ(restricted.cpus(), (std::vector<size_t> { 0, 8 }));
+
+    NumaTopology none = detect_numa_topology((fake.root / "missing").string(), { 0, 1, 2 });
+    ASSERT_EQ(none.num_nodes(), 1u);
+    EXPECT_EQ(none.cpus(), (std::vector<size_t> { 0, 1, 2 }));
+    EXPECT_EQ(none.node_for_thread(2, 3), 0u);
+
+    EXPECT_GE(numa_topology().num_nodes(), 1u);
+    EXPECT_FALSE(numa_topology().cpus().empty());
+}
+
+TEST(Numa, PinnedWorkersRunOnOneCpu)
+{
+    ThreadPool pool(3);
+    EXPECT_FALSE(pool.is_pinned());
+    pool.set_pinned(true);
+    EXPECT_TRUE(pool.is_pinned());
+    std::atomic<size_t> count { 0 };
+    std::atomic<bool> single { true };
+    pool.parallel_chunks(64, [&](size_t) {
+        count++;
+#if defined(__linux__)
+        if (pool.in_worker()) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            sched_getaffinity(0, sizeof(set), &set);
+            if (CPU_COUNT(&set) != 1)
+                single = false;
+        }
+#endif
+    });
+    EXPECT_EQ(count.load(), 64u);
+    EXPECT_TRUE(single.load());
+
+    // Pinning the caller is left to the application
+    std::thread other([]() { EXPECT_EQ(pin_current_thread(numa_topology().cpus().front()), bool(NUMCPP_HAS_NUMA)); });
+    other.join();
+}
+
+TEST(Numa, AllocatorPlacesLargeBuffers)
+{
+    for (NumaPolicy policy : { NumaPolicy::Local, NumaPolicy::Interleave, NumaPolicy::Partitioned }) {
+        NumaAllocator numa(policy, 1 << 16);
+        EXPECT_EQ(numa.policy(), policy);
+        void* large = numa.allocate(100000, 64);
+        void* small = numa.allocate(1000, 64);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(large) % 64, 0u);
+        static_cast<char*>(large)[99999] = 1;
+        EXPECT_EQ(numa.stats().allocations, 2u);
+        EXPECT_EQ(numa.stats().bytes_in_use, 101000u);
+        numa.deallocate(large, 100000, 64);
+        numa.deallocate(small, 1000, 64);
+        EXPECT_EQ(numa.stats().bytes_in_use, 0u);
+    }
+}
+
+TEST(Numa, SingleNodeMachinesUseUpstream)
+{
+    CountingAllocator upstream;
+    NumaAllocator numa(NumaPolicy::Interleave, 1 << 16, upstream);
+    void* small = numa.allocate(1000, 64);
+    EXPECT_EQ(upstream.live, 1);
+    void* large = numa.allocate(1 << 20, 64);
+    bool placed = NUMCPP_HAS_NUMA && numa_topology().num_nodes() > 1;
+    EXPECT_EQ(upstream.live, placed ? 1 : 2);
+    numa.deallocate(large, 1 << 20, 64);
+    numa.deallocate(small, 1000, 64);
+    EXPECT_EQ(upstream.live, 0);
+}
+
+TEST(Numa, ArraysInitializeInParallelOnNumaStorage)
+{
+    ThreadPool& pool = ThreadPool::instance();
+    size_t previous = pool.num_threads();
+    pool.set_num_threads(4);
+    NumaAllocator numa(NumaPolicy::Partitioned, 1 << 16);
+    {
+        ScopedAllocator scope(numa);
+        Array<double> a({ 1 << 18 }, 0.5);
+        Array<double> b = a;
+        b += 1.0;
+        EXPECT_DOUBLE_EQ(a.sum(), 0.5 * (1 << 18));
+        EXPECT_DOUBLE_EQ(b.sum(), 1.5 * (1 << 18));
+
+        Storage<double> filled(1 << 18, 2.0);
+        Storage<double> copy = filled.clone();
+        EXPECT_EQ(copy.data()[0], 2.0);
+        EXPECT_EQ(copy.data()[(1 << 18) - 1], 2.0);
+        EXPECT_EQ(numa.stats().allocations, 4u);
+    }
+    EXPECT_EQ(numa.stats().bytes_in_use, 0u);
+    pool.set_num_threads(previous);
+}
@@ -0,0 +1,153 @@
+#include "Array.hpp"
+#include "Permute.hpp"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <numeric>
+
+using namespace NumCPP;
+
+namespace {
+template <typename F>
+void for_each_level(F body)
+{
+    SimdLevel saved = simd_level();
+    for (int level = 0; level <= static_cast<int>(detected_simd_level()); level++) {
+        set_simd_level(static_cast<SimdLevel>(level));
+        SCOPED_TRACE(simd_level_name(simd_level()));
+        body();
+    }
+    set_simd_level(saved);
+}
+
+template <typename T>
+std::vector<T> iota_values(size_t n)
+{
+    std::vector<T> values(n);
+    for (size_t i = 0; i < n; i++)
+        values[i] = static_cast<T>(i);
+    return values;
+}
+
+template <typename T>
+void check_transpose(size_t rows, size_t cols)
+{
+    std::vector<T> src = iota_values<T>(rows * cols);
+    std::vector<T> dst(rows * cols, T(-1));
+    transpose(src.data(), rows, cols, cols, dst.data(), rows);
+    for (size_t i = 0; i < rows; i++) {
+        for (size_t j = 0; j < cols; j++)
+            ASSERT_EQ(dst[j * rows + i], src[i * cols + j]) << rows << "x" << cols << " at " << i << "," << j;
+    }
+}
+
+// Reference permute through multi-indices
+std::vector<double> naive_permute(const std::vector<double>& src, const std::vector<size_t>& shape,
+    const std::vector<size_t>& axes)
+{
+    size_t nd = shape.size();
+    std::vector<size_t> strides(nd, 1), out_shape(nd);
+    for (size_t d = nd - 1; d-- > 0;)
+        strides[d] = strides[d + 1] * shape[d + 1];
+    for (size_t d = 0; d < nd; d++)
+        out_shape[d] = shape[axes[d]];
+    std::vector<double> out(src.size());
+    for (size_t flat = 0; flat < out.size(); flat++) {
+        size_t rem = flat, off = 0;
+        for (size_t d = nd; d-- > 0;) {
+            off += (rem % out_shape[d]) * strides[axes[d]];
+            rem /= out_shape[d];
+        }
+        out[flat] = src[off];
+    }
+    return out;
+}
+}
+
+TEST(Permute, TransposeOddShapesAllLevels)
+{
+    for_each_level([] {
+        for (size_t rows : { 1u, 3u, 16u, 17u, 65u, 300u }) {
+            for (size_t cols : { 1u, 5u, 16u, 31u, 257u }) {
+                check_transpose<double>(rows, cols);
+                check_transpose<float>(rows, cols);
+                check_transpose<std::int16_t>(rows, cols);
+            }
+        }
+    });
+}
+
+TEST(Permute, TransposeWithLeadingDimensions)
+{
+    // 5 x 7 block inside 9 x 11 storage, written into a 7 x 5 block of 7 x 8
+    std::vector<double> src = iota_values<double>(9 * 11);
+    std::vector<double> dst(7 * 8, -1.0);
+    transpose(src.data() + 11 + 2, 5, 7, 11, dst.data() + 1, 8);
+    for (size_t i = 0; i < 5; i++) {
+        for (size_t j = 0; j < 7; j++)
+            EXPECT_EQ(dst[j * 8 + 1 + i], src[(i + 1) * 11 + 2 + j]);
+    }
+    EXPECT_EQ(dst[0], -1.0);
+}
+
+TEST(Permute, InplaceTransposeAllLevels)
+{
+    for_each_level([] {
+        for (size_t n : { 1u, 2u, 15u, 64u, 100u, 130u }) {
+            std::vector<float> a = iota_values<float>(n * n);
+            transpose_inplace(a.data(), n);
+            for (size_t i = 0; i < n; i++) {
+                for (size_t j = 0; j < n; j++)
+                    ASSERT_EQ(a[i * n + j], static_cast<float>(j * n + i)) << n;
+            }
+        }
+    });
+}
+
+TEST(Permute, PermuteMatchesNaive)
+{
+    std::vector<size_t> shape = { 3, 17, 4, 33 };
+    std::vector<double> src = iota_values<double>(3 * 17 * 4 * 33);
+    std::vector<size_t> axes = { 0, 1, 2, 3 };
+    do {
+        std::vector<double> dst(src.size());
+        permute(src.data(), shape, axes, dst.data());
+        EXPECT_EQ(dst, naive_permute(src, shape, axes));
+    } while (std::next_permutation(axes.begin(), axes.end()));
+}
+
+TEST(Permute, RejectsInvalidAxes)
+{
+    std::vector<double> src(6), dst(6);
+    EXPECT_THROW(permute(src.data(), { 2, 3 }, { 0, 0 }, dst.data()), std::invalid_argument);
+    EXPECT_THROW(permute(src.data(), { 2, 3 }, { 0 }, dst.data()), std::invalid_argument);
+    EXPECT_THROW(permute(src.data(), { 2, 3 }, { 0, 2 }, dst.data()), std::invalid_argument);
+}
+
+TEST(Permute, ArrayTransposeAndPermute)
+{
+    Array<double> square({ 70, 70 }, iota_values<double>(70 * 70));
+    Array<double> shared = square;
+    square.transpose();
+    EXPECT_EQ(square({ 3, 5 }), 5.0 * 70 + 3);
+    EXPECT_EQ(shared({ 3, 5 }), 3.0 * 70 + 5);
+
+    Array<double> cube({ 2, 3, 4 }, iota_values<double>(24));
+    Array<double> moved = cube.permuted({ 2, 0, 1 });
+    EXPECT_EQ(moved.shape(), (std::vector<size_t> { 4, 2, 3 }));
+    EXPECT_EQ(moved({ 3, 1, 2 }), cube({ 1, 2, 3 }));
+    cube.permute({ 1, 2, 0 });
+    EXPECT_EQ(cube.shape(), (std::vector<size_t> { 3, 4, 2 }));
+    EXPECT_EQ(cube({ 2, 3, 1 }), 1.0 * 12 + 2 * 4 + 3);
+    EXPECT_THROW(cube.permute({ 0, 1 }), std::invalid_argument);
+}
+
+TEST(Permute, TransposedViewMaterializes)
+{
+    Array<float> a({ 40, 50 }, iota_values<float>(2000));
+    Array<float> t(a.view().transpose());
+    EXPECT_EQ(t.shape(), (std::vector<size_t> { 50, 40 }));
+    for (size_t i = 0; i < 50; i++) {
+        for (size_t j = 0; j < 40; j++)
+            ASSERT_EQ(t({ i, j }), a({ j, i }));
+    }
+}
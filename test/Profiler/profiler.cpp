@@ -0,0 +1,102 @@
+#include "NumCPP.hpp"
+#include <gtest/gtest.h>
+#include <sstream>
+
+using namespace NumCPP;
+
+namespace {
+// Enables recording for one test and restores a clean profiler afterwards
+class ProfilerTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        Profiler::instance().reset();
+        Profiler::instance().set_enabled(true);
+    }
+    void TearDown() override
+    {
+        Profiler::instance().set_enabled(false);
+        Profiler::instance().set_tracing(false);
+        Profiler::instance().reset();
+        ThreadPool::instance().set_num_threads(0);
+    }
+};
+}
+
+TEST_F(ProfilerTest, CountsCallsElementsAndBytes)
+{
+    Array<double> a({ 100 }, 1.0);
+    EXPECT_DOUBLE_EQ(a.sum(), 100.0);
+    EXPECT_DOUBLE_EQ(a.sum(), 100.0);
+    Array<double> b = a.transposed();
+
+    OpStats sum = Profiler::instance().stats("Array::sum");
+    EXPECT_EQ(sum.calls, 2u);
+    EXPECT_EQ(sum.elements, 200u);
+    EXPECT_EQ(sum.bytes_allocated, 0u);
+
+    OpStats construct = Profiler::instance().stats("Array::Array");
+    EXPECT_EQ(construct.calls, 1u);
+    EXPECT_EQ(construct.bytes_allocated, 100 * sizeof(double));
+
+    // Inclusive of the nested permuted(), which allocates the result
+    OpStats transposed = Profiler::instance().stats("Array::transposed");
+    EXPECT_EQ(transposed.calls, 1u);
+    EXPECT_EQ(transposed.bytes_allocated, 100 * sizeof(double));
+    EXPECT_EQ(Profiler::instance().stats("Array::permuted").bytes_allocated, 100 * sizeof(double));
+    EXPECT_GE(transposed.total_ns, Profiler::instance().stats("Array::permuted").total_ns);
+
+    EXPECT_EQ(Profiler::instance().stats("Array::never_called").calls, 0u);
+}
+
+TEST_F(ProfilerTest, RecordsParallelPath)
+{
+    ThreadPool::instance().set_num_threads(4);
+    Array<float> big({ 1 << 20 }, 1.0f);
+    Array<float> small({ 16 }, 1.0f);
+    big.sum();
+    small.sum();
+    EXPECT_EQ(Profiler::instance().stats("Array::sum").calls, 2u);
+    EXPECT_EQ(Profiler::instance().stats("Array::sum").parallel_calls, 1u);
+}
+
+TEST_F(ProfilerTest, DisabledAtRuntimeRecordsNothing)
+{
+    Profiler::instance().set_enabled(false);
+    Array<int> a({ 10 }, 1);
+    a += 1;
+    EXPECT_TRUE(Profiler::instance().stats().empty());
+}
+
+TEST_F(ProfilerTest, MatrixAndSquareMatrixOps)
+{
+    SquareMatrix<double> m(Array<double>({ 2, 2 }, { 4, 1, 2, 3 }));
+    EXPECT_NEAR(m.determinant(), 10.0, 1e-12);
+    m.dot(m);
+    EXPECT_EQ(Profiler::instance().stats("SquareMatrix::determinant").calls, 1u);
+    EXPECT_EQ(Profiler::instance().stats("Matrix::dot").calls, 1u);
+
+    std::vector<OpStats> all = Profiler::instance().stats();
+    ASSERT_FALSE(all.empty());
+    for (size_t i = 1; i < all.size(); ++i)
+        EXPECT_GE(all[i - 1].total_ns, all[i].total_ns);
+}
+
+TEST_F(ProfilerTest, ChromeTraceExport)
+{
+    Profiler::instance().set_tracing(true, 3);
+    Array<double> a({ 8 }, 2.0);
+    a.max();
+    a.min();
+    a.mean();
+    EXPECT_EQ(Profiler::instance().events().size(), 3u);
+    EXPECT_GT(Profiler::instance().dropped_events(), 0u);
+
+    std::ostringstream out;
+    Profiler::instance().write_chrome_trace(out);
+    std::string json = out.str();
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\"", 0), 0u);
+    EXPECT_NE(json.find("\"name\": \"Array::max\""), std::string::npos);
+    EXPECT_NE(json.find("\"ph\": \"X\""), std::string::npos);
+    EXPECT_NE(json.find("\"elements\": 8"), std::string::npos);
+}
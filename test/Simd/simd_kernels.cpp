@@ -0,0 +1,137 @@
+#include "Array.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace NumCPP;
+
+namespace {
+// Runs body once per SIMD level supported by this CPU, restoring the
+// active level afterwards.
+template <typename F>
+void for_each_level(F body)
+{
+    SimdLevel saved = simd_level();
+    for (int level = 0; level <= static_cast<int>(detected_simd_level()); level++) {
+        set_simd_level(static_cast<SimdLevel>(level));
+        SCOPED_TRACE(simd_level_name(simd_level()));
+        body();
+    }
+    set_simd_level(saved);
+}
+
+template <typename T>
+Array<T> ramp(size_t n, T start, T step)
+{
+    std::vector<T> values(n);
+    for (size_t i = 0; i < n; i++)
+        values[i] = static_cast<T>(start + step * static_cast<T>(i));
+    return Array<T>({ n }, values);
+}
+}
+
+TEST(SimdKernels, LevelIsClampedToDetected)
+{
+    SimdLevel saved = simd_level();
+    set_simd_level(SimdLevel::AVX512);
+    EXPECT_LE(static_cast<int>(simd_level()), static_cast<int>(detected_simd_level()));
+    set_simd_level(SimdLevel::Scalar);
+    EXPECT_EQ(simd_level(), SimdLevel::Scalar);
+    set_simd_level(saved);
+}
+
+TEST(SimdKernels, ElementWiseMatchesScalarForOddSizes)
+{
+    for_each_level([] {
+        for (size_t n : { 1u, 3u, 7u, 17u, 33u, 1023u }) {
+            Array<double> a = ramp<double>(n, 1.0, 0.5);
+            Array<double> b = ramp<double>(n, 2.0, -0.25);
+            Array<double> result = a * b + a / 2.0 - b;
+            for (size_t i = 0; i < n; i++) {
+                EXPECT_DOUBLE_EQ(result(i), a(i) * b(i) + a(i) / 2.0 - b(i));
+            }
+        }
+    });
+}
+
+TEST(SimdKernels, IntegerAndFloatLanes)
+{
+    for_each_level([] {
+        Array<int> a = ramp<int>(37, -5, 3);
+        Array<int> result = (a * 2 - 1) ^ a;
+        for (size_t i = 0; i < 37; i++) {
+            EXPECT_EQ(result(i), (a(i) * 2 - 1) ^ a(i));
+        }
+        Array<float> f = ramp<float>(37, 0.5f, 0.25f);
+        Array<float> g = -f + 1.0f;
+        for (size_t i = 0; i < 37; i++) {
+            EXPECT_FLOAT_EQ(g(i), -f(i) + 1.0f);
+        }
+    });
+}
+
+TEST(SimdKernels, ComparisonsYieldOnesAndZeros)
+{
+    for_each_level([] {
+        Array<double> a = ramp<double>(19, 0.0, 1.0);
+        Array<double> b({ 19 }, 9.0);
+        Array<double> less = a < b;
+        Array<double> both = (a > 2.0) && (a <= b);
+        for (size_t i = 0; i < 19; i++) {
+            EXPECT_DOUBLE_EQ(less(i), i < 9 ? 1.0 : 0.0);
+            EXPECT_DOUBLE_EQ(both(i), (i > 2 && i <= 9) ? 1.0 : 0.0);
+        }
+    });
+}
+
+TEST(SimdKernels, CompoundAssignmentOnUnalignedRange)
+{
+    for_each_level([] {
+        Array<double> a = ramp<double>(45, 1.0, 1.0);
+        Array<double> b({ 45 }, 2.0);
+        a *= b;
+        a += 1.0;
+        for (size_t i = 0; i < 45; i++) {
+            EXPECT_DOUBLE_EQ(a(i), (i + 1.0) * 2.0 + 1.0);
+        }
+    });
+}
+
+TEST(SimdKernels, FillAndPow)
+{
+    for_each_level([] {
+        Array<double> a({ 21 }, 0.0);
+        a.fill(3.0);
+        a.pow(2.0);
+        for (size_t i = 0; i < 21; i++) {
+            EXPECT_DOUBLE_EQ(a(i), 9.0);
+        }
+        a.pow(-1.0);
+        EXPECT_DOUBLE_EQ(a(20), 1.0 / 9.0);
+        a.pow(0.5);
+        EXPECT_DOUBLE_EQ(a(0), std::pow(1.0 / 9.0, 0.5));
+
+        Array<int> b({ 5 }, 3);
+        b.pow(3);
+        EXPECT_EQ(b(4), 27);
+    });
+}
+
+TEST(SimdKernels, ReductionsMatchScalar)
+{
+    for_each_level([] {
+        for (size_t n : { 1u, 5u, 16u, 61u, 4099u }) {
+            Array<long> a = ramp<long>(n, -30, 7);
+            long sum = 0;
+            for (size_t i = 0; i < n; i++)
+                sum += a(i);
+            EXPECT_EQ(a.sum(), sum);
+            EXPECT_EQ(a.min(), -30);
+            EXPECT_EQ(a.max(), -30 + 7 * static_cast<long>(n - 1));
+
+            Array<double> d = ramp<double>(n, 10.0, -1.0);
+            EXPECT_DOUBLE_EQ(d.min(), 10.0 - static_cast<double>(n - 1));
+            EXPECT_DOUBLE_EQ(d.max(), 10.0);
+            EXPECT_DOUBLE_EQ((d * 2.0).sum(), 2.0 * d.sum());
+        }
+    });
+}
@@ -0,0 +1,130 @@
+#include "NumCPP.hpp"
+#include "TestUtils.hpp"
+#include <gtest/gtest.h>
+
+using namespace NumCPP;
+
+namespace {
+// About one element in `every` is nonzero; row 3 is dense so blocks of rows
+// carry very different numbers of entries
+Array<double> sparse_dense(size_t rows, size_t cols, size_t every, unsigned seed)
+{
+    Array<double> a({ rows, cols }, 0.0);
+    double* data = a.data();
+    TestRandom random(seed);
+    for (size_t i = 0; i < rows * cols; ++i) {
+        double value = random.uniform();
+        if (random.bits() % every == 0 || i / cols == 3)
+            data[i] = value;
+    }
+    return a;
+}
+}
+
+TEST(Sparse, CooAssemblesSortedCsrSummingDuplicates)
+{
+    CooMatrix<double> coo(3, 4);
+    coo.add(2, 1, 5);
+    coo.add(0, 3, 1);
+    coo.add(0, 0, 2);
+    coo.add(2, 1, -1);
+    EXPECT_THROW(coo.add(3, 0, 1), std::out_of_range);
+    CsrMatrix<double> csr = coo.to_csr();
+    EXPECT_EQ(csr.nnz(), 3u);
+    EXPECT_EQ(csr.indptr(), (std::vector<size_t> { 0, 2, 2, 3 }));
+    EXPECT_EQ(csr.indices(), (std::vector<size_t> { 0, 3, 1 }));
+    EXPECT_EQ(csr.values(), (std::vector<double> { 2, 1, 4 }));
+    EXPECT_EQ(csr.at(2, 1), 4);
+    EXPECT_EQ(csr.at(1, 1), 0);
+    EXPECT_THROW(csr.at(0, 4), std::out_of_range);
+    EXPECT_EQ(csr.to_array().flatten(), coo.to_array().flatten());
+    EXPECT_EQ(csr.to_coo().to_csr().values(), csr.values());
+}
+
+TEST(Sparse, DenseRoundTripAndValidation)
+{
+    Array<double> dense = sparse_dense(20, 30, 10, 1);
+    CsrMatrix<double> csr(dense);
+    EXPECT_EQ(csr.shape(), (std::vector<size_t> { 20, 30 }));
+    EXPECT_EQ(csr.to_array().flatten(), dense.flatten());
+    EXPECT_EQ(CooMatrix<double>(dense).to_csr().indices(), csr.indices());
+    Matrix<double> matrix = csr.to_matrix();
+    EXPECT_EQ(CsrMatrix<double>(matrix).values(), csr.values());
+    expect_near(csr.transposed().to_array(), dense.transposed(), 0);
+
+    EXPECT_THROW(CsrMatrix<double>(0, 3), std::invalid_argument);
+    EXPECT_THROW(CsrMatrix<double>(2, 2, { 0, 1 }, { 0 }, { 1.0 }), std::invalid_argument);
+    EXPECT_THROW(CsrMatrix<double>(2, 2, { 0, 2, 2 }, { 1, 0 }, { 1.0, 2.0 }), std::invalid_argument);
+    EXPECT_THROW(CsrMatrix<double>(2, 2, { 0, 1, 1 }, { 2 }, { 1.0 }), std::invalid_argument);
+    EXPECT_THROW(CsrMatrix<double>(Array<double>({ 2, 2, 2 }, 1.0)), std::invalid_argument);
+}
+
+TEST(Sparse, SpmvAndSpmmMatchDenseProduct)
+{
+    Array<double> dense = sparse_dense(300, 200, 20, 2);
+    CsrMatrix<double> csr(dense);
+    Matrix<double> dense_matrix(dense);
+
+    Array<double> x = sparse_dense(200, 1, 1, 3);
+    Array<double> vector({ 200 }, x.flatten());
+    Array<double> y = csr.dot(vector);
+    ASSERT_EQ(y.shape(), (std::vector<size_t> { 300 }));
+    Array<double> expected = dense_matrix.dot(Matrix<double>(x));
+    for (size_t i = 0; i < 300; ++i)
+        EXPECT_NEAR(y.data()[i], expected.data()[i], 1e-12);
+
+    Array<double> b = sparse_dense(200, 7, 1, 4);
+    Matrix<double> b_matrix(b);
+    expect_near(csr.dot(b), dense_matrix.dot(b_matrix), 1e-12);
+    expect_near(csr.dot(b_matrix), dense_matrix.dot(b_matrix), 1e-12);
+
+    Array<double> out({ 300, 7 });
+    csr.dot(b, out);
+    expect_near(out, dense_matrix.dot(b_matrix), 1e-12);
+    Array<double> wrong({ 300, 6 });
+    EXPECT_THROW(csr.dot(b, wrong), std::invalid_argument);
+    EXPECT_THROW(csr.dot(Array<double>({ 199 }, 1.0)), std::runtime_error);
+}
+
+TEST(Sparse, DotIntoItsOwnInput)
+{
+    CooMatrix<double> coo(2, 2);
+    coo.add(0, 1, 1);
+    coo.add(1, 0, 1);
+    CsrMatrix<double> swap = coo.to_csr();
+    Array<double> x({ 2 }, std::vector<double> { 1, 2 });
+    swap.dot(x, x);
+    EXPECT_EQ(x.flatten(), (std::vector<double> { 2, 1 }));
+
+    Array<double> dense = sparse_dense(30, 30, 5, 9);
+    CsrMatrix<double> csr(dense);
+    Array<double> b = sparse_dense(30, 4, 1, 10);
+    Array<double> expected = csr.dot(b);
+    csr.dot(b, b);
+    expect_near(b, expected, 0);
+}
+
+TEST(Sparse, DenseTimesSparseThroughMatrixDot)
+{
+    Array<double> a = sparse_dense(9, 40, 3, 5);
+    Array<double> s = sparse_dense(40, 25, 8, 6);
+    Matrix<double> a_matrix(a);
+    Matrix<double> s_matrix(s);
+    expect_near(a_matrix.dot(CsrMatrix<double>(s)), a_matrix.dot(s_matrix), 1e-12);
+    EXPECT_THROW(a_matrix.dot(CsrMatrix<double>(39, 25)), std::runtime_error);
+}
+
+TEST(Sparse, ElementWiseOperators)
+{
+    Array<double> a = sparse_dense(12, 15, 4, 7);
+    Array<double> b = sparse_dense(12, 15, 4, 8);
+    CsrMatrix<double> sa(a), sb(b);
+    expect_near((sa + sb).to_array(), a + b, 1e-15);
+    expect_near((sa - sb).to_array(), a - b, 1e-15);
+    expect_near((sa * sb).to_array(), a * b, 1e-15);
+    expect_near((sa * 3.0).to_array(), a * 3.0, 1e-15);
+    expect_near((sa / 2.0).to_array(), a / 2.0, 1e-15);
+    expect_near((-sa).to_array(), -a, 1e-15);
+    EXPECT_LE((sa * sb).nnz(), std::min(sa.nnz(), sb.nnz()));
+    EXPECT_THROW(sa + CsrMatrix<double>(12, 14), std::runtime_error);
+}
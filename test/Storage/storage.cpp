@@ -0,0 +1,164 @@
+#include "NumCPP.hpp"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <utility>
+
+using namespace NumCPP;
+
+namespace {
+// Counts the blocks it hands out
+class CountingAllocator : public Allocator {
+public:
+    void* allocate(size_t bytes, size_t alignment) override
+    {
+        live++;
+        return base.allocate(bytes, alignment);
+    }
+    void deallocate(void* ptr, size_t bytes, size_t alignment) noexcept override
+    {
+        live--;
+        base.deallocate(ptr, bytes, alignment);
+    }
+
+    int live = 0;
+    AlignedAllocator base;
+};
+}
+
+TEST(Storage, AlignedAllocation)
+{
+    Storage<double> s(17, 1.5);
+    EXPECT_EQ(s.size(), 17u);
+    EXPECT_EQ(s.alignment(), Storage<double>::default_alignment);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(s.data()) % 64, 0u);
+    EXPECT_DOUBLE_EQ(s.data()[16], 1.5);
+
+    Storage<float> wide(5, default_allocator(), 256);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(wide.data()) % 256, 0u);
+    EXPECT_THROW(Storage<float>(5, default_allocator(), 48), std::invalid_argument);
+}
+
+TEST(Storage, CopiesShareAndCloneDetaches)
+{
+    Storage<int> a(4, 7);
+    Storage<int> b = a;
+    EXPECT_EQ(a.data(), b.data());
+    EXPECT_EQ(a.use_count(), 2u);
+    b.make_unique();
+    EXPECT_NE(a.data(), b.data());
+    EXPECT_EQ(b.data()[3], 7);
+    EXPECT_TRUE(a.unique());
+}
+
+TEST(Storage, PluggableAllocator)
+{
+    CountingAllocator counting;
+    {
+        Storage<double> s(8, 0.0, counting);
+        Storage<double> shared = s;
+        EXPECT_EQ(counting.live, 1);
+        Storage<double> copy = s.clone();
+        EXPECT_EQ(counting.live, 2);
+    }
+    EXPECT_EQ(counting.live, 0);
+}
+
+TEST(Storage, AdoptAndWrapExternalMemory)
+{
+    bool released = false;
+    double* external = new double[3] { 1.0, 2.0, 3.0 };
+    {
+        Array<double> a({ 3 }, Storage<double>::adopt(external, 3, [&](double* p) {
+            released = true;
+            delete[] p;
+        }));
+        EXPECT_EQ(static_cast<const Array<double>&>(a).data(), external);
+        EXPECT_DOUBLE_EQ(a.sum(), 6.0);
+    }
+    EXPECT_TRUE(released);
+
+    std::vector<int> buffer = { 1, 2, 3, 4, 5, 6 };
+    Array<int> view({ 2, 3 }, Storage<int>::wrap(buffer.data(), buffer.size()));
+    view += 10;
+    EXPECT_EQ(buffer[5], 16);
+    EXPECT_THROW(Array<int>({ 4, 3 }, Storage<int>::wrap(buffer.data(), buffer.size())),
+        std::invalid_argument);
+}
+
+TEST(Storage, ReadOnlyAdoptionCopiesOnFirstWrite)
+{
+    const double constant[] = { 1.0, 2.0, 3.0 };
+    Array<double> a({ 3 }, Storage<double>::adopt(const_cast<double*>(constant), 3, nullptr, true));
+    EXPECT_TRUE(a.storage().read_only());
+    EXPECT_TRUE(a.storage().unique());
+    EXPECT_FALSE(a.storage().writable());
+    a *= 2.0;
+    EXPECT_FALSE(a.storage().read_only());
+    EXPECT_DOUBLE_EQ(a.sum(), 12.0);
+    EXPECT_EQ(constant[2], 3.0);
+}
+
+TEST(Storage, ArrayCopyOnWrite)
+{
+    Array<double> a({ 1000 }, 1.0);
+    Array<double> b = a;
+    const Array<double>& ca = a;
+    const Array<double>& cb = b;
+    EXPECT_EQ(ca.data(), cb.data());
+    EXPECT_EQ(a.storage().use_count(), 2u);
+
+    b(0) = 5.0;
+    EXPECT_NE(ca.data(), cb.data());
+    EXPECT_DOUBLE_EQ(a(0), 1.0);
+    EXPECT_DOUBLE_EQ(b(0), 5.0);
+
+    Array<double> c = a;
+    c += 1.0;
+    EXPECT_DOUBLE_EQ(a.sum(), 1000.0);
+    EXPECT_DOUBLE_EQ(c.sum(), 2000.0);
+
+    Array<double> d = a;
+    d = d * 3.0;
+    EXPECT_DOUBLE_EQ(a(999), 1.0);
+    EXPECT_DOUBLE_EQ(d(999), 3.0);
+}
+
+TEST(Storage, ReferencesTakenBeforeACopyStayPrivate)
+{
+    Array<double> a({ 4 }, 1.0);
+    double& r = a(0);
+    Array<double> b = a;
+    r = 5;
+    EXPECT_EQ(std::as_const(b)(0), 1.0);
+    EXPECT_EQ(std::as_const(a)(0), 5.0);
+    EXPECT_TRUE(a.storage().leaked());
+
+    // Pointers, spans and views escape the buffer the same way
+    Array<double> p({ 4 }, 1.0);
+    double* raw = p.data();
+    ArrayView<double> view = p.view();
+    Array<double> q = p;
+    Array<double> s = p.reshape({ 2, 2 });
+    raw[1] = 7.0;
+    view(2) = 8.0;
+    EXPECT_EQ(std::as_const(q)(1), 1.0);
+    EXPECT_EQ(std::as_const(q)(2), 1.0);
+    EXPECT_EQ(std::as_const(s)(0, 1), 1.0);
+    EXPECT_EQ(std::as_const(p)(2), 8.0);
+
+    // Read-only access leaves copies sharing the buffer
+    Array<double> shared({ 4 }, 1.0);
+    EXPECT_EQ(std::as_const(shared)(0), 1.0);
+    Array<double> copy = shared;
+    EXPECT_EQ(std::as_const(copy).data(), std::as_const(shared).data());
+}
+
+TEST(Storage, ReshapeSharesBuffer)
+{
+    Array<double> a({ 2, 6 }, 2.0);
+    Array<double> r = a.reshape({ 3, 4 });
+    EXPECT_EQ(static_cast<const Array<double>&>(a).data(), static_cast<const Array<double>&>(r).data());
+    r.fill(0.0);
+    EXPECT_DOUBLE_EQ(a.sum(), 24.0);
+    EXPECT_DOUBLE_EQ(r.sum(), 0.0);
+}
@@ -0,0 +1,58 @@
+#ifndef TEST_UTILS_HPP
+#define TEST_UTILS_HPP
+
+#include "Array.hpp"
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <vector>
+
+// Linear congruential generator, so every platform sees the same test data
+class TestRandom {
+public:
+    explicit TestRandom(unsigned seed)
+        : state_(seed)
+    {
+    }
+
+    // 15 random bits
+    unsigned bits()
+    {
+        state_ = state_ * 1103515245u + 12345u;
+        return state_ >> 16 & 0x7fff;
+    }
+
+    // Uniform in [-0.5, 0.5)
+    double uniform() { return double(bits()) / 32768.0 - 0.5; }
+
+private:
+    unsigned state_;
+};
+
+inline NumCPP::Array<double> random_array(const std::vector<size_t>& shape, unsigned seed)
+{
+    size_t size = 1;
+    for (size_t extent : shape)
+        size *= extent;
+    std::vector<double> values(size);
+    TestRandom random(seed);
+    for (double& value : values)
+        value = random.uniform();
+    return NumCPP::Array<double>(shape, values);
+}
+
+// Element-wise comparison in row-major order
+inline void expect_near(const NumCPP::Array<double>& actual, const std::vector<double>& expected, double tolerance)
+{
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+        EXPECT_NEAR(actual.data()[i], expected[i], tolerance) << "at flat index " << i;
+}
+
+inline void expect_near(const NumCPP::Array<double>& actual, const NumCPP::Array<double>& expected, double tolerance)
+{
+    ASSERT_EQ(actual.shape(), expected.shape());
+    for (size_t i = 0; i < actual.size(); ++i)
+        EXPECT_NEAR(actual.data()[i], expected.data()[i], tolerance) << "at flat index " << i;
+}
+
+#endif
@@ -0,0 +1,127 @@
+#include "Array.hpp"
+#include "ThreadPool.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <thread>
+
+using namespace NumCPP;
+
+TEST(ThreadPool, ParallelForCoversRange)
+{
+    ThreadPool pool(4);
+    std::vector<int> hits(10000, 0);
+    pool.parallel_for(0, hits.size(), [&](size_t start, size_t end) {
+        for (size_t i = start; i < end; i++)
+            hits[i]++;
+    });
+    EXPECT_EQ(std::accumulate(hits.begin(), hits.end(), 0), 10000);
+    EXPECT_TRUE(std::all_of(hits.begin(), hits.end(), [](int h) { return h == 1; }));
+}
+
+TEST(ThreadPool, SmallRangeRunsOnCaller)
+{
+    ThreadPool pool(4);
+    std::thread::id caller = std::this_thread::get_id();
+    std::thread::id seen;
+    pool.parallel_for(0, 3, [&](size_t, size_t) { seen = std::this_thread::get_id(); });
+    EXPECT_EQ(seen, caller);
+}
+
+TEST(ThreadPool, InlineModeUsesCallerOnly)
+{
+    ThreadPool pool(4);
+    pool.set_inline(true);
+    std::thread::id caller = std::this_thread::get_id();
+    std::set<std::thread::id> seen;
+    pool.parallel_chunks(16, [&](size_t) { seen.insert(std::this_thread::get_id()); });
+    ASSERT_EQ(seen.size(), 1u);
+    EXPECT_EQ(*seen.begin(), caller);
+}
+
+TEST(ThreadPool, ThreadsStartOnTheirOwnShare)
+{
+    // Chunks 0-1 are the caller's share, 2-3 the worker's. Chunk 0 holds the
+    // caller until chunk 2 has run, so only the worker can have run it, and
+    // it must have started there rather than at the next free chunk.
+    ThreadPool pool(2);
+    std::mutex mutex;
+    std::condition_variable ran;
+    std::vector<std::thread::id> order;
+    std::vector<size_t> chunks;
+    pool.parallel_chunks(4, [&](size_t c) {
+        std::unique_lock<std::mutex> lock(mutex);
+        order.push_back(std::this_thread::get_id());
+        chunks.push_back(c);
+        ran.notify_all();
+        if (c == 0)
+            ran.wait_for(lock, std::chrono::seconds(10), [&]() {
+                return std::find(chunks.begin(), chunks.end(), 2u) != chunks.end();
+            });
+    });
+    auto two = std::find(chunks.begin(), chunks.end(), 2u) - chunks.begin();
+    std::thread::id worker = order[two];
+    EXPECT_NE(worker, std::this_thread::get_id());
+    EXPECT_EQ(std::find(order.begin(), order.end(), worker) - order.begin(), two);
+}
+
+TEST(ThreadPool, ParallelReduceCombinesInOrder)
+{
+    ThreadPool pool(3);
+    long long result = pool.parallel_reduce(
+        0, 100000, 0LL,
+        [](size_t start, size_t end) {
+            long long local = 0;
+            for (size_t i = start; i < end; i++)
+                local += static_cast<long long>(i);
+            return local;
+        },
+        [](long long a, long long b) { return a + b; }, 100);
+    EXPECT_EQ(result, 100000LL * 99999LL / 2);
+}
+
+TEST(ThreadPool, NestedParallelism)
+{
+    ThreadPool pool(4);
+    std::atomic<size_t> count { 0 };
+    pool.parallel_chunks(8, [&](size_t) {
+        pool.parallel_for(0, 4000, [&](size_t start, size_t end) { count += end - start; }, 100);
+    });
+    EXPECT_EQ(count.load(), 8u * 4000u);
+}
+
+TEST(ThreadPool, ExceptionPropagatesToCaller)
+{
+    ThreadPool pool(4);
+    EXPECT_THROW(pool.parallel_chunks(8, [](size_t c) {
+        if (c == 5)
+            throw std::runtime_error("chunk failed");
+    }),
+        std::runtime_error);
+}
+
+TEST(ThreadPool, SetNumThreads)
+{
+    ThreadPool pool(2);
+    EXPECT_EQ(pool.num_threads(), 2u);
+    pool.set_num_threads(5);
+    EXPECT_EQ(pool.num_threads(), 5u);
+    std::atomic<size_t> count { 0 };
+    pool.parallel_chunks(20, [&](size_t) { count++; });
+    EXPECT_EQ(count.load(), 20u);
+}
+
+TEST(ThreadPool, ArrayKernelsUseSharedPool)
+{
+    Array<double> arr({ 100, 100 }, 1.5);
+    EXPECT_DOUBLE_EQ(arr.sum(), 15000.0);
+    auto doubled = arr + arr;
+    EXPECT_DOUBLE_EQ(doubled.max(), 3.0);
+    ThreadPool::instance().set_inline(true);
+    EXPECT_DOUBLE_EQ((doubled - arr).min(), 1.5);
+    ThreadPool::instance().set_inline(false);
+}